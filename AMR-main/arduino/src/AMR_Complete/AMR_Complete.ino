@@ -8,7 +8,7 @@
  * 
  * HARDWARE:
  * - Arduino Uno / UNO R4 WiFi
- * - Encoder E386G5 (calibrado a ~3418 PPR por defecto)
+ * - Encoder E386G5 (cuadratura 4x, ~6836 cuentas/vuelta por defecto)
  * - Driver BTS7960 para motores (43A máx, 2 unidades)
  * - Ruedas 15.50cm diámetro
  * - Sensores IR analógicos (5 sensores: frontal, laterales, trasero)
@@ -37,6 +37,8 @@
  * - TURN_SPEED    = 51  (~20% PWM) - Velocidad para giros automáticos
  * - MIN_SPEED     = 80  (~31% PWM) - Velocidad mínima para superar fricción
  * - MAX_SPEED     = 255 (100% PWM) - Velocidad máxima
+ * Los modos automáticos (rutas, giros, pared) van en lazo cerrado con
+ * consignas en mm/s y grados/s (DriveController.h); los manuales en PWM.
  * 
  * CONEXIONES:
  * Encoder Izq:  A=Pin8, B=Pin2 (INT0)
@@ -62,596 +64,127 @@
 #include "MotorDriver.h"
 #include "Encoder.h"
 #include "Odometry.h"
+#include "IRScanner.h"
+#include "Scheduler.h"
+#include "DriveController.h"
+#include "JsonWriter.h"
+#include "HttpRequest.h"
+#include "TelemetryProtocol.h"
+#include "LogRing.h"
+#include "IMU.h"
+#include "HeadingFilter.h"
+#include "PathFollower.h"
+#include "MotionProfile.h"
+#include "OccupancyGrid.h"
+#include "LocalPlanner.h"
+#include "RouteStore.h"
+#include "Calibration.h"
+#include "IRCurve.h"
+#include "Perf.h"
+#include "WebAssets.h"
+#include "Teleop.h"
+#include "Bench.h"
+#include "TraceRing.h"
+#include "ObstacleTracker.h"
+#include "FleetControl.h"
 // WiFi (UNO R4 WiFi - WiFiS3 core)
 #include <WiFiS3.h>
 #include <WiFiServer.h>
+#include <WiFiUdp.h>
 #include <math.h>
 
 // ======== CONFIGURACIÓN WIFI AP ========
 const char* AP_SSID = "AMR_Robot_AP";
 const char* AP_PASS = "12345678"; // puedes cambiarla
 
+// ======== MODO ESTACIÓN / FLOTA ========
+// WIFI_STATION_MODE 1: unirse a la red del sitio (STA_SSID) en lugar de
+// levantar el AP propio; si no conecta en WIFI_STA_ATTEMPTS intentos se
+// levanta el AP como siempre. En los dos modos el robot difunde su estado
+// por UDP (TELEM_MSG_FLEET_STATE, 20 Hz) y acepta órdenes en /fleet.
+#define WIFI_STATION_MODE 0
+const char* STA_SSID = "AMR_Site";
+const char* STA_PASS = "cambiar";  // red del sitio
+#define WIFI_STA_ATTEMPTS 3
+#define WIFI_STA_DHCP_TIMEOUT_MS 5000UL
+#define WIFI_STA_RECONNECT_MS 10000UL   // reintento tras perder la red (solo con el robot parado)
+#define FLEET_ROBOT_ID 0                // 0: último octeto de la IP (único en la red del sitio)
+#define FLEET_UDP_PORT 4210
+
 WiFiServer server(80);
+WiFiUDP fleetUdp;
+IPAddress fleetBroadcast;
+uint8_t fleetRobotId = 1;
+uint8_t fleetSeq = 0;
+uint32_t fleetFramesSent = 0;
+uint32_t fleetSendErrors = 0;
+bool wifiStation = false;           // unido a la red del sitio
+bool fleetWasHeld = false;
+unsigned long wifiLastReconnectMs = 0;
+
+// Flujos Server-Sent Events (/events?hz=N)
+#define SSE_MAX_CLIENTS 2   // dashboard + página de rutas
+#define SSE_DEFAULT_HZ 10
+#define SSE_MAX_HZ 20
+
+// 1: ejecutar los microbenchmarks ('U') en setup(), antes de WiFi y del
+// scheduler, para medir sin carga sobre una compilación dedicada
+#define BENCH_AT_BOOT 0
+
+// Declarado aquí (no junto al servidor) para los prototipos generados
+struct EventStream {
+    WiFiClient client;
+    bool active;
+    unsigned long periodMs;
+    unsigned long lastSendMs;
+};
 
 // Forward declare types/functions that are referenced in generated prototypes
-struct IRSensors;
 void startAutoTurn(float angleDelta);
+extern bool turningInProgress;
+extern bool httpKeepAlive;
+extern bool teleopChannelOpen;
+extern int IR_THRESHOLD;
 
 // ----------------------
 // Routes data (for dropdown UI)
 // ----------------------
+// Las rutas viven en EEPROM (RouteStore) y se cambian con POST /routes.
+// Estas solo se graban en el primer arranque, cuando no hay almacén válido.
 struct Point { float x; float y; };
 
-// Example routes (adjust/add as needed)
-const Point route0[] = { {0.0f,0.0f}, {30.0f,0.0f}, {30.0f,30.0f} };
-const Point route1[] = { {-10.0f,5.0f}, {0.0f,10.0f}, {10.0f,5.0f}, {0.0f,0.0f} };
-const Point route2[] = { {-10.0f,5.0f}, {0.0f,10.0f}, {10.0f,5.0f}, {0.0f,0.0f} };
-const Point route3[] = { {0.0f,0.0f}, {5.0f,0.0f}, {10.0f,5.0f} };
-const Point route4[] = { {0.0f,0.0f}, {0.0f,200.0f}, {200.0f,200.0f}};
-
-const char* routeNames[] = { "Ruta A", "Ruta B","Ruta C", "Ruta D", "Ruta E" };
-const Point* routesPoints[] = { route0, route1, route2, route3, route4 };
-const int routesCounts[] = { sizeof(route0)/sizeof(route0[0]), sizeof(route1)/sizeof(route1[0]), sizeof(route2)/sizeof(route2[0]), sizeof(route3)/sizeof(route3[0]), sizeof(route4)/sizeof(route4[0]) };
-const int ROUTE_COUNT = 5;
-
-// ----------------------
-// Routes UI page (serves the dropdown HTML)
-// Access it at: http://<robot_ip>/routes_ui
-const char routesPageHTML[] PROGMEM = R"rawliteral(
-<!doctype html>
-<html lang="es">
-<head>
-    <meta charset="utf-8" />
-    <meta name="viewport" content="width=device-width,initial-scale=1" />
-    <title>Control de Rutas - Robot</title>
-    <style>
-        /* Dashboard-like dark theme for Routes UI */
-        html, body {
-            background: #0b0b0b;
-            color: #eaeaea;
-            font-family: Arial, sans-serif;
-            margin: 0;
-            padding: 12px;
-            -webkit-user-select: none;
-            -moz-user-select: none;
-            -ms-user-select: none;
-            user-select: none;
-            -webkit-touch-callout: none;
-            -webkit-tap-highlight-color: rgba(0,0,0,0);
-            touch-action: manipulation;
-        }
-        .container { max-width: 780px; margin: 0 auto; }
-    .card { background: #111; border: 1px solid #222; border-radius: 8px; padding: 12px; box-shadow: 0 2px 6px rgba(0,0,0,0.6); display:block; }
-        .headerRow { display:flex; align-items:center; gap:10px; margin-bottom:10px; }
-        .headerRow h2 { margin:0; font-size:1.2em; color:#7CFC00; }
-        .headerRow button { background:transparent; border:0; color:#7CFC00; font-size:20px; width:40px; height:40px; border-radius:6px; cursor:pointer; }
-        .headerRow button:active { transform: translateY(1px); }
-
-    label { display:block; margin: 8px 0 6px 0; color:#ccc; text-align:center; }
-    select, input[type=number] { width:90%; max-width:540px; padding:8px; border-radius:6px; border:1px solid #333; background:#0d0d0d; color:#eee; margin:0 auto; }
-        select option { background:#111; color:#eee; }
-        pre { background:#0e0e0e; color:#cfcfcf; padding:8px; border-radius:6px; }
-
-    .row { display:flex; gap:18px; align-items:flex-start; width:100%; }
-        .row > * { flex: 1 1 auto; }
-    .controls { display:flex; gap:8px; margin-top:8px; flex-wrap:wrap; justify-content:center; }
-    .controls button { background:#222; color:#7CFC00; border:none; padding:10px 12px; margin:4px 0; font-size:16px; border-radius:6px; cursor:pointer; }
-        .controls button:hover { background:#7CFC00; color:#000; }
-        
-        /* Estilos para elementos deshabilitados (preview) */
-        select:disabled {
-            opacity: 0.6;
-            cursor: not-allowed;
-            background: #1a1a1a !important;
-        }
-        select:disabled option {
-            color: #666;
-        }
-
-        @media (max-width:520px) {
-            .container { padding:6px; }
-            .headerRow h2 { font-size:1.0em; }
-            .controls button { padding:12px 14px; font-size:18px; }
-        }
-    </style>
-</head>
-<body>
-    <div class="container">
-    <div class="card">
-    <div class="headerRow">
-        <button id="backToDash" title="Volver al dashboard" onclick="location.href='/'">←</button>
-        <h2>Control de Rutas Automáticas</h2>
-    </div>
-    
-    <div>
-        <label for="routeSelect">Selecciona la ruta:</label>
-        <select id="routeSelect"></select>
-    </div>
-
-    <div>
-        <label for="waypointSelect">Waypoints de la ruta <span style="color:#888; font-size:0.85em;">(Preview - Implementación futura)</span>:</label>
-        <select id="waypointSelect" disabled style="opacity:0.6; cursor:not-allowed; background:#1a1a1a;"></select>
-    </div>
-
-    <div>
-        <label for="allPointsSelect">Todos los puntos <span style="color:#888; font-size:0.85em;">(Preview - Implementación futura)</span>:</label>
-        <select id="allPointsSelect" size="6" disabled style="opacity:0.6; cursor:not-allowed; background:#1a1a1a;"></select>
-    </div>
-
-    <div class="row">
-        <div>
-            <label for="delaySec">Delay antes de iniciar (segundos):</label>
-            <input id="delaySec" type="number" value="10" min="0" style="width:100%" />
-        </div>
-        <div style="display:flex;flex-direction:column;gap:6px;">
-            <div class="controls">
-                <button id="startIda">Iniciar (IDA)</button>
-                <button id="startRet">Iniciar (RETORNO)</button>
-                <button id="stopRoute">Detener</button>
-            </div>
-            <div class="controls">
-                <button id="confirmStart" disabled>Confirmar inicio</button>
-                <div style="padding:6px; background:#222; color:#0f0; border-radius:4px; text-align:center;">Cuenta regresiva: <span id="countdown">--</span></div>
-            </div>
-            <div style="margin-top:12px; padding-top:12px; border-top:1px solid #333;">
-                <div style="text-align:center; color:#7CFC00; margin-bottom:8px; font-size:0.9em;">Seguimiento de Pared</div>
-                <div class="controls">
-                    <button id="wallFollowLeft" style="background:#444; color:#7CFC00;">Seguir Pared Izquierda</button>
-                    <button id="wallFollowRight" style="background:#444; color:#7CFC00;">Seguir Pared Derecha</button>
-                    <button id="stopWallFollow" style="background:#666; color:#fff;">Detener Seguimiento</button>
-                </div>
-            </div>
-            
-        </div>
-    </div>
-
-    </div> <!-- .card -->
-    </div> <!-- .container -->
-
-    <div>
-        <strong>Estado:</strong>
-        <pre id="status">Inactivo</pre>
-    </div>
-
-    <div>
-        <strong>Información de la ruta:</strong>
-        <pre id="selected">Selecciona una ruta para ver sus waypoints</pre>
-    </div>
-
-    <script>
-        const ROUTES_URL = '/routes';
-        const START_URL = '/start_route';
-        const STOP_URL = '/stop_route';
-        const STATUS_URL = '/route_status';
-        const CONFIRM_URL = '/confirm_route';
-        const WALL_FOLLOW_URL = '/wall_follow';
-        const STOP_WALL_FOLLOW_URL = '/stop_wall_follow';
-
-        let routes = [];
-        const routeSelect = document.getElementById('routeSelect');
-        const waypointSelect = document.getElementById('waypointSelect');
-        const allPointsSelect = document.getElementById('allPointsSelect');
-        const selectedPre = document.getElementById('selected');
-        const statusPre = document.getElementById('status');
-        const countdownSpan = document.getElementById('countdown');
-        const confirmBtn = document.getElementById('confirmStart');
-
-        async function loadRoutes() {
-            try {
-                const resp = await fetch(ROUTES_URL, { cache: 'no-store' });
-                if (!resp.ok) throw new Error('Error ' + resp.status);
-                routes = await resp.json();
-                populateRouteSelect();
-                populateAllPoints();
-                if (routes.length > 0) { 
-                    routeSelect.selectedIndex = 0; 
-                    populateWaypointsForRoute(0); 
-                    // Mostrar información inicial de la primera ruta
-                    const firstRoute = routes[0];
-                    if (firstRoute && firstRoute.points && firstRoute.points.length > 0) {
-                        selectedPre.textContent = `Ruta: ${firstRoute.name || 'Ruta 0'}\nWaypoints: ${firstRoute.points.length}\nPrimer punto: (${firstRoute.points[0].x}, ${firstRoute.points[0].y})\nÚltimo punto: (${firstRoute.points[firstRoute.points.length-1].x}, ${firstRoute.points[firstRoute.points.length-1].y})`;
-                    }
-                }
-            } catch (err) {
-                statusPre.textContent = 'No se pudieron cargar rutas: ' + err;
-            }
-        }
-
-        function populateRouteSelect() {
-            routeSelect.innerHTML = '';
-            routes.forEach((r, idx) => { const opt=document.createElement('option'); opt.value=idx; opt.textContent = `Ruta: ${r.name||('#'+idx)}`; routeSelect.appendChild(opt); });
-        }
-        function populateWaypointsForRoute(routeIndex) {
-            waypointSelect.innerHTML = '';
-            const waypoints = (routes[routeIndex] && routes[routeIndex].points) || [];
-            waypoints.forEach((pt,pIndex)=>{ 
-                const opt=document.createElement('option'); 
-                opt.value=`${routeIndex}|${pIndex}`; 
-                opt.textContent=`Waypoint ${pIndex + 1}: (${pt.x}, ${pt.y})`; 
-                waypointSelect.appendChild(opt); 
-            });
-            if (waypoints.length===0){ 
-                const opt=document.createElement('option'); 
-                opt.textContent='(sin waypoints)'; 
-                opt.value=''; 
-                waypointSelect.appendChild(opt);
-            }
-            // Actualizar información mostrada
-            if (waypoints.length > 0) {
-                const routeName = routes[routeIndex]?.name || `Ruta ${routeIndex}`;
-                selectedPre.textContent = `Ruta: ${routeName}\nWaypoints: ${waypoints.length}\nPrimer punto: (${waypoints[0].x}, ${waypoints[0].y})\nÚltimo punto: (${waypoints[waypoints.length-1].x}, ${waypoints[waypoints.length-1].y})`;
-            }
-        }
-        function populateAllPoints(){ allPointsSelect.innerHTML=''; routes.forEach((r,ri)=>{ (r.points||[]).forEach((pt,pi)=>{ const opt=document.createElement('option'); opt.value=`${ri}|${pi}`; opt.textContent=`(${pt.x}, ${pt.y}, ${ri}, ${pi}) — ${r.name||''}`; allPointsSelect.appendChild(opt); }); }); }
-        function showSelectedFromOptionValue(value){ 
-            if(!value){ 
-                selectedPre.textContent='Selecciona una ruta para ver sus waypoints'; 
-                return; 
-            } 
-            const [r,p]=value.split('|').map(n=>parseInt(n,10)); 
-            if(isNaN(r)||isNaN(p)||!routes[r]||!routes[r].points[p]){ 
-                selectedPre.textContent='Valor inválido'; 
-                return; 
-            } 
-            const pt=routes[r].points[p]; 
-            const routeName = routes[r].name || `Ruta ${r}`;
-            selectedPre.textContent=`Ruta: ${routeName}\nWaypoint ${p + 1} de ${routes[r].points.length}\nCoordenadas: x=${pt.x}, y=${pt.y}\n\n(Preview - Selección de waypoints disponible en futuras versiones)`;
-        }
-
-        // Actualizar waypoints cuando cambia la ruta (solo para visualización)
-        routeSelect.addEventListener('change', ()=>{ 
-            const idx=parseInt(routeSelect.value,10); 
-            populateWaypointsForRoute(idx); 
-            if(waypointSelect.options.length>0){ 
-                waypointSelect.selectedIndex=0; 
-                // Mostrar información del primer waypoint como preview
-                const firstWaypoint = waypointSelect.options[0];
-                if (firstWaypoint && firstWaypoint.value) {
-                    showSelectedFromOptionValue(firstWaypoint.value);
-                } else {
-                    selectedPre.textContent = `Ruta: ${routes[idx]?.name || 'N/A'}\nWaypoints: ${routes[idx]?.points?.length || 0}`;
-                }
-            }
-        });
-        
-        // Los waypoints están deshabilitados, pero mantenemos los listeners para futuro
-        waypointSelect.addEventListener('change', ()=> {
-            if (!waypointSelect.disabled) {
-                showSelectedFromOptionValue(waypointSelect.value);
-            }
-        });
-        
-        allPointsSelect.addEventListener('change', ()=>{ 
-            if (!allPointsSelect.disabled) {
-                showSelectedFromOptionValue(allPointsSelect.value); 
-                const [r,p]=allPointsSelect.value.split('|').map(n=>parseInt(n,10)); 
-                if(!isNaN(r)){ 
-                    routeSelect.value = r; 
-                    populateWaypointsForRoute(r); 
-                    if(!isNaN(p) && waypointSelect.options[p]) waypointSelect.selectedIndex = p; 
-                }
-            }
-        });
-
-        async function startRoute(dir) {
-            // Solo usar la ruta seleccionada, ignorar waypoints (están deshabilitados)
-            const ridx = parseInt(routeSelect.value || '0', 10);
-            if (isNaN(ridx) || ridx < 0) {
-                statusPre.textContent = 'Error: Selecciona una ruta válida';
-                return;
-            }
-            const delaySec = parseFloat(document.getElementById('delaySec').value || '0');
-            const delayMs = Math.max(0, Math.round(delaySec*1000));
-            const url = `${START_URL}?route=${ridx}&dir=${dir}&delay=${delayMs}`;
-            try {
-                statusPre.textContent = `Programando ruta ${routes[ridx]?.name || ridx} (${dir})...`;
-                const r = await fetch(url);
-                if (!r.ok) throw new Error('HTTP '+r.status);
-                statusPre.textContent = `Ruta programada: ${routes[ridx]?.name || ridx} (${dir})`;
-                // start polling status
-            } catch (e) { statusPre.textContent = 'Error: '+e; }
-        }
+struct DefaultRoute {
+    const char* name;
+    const int16_t* xyMm;   // pares x,y en mm
+    uint8_t count;
+};
 
-        async function stopRoute(){ try { const r = await fetch(STOP_URL); if(!r.ok) throw new Error('HTTP '+r.status); statusPre.textContent = 'Detenido'; } catch(e){ statusPre.textContent = 'Error stop: '+e; } }
+const int16_t defaultRouteA[] = { 0, 0,  300, 0,  300, 300 };
+const int16_t defaultRouteB[] = { -100, 50,  0, 100,  100, 50,  0, 0 };
+const int16_t defaultRouteC[] = { -100, 50,  0, 100,  100, 50,  0, 0 };
+const int16_t defaultRouteD[] = { 0, 0,  50, 0,  100, 50 };
+const int16_t defaultRouteE[] = { 0, 0,  0, 2000,  2000, 2000 };
+
+const DefaultRoute DEFAULT_ROUTES[] = {
+    { "Ruta A", defaultRouteA, sizeof(defaultRouteA) / (2 * sizeof(int16_t)) },
+    { "Ruta B", defaultRouteB, sizeof(defaultRouteB) / (2 * sizeof(int16_t)) },
+    { "Ruta C", defaultRouteC, sizeof(defaultRouteC) / (2 * sizeof(int16_t)) },
+    { "Ruta D", defaultRouteD, sizeof(defaultRouteD) / (2 * sizeof(int16_t)) },
+    { "Ruta E", defaultRouteE, sizeof(defaultRouteE) / (2 * sizeof(int16_t)) },
+};
+const uint8_t DEFAULT_ROUTE_COUNT = sizeof(DEFAULT_ROUTES) / sizeof(DEFAULT_ROUTES[0]);
 
-        async function confirmStart(){ try { const r = await fetch(CONFIRM_URL); if(!r.ok) throw new Error('HTTP '+r.status); statusPre.textContent = 'Inicio confirmado'; } catch(e){ statusPre.textContent = 'Error confirm: '+e; } }
+RouteStore routeStore;
 
-        document.getElementById('startIda').addEventListener('click', ()=> startRoute('ida'));
-        document.getElementById('startRet').addEventListener('click', ()=> startRoute('retorno'));
-        document.getElementById('stopRoute').addEventListener('click', ()=> stopRoute());
-        confirmBtn.addEventListener('click', ()=> confirmStart());
-        
-        // Seguimiento de pared
-        async function startWallFollow(side) {
-            try {
-                const r = await fetch(`${WALL_FOLLOW_URL}?side=${side}`);
-                if (!r.ok) throw new Error('HTTP '+r.status);
-                statusPre.textContent = `Seguimiento de pared ${side === 'left' ? 'izquierda' : 'derecha'} iniciado`;
-            } catch(e) { statusPre.textContent = 'Error: '+e; }
-        }
-        
-        async function stopWallFollow() {
-            try {
-                const r = await fetch(STOP_WALL_FOLLOW_URL);
-                if (!r.ok) throw new Error('HTTP '+r.status);
-                statusPre.textContent = 'Seguimiento de pared detenido';
-            } catch(e) { statusPre.textContent = 'Error stop: '+e; }
-        }
-        
-        document.getElementById('wallFollowLeft').addEventListener('click', ()=> startWallFollow('left'));
-        document.getElementById('wallFollowRight').addEventListener('click', ()=> startWallFollow('right'));
-        document.getElementById('stopWallFollow').addEventListener('click', ()=> stopWallFollow());
-
-        // Poll route status and update UI
-        async function pollStatus(){
-            try {
-                const r = await fetch(STATUS_URL, { cache: 'no-store' });
-                if (!r.ok) throw new Error('Status HTTP '+r.status);
-                const j = await r.json();
-                // update state
-                if (j.active) {
-                            statusPre.textContent = `Active. state:${j.state} route:${j.routeIndex} pt:${j.currentPoint} awaitingConfirm:${j.awaitingConfirm} obstacle:${j.obstacleActive?1:0} obState:${j.obstacleState}`;
-                    // disable start buttons while active
-                    document.getElementById('startIda').disabled = true;
-                    document.getElementById('startRet').disabled = true;
-                    document.getElementById('stopRoute').disabled = false;
-                } else {
-                    statusPre.textContent = 'Inactivo';
-                    document.getElementById('startIda').disabled = false;
-                    document.getElementById('startRet').disabled = false;
-                    document.getElementById('stopRoute').disabled = true;
-                }
-                // awaiting confirm
-                if (j.awaitingConfirm) {
-                    confirmBtn.disabled = false;
-                } else {
-                    confirmBtn.disabled = true;
-                }
-                // countdown
-                if (j.remainingDelayMs && j.remainingDelayMs > 0) {
-                    const s = Math.ceil(j.remainingDelayMs/1000);
-                    countdownSpan.textContent = s + ' s';
-                } else {
-                    countdownSpan.textContent = '--';
-                }
-            } catch (e) {
-                // ignore
-            }
-        }
+// Páginas web (dashboard y /routes_ui): gzip en flash generado desde web/*.html
+// por tools/build_web_assets.py (ver WebAssets.h)
 
-        // initial load and start polling
-        loadRoutes();
-        setInterval(pollStatus, 800);
-    </script>
-    <script>
-        // Evitar que se seleccione texto en el UI por long-press
-        document.addEventListener('selectstart', function(e) {
-            const t = e.target && e.target.tagName;
-            if (t !== 'INPUT' && t !== 'TEXTAREA' && t !== 'SELECT') e.preventDefault();
-        }, false);
-        // Prevenir el menu contextual por long-press en botones (solo en botones)
-        document.addEventListener('contextmenu', function(e){ if (e.target && e.target.tagName === 'BUTTON') e.preventDefault(); }, false);
-    </script>
-</body>
-</html>
-)rawliteral";
-
-// Full dashboard page: user-provided layout completed with responsive CSS and JS
-const char dashboardHTML[] PROGMEM = R"rawliteral(
-<!DOCTYPE html>
-<html>
-<head>
-<meta charset="utf-8">
-<meta name="viewport" content="width=device-width,initial-scale=1">
-<title>AMR Dashboard</title>
-<style>
-    /* Evitar selección y resaltado táctil en botones/áreas no editables */
-    html, body {
-        background:#111; color:#eee; font-family:Arial; margin:0; padding:8px;
-        -webkit-user-select: none; /* Safari */
-        -moz-user-select: none;
-        -ms-user-select: none;
-        user-select: none; /* Evita selección de texto por long-press */
-        -webkit-touch-callout: none; /* iOS long-press */
-        -webkit-tap-highlight-color: rgba(0,0,0,0); /* quitar highlight */
-        touch-action: manipulation; /* mejora la interacción táctil */
-    }
-    /* Permitir selección en campos editables */
-    select, input, textarea { -webkit-user-select: text; user-select: text; }
-    h1 { color:#0f0; text-align:center; margin:8px 0; }
-    #charts { display:flex; justify-content:space-around; flex-wrap:wrap; gap:10px; align-items:center; padding:6px; }
-    /* Ensure chart panels center their content and have matching center lines */
-    .chart { display:flex; flex-direction:column; align-items:center; justify-content:center; min-height:160px; }
-    canvas { background:#222; border:1px solid #444; border-radius:6px; display:block; width:100%; height:auto; }
-    .map { max-width:260px; }
-    .compass { max-width:140px; }
-    .ir { max-width:300px; }
-    .controls { margin-top:14px; display:flex; justify-content:center; gap:8px; flex-wrap:wrap; }
-    .controls button { background:#333; color:#0f0; border:none; padding:10px 16px; margin:4px; font-size:18px; border-radius:6px; }
-    .controls button:hover { background:#0f0; color:#000; }
-    /* Tests panel (compact buttons to trigger built-in tests) */
-    .tests-grid { display:flex; gap:8px; justify-content:center; flex-wrap:wrap; margin-top:10px; }
-    /* separation and header for controls section */
-    .section-title { color:#7CFC00; text-align:center; margin:12px 0 6px; font-size:1.02rem; }
-    .control-section { display:flex; justify-content:center; gap:18px; align-items:flex-start; margin-top:10px; padding:8px 6px; border-top:1px solid #222; flex-wrap:wrap; }
-    /* D-pad (cruceta) layout: use previous button aesthetic but arranged in cruceta */
-    .dpad { display:grid; grid-template-columns: 1fr 1fr 1fr; grid-auto-rows: auto; gap:10px; justify-content:center; align-items:center; width:100%; max-width:360px; margin:0 auto; }
-    .dpad-btn { background:#333; color:#0f0; border:none; border-radius:8px; padding:10px 16px; font-size:16px; min-width:110px; min-height:44px; cursor:pointer; }
-    .dpad-btn:hover { background:#7CFC00; color:#000; }
-    .dpad-btn:active { transform: translateY(1px); }
-    .dpad .spacer { background:transparent; box-shadow:none; border:none; }
-    .dpad .stop { background:#444; color:#fff; font-weight:bold; }
-    .route-btn { background:#222; color:#7CFC00; border:1px solid #333; padding:10px 14px; border-radius:8px; font-size:16px; cursor:pointer; }
-    .test-btn { background:#222; color:#7CFC00; border:1px solid #333; padding:8px 10px; border-radius:6px; font-size:14px; cursor:pointer; min-width:110px; }
-    .test-btn:hover { background:#7CFC00; color:#000; border-color:#7CFC00; }
-    .status { text-align:center; margin-top:10px; color:#ccc }
-
-    @media (max-width:520px) {
-        .map { max-width:96%; }
-        .compass { max-width:80%; }
-        .ir { max-width:96%; }
-        .controls button { padding:12px 18px; font-size:20px; }
-        /* cruceta buttons use default sizing (no zoom) */
-        .controls > div:first-child button { font-size:18px; padding:10px 16px; }
-    }
-</style>
-</head>
-<body>
-    <h1> AMR CONTROL DASHBOARD</h1>
-    <div id="charts">
-        <div class="chart map"><canvas id="map"></canvas><small>Trayectoria Recorrida</small></div>
-        <div class="chart compass"><canvas id="compass"></canvas><small>Brújula</small></div>
-        <div class="chart ir"><canvas id="irChart"></canvas><small>Sensores IR</small></div>
-    </div>
-
-    <!-- Section title separating charts and controls -->
-    <h2 class="section-title">Panel de Control</h2>
-
-    <!-- Controls section: two-column layout for main controls + route button -->
-    <div class="control-section">
-        <div>
-            <div class="dpad">
-                <button class="dpad-btn spacer" aria-hidden="true"></button>
-                <button id="btnW" class="dpad-btn up" onmousedown="startHold('W')" onmouseup="stopHold()" onmouseleave="stopHold()" ontouchstart="startHold('W')" ontouchend="stopHold()">↑ Adelante</button>
-                <button class="dpad-btn spacer" aria-hidden="true"></button>
-
-                <button class="dpad-btn left" onmousedown="startHold('Q')" onmouseup="stopHold()" onmouseleave="stopHold()" ontouchstart="startHold('Q')" ontouchend="stopHold()">← Izq</button>
-                <button class="dpad-btn stop" onclick="sendCmd('X')">⏹ Stop</button>
-                <button class="dpad-btn right" onmousedown="startHold('E')" onmouseup="stopHold()" onmouseleave="stopHold()" ontouchstart="startHold('E')" ontouchend="stopHold()">Der →</button>
-
-                <button class="dpad-btn spacer" aria-hidden="true"></button>
-                <button id="btnS" class="dpad-btn down" onmousedown="startHold('S')" onmouseup="stopHold()" onmouseleave="stopHold()" ontouchstart="startHold('S')" ontouchend="stopHold()">↓ Atrás</button>
-                <button class="dpad-btn spacer" aria-hidden="true"></button>
-            </div>
-        </div>
-
-        <div style="display:flex;align-items:center;justify-content:center;min-width:140px;">
-            <button class="route-btn" onclick="location.href='/routes_ui'">Control Rutas</button>
-        </div>
-    </div>
-
-    <!-- Tests block moved below controls, visually grouped and with a small header -->
-    <div style="text-align:center;margin-top:8px;color:#ccc;font-size:0.95rem;">Pruebas Rápidas</div>
-    <div id="tests" class="tests-grid" style="margin-top:8px;">
-        <button class="test-btn" onclick="sendCmd('T')">Test Motores (T)</button>
-        <button class="test-btn" onclick="sendCmd('V')">Avanzar 1 vuelta (V)</button>
-        <button class="test-btn" onclick="sendCmd('I')">Inspección (I)</button>
-        <button class="test-btn" onclick="sendCmd('R')">Reset Pos (R)</button>
-    </div>
-
-    <div class="status"><strong>Estado:</strong> <span id="statusText">-</span></div>
-
-    <script>
-    // Responsive canvas setup + lightweight renderer
-    const mapCanvas = document.getElementById('map');
-    const compassCanvas = document.getElementById('compass');
-    const irCanvas = document.getElementById('irChart');
-    const statusText = document.getElementById('statusText');
-    let lastPositions = [];
-
-    function setDPR(c) {
-        const dpr = window.devicePixelRatio || 1;
-        const rect = c.getBoundingClientRect();
-        c.width = Math.max(1, Math.floor(rect.width * dpr));
-        // keep a square-ish compass, map similar
-        let cssH = rect.width; if (c===irCanvas) cssH = rect.width * 0.65; if (c===compassCanvas) cssH = rect.width;
-        c.height = Math.max(1, Math.floor(cssH * dpr));
-        const ctx = c.getContext('2d'); ctx.setTransform(dpr,0,0,dpr,0,0);
-    }
-
-    function resizeAll(){ [mapCanvas, compassCanvas, irCanvas].forEach(setDPR); }
-
-    function drawMap(x,y){ const ctx = mapCanvas.getContext('2d'); const w = mapCanvas.clientWidth, h = mapCanvas.clientHeight; ctx.clearRect(0,0,mapCanvas.width,mapCanvas.height); ctx.fillStyle='#111'; ctx.fillRect(0,0,w,h); ctx.strokeStyle='#333'; const step = Math.max(16, Math.round(Math.min(w,h)/10)); for(let i=0;i<=w;i+=step){ ctx.beginPath(); ctx.moveTo(i,0); ctx.lineTo(i,h); ctx.stroke(); } for(let i=0;i<=h;i+=step){ ctx.beginPath(); ctx.moveTo(0,i); ctx.lineTo(w,i); ctx.stroke(); } lastPositions.push({x,y}); if(lastPositions.length>80) lastPositions.shift(); ctx.strokeStyle='lime'; ctx.beginPath(); lastPositions.forEach((p,i)=>{ const sx=w/2 + p.x, sy=h/2 - p.y; if(i==0) ctx.moveTo(sx,sy); else ctx.lineTo(sx,sy); }); ctx.stroke(); ctx.fillStyle='red'; ctx.beginPath(); ctx.arc(w/2 + x, h/2 - y, Math.max(3, Math.min(8, w*0.02)), 0, 2*Math.PI); ctx.fill(); }
-
-    function drawCompass(th){ const ctx = compassCanvas.getContext('2d'); const w = compassCanvas.clientWidth, h = compassCanvas.clientHeight; ctx.clearRect(0,0,compassCanvas.width,compassCanvas.height); const cx=w/2, cy=h/2, r=Math.min(w,h)/2-6; ctx.beginPath(); ctx.arc(cx,cy,r,0,2*Math.PI); ctx.strokeStyle='#555'; ctx.stroke(); ctx.save(); ctx.translate(cx,cy); ctx.rotate(th*Math.PI/180); ctx.beginPath(); ctx.moveTo(0,0); ctx.lineTo(0,-r*0.8); ctx.strokeStyle='red'; ctx.stroke(); ctx.restore(); ctx.fillStyle='#eee'; ctx.fillText(Math.round(th)+'°',cx-10,cy+Math.round(r*0.5)); }
-
-    function drawIR(values){
-        const ctx = irCanvas.getContext('2d');
-        const w = irCanvas.clientWidth, h = irCanvas.clientHeight;
-        ctx.clearRect(0,0,irCanvas.width,irCanvas.height);
-        const padding = 8, gap = 8;
-        const bottomLabelArea = 18; // reserve space for sensor labels under bars
-        const barAreaW = w - padding*2;
-        const barWidth = (barAreaW - gap*(values.length-1)) / values.length;
-        // Display scale in centimeters (user requested max 100 cm for margin)
-        const maxValCm = 100.0;
-        // adaptive font sizes
-        const valFontSize = Math.max(10, Math.round(h * 0.08));
-        const nameFontSize = Math.max(10, Math.round(h * 0.06));
-        ctx.textAlign = 'center';
-        for (let i = 0; i < values.length; i++) {
-            const raw = Number(values[i]);
-            const maxBarHeight = h - padding - bottomLabelArea;
-
-            // Convert ADC/raw value to centimeters using the calibrated formula
-            // distancia_cm = 17569.7 * adc^-1.2062
-            let dist = 0.0;
-            if (raw <= 0) {
-                dist = maxValCm; // if invalid reading, show as far
-            } else {
-                dist = 17569.7 * Math.pow(raw, -1.2062);
-            }
-            if (!isFinite(dist)) dist = maxValCm;
-            if (dist < 2.0) dist = 2.0;
-            if (dist > maxValCm) dist = maxValCm;
-
-            // Height proportional to distance (0..maxValCm mapped to 0..maxBarHeight)
-            const barH = Math.max(2, (dist / maxValCm) * maxBarHeight);
-            const x = padding + i * (barWidth + gap);
-            const y = h - bottomLabelArea - barH;
-
-            // color: red if very close (e.g., < 20 cm), otherwise lime
-            ctx.fillStyle = dist < 20.0 ? 'red' : 'lime';
-            ctx.fillRect(x, y, barWidth, barH);
-
-            // draw numeric value above the bar (distance in cm with 1 decimal)
-            ctx.fillStyle = '#fff';
-            ctx.font = valFontSize + 'px Arial';
-            const valueX = x + barWidth / 2;
-            const valueY = Math.max(12, y - 6);
-            ctx.fillText(String(dist.toFixed(1)) + ' cm', valueX, valueY);
-
-            // draw sensor short name centered below the bar
-            ctx.fillStyle = '#eee';
-            ctx.font = nameFontSize + 'px Arial';
-            const names = ['L','FL','B','FR','R'];
-            const name = (names[i] || 'S') + '';
-            const nameY = h - 4;
-            ctx.fillText(name, x + barWidth / 2, nameY);
-        }
-        // reset textAlign to default left for other drawings
-        ctx.textAlign = 'left';
-    }
-
-    function startHold(cmd){ if(window._holdInterval) clearInterval(window._holdInterval); fetch('/cmd?c='+cmd).catch(()=>{}); window._holdInterval = setInterval(()=>fetch('/cmd?c='+cmd).catch(()=>{}),200); }
-    function stopHold(){ if(window._holdInterval) { clearInterval(window._holdInterval); window._holdInterval = null; } fetch('/cmd?c=X').catch(()=>{}); }
-    function sendCmd(cmd){ fetch('/cmd?c='+cmd).catch(()=>{}); }
-
-    function updateLoop(){ fetch('/data').then(r=>r.json()).then(j=>{ drawMap(j.x,j.y); drawCompass(j.th); drawIR(j.ir); statusText.textContent = `x:${j.x.toFixed(2)} y:${j.y.toFixed(2)} th:${j.th.toFixed(0)}°`; }).catch(()=>{ statusText.textContent='No telemetría'; }); setTimeout(updateLoop,500); }
-
-    window.addEventListener('load', ()=>{ resizeAll(); window.addEventListener('resize', resizeAll); updateLoop(); });
-    window.addEventListener('orientationchange', ()=> setTimeout(resizeAll,250));
-    </script>
-    <script>
-        // Evitar selección por long-press en áreas no editables, pero permitir en inputs/selects
-        document.addEventListener('selectstart', function(e) {
-            const t = e.target && e.target.tagName;
-            if (t !== 'INPUT' && t !== 'TEXTAREA' && t !== 'SELECT') e.preventDefault();
-        }, false);
-        // Evitar el menú contextual por long-press en botones (útil en móviles)
-        document.addEventListener('contextmenu', function(e){ if (e.target && e.target.tagName === 'BUTTON') e.preventDefault(); }, false);
-        // Quitar highlight táctil adicional en todos los botones (estilo redundante)
-        Array.from(document.querySelectorAll('button')).forEach(b=>{ b.style.webkitTapHighlightColor = 'transparent'; });
-    </script>
-</body>
-</html>
-)rawliteral";
 // ========================================
 // ESTRUCTURA DEL CÓDIGO
 // ========================================
 // Este sketch está organizado en secciones claras:
 // 1. Librerías e includes
-// 2. Configuración WiFi y HTML embebido (PROGMEM)
+// 2. Configuración WiFi (las páginas están en WebAssets.h)
 // 3. Definición de rutas y estructuras de datos
 // 4. Instancias globales (motors, encoders, odometry)
 // 5. Máquina de estados de ejecución de rutas
@@ -671,20 +204,78 @@ const char dashboardHTML[] PROGMEM = R"rawliteral(
 MotorDriver motors;
 Encoder encoders;
 Odometry odometry(&encoders);
+DriveController drive(&motors, &encoders);
+IRScanner irScanner;
+Scheduler scheduler;
+IMU imu;
+HeadingFilter headingFilter;
+PathFollower pathFollower(WHEEL_BASE_CM);
+MotionProfile moveProfile;   // velocidad a lo largo de la trayectoria (rutas)
+MotionProfile turnProfile;   // giros automáticos en sitio
+OccupancyGrid occupancyGrid; // mapa local de ocupación (tarea "map")
+LocalPlanner localPlanner;   // desvíos A* sobre occupancyGrid
+ObstacleTracker obstacleTracker; // pistas alfa-beta de los IR frontales (confirmación y TTC)
+FleetControl fleet;          // retención y reservas del coordinador (/fleet)
+Calibrator calibrator;       // calibración automática (comando 'C')
+CalibrationData calibration; // parámetros en uso (EEPROM, ver Calibration.h)
+bool calibrationRunning = false;
+float gyroYawRad = 0.0f;     // giro integrado solo del gyro (sin odometría)
+
+// Diagnósticos sin bloqueo: 'T' (MotorDriver::startTest) y 'V' (una vuelta
+// de rueda). Los avanza motionTask; 'X' y /stop_route los cancelan.
+#define ONE_REV_PRINT_MS 100
+#define ONE_REV_TIMEOUT_MS 15000UL   // sin llegar a una vuelta: encoder o motor sin respuesta
+struct OneRevTest {
+    bool active = false;
+    long left0 = 0;
+    long right0 = 0;
+    long target = 0;
+    unsigned long startMs = 0;
+    unsigned long lastPrintMs = 0;
+};
+OneRevTest oneRevTest;
+
+Teleop teleop;               // POST /teleop (ver Teleop.h)
+TraceRing traceRing;         // grabador de vuelo: /trace y 'G' (ver TraceRing.h)
+bool teleopDriving = false;  // motionTask aplica teleop a los motores
 
 // ----------------------
 // SISTEMA DE EJECUCIÓN DE RUTAS (SIN MÁQUINA DE ESTADOS EXPLÍCITA)
 // ----------------------
 // Sistema basado en funciones que retornan progreso en lugar de máquina de estados
 // - waitForDelay(): Espera delay inicial o confirmación
-// - executeTurn(): Realiza giro hacia el siguiente waypoint
-// - executeMove(): Movimiento hacia waypoint con evasión de obstáculos
+// - executeMove(): Sigue la polilínea de waypoints con pure pursuit
+//   (PathFollower) sin parar en cada esquina, con evasión de obstáculos.
+//   Los giros en sitio solo quedan para los 180° de fin de tramo.
 //
-// Sistema de evasión de obstáculos integrado:
-// - Estados: 0=idle, 1=TURN (90°), 2=FORWARD (avance lateral), 
-//            3=TURNBACK (-90°), 4=CROSS_FORWARD (cruzar), 5=DONE
-// - Confirmación de 2 segundos antes de iniciar evasión
-// - Selección automática del lado con más espacio libre
+// Sistema de evasión de obstáculos integrado (desvío planificado):
+// - Estados: 0=idle, 1=DETOUR (siguiendo un desvío), 2=BLOCKED (parado,
+//   sin desvío: se reintenta con el mapa actualizado)
+// - Confirmación por seguimiento (obstacleTracker, ObstacleTracker.h): la
+//   distancia filtrada de los IR frontales debe acercarse a la velocidad
+//   del robot durante OBSTACLE_CONFIRM_S; si ya está en el mapa de ocupación
+//   no se espera, y sin confirmación se acepta igualmente a los 2 s
+// - El crucero se reduce con el tiempo hasta colisión (TTC) del obstáculo
+//   seguido: por debajo de OBSTACLE_TTC_SLOW_S la velocidad es
+//   proporcional al TTC, hasta parar a OBSTACLE_STOP_CM
+// - El desvío lo busca localPlanner (A*) hasta el waypoint pendiente y se
+//   inserta en la trayectoria del pure pursuit
+
+// Obstacle avoidance parameters
+const float OBSTACLE_THRESHOLD_CM = 30.0f; // if front distance below this, consider obstacle
+// Espera máxima antes de aceptar un obstáculo que el seguimiento no confirma
+// (se aleja, lecturas erráticas); lo normal es confirmar en OBSTACLE_CONFIRM_S
+const unsigned long OBSTACLE_DETECTION_DELAY_MS = 2000; // 2 seconds
+const float OBSTACLE_STOP_CM = 10.0f;           // distancia frontal con consigna 0
+const float OBSTACLE_TTC_SLOW_S = 1.5f;         // por debajo, crucero proporcional al TTC
+const float OBSTACLE_DETOUR_MIN_SCALE = 0.3f;   // en desvío nunca se para del todo (tiene que girar)
+const unsigned long OBSTACLE_REPLAN_MS = 1000;  // mínimo entre planificaciones / reintentos
+const int OBSTACLE_MAX_REPLANS = 10;            // reintentos sin desvío antes de abortar
+const uint8_t OBSTACLE_MAX_DETOUR_POINTS = 6;   // puntos intermedios por desvío
+const int OBSTACLE_IDLE = 0;
+const int OBSTACLE_DETOUR = 1;
+const int OBSTACLE_BLOCKED = 2;
+
 struct RouteExecution {
     bool active = false;
     int routeIndex = 0;
@@ -694,27 +285,24 @@ struct RouteExecution {
     int currentPoint = 0; // 0..(n-1)
     // Flags de operación en progreso (reemplazan estados explícitos)
     bool isWaiting = false; // esperando delay o confirmación
-    bool isTurning = false; // realizando giro hacia waypoint
-    bool isMoving = false; // moviéndose hacia waypoint
+    bool isTurning = false; // giro en sitio (180° de fin de tramo)
+    bool isMoving = false; // siguiendo la trayectoria hacia los waypoints
     bool awaitingConfirm = false;
     bool waitingForReturnConfirm = false; // waiting confirmation after finishing ida
     bool returnModeActive = false; // true when executing return leg
     bool postFinishTurn = false; // indicates we've started the final 180° turn
     // Obstacle avoidance state
     bool obstacleActive = false; // flag indicating avoidance in progress
-    int obstacleSide = 0; // +1 = left, -1 = right (chosen side to go around)
-    int obstacleState = 0; // 0=idle,1=TURN,2=FORWARD,3=TURNBACK,4=CROSS_FORWARD,5=DONE
-    long obstacleMoveStartLeft = 0;
-    long obstacleMoveStartRight = 0;
-    long obstacleMoveTargetPulses = 0;
-    long obstacleMoveMaxPulses = 0; // safety cap if sensor never clears
-    int obstacleProbePin = -1; // pin to sample for clearance (opposite sensor)
+    int obstacleState = 0; // OBSTACLE_IDLE / OBSTACLE_DETOUR / OBSTACLE_BLOCKED
     bool obstacleWaitActive = false; // waiting a short time to confirm obstacle isn't transient
     unsigned long obstacleWaitStartMillis = 0;
+    unsigned long obstacleLastPlanMillis = 0;
+    int obstacleReplans = 0; // planificaciones fallidas seguidas
     // movement bookkeeping
-    long moveStartLeft = 0;
-    long moveStartRight = 0;
-    long moveTargetPulses = 0;
+    int pathBasePoint = 0; // currentPoint del primer waypoint cargado en pathFollower
+    int pathLastPoint = 0; // currentPoint del último waypoint cargado
+    uint8_t pathDetourPoints = 0; // puntos de desvío delante de los waypoints
+    float legLengthMm = 0.0f; // longitud de la trayectoria cargada (perfil de velocidad)
     float targetX = 0.0f;
     float targetY = 0.0f;
 } routeExec;
@@ -730,20 +318,43 @@ struct WallFollow {
     unsigned long allWallsDetectedStart = 0; // timestamp cuando se detectaron todas las paredes
 } wallFollow;
 
+// Pose de la pasada actual de la tarea motion: motionTask() la copia una vez
+// (Odometry::sample()) y la leen rutas, evasión y giros automáticos, así que
+// todos comparan pulsos y posición del mismo instante.
+PoseSample motionPose;
+float motionDtS = 0.01f;            // tiempo entre pasadas de motion (perfiles)
+unsigned long motionLastUs = 0;
+
 const float WALL_FOLLOW_THRESHOLD_CM = 30.0f; // distancia para considerar pared detectada
 const unsigned long ALL_WALLS_TIMEOUT_MS = 10000; // 10 segundos para finalizar si todas las paredes detectadas
-const int WALL_FOLLOW_SPEED = 100; // velocidad base para seguimiento de pared
-const int WALL_FOLLOW_TURN_SPEED = 80; // velocidad para giros durante seguimiento
+const float WALL_FOLLOW_SPEED_MM_S = 150.0f;      // velocidad base para seguimiento de pared
+const float WALL_FOLLOW_CORRECTION_MM_S = 30.0f;  // corrección de rueda para acercarse/alejarse
+const float WALL_FOLLOW_MIN_MM_S = 90.0f;         // consigna mínima por rueda
+const float WALL_FOLLOW_MAX_MM_S = 380.0f;        // consigna máxima por rueda
 
 // Helper: stop/abort execution
+// Estado virtual para compatibilidad con API (basado en flags); lo usan
+// /route_status y la telemetría binaria
+int routeVirtualState() {
+    if (routeExec.isWaiting) return 1; // ROUTE_WAITING
+    if (routeExec.isTurning) return 2; // ROUTE_TURNING
+    if (routeExec.isMoving) return 3;  // ROUTE_MOVING
+    if (!routeExec.active) return 4;   // ROUTE_DONE
+    return 0;                          // ROUTE_IDLE
+}
+
 void stopRouteExecution() {
     if (!routeExec.active) return;
+    traceRing.trigger(TELEM_TRACE_ROUTE_ABORT, millis());
     routeExec.active = false;
     routeExec.isWaiting = false;
     routeExec.isTurning = false;
     routeExec.isMoving = false;
-    motors.stop();
-    Serial.println(F("Route execution aborted"));
+    routeExec.obstacleActive = false;
+    routeExec.obstacleState = OBSTACLE_IDLE;
+    routeExec.obstacleWaitActive = false;
+    drive.stop();
+    logPrintln(F("Route execution aborted"));
 }
 
 // Helper: stop wall following
@@ -751,24 +362,26 @@ void stopWallFollowing() {
     if (!wallFollow.active) return;
     wallFollow.active = false;
     wallFollow.state = 0;
-    motors.stop();
-    Serial.println(F("Wall following stopped"));
+    drive.stop();
+    logPrintln(F("Wall following stopped"));
 }
 
 // Helper: start wall following
 void startWallFollowing(int side) {
     if (wallFollow.active) stopWallFollowing();
+    stopTeleop();
     // Detener cualquier ruta activa antes de iniciar seguimiento de pared
     if (routeExec.active) {
         stopRouteExecution();
-        Serial.println(F("Ruta detenida para iniciar seguimiento de pared."));
+        logPrintln(F("Ruta detenida para iniciar seguimiento de pared."));
     }
     wallFollow.active = true;
     wallFollow.side = side;
     wallFollow.state = 1; // following
     wallFollow.allWallsDetectedStart = 0;
-    Serial.print(F("Wall following started: "));
-    Serial.println(side == 1 ? F("LEFT") : F("RIGHT"));
+    traceRing.rearm();
+    logPrint(F("Wall following started: "));
+    logPrintln(side == 1 ? F("LEFT") : F("RIGHT"));
 }
 
 // helper to normalize angle to [-180,180]
@@ -796,149 +409,225 @@ bool waitForDelay() {
     return false;
 }
 
-// Ejecuta giro hacia el waypoint objetivo
-// Retorna true cuando el giro ha terminado
-bool executeTurn() {
-    if (!routeExec.isTurning) return true;
-    
-    // wait for turningInProgress to finish (handled by handleAutoTurn)
-    if (!turningInProgress) {
-        // Giro completado, calcular movimiento hacia target
-        float dx = routeExec.targetX - odometry.getX();
-        float dy = routeExec.targetY - odometry.getY();
-        float dist = sqrtf(dx*dx + dy*dy);
-        float pulsesF = (dist / (float)WHEEL_CIRCUMFERENCE_CM) * (float)encoders.getPulsesPerRevolution();
-        routeExec.moveTargetPulses = (long)(pulsesF + 0.5f);
-        routeExec.moveStartLeft = encoders.readLeft();
-        routeExec.moveStartRight = encoders.readRight();
-        
-        routeExec.isTurning = false;
-        
-        if (routeExec.moveTargetPulses <= 0) {
-            // Ya está en el waypoint, avanzar al siguiente
-            Serial.print(F("Waypoint alcanzado. Avanzando al siguiente..."));
-            routeExec.currentPoint++;
-            beginNextWaypoint();
-        } else {
-            // Iniciar movimiento
-            motors.moveForward();
-            routeExec.isMoving = true;
-            Serial.print(F("Avanzando hacia waypoint: "));
-            Serial.print(routeExec.moveTargetPulses);
-            Serial.println(F(" pulsos"));
+// Perfil de velocidad de los tramos de ruta
+const float ROUTE_PROFILE_KP = 3.0f;             // 1/s
+const float ROUTE_PROFILE_TOLERANCE_MM = 5.0f;
+
+// Waypoint i de la ruta r (cm), leído del almacén
+Point routePoint(int r, int i) {
+    Point p = { 0.0f, 0.0f };
+    routeStore.point((uint8_t)r, (uint8_t)i, p.x, p.y);
+    return p;
+}
+
+// Índice en la ruta del waypoint que corresponde a currentPoint = cp
+// (IDA omite el primero; RETORNO recorre al revés omitiendo el último)
+int routeWaypointIndex(int cp) {
+    int count = routeStore.pointCount(routeExec.routeIndex);
+    return (routeExec.direction == 1) ? cp + 1 : count - 2 - cp;
+}
+
+// Cargar en el seguidor: pose actual + desvío (opcional) + waypoints
+// pendientes desde currentPoint, y planificar el perfil de velocidad.
+// Devuelve false si un índice de waypoint queda fuera de rango.
+bool loadRoutePath(const PathPoint* detour, uint8_t detourCount) {
+    int idx = routeExec.routeIndex;
+    int count = routeStore.pointCount(idx);
+    int effectiveCount = count - 1;
+
+    pathFollower.reset(motionPose.x, motionPose.y);
+    for (uint8_t i = 0; i < detourCount; ++i) pathFollower.addPoint(detour[i].x, detour[i].y);
+    routeExec.pathDetourPoints = pathFollower.pointCount() - 1;
+    routeExec.pathBasePoint = routeExec.currentPoint;
+    routeExec.pathLastPoint = routeExec.currentPoint - 1;
+    for (int cp = routeExec.currentPoint; cp < effectiveCount; ++cp) {
+        int pIndex = routeWaypointIndex(cp);
+        if (pIndex < 0 || pIndex >= count) {
+            logPrint(F("Error: índice de waypoint fuera de rango: "));
+            logPrintln(pIndex);
+            return false;
         }
-        return true;
+        Point p = routePoint(idx, pIndex);
+        if (!pathFollower.addPoint(p.x, p.y)) {
+            // El resto se carga al terminar esta parte (beginNextWaypoint)
+            logPrintln(F("Aviso: trayectoria truncada (PATH_MAX_POINTS)"));
+            break;
+        }
+        routeExec.pathLastPoint = cp;
+        routeExec.targetX = p.x;
+        routeExec.targetY = p.y;
+    }
+
+    // Perfil en S sobre la longitud de la trayectoria: arranque y frenado suaves
+    routeExec.legLengthMm = pathFollower.remainingDistance(motionPose.x, motionPose.y) * 10.0f;
+    moveProfile.plan(routeExec.legLengthMm, DRIVE_ROUTE_MM_S, DRIVE_ACCEL_MM_S2, DRIVE_JERK_MM_S3);
+    moveProfile.setTracking(ROUTE_PROFILE_KP, ROUTE_PROFILE_TOLERANCE_MM, PATH_MIN_SPEED_MM_S);
+    pathFollower.setCruiseSpeed(0.0f);
+    return true;
+}
+
+// ¿La trayectoria cargada cruza obstáculos (inflados) del mapa actual?
+bool routePathBlocked() {
+    localPlanner.prepare(occupancyGrid, motionPose.x, motionPose.y);
+    PathPoint prev = { motionPose.x, motionPose.y };
+    for (uint8_t i = pathFollower.targetIndex(); i < pathFollower.pointCount(); ++i) {
+        PathPoint p = pathFollower.point(i);
+        if (localPlanner.segmentBlocked(prev.x, prev.y, p.x, p.y)) return true;
+        prev = p;
     }
     return false;
 }
 
-// Ejecuta movimiento hacia waypoint con evasión de obstáculos
-// Retorna true cuando el movimiento ha terminado
+// Bloqueo confirmado: planificar un desvío hasta el waypoint pendiente y
+// cargarlo en el seguidor; si no hay camino, parar y reintentar más tarde
+void planDetour() {
+    routeExec.obstacleLastPlanMillis = millis();
+    routeExec.obstacleWaitActive = false;
+    int pIndex = routeWaypointIndex(routeExec.currentPoint);
+    Point goal = routePoint(routeExec.routeIndex, pIndex);
+
+    PathPoint detour[OBSTACLE_MAX_DETOUR_POINTS];
+    int n = localPlanner.plan(occupancyGrid, motionPose.x, motionPose.y, goal.x, goal.y, detour, OBSTACLE_MAX_DETOUR_POINTS);
+    if (n < 0) {
+        drive.stop();
+        routeExec.obstacleActive = true;
+        routeExec.obstacleState = OBSTACLE_BLOCKED;
+        routeExec.obstacleReplans++;
+        logPrint(F("Sin desvío (expansiones: "));
+        logPrint((unsigned long)localPlanner.getExpansions());
+        logPrint(F("). Reintento "));
+        logPrint(routeExec.obstacleReplans);
+        logPrint(F("/"));
+        logPrintln(OBSTACLE_MAX_REPLANS);
+        if (routeExec.obstacleReplans >= OBSTACLE_MAX_REPLANS) {
+            logPrintln(F("Obstáculo sin desvío posible. Ruta abortada."));
+            stopRouteExecution();
+        }
+        return;
+    }
+
+    routeExec.obstacleReplans = 0;
+    routeExec.obstacleActive = n > 0;
+    routeExec.obstacleState = (n > 0) ? OBSTACLE_DETOUR : OBSTACLE_IDLE;
+    if (!loadRoutePath(detour, (uint8_t)n)) {
+        stopRouteExecution();
+        return;
+    }
+    logPrint(F("Desvío planificado: "));
+    logPrint((long)n);
+    logPrint(F(" puntos, "));
+    logPrint(pathFollower.remainingDistance(motionPose.x, motionPose.y), 0);
+    logPrint(F(" cm hasta meta, expansiones: "));
+    logPrintln((unsigned long)localPlanner.getExpansions());
+}
+
+// Sigue la trayectoria cargada en pathFollower con evasión de obstáculos
+// Retorna true cuando el tramo ha terminado
 bool executeMove() {
     if (!routeExec.isMoving) return true;
     
-    // First, check for obstacles using IR sensors
-    float dFL = distanciaSamples(IR_FRONT_LEFT_PIN, 3, NULL);
-    float dFR = distanciaSamples(IR_FRONT_RIGHT_PIN, 3, NULL);
-    float frontMin = min(dFL, dFR);
-    
-    // Obstacle detection and avoidance logic
-    if (!routeExec.obstacleActive && !routeExec.obstacleWaitActive && frontMin <= OBSTACLE_THRESHOLD_CM) {
-        routeExec.obstacleWaitActive = true;
-        routeExec.obstacleWaitStartMillis = millis();
-        Serial.print(F("Obstacle seen briefly (waiting to confirm). frontMin=")); Serial.println(frontMin);
-    } else if (!routeExec.obstacleActive && routeExec.obstacleWaitActive) {
-        // check if wait period expired
-        if (millis() - routeExec.obstacleWaitStartMillis >= OBSTACLE_DETECTION_DELAY_MS) {
-            // re-sample front to confirm
-            float dFL2 = distanciaSamples(IR_FRONT_LEFT_PIN, 3, NULL);
-            float dFR2 = distanciaSamples(IR_FRONT_RIGHT_PIN, 3, NULL);
-            float frontMin2 = min(dFL2, dFR2);
-            routeExec.obstacleWaitActive = false;
-            if (frontMin2 <= OBSTACLE_THRESHOLD_CM) {
-                // Confirmed obstacle: trigger avoidance
-                float dL = distanciaSamples(IR_LEFT_SIDE_PIN, 3, NULL);
-                float dR = distanciaSamples(IR_RIGHT_SIDE_PIN, 3, NULL);
-                routeExec.obstacleSide = (dL > dR) ? +1 : -1;
-                routeExec.obstacleActive = true;
-                routeExec.obstacleState = 1; // TURN
-                motors.stop();
-                delay(30);
-                routeExec.obstacleProbePin = (routeExec.obstacleSide == +1) ? IR_RIGHT_SIDE_PIN : IR_LEFT_SIDE_PIN;
-                float pulsesF = (AVOID_MAX_STEP_CM / (float)WHEEL_CIRCUMFERENCE_CM) * (float)encoders.getPulsesPerRevolution();
-                routeExec.obstacleMoveMaxPulses = (long)(pulsesF + 0.5f);
-                startAutoTurn(routeExec.obstacleSide * 90.0f);
-                Serial.print(F("Obstacle confirmed. side=")); Serial.print(routeExec.obstacleSide);
-                Serial.print(F(" frontMin=")); Serial.println(frontMin2);
+    // Obstáculos: pistas de los IR frontales (actualizadas en motionTask)
+    float frontMin = obstacleTracker.nearestRange();
+    unsigned long now = millis();
+
+    if (routeExec.obstacleState == OBSTACLE_BLOCKED) {
+        // Parado sin desvío: reintentar cuando el mapa haya tenido tiempo de crecer
+        if (now - routeExec.obstacleLastPlanMillis >= OBSTACLE_REPLAN_MS) planDetour();
+        return false;
+    }
+
+    // Obstacle detection: confirmar (seguimiento, mapa o 2 s) y replanificar
+    // solo si la trayectoria actual atraviesa lo que hay en el mapa
+    if (frontMin <= OBSTACLE_THRESHOLD_CM) {
+        if (!routeExec.obstacleWaitActive) {
+            routeExec.obstacleWaitActive = true;
+            routeExec.obstacleWaitStartMillis = now;
+            if (mapConfirmsFrontObstacle(frontMin)) {
+                // Ya está en el mapa de ocupación: no esperar la confirmación
+                routeExec.obstacleWaitStartMillis -= OBSTACLE_DETECTION_DELAY_MS;
+                logPrint(F("Obstacle already mapped. frontMin=")); logPrintln(frontMin);
             } else {
-                Serial.print(F("Obstacle cleared during wait. frontMin=")); Serial.println(frontMin2);
+                logPrint(F("Obstacle seen briefly (waiting to confirm). frontMin=")); logPrintln(frontMin);
             }
-        }
-    } else if (routeExec.obstacleActive) {
-        // Obstacle avoidance in progress
-        if (routeExec.obstacleState == 2) {
-            // moving forward step: sensor-driven completion
-            float probeDist = distanciaSamples(routeExec.obstacleProbePin, 3, NULL);
-            long dl = labs(encoders.readLeft() - routeExec.obstacleMoveStartLeft);
-            long dr = labs(encoders.readRight() - routeExec.obstacleMoveStartRight);
-            long maxm = (dl > dr) ? dl : dr;
-            if (probeDist >= (OBSTACLE_THRESHOLD_CM + AVOID_CLEAR_MARGIN_CM) || maxm >= routeExec.obstacleMoveMaxPulses) {
-                motors.stop();
-                delay(30);
-                routeExec.obstacleState = 3; // TURNBACK
-                startAutoTurn(-routeExec.obstacleSide * 90.0f);
-            }
-        } else if (routeExec.obstacleState == 4) {
-            // crossing forward step
-            long dl = labs(encoders.readLeft() - routeExec.obstacleMoveStartLeft);
-            long dr = labs(encoders.readRight() - routeExec.obstacleMoveStartRight);
-            long maxm = (dl > dr) ? dl : dr;
-            if (maxm >= routeExec.obstacleMoveTargetPulses) {
-                motors.stop();
-                delay(30);
-                routeExec.obstacleState = 5; // DONE
-                routeExec.obstacleActive = false;
-                Serial.println(F("Obstacle avoidance finished."));
-                // recompute movement towards same waypoint
-                float dx = routeExec.targetX - odometry.getX();
-                float dy = routeExec.targetY - odometry.getY();
-                float dist = sqrtf(dx*dx + dy*dy);
-                float pulsesF = (dist / (float)WHEEL_CIRCUMFERENCE_CM) * (float)encoders.getPulsesPerRevolution();
-                routeExec.moveTargetPulses = (long)(pulsesF + 0.5f);
-                routeExec.moveStartLeft = encoders.readLeft();
-                routeExec.moveStartRight = encoders.readRight();
-                if (routeExec.moveTargetPulses <= 0) {
-                    Serial.println(F("Waypoint alcanzado después de evasión. Avanzando al siguiente..."));
-                    routeExec.currentPoint++;
-                    beginNextWaypoint();
-                    routeExec.isMoving = false;
-                    return true;
-                } else {
-                    Serial.print(F("Continuando hacia waypoint desde nueva posición: "));
-                    Serial.print(routeExec.moveTargetPulses);
-                    Serial.println(F(" pulsos"));
-                    motors.moveForward();
-                }
+        } else if ((obstacleTracker.confirmed(OBSTACLE_THRESHOLD_CM) ||
+                    now - routeExec.obstacleWaitStartMillis >= OBSTACLE_DETECTION_DELAY_MS) &&
+                   now - routeExec.obstacleLastPlanMillis >= OBSTACLE_REPLAN_MS) {
+            routeExec.obstacleLastPlanMillis = now;
+            if (routePathBlocked()) {
+                logPrint(F("Obstacle confirmed. frontMin=")); logPrint(frontMin);
+                logPrint(F(" rate=")); logPrint(obstacleTracker.nearestRate(), 1);
+                logPrint(F(" after ")); logPrint(now - routeExec.obstacleWaitStartMillis); logPrintln(F(" ms"));
+                planDetour();
+                if (routeExec.obstacleState == OBSTACLE_BLOCKED || !routeExec.active) return false;
             }
         }
-    } else {
-        // Normal movement completion check (no obstacle active)
-        long dl = labs(encoders.readLeft() - routeExec.moveStartLeft);
-        long dr = labs(encoders.readRight() - routeExec.moveStartRight);
-        long maxm = (dl > dr) ? dl : dr;
-        if (maxm >= routeExec.moveTargetPulses) {
-            // Waypoint alcanzado
-            motors.stop();
-            Serial.print(F("Waypoint alcanzado. Total waypoints visitados: "));
-            Serial.print(routeExec.currentPoint + 1);
-            Serial.print(F("/"));
-            Serial.println(routesCounts[routeExec.routeIndex]);
-            routeExec.currentPoint++;
-            delay(80);
-            beginNextWaypoint();
-            routeExec.isMoving = false;
-            return true;
+    } else if (routeExec.obstacleWaitActive) {
+        routeExec.obstacleWaitActive = false;
+        logPrint(F("Obstacle cleared. frontMin=")); logPrintln(frontMin);
+    }
+
+    // En desvío los IR laterales completan en el mapa las caras del
+    // obstáculo que el frontal no vio (las desconocidas cuentan como libres):
+    // revisar la trayectoria aunque delante no haya nada
+    if (routeExec.obstacleState == OBSTACLE_DETOUR &&
+        now - routeExec.obstacleLastPlanMillis >= OBSTACLE_REPLAN_MS) {
+        routeExec.obstacleLastPlanMillis = now;
+        if (routePathBlocked()) {
+            logPrintln(F("Desvío cruza el obstáculo mapeado: replanificando"));
+            planDetour();
+            if (routeExec.obstacleState == OBSTACLE_BLOCKED || !routeExec.active) return false;
+        }
+    }
+
+    // Seguimiento continuo: consignas por rueda del pure pursuit. El perfil
+    // en S marca la velocidad de crucero según lo recorrido.
+    float traveledMm = routeExec.legLengthMm - pathFollower.remainingDistance(motionPose.x, motionPose.y) * 10.0f;
+    MotionSetpoint sp = moveProfile.track(traveledMm, motionDtS);
+    float ttc = obstacleTracker.timeToCollision(sp.vel * 0.1f, OBSTACLE_STOP_CM);
+    if (ttc < OBSTACLE_TTC_SLOW_S) {
+        float scale = ttc / OBSTACLE_TTC_SLOW_S;
+        if (routeExec.obstacleState == OBSTACLE_DETOUR && ttc > 0.0f && scale < OBSTACLE_DETOUR_MIN_SCALE) {
+            scale = OBSTACLE_DETOUR_MIN_SCALE;
         }
+        sp.vel *= scale;
+    }
+    pathFollower.setCruiseSpeed(sp.vel);
+    PathCommand cmd = pathFollower.update(motionPose.x, motionPose.y, motionPose.theta);
+    int effectiveCount = routeStore.pointCount(routeExec.routeIndex) - 1;
+    if (cmd.done) {
+        // Meta de la trayectoria cargada alcanzada (por distancia)
+        drive.stop();
+        logPrint(F("Waypoints visitados: "));
+        logPrint(routeExec.pathLastPoint + 1);
+        logPrint(F("/"));
+        logPrint(effectiveCount);
+        logPrint(F(" error:"));
+        logPrint(pathFollower.distanceToGoal(motionPose.x, motionPose.y), 1);
+        logPrintln(F(" cm"));
+        routeExec.isMoving = false;
+        routeExec.obstacleActive = false;
+        routeExec.obstacleState = OBSTACLE_IDLE;
+        routeExec.currentPoint = routeExec.pathLastPoint + 1;
+        beginNextWaypoint();
+        return true;
+    }
+    drive.setWheelSpeeds(cmd.leftMmS, cmd.rightMmS);
+
+    // Desvío superado cuando el seguidor apunta al primer waypoint de la ruta
+    int target = (int)pathFollower.targetIndex() - 1 - routeExec.pathDetourPoints;
+    if (routeExec.obstacleState == OBSTACLE_DETOUR && target >= 0) {
+        routeExec.obstacleState = OBSTACLE_IDLE;
+        routeExec.obstacleActive = false;
+        logPrintln(F("Obstacle avoidance finished."));
+    }
+    int cp = routeExec.pathBasePoint + (target > 0 ? target : 0);
+    if (cp > routeExec.pathLastPoint) cp = routeExec.pathLastPoint;
+    if (cp != routeExec.currentPoint) {
+        logPrint(F("Waypoint alcanzado (en marcha). Siguiente: "));
+        logPrint(cp + 1);
+        logPrint(F("/"));
+        logPrintln(effectiveCount);
+        routeExec.currentPoint = cp;
     }
     return false;
 }
@@ -946,29 +635,35 @@ bool executeMove() {
 // Función principal de ejecución de ruta (reemplaza máquina de estados)
 void executeRoute() {
     if (!routeExec.active) return;
+    // Retenido por el coordinador de flota (o reserva vencida): parado donde
+    // esté sin cancelar la ruta. Un giro en sitio ya empezado termina.
+    if (!fleet.mayMove(millis())) {
+        if (routeExec.isMoving) drive.stop();
+        return;
+    }
     
-    // Ejecutar en orden: wait -> turn -> move
+    // Ejecutar en orden: wait -> move. Los giros de 180° (isTurning) los
+    // cierra handleAutoTurn().
     if (routeExec.isWaiting) {
         if (waitForDelay()) {
             beginNextWaypoint();
         }
-    } else if (routeExec.isTurning) {
-        executeTurn();
     } else if (routeExec.isMoving) {
         executeMove();
     }
 }
 
-// begin the next waypoint (calculate turn and start it)
+// begin the next waypoint: carga en pathFollower los waypoints restantes del
+// tramo y arranca el seguimiento continuo (o el giro de 180° de fin de tramo)
 // NOTA: Omite el primer waypoint en IDA (siempre está en 0,0) y el último en RETORNO (ya está ahí)
 void beginNextWaypoint() {
     int idx = routeExec.routeIndex;
-    if (idx < 0 || idx >= ROUTE_COUNT) { stopRouteExecution(); return; }
-    int count = routesCounts[idx];
+    if (idx < 0 || idx >= routeStore.routeCount()) { stopRouteExecution(); return; }
+    int count = routeStore.pointCount(idx);
     
     // Si la ruta tiene solo 1 waypoint, no hay nada que visitar (se omite en ambos sentidos)
     if (count <= 1) {
-        Serial.println(F("Ruta tiene solo 1 waypoint. No hay waypoints a visitar (se omite)."));
+        logPrintln(F("Ruta tiene solo 1 waypoint. No hay waypoints a visitar (se omite)."));
         if (!routeExec.returnModeActive) {
             routeExec.postFinishTurn = true;
             startAutoTurn(180);
@@ -978,7 +673,7 @@ void beginNextWaypoint() {
             routeExec.isWaiting = false;
             routeExec.isTurning = false;
             routeExec.isMoving = false;
-            Serial.println(F("Ruta completada (sin waypoints a visitar)."));
+            logPrintln(F("Ruta completada (sin waypoints a visitar)."));
         }
         return;
     }
@@ -991,7 +686,7 @@ void beginNextWaypoint() {
         // reached end of route
         if (!routeExec.returnModeActive) {
             // IDA finished: perform 180° turn to face return direction, then wait for confirmation
-            Serial.println(F("Ruta de IDA completada. Girando 180° para preparar retorno..."));
+            logPrintln(F("Ruta de IDA completada. Girando 180° para preparar retorno..."));
             routeExec.postFinishTurn = true;
             startAutoTurn(180);
             routeExec.isMoving = false;
@@ -1000,83 +695,47 @@ void beginNextWaypoint() {
             return;
         } else {
             // RETORNO finished: perform final 180° then finish route
-            Serial.println(F("Ruta de RETORNO completada. Girando 180° para finalizar..."));
+            logPrintln(F("Ruta de RETORNO completada. Girando 180° para finalizar..."));
             routeExec.postFinishTurn = true;
             startAutoTurn(180);
             routeExec.isMoving = false;
             routeExec.isTurning = true;
-            Serial.println(F("Retorno finalizado. Ruta completa terminada."));
+            logPrintln(F("Retorno finalizado. Ruta completa terminada."));
             return;
         }
     }
 
-    // Calcular índice del waypoint a visitar (omitiendo primero en IDA, último en RETORNO)
-    int pIndex;
-    if (routeExec.direction == 1) {
-        // IDA: omitir waypoint 0 (índice 0), empezar desde waypoint 1 (índice 1)
-        // currentPoint 0 → waypoint índice 1
-        // currentPoint 1 → waypoint índice 2
-        // etc.
-        pIndex = routeExec.currentPoint + 1;
-    } else {
-        // RETORNO: omitir último waypoint (índice count-1), visitar todos los demás en orden inverso
-        // Ejemplo con 4 waypoints [0,0], [30,0], [30,30], [0,30]:
-        // - Omite: [0,30] (índice 3, último)
-        // - Visita: [30,30] (índice 2) → [30,0] (índice 1) → [0,0] (índice 0)
-        // currentPoint 0 → waypoint índice count-2 (penúltimo)
-        // currentPoint 1 → waypoint índice count-3
-        // currentPoint 2 → waypoint índice count-4 = 0 (primero, [0,0])
-        // etc.
-        pIndex = count - 2 - routeExec.currentPoint;
-    }
-    
-    // Validar que el índice esté en rango
-    if (pIndex < 0 || pIndex >= count) {
-        Serial.print(F("Error: índice de waypoint fuera de rango: "));
-        Serial.println(pIndex);
+    // Cargar en el seguidor la pose actual + los waypoints pendientes del tramo
+    // (IDA: índices currentPoint+1 .. count-1; RETORNO: count-2-currentPoint .. 0)
+    if (!loadRoutePath(nullptr, 0)) {
         stopRouteExecution();
         return;
     }
-    
-    routeExec.targetX = routesPoints[idx][pIndex].x;
-    routeExec.targetY = routesPoints[idx][pIndex].y;
-
-    // compute heading and angle delta
-    float curX = odometry.getX();
-    float curY = odometry.getY();
-    float curTh = odometry.getThetaDegrees();
-    float dx = routeExec.targetX - curX;
-    float dy = routeExec.targetY - curY;
-    float desired = atan2f(dy, dx) * 180.0f / PI;
-    float delta = normalizeAngle(desired - curTh);
-
-    // Log información del waypoint actual
-    effectiveCount = (count > 1) ? count - 1 : count;
-    Serial.print(F("Waypoint "));
-    Serial.print(routeExec.currentPoint + 1);
-    Serial.print(F("/"));
-    Serial.print(effectiveCount);
-    Serial.print(F(" de ruta "));
-    Serial.print(routeNames[idx]);
-    Serial.print(F(" (índice "));
-    Serial.print(pIndex);
-    Serial.print(F("): ("));
-    Serial.print(routeExec.targetX);
-    Serial.print(F(","));
-    Serial.print(routeExec.targetY);
-    Serial.print(F(") - Giro: "));
-    Serial.print(delta, 1);
-    Serial.println(F("°"));
-
-    // start turn using existing routine
-    startAutoTurn(delta);
-    routeExec.isTurning = true;
+
+    char routeName[ROUTE_STORE_NAME_MAX + 1];
+    logPrint(F("Siguiendo ruta "));
+    logPrint(routeStore.name(idx, routeName, sizeof(routeName)));
+    logPrint(F(" desde waypoint "));
+    logPrint(routeExec.currentPoint + 1);
+    logPrint(F("/"));
+    logPrint(effectiveCount);
+    logPrint(F(" meta: ("));
+    logPrint(routeExec.targetX);
+    logPrint(F(","));
+    logPrint(routeExec.targetY);
+    logPrint(F(") lookahead: "));
+    logPrint(pathFollower.getLookahead(), 1);
+    logPrintln(F(" cm"));
+
+    routeExec.isTurning = false;
+    routeExec.isMoving = true;
 }
 
 // schedule route execution
 bool startRouteExecution(int routeIndex, bool retorno, unsigned long delayMilliseconds) {
     if (routeExec.active) return false;
-    if (routeIndex < 0 || routeIndex >= ROUTE_COUNT) return false;
+    if (routeIndex < 0 || routeIndex >= routeStore.routeCount()) return false;
+    stopTeleop();
     routeExec.active = true;
     routeExec.routeIndex = routeIndex;
     routeExec.direction = retorno ? -1 : 1;
@@ -1086,29 +745,36 @@ bool startRouteExecution(int routeIndex, bool retorno, unsigned long delayMillis
     routeExec.isWaiting = (delayMilliseconds > 0);
     routeExec.isTurning = false;
     routeExec.isMoving = false;
+    routeExec.obstacleActive = false;
+    routeExec.obstacleState = OBSTACLE_IDLE;
+    routeExec.obstacleWaitActive = false;
+    routeExec.obstacleReplans = 0;
+    obstacleTracker.reset();
     // require operator confirmation by default; will auto-start when delay expires
     routeExec.awaitingConfirm = true;
+    traceRing.rearm();
 
-    int totalWaypoints = routesCounts[routeIndex];
+    int totalWaypoints = routeStore.pointCount(routeIndex);
     int effectiveWaypoints = (totalWaypoints > 1) ? totalWaypoints - 1 : totalWaypoints;
     
-    Serial.print(F("Ruta programada: "));
-    Serial.print(routeNames[routeIndex]);
-    Serial.print(F(" - Modo: "));
-    Serial.print(retorno ? F("RETORNO") : F("IDA"));
-    Serial.print(F(" - Waypoints a visitar: "));
-    Serial.print(effectiveWaypoints);
-    Serial.print(F(" de "));
-    Serial.print(totalWaypoints);
-    Serial.print(F(" totales"));
+    char routeName[ROUTE_STORE_NAME_MAX + 1];
+    logPrint(F("Ruta programada: "));
+    logPrint(routeStore.name(routeIndex, routeName, sizeof(routeName)));
+    logPrint(F(" - Modo: "));
+    logPrint(retorno ? F("RETORNO") : F("IDA"));
+    logPrint(F(" - Waypoints a visitar: "));
+    logPrint(effectiveWaypoints);
+    logPrint(F(" de "));
+    logPrint(totalWaypoints);
+    logPrint(F(" totales"));
     if (retorno) {
-        Serial.print(F(" (omitiendo último waypoint)"));
+        logPrint(F(" (omitiendo último waypoint)"));
     } else {
-        Serial.print(F(" (omitiendo primer waypoint 0,0)"));
+        logPrint(F(" (omitiendo primer waypoint 0,0)"));
     }
-    Serial.print(F(" - Delay: "));
-    Serial.print(delayMilliseconds);
-    Serial.println(F(" ms"));
+    logPrint(F(" - Delay: "));
+    logPrint(delayMilliseconds);
+    logPrintln(F(" ms"));
 
     if (delayMilliseconds == 0) beginNextWaypoint();
     return true;
@@ -1125,7 +791,8 @@ bool startRouteExecution(int routeIndex, bool retorno, unsigned long delayMillis
 // 
 // `encoders`: Gestión de encoders E386G5
 //   - Contadores de pulsos por rueda (left/right)
-//   - Calibración de pulsos por revolución (por defecto ~3418 PPR)
+//   - Calibración de pulsos por revolución (por defecto ~6836 cuentas 4x)
+//   - Contadores de transiciones ilegales: getLeftErrors(), getRightErrors()
 //   - Utilidades: getPulsesPerRevolution(), readLeft(), readRight()
 // 
 // `odometry`: Cálculo de posición y orientación
@@ -1133,23 +800,30 @@ bool startRouteExecution(int routeIndex, bool retorno, unsigned long delayMillis
 //   - Posición (x, y) en centímetros
 //   - Orientación (theta) en radianes/grados
 //   - Funciones: getX(), getY(), getThetaDegrees(), resetPosition()
+//   - Velocidades instantáneas: getLinearVelocity() (cm/s), getAngularVelocity() (rad/s)
 // --------------------------------------------------------------------------------
 
 // ========================================
 //         VARIABLES DE CONTROL
 // ========================================
-unsigned long lastPositionUpdate = 0;
-const unsigned int POSITION_UPDATE_INTERVAL = 50;   // Actualizar cada 50ms
-
 // Variables para giros automáticos
 bool turningInProgress = false;
 float targetAngle = 0;
 unsigned long turnStartTime = 0;
-const unsigned int MAX_TURN_TIME = 4000; // 4 segundos máximo para girar
+const unsigned int MAX_TURN_TIME = 4000; // margen sobre la duración del perfil (ms)
+float turnDirection = 1.0f;              // +1 antihorario, -1 horario
 // Variables para control de giros por encoder
 long turnStartLeft0 = 0;
 long turnStartRight0 = 0;
 long turnTargetPulses = 0;
+// Giro en lazo cerrado sobre el rumbo fusionado (IMU + odometría)
+bool turnUseHeading = false;
+float turnHeadingTargetDeg = 0;          // rumbo continuo objetivo (antihorario +)
+float turnHeadingStartDeg = 0;
+// Seguimiento del perfil de giro (turnProfile, en grados)
+const float TURN_TOLERANCE_DEG = 1.0f;
+const float TURN_PROFILE_KP = 3.0f;       // (°/s) por grado de error
+const float TURN_MIN_DEG_S = 15.0f;       // aproximación final
 
 // Variables para imprimir tics mientras se avanza con 'W'
 bool printTicksWhileMoving = false;
@@ -1174,42 +848,11 @@ bool inspectionActive = false;
 unsigned long inspectionLastMillis = 0;
 const unsigned long INSPECTION_INTERVAL_MS = 250; // intervalo para inspección continua
 
-// Simple circular log buffer to capture important messages (also mirrored to Serial)
-const int LOG_LINES = 64;
-String logBuffer[LOG_LINES];
-int logIndex = 0; // next insertion index
-
-void addLogLine(const String &s) {
-    logBuffer[logIndex] = s;
-    logIndex++;
-    if (logIndex >= LOG_LINES) logIndex = 0;
-}
-
-// Helpers that print to Serial and also store to buffer (overloads for flash strings)
-void logPrint(const __FlashStringHelper *fs) { String tmp = String(fs); Serial.print(fs); addLogLine(tmp); }
-void logPrintln(const __FlashStringHelper *fs) { String tmp = String(fs); Serial.println(fs); addLogLine(tmp); }
-void logPrint(const String &s) { Serial.print(s); addLogLine(s); }
-void logPrintln(const String &s) { Serial.println(s); addLogLine(s); }
-
-String getLogsText() {
-    String out = "";
-    // start from the oldest message
-    for (int i = 0; i < LOG_LINES; ++i) {
-        int idx = (logIndex + i) % LOG_LINES;
-        if (logBuffer[idx].length() > 0) {
-            out += logBuffer[idx];
-            out += '\n';
-        }
-    }
-    return out;
-}
-
 // -------------------------------------------------------------------------------
 // VARIABLES DE CONTROL - Descripción:
 // 
 // Odometría:
-// - `POSITION_UPDATE_INTERVAL` (50ms): Frecuencia de actualización de odometría.
-//   Valores más cortos aumentan precisión pero consumen más CPU.
+// - La actualiza la tarea "odometry" del scheduler a 200 Hz (ODOMETRY_PERIOD_US).
 // 
 // Giros automáticos:
 // - `turningInProgress`: Flag que indica si hay un giro en progreso
@@ -1223,8 +866,8 @@ String getLogsText() {
 // - `irSampler`: Muestreo continuo de sensores IR (comando 'K', no implementado)
 // 
 // Logging:
-// - `logBuffer[]`: Buffer circular de 64 líneas para almacenar logs
-// - Funciones logPrint/logPrintln: Imprimen a Serial y almacenan en buffer
+// - `logRing` (LogRing.h): arena circular de 1 KB sin heap; se vuelca en /logs
+// - Funciones logPrint/logPrintln: Imprimen a Serial y almacenan en la arena
 // -------------------------------------------------------------------------------
 
 // ========================================
@@ -1233,123 +876,41 @@ String getLogsText() {
 // Sistema de 5 sensores IR analógicos para detección de obstáculos y navegación.
 // 
 // Funcionamiento:
-// - Lectura analógica 0-1023 (ADC de 10 bits)
-// - Promediado de múltiples muestras para reducir ruido (IR_NUM_SAMPLES = 6)
-// - Conversión a distancia en cm usando fórmula calibrada: 
-//   distancia_cm = 17569.7 * adc^-1.2062
+// - Lectura analógica 0-1023 (ADC de 10 bits) en segundo plano (IRScanner)
+// - Anillo de IR_RING_SIZE = 8 muestras por canal con promedio corrido
+// - Lecturas no bloqueantes: irScanner.snapshot() devuelve raws + cm
+// - Conversión a distancia en cm por tabla lineal a tramos de cada canal
+//   (sin powf por lectura), generada de la curva de fábrica
+//   distancia_cm = 17569.7 * adc^-1.2062 o de la curva propia del sensor
+//   capturada con /ir_cal (IRCurve.h); 'L' elige entre ambas
 // - Detección booleana basada en umbral configurable (IR_THRESHOLD = 150)
 // 
 // Uso en evasión de obstáculos:
 // - Sensores frontales (FL, FR) para detección inicial
 // - Sensores laterales (L, R) para elegir lado de evasión
 // - Sensor opuesto al giro como "sonda" durante evasión lateral
-// - Confirmación de 2 segundos (OBSTACLE_DETECTION_DELAY_MS) antes de evadir
-
-// Mapeo de pines (ajustado: swap L<->R)
-// LEFT_SIDE (lateral izquierdo)  -> A5 (antes A0)
-// FRONT_LEFT (frontal izquierdo) -> A4 (antes A1)
-// BACK_CENTER (trasero central)  -> A2 (sin cambios)
-// FRONT_RIGHT (frontal derecho)  -> A1 (antes A4)
-// RIGHT_SIDE (lateral derecho)   -> A0 (antes A5)
-const int IR_LEFT_SIDE_PIN   = A5; // Lateral izquierdo (swapped)
-const int IR_FRONT_LEFT_PIN  = A4; // Frontal izquierdo (swapped)
-const int IR_BACK_CENTER_PIN = A2; // Trasero central
-const int IR_FRONT_RIGHT_PIN = A1; // Frontal derecho (swapped)
-const int IR_RIGHT_SIDE_PIN  = A0; // Lateral derecho (swapped)
+// - Pistas alfa-beta de FL y FR (obstacleTracker) para confirmar y para el
+//   TTC; 2 s (OBSTACLE_DETECTION_DELAY_MS) como espera máxima antes de evadir
+
+// Pines, estructura IRSensors y conversión ADC->cm: ver IRScanner.h
 
 // Parámetros de lectura
-const int IR_NUM_SAMPLES = 6;      // número de lecturas para promediar
 int IR_THRESHOLD = 150;            // umbral por defecto (0-255). Ajustar por calibración
-// Obstacle avoidance parameters
-const float OBSTACLE_THRESHOLD_CM = 30.0f; // if front distance below this, consider obstacle
-const float AVOID_STEP_CM = 30.0f; // how far to advance when circumventing (per step)
-const float AVOID_CLEAR_MARGIN_CM = 8.0f; // extra margin to consider object cleared
-const float AVOID_MAX_STEP_CM = 200.0f; // maximum allowed advance during avoidance (safety)
-// When an obstacle is detected, wait this many ms before starting avoidance
-const unsigned long OBSTACLE_DETECTION_DELAY_MS = 2000; // 2 seconds
 
-// Estructura para devolver lecturas
-struct IRSensors {
-    int rawLeft;
-    int rawFrontLeft;
-    int rawBack;
-    int rawFrontRight;
-    int rawRight;
-    bool left;
-    bool frontLeft;
-    bool back;
-    bool frontRight;
-    bool right;
-};
+IRCurveData irCurves;              // curvas en uso (EEPROM, ver IRCurve.h)
+IRCurveCalibrator irCurveCal;      // puntos capturados con /ir_cal
 
-// Inicializar pines analógicos (no es necesario pinMode para analogRead,
-// pero dejamos una función para futura configuración y documentación)
+// Inicializar el escáner IR: llena los anillos de muestras y arranca el
+// barrido en segundo plano (ISR del ADC en AVR, service() en otras placas)
 void setupIRSensors() {
-    // No es necesario configurar A0..A5 con pinMode para analogRead en Arduino,
-    // pero si los sensores necesitan alimentación o referencias externas, eso se
-    // debe hacer en el cableado físico.
     // Añadir una pequeña espera para estabilizar sensores si es necesario
     delay(20);
+    irScanner.init();
 }
 
-// Leer un pin IR con promedio de N muestras
-int readIRRaw(int pin) {
-    long acc = 0;
-    for (int i = 0; i < IR_NUM_SAMPLES; ++i) {
-        acc += analogRead(pin);
-        delay(4);
-    }
-    int avg = (int)(acc / IR_NUM_SAMPLES);
-    return avg;
-}
-
+// Lectura no bloqueante: últimos promedios del escáner con detección por umbral
 IRSensors readIRSensors() {
-    IRSensors s;
-    s.rawLeft = readIRRaw(IR_LEFT_SIDE_PIN);
-    s.rawFrontLeft = readIRRaw(IR_FRONT_LEFT_PIN);
-    s.rawBack = readIRRaw(IR_BACK_CENTER_PIN);
-    s.rawFrontRight = readIRRaw(IR_FRONT_RIGHT_PIN);
-    s.rawRight = readIRRaw(IR_RIGHT_SIDE_PIN);
-
-    // Detección booleana (suponer HIGH -> mayor valor -> detectado)
-    s.left = s.rawLeft >= IR_THRESHOLD;
-    s.frontLeft = s.rawFrontLeft >= IR_THRESHOLD;
-    s.back = s.rawBack >= IR_THRESHOLD;
-    s.frontRight = s.rawFrontRight >= IR_THRESHOLD;
-    s.right = s.rawRight >= IR_THRESHOLD;
-    return s;
-}
-
-// Convertir lectura raw del sensor IR (0-1023) a distancia aproximada en cm.
-// Conversión calibrada (modelo empírico) de ADC -> cm.
-// Esta fórmula proviene de la calibración específica mostrada:
-// distancia_cm = 17569.7 * pow(adc, -1.2062)
-// Usamos esa relación porque da mejor precisión para el sensor empleado.
-float irRawToCentimeters(int raw) {
-    if (raw <= 0) return 1000.0f;
-    float adc = (float)raw;
-    float d = 17569.7f * powf(adc, -1.2062f);
-    if (d < 2.0f) d = 2.0f;
-    if (d > 1000.0f) d = 1000.0f;
-    return d;
-}
-
-// Medir distancia en un pin con 'n' muestras y opcionalmente devolver el tiempo
-// en milisegundos mediante el parámetro de salida 'outTimeMs' (puede ser NULL).
-float distanciaSamples(int pin, int n, unsigned long *outTimeMs = NULL) {
-    unsigned long t0 = millis();
-    long suma = 0;
-    for (int i = 0; i < n; ++i) {
-        suma += analogRead(pin);
-        // pequeña espera entre muestras para estabilizar si se desea
-        delay(5);
-    }
-    float adc = (float)suma / (float)n;
-    float dist = 17569.7f * powf(adc, -1.2062f);
-    if (dist < 2.0f) dist = 2.0f;
-    if (dist > 1000.0f) dist = 1000.0f;
-    if (outTimeMs) *outTimeMs = millis() - t0;
-    return dist;
+    return irScanner.snapshot(IR_THRESHOLD).sensors;
 }
 
 // Enviar telemetría simple por Serial
@@ -1370,15 +931,101 @@ void sendIRTelemetry(const IRSensors &s) {
 // the automatic prototype generator. Keep prototypes for functions
 // referenced before their definitions.
 void setupWiFi();
-void handleClient(WiFiClient client);
+void sendJsonHeaders(WiFiClient& client);
 void handleWiFiServer();
+void serviceEventStreams();
+bool openEventStream(WiFiClient& client, long hz);
 void processCommand(char cmd);
 void handleAutoTurn();
 void startAutoTurn(float angleDelta);
 void showHelp();
+void setupScheduler();
+void controlTask();
+void odometryTask();
+void irScanTask();
+void imuTask();
+void motionTask();
+void serialTask();
+void telemetryTask();
+void binaryTelemetryTask();
+void mapTask();
+void fleetTask();
+void webTask();
+
+// Repartir los parámetros de calibración entre los módulos
+void applyCalibration() {
+    encoders.setPulsesPerRevolution(calibration.pulsesPerRevolution);
+    odometry.setGeometry(calibration.wheelBaseCm, calibration.wheelRatio);
+    drive.setGeometry(calibration.wheelBaseCm, calibration.wheelRatio);
+    pathFollower.setWheelBase(calibration.wheelBaseCm);
+    motors.setFeedforward(calibration.kffLeft, calibration.kffRight, calibration.kStaticPwm);
+    motors.setRightCompensation(calibration.rightCompensation);
+    IR_THRESHOLD = calibration.irThreshold;
+}
+
+void printCalibration() {
+    Serial.print(F("Cal PPR:")); Serial.print(calibration.pulsesPerRevolution);
+    Serial.print(F(" base:")); Serial.print(calibration.wheelBaseCm, 2);
+    Serial.print(F("cm ratio:")); Serial.print(calibration.wheelRatio, 4);
+    Serial.print(F(" compD:")); Serial.print(calibration.rightCompensation, 3);
+    Serial.print(F(" kff:")); Serial.print(calibration.kffLeft, 4);
+    Serial.print(F("/")); Serial.print(calibration.kffRight, 4);
+    Serial.print(F(" k0:")); Serial.print(calibration.kStaticPwm, 1);
+    Serial.print(F(" IR:")); Serial.println(calibration.irThreshold);
+}
+
+// Calibración de EEPROM (o valores por defecto de compilación)
+void setupCalibration() {
+    calibrationDefaults(calibration);
+    if (calibrationLoad(calibration)) Serial.println(F("Calibracion cargada de EEPROM"));
+    else Serial.println(F("Sin calibracion en EEPROM: valores por defecto ('C' para calibrar)"));
+    applyCalibration();
+    printCalibration();
+}
+
+void printIrCurves() {
+    Serial.print(F("IR curvas: "));
+    Serial.print(irCurves.useSensor ? F("por sensor") : F("fabrica"));
+    for (uint8_t ch = 0; ch < IR_CHANNEL_COUNT; ++ch) {
+        Serial.print(F(" ")); Serial.print(ch); Serial.print(F(":"));
+        if (irCurves.fittedMask & (1u << ch)) {
+            Serial.print(irCurves.scale[ch], 1);
+            Serial.print(F("^")); Serial.print(irCurves.exponent[ch], 4);
+        } else {
+            Serial.print(F("-"));
+        }
+    }
+    Serial.println();
+}
+
+// Curvas IR por sensor de EEPROM (o la de fábrica en todos los canales)
+void setupIrCurves() {
+    if (!irCurveLoad(irCurves)) irCurveDefaults(irCurves);
+    irCurveApply(irCurves);
+    printIrCurves();
+}
+
+// Cargar el almacén de rutas; sin banco válido, grabar DEFAULT_ROUTES
+void setupRouteStore() {
+    if (routeStore.begin()) {
+        Serial.print(F("Rutas en EEPROM: "));
+        Serial.print(routeStore.routeCount());
+        Serial.print(F(" (seq "));
+        Serial.print(routeStore.getSequence());
+        Serial.println(F(")"));
+        return;
+    }
+    Serial.println(F("EEPROM sin rutas validas: grabando rutas de fabrica"));
+    routeStore.beginWrite();
+    for (uint8_t i = 0; i < DEFAULT_ROUTE_COUNT; ++i) {
+        routeStore.writeRoute(DEFAULT_ROUTES[i].name, DEFAULT_ROUTES[i].xyMm, DEFAULT_ROUTES[i].count);
+    }
+    if (!routeStore.commit()) Serial.println(F("Error grabando rutas en EEPROM"));
+}
 
 void setup() {
     Serial.begin(115200);
+    logRing.begin(&Serial);
     
     // Banner de inicio
     Serial.println(F("=== AMR SYSTEM ==="));
@@ -1393,11 +1040,27 @@ void setup() {
     odometry.init(0.0, 0.0, 0.0);
     // Inicializar sensores IR analógicos (A0..A5)
     setupIRSensors();
+    // IMU (calibra el sesgo del giróscopo: robot quieto durante ~0.5 s)
+    imu.init();
+    headingFilter.reset(odometry.getTheta());
+    // Rutas desde EEPROM (las de fábrica si el almacén está vacío o dañado)
+    setupRouteStore();
+    // PPR, base, asimetría de motores y umbral IR guardados por 'C' / 'V'
+    setupCalibration();
+    // Tablas ADC -> cm de los sensores IR (curvas de /ir_cal)
+    setupIrCurves();
     
     Serial.println(F("LISTO! Pos:(0,0)"));
 
+#if BENCH_AT_BOOT
+    runBenchmarks();
+#endif
+
     // Iniciar Access Point y servidor web (UNO R4 WiFi)
     setupWiFi();
+
+    // Registrar tareas y arrancar el tick (después de motors.init())
+    setupScheduler();
 }
 
 // ========================================
@@ -1411,67 +1074,146 @@ void setup() {
 //    - Encoder: Inicializa contadores y configura interrupciones
 //    - Odometry: Inicializa posición en (0, 0, 0)
 //    - Sensores IR: Pequeño delay para estabilización
+//    - RouteStore: carga las rutas de EEPROM o graba las de fábrica
+//    - Calibración: carga de EEPROM y aplica PPR, base, feedforward, etc.
+//    - Curvas IR: tablas ADC -> cm por sensor (o de fábrica)
 // 4. WiFi Access Point: Crea red "AMR_Robot_AP" y servidor HTTP en puerto 80
+// 5. Scheduler: registra las tareas periódicas y arranca el tick del timer
 //
 // Nota: El WiFi requiere Arduino UNO R4 WiFi o placa compatible con WiFiS3.
 
 
 // ========================================
-//            LOOP PRINCIPAL
+//            TAREAS DEL SCHEDULER
 // ========================================
-// El loop principal ejecuta las siguientes tareas en cada iteración:
-// 1. Actualización de odometría (cada 50ms)
-// 2. Procesamiento de comandos serie (si hay datos disponibles)
-// 3. Manejo de giros automáticos (verifica finalización)
-// 4. Ejecución de rutas (sistema basado en funciones, sin máquina de estados explícita)
-//    - isWaiting: Espera delay o confirmación
-//    - isTurning: Espera finalización de giro
-//    - isMoving: Movimiento hacia waypoint con evasión de obstáculos
-// 5. Impresión de tics mientras avanza (comando 'W')
-// 6. Inspección continua (comando 'I')
-// 7. Manejo de servidor WiFi (dashboard y API HTTP)
-//
-// Nota: delay(5) al final proporciona estabilidad y evita saturación de CPU
-void loop() {
-    // Actualizar odometría frecuentemente
-    if (millis() - lastPositionUpdate >= POSITION_UPDATE_INTERVAL) {
-        odometry.update();
-        lastPositionUpdate = millis();
-    }
-    
-    // Procesar comandos serie
-    if (Serial.available()) {
-        char command = Serial.read();
-        processCommand(command);
-        
-        // Limpiar buffer serie
-        while (Serial.available()) {
-            Serial.read();
-        }
+// Periodos de las tareas (ver Scheduler.h). Las de tiempo real corren en la
+// ISR del tick: no deben usar Serial, WiFi ni delay().
+const unsigned long CONTROL_PERIOD_US   = 5000;   // 200 Hz (PID de velocidad)
+const unsigned long ODOMETRY_PERIOD_US  = 5000;   // 200 Hz (integración sin cos/sin por tick)
+const unsigned long IR_SCAN_PERIOD_US   = 1000;   // 1 kHz (una conversión por tick, no-AVR)
+const unsigned long IMU_PERIOD_US       = 5000;   // 200 Hz (~1 muestra de FIFO por pasada)
+const unsigned long MOTION_PERIOD_US    = 10000;  // 100 Hz (giros, rutas, pared)
+const unsigned long SERIAL_PERIOD_US    = 20000;  // 50 Hz
+const unsigned long TELEMETRY_PERIOD_US = 100000; // 10 Hz
+const unsigned long BINARY_TELEMETRY_PERIOD_US = 10000; // 100 Hz (47 B/trama: ~4.7 KB/s de 11.5 a 115200)
+const unsigned long MAP_PERIOD_US       = 100000; // 10 Hz (5 rayos IR al mapa)
+const unsigned long FLEET_PERIOD_US     = 50000;  // 20 Hz (difusión UDP de pose y ruta)
+// El servidor web es best-effort (periodo 0): corre en cada pasada de loop()
+
+// PID a 100 Hz: con la velocidad por periodo entre flancos ya no hace falta
+// esperar 50 ms de pulsos para tener una medida con resolución
+const unsigned int VELOCITY_PID_INTERVAL_MS = 10;
+
+// Tiempo real: estimar velocidad de rueda y actualizar el PID de velocidad.
+// La caducidad y la frescura de la consigna se aplican aquí y no en
+// motionTask: el hombre muerto de teleop y las paradas de ruta no pueden
+// depender de que loop() siga corriendo
+void controlTask() {
+    unsigned long nowMs = millis();
+    drive.enforceExpiry(nowMs);
+    drive.enforceFreshness(nowMs, CONTROL_PERIOD_US / 1000);
+    encoders.sampleVelocity(micros());
+    motors.updateVelocityControlPps(encoders.getLeftPulsesPerSecond(),
+                                    encoders.getRightPulsesPerSecond(),
+                                    CONTROL_PERIOD_US / 1000);
+}
+
+// Tiempo real: integración de odometría
+void odometryTask() {
+    PERF_SCOPE(PERF_ODOMETRY);
+    odometry.update();
+}
+
+// IMU: vaciar la FIFO y fusionar el giro con la odometría (usa I2C: tarea de loop)
+void imuTask() {
+    PoseSample pose = odometry.sample();
+    // Encoder::sampleVelocity da 0 exacto pasado ENCODER_STOP_TIMEOUT_US sin flancos
+    bool stopped = pose.linearVelocity == 0.0f && pose.angularVelocity == 0.0f;
+    imu.setStationary(stopped);
+    imu.service();
+    float gyroDelta = imu.takeYawDelta();
+    gyroYawRad += gyroDelta;
+    headingFilter.update(pose.theta, gyroDelta, imu.isHealthy(), stopped);
+}
+
+// Avanzar el barrido IR en segundo plano (no-op en AVR: lo lleva la ISR del ADC)
+void irScanTask() {
+    PERF_SCOPE(PERF_IR_SCAN);
+    irScanner.service();
+}
+
+// ========================================
+//        MAPA DE OCUPACIÓN (IR + POSE)
+// ========================================
+// Cada pasada proyecta los 5 sensores IR desde la pose actual sobre
+// occupancyGrid. Posiciones y orientaciones de montaje en el marco del
+// robot (x adelante, y izquierda, cm): ajustar a la carrocería real.
+struct IRMount {
+    float x;
+    float y;
+    float angleRad;
+};
+
+const IRMount IR_MOUNTS[IR_CHANNEL_COUNT] = {
+    {   0.0f,  30.0f,  PI / 2 },   // IR_CH_LEFT
+    {  25.0f,  15.0f,  0.0f },     // IR_CH_FRONT_LEFT
+    { -25.0f,   0.0f,  PI },       // IR_CH_BACK
+    {  25.0f, -15.0f,  0.0f },     // IR_CH_FRONT_RIGHT
+    {   0.0f, -30.0f, -PI / 2 },   // IR_CH_RIGHT
+};
+
+const float MAP_IR_MIN_CM = 10.0f;       // por debajo la curva del sensor es ambigua
+const float MAP_IR_MAX_CM = 80.0f;       // más allá: solo se libera el rayo
+const float MAP_MAX_TURN_RAD_S = 1.0f;   // girando rápido el promedio IR se emborrona
+
+void mapTask() {
+    PoseSample pose = odometry.sample();
+    if (fabs(pose.angularVelocity) > MAP_MAX_TURN_RAD_S) return;
+    occupancyGrid.recenter(pose.x, pose.y);
+
+    IRSnapshot ir = irScanner.snapshot(IR_THRESHOLD);
+    float c = cosf(pose.theta);
+    float s = sinf(pose.theta);
+    for (uint8_t ch = 0; ch < IR_CHANNEL_COUNT; ++ch) {
+        float range = ir.cm[ch];
+        if (!(range >= MAP_IR_MIN_CM)) continue;   // también descarta NaN
+        bool hit = range <= MAP_IR_MAX_CM;
+        if (!hit) range = MAP_IR_MAX_CM;
+        const IRMount& m = IR_MOUNTS[ch];
+        float sx = pose.x + c * m.x - s * m.y;
+        float sy = pose.y + s * m.x + c * m.y;
+        occupancyGrid.integrateRay(sx, sy, pose.theta + m.angleRad, range, hit);
     }
-    
-    // Manejar giros automáticos
-    handleAutoTurn();
+}
 
-    // Ejecutar ruta (sistema basado en funciones, sin máquina de estados explícita)
-    executeRoute();
+// Pistas de los IR frontales: una vez por pasada de motion, con la
+// velocidad de la misma pose que usan rutas y evasión
+void updateObstacleTracker() {
+    IRSnapshot ir = irScanner.snapshot(IR_THRESHOLD);
+    float front[OBSTACLE_TRACK_CHANNELS] = { ir.cm[IR_CH_FRONT_LEFT], ir.cm[IR_CH_FRONT_RIGHT] };
+    obstacleTracker.update(front, motionPose.linearVelocity, motionDtS);
+}
 
-    // ========================================
-    //     SEGUIMIENTO DE PARED
-    // ========================================
-    // Nota: El seguimiento de pared y las rutas son mutuamente excluyentes
-    if (wallFollow.active && !routeExec.active) {
+// ¿El mapa ya tiene ocupado el punto que ve el sensor frontal? Entonces el
+// obstáculo es conocido y no hace falta esperar la confirmación.
+bool mapConfirmsFrontObstacle(float frontCm) {
+    float ahead = frontCm + IR_MOUNTS[IR_CH_FRONT_LEFT].x;
+    return occupancyGrid.isOccupied(motionPose.x + ahead * cosf(motionPose.theta),
+                                    motionPose.y + ahead * sinf(motionPose.theta));
+}
 
-    // ========================================
-    //     SEGUIMIENTO DE PARED
-    // ========================================
+// ========================================
+//     SEGUIMIENTO DE PARED
+// ========================================
+void handleWallFollow() {
     // Nota: El seguimiento de pared y las rutas son mutuamente excluyentes
     if (wallFollow.active && !routeExec.active) {
-        // Leer sensores
-        float dFL = distanciaSamples(IR_FRONT_LEFT_PIN, 3, NULL);
-        float dFR = distanciaSamples(IR_FRONT_RIGHT_PIN, 3, NULL);
-        float dL = distanciaSamples(IR_LEFT_SIDE_PIN, 3, NULL);
-        float dR = distanciaSamples(IR_RIGHT_SIDE_PIN, 3, NULL);
+        // Leer sensores (snapshot no bloqueante)
+        IRSnapshot ir = irScanner.snapshot(IR_THRESHOLD);
+        float dFL = ir.cm[IR_CH_FRONT_LEFT];
+        float dFR = ir.cm[IR_CH_FRONT_RIGHT];
+        float dL = ir.cm[IR_CH_LEFT];
+        float dR = ir.cm[IR_CH_RIGHT];
         
         // Determinar qué sensores están detectando pared
         bool frontLeftWall = dFL <= WALL_FOLLOW_THRESHOLD_CM;
@@ -1522,7 +1264,7 @@ void loop() {
             // En este caso, girar 90° hacia el exterior (hacia donde estaba la pared seguida) para seguirla
             if (!frontLeftWall && !frontRightWall && !followSideWall) {
                 wallFollow.state = 2; // turning
-                motors.stop();
+                drive.stop();
                 // Girar hacia el exterior (hacia la pared que seguíamos) para seguirla
                 startAutoTurn(90.0f * wallFollow.side);
                 Serial.println(F("Esquina externa detectada: lateral seguido perdió pared. Girando 90° hacia exterior para seguir pared."));
@@ -1530,203 +1272,562 @@ void loop() {
             
             // Verificar si todas las paredes están detectadas
             if (allWalls) {
-                motors.stop();
+                drive.stop();
                 wallFollow.state = 3; // stopped
                 wallFollow.allWallsDetectedStart = millis();
                 Serial.println(F("Todas las paredes detectadas. Deteniendo seguimiento."));
             } else if (frontWall) {
                 // Hay pared al frente, girar
                 wallFollow.state = 2; // turning
-                motors.stop();
+                drive.stop();
                 // Girar hacia el lado opuesto a la pared que seguimos (alejarse de la pared seguida)
                 startAutoTurn(-90.0f * wallFollow.side);
                 Serial.println(F("Pared al frente detectada. Girando..."));
             } else {
                 // Seguir la pared ajustando velocidad según distancia
                 // Control proporcional: más cerca = más lento, más lejos = más rápido
-                int baseSpeed = WALL_FOLLOW_SPEED;
-                int leftSpeed = baseSpeed;
-                int rightSpeed = baseSpeed;
+                float baseSpeed = WALL_FOLLOW_SPEED_MM_S;
+                float leftSpeed = baseSpeed;
+                float rightSpeed = baseSpeed;
                 
                 // Calcular velocidad proporcional según distancia (15-25cm es rango ideal)
                 // Muy cerca (<15cm): reducir velocidad y alejarse
                 // Rango ideal (15-25cm): velocidad base
                 // Lejos (>25cm): aumentar velocidad y acercarse
                 float speedMultiplier = 1.0f;
-                float correctionFactor = 0.0f;
+                float correction = 0.0f;
                 
                 if (followSideDist < 15.0f) {
                     // Muy cerca: reducir velocidad proporcionalmente (mínimo 60% de base)
                     speedMultiplier = 0.6f + (followSideDist / 15.0f) * 0.4f; // 0.6 a 1.0
-                    correctionFactor = -20.0f; // alejarse
+                    correction = -WALL_FOLLOW_CORRECTION_MM_S; // alejarse
                 } else if (followSideDist > 25.0f) {
                     // Lejos: aumentar velocidad proporcionalmente (máximo 120% de base)
                     speedMultiplier = 1.0f + ((followSideDist - 25.0f) / 25.0f) * 0.2f; // 1.0 a 1.2
                     if (speedMultiplier > 1.2f) speedMultiplier = 1.2f;
-                    correctionFactor = 20.0f; // acercarse
+                    correction = WALL_FOLLOW_CORRECTION_MM_S; // acercarse
                 }
                 
                 // Aplicar velocidad base ajustada
-                int adjustedSpeed = (int)(baseSpeed * speedMultiplier);
-                if (adjustedSpeed > 255) adjustedSpeed = 255;
-                if (adjustedSpeed < 60) adjustedSpeed = 60; // velocidad mínima
+                float adjustedSpeed = constrain(baseSpeed * speedMultiplier, WALL_FOLLOW_MIN_MM_S, WALL_FOLLOW_MAX_MM_S);
+                leftSpeed = adjustedSpeed;
+                rightSpeed = adjustedSpeed;
                 
                 // Aplicar corrección de dirección
                 if (wallFollow.side == 1) {
                     // Siguiendo pared izquierda
-                    if (correctionFactor < 0) {
+                    if (correction < 0) {
                         // Alejarse: girar ligeramente a la derecha
-                        rightSpeed = adjustedSpeed + (int)correctionFactor;
-                        leftSpeed = adjustedSpeed;
-                    } else if (correctionFactor > 0) {
+                        rightSpeed = adjustedSpeed + correction;
+                    } else if (correction > 0) {
                         // Acercarse: girar ligeramente a la izquierda
-                        leftSpeed = adjustedSpeed + (int)correctionFactor;
-                        rightSpeed = adjustedSpeed;
-                    } else {
-                        leftSpeed = adjustedSpeed;
-                        rightSpeed = adjustedSpeed;
+                        leftSpeed = adjustedSpeed + correction;
                     }
                 } else {
                     // Siguiendo pared derecha
-                    if (correctionFactor < 0) {
+                    if (correction < 0) {
                         // Alejarse: girar ligeramente a la izquierda
-                        leftSpeed = adjustedSpeed + (int)correctionFactor;
-                        rightSpeed = adjustedSpeed;
-                    } else if (correctionFactor > 0) {
+                        leftSpeed = adjustedSpeed + correction;
+                    } else if (correction > 0) {
                         // Acercarse: girar ligeramente a la derecha
-                        rightSpeed = adjustedSpeed + (int)correctionFactor;
-                        leftSpeed = adjustedSpeed;
-                    } else {
-                        leftSpeed = adjustedSpeed;
-                        rightSpeed = adjustedSpeed;
+                        rightSpeed = adjustedSpeed + correction;
                     }
                 }
                 
-                // Asegurar límites PWM
-                if (leftSpeed > 255) leftSpeed = 255;
-                if (leftSpeed < 60) leftSpeed = 60;
-                if (rightSpeed > 255) rightSpeed = 255;
-                if (rightSpeed < 60) rightSpeed = 60;
+                // Asegurar límites de consigna
+                leftSpeed = constrain(leftSpeed, WALL_FOLLOW_MIN_MM_S, WALL_FOLLOW_MAX_MM_S);
+                rightSpeed = constrain(rightSpeed, WALL_FOLLOW_MIN_MM_S, WALL_FOLLOW_MAX_MM_S);
                 
-                motors.setBothMotors(leftSpeed, rightSpeed);
+                drive.setWheelSpeeds(leftSpeed, rightSpeed);
             }
         }
     }
+}
 
-    // Si estamos en modo impresión de tics mientras avanzamos (comando 'W')
-    if (printTicksWhileMoving && millis() - lastTickPrintMillis >= TICK_PRINT_INTERVAL) {
-        long dl = encoders.readLeft() - tickPrintLeft0;
-        long dr = encoders.readRight() - tickPrintRight0;
-        if (dl < 0) dl = 0;
-        if (dr < 0) dr = 0;
-        long avg = (dl + dr) / 2;
-        Serial.print(F("Ticks L:")); Serial.print(dl);
-        Serial.print(F(" R:")); Serial.print(dr);
-        Serial.print(F(" Avg:")); Serial.println(avg);
-        lastTickPrintMillis = millis();
+// Giros automáticos, ejecución de rutas y seguimiento de pared
+void motionTask() {
+    motionPose = odometry.sample();
+    // dt real de la pasada (acotado si la tarea se retrasó)
+    unsigned long dtUs = motionPose.timestampUs - motionLastUs;
+    motionLastUs = motionPose.timestampUs;
+    motionDtS = (dtUs > 50000UL) ? 0.05f : dtUs * 1e-6f;
+    updateObstacleTracker();
+    traceRecord();
+
+    // La calibración y los diagnósticos se adueñan de los motores mientras duran
+    if (calibrationRunning) {
+        handleCalibration();
+        return;
     }
-    
-    // Inspección continua (comando 'I') - ejecuta las mismas acciones que la
-    // inspección rápida pero de forma periódica hasta que se envíe 'X'.
-    if (inspectionActive && (millis() - inspectionLastMillis >= INSPECTION_INTERVAL_MS)) {
-        inspectionLastMillis = millis();
-        // Single-line output: pulses and raw IR values, each field width 6 for alignment
-        // Read raws (for telemetry) and compute distances in cm using calibrated function
-        IRSensors ir = readIRSensors();
-        long pL = encoders.readLeft();
-        long pR = encoders.readRight();
-        unsigned long tTotal = 0;
-        float dL = distanciaSamples(IR_LEFT_SIDE_PIN, IR_NUM_SAMPLES, &tTotal);
-        float dFL = distanciaSamples(IR_FRONT_LEFT_PIN, IR_NUM_SAMPLES, &tTotal);
-        float dB = distanciaSamples(IR_BACK_CENTER_PIN, IR_NUM_SAMPLES, &tTotal);
-        float dFR = distanciaSamples(IR_FRONT_RIGHT_PIN, IR_NUM_SAMPLES, &tTotal);
-        float dR = distanciaSamples(IR_RIGHT_SIDE_PIN, IR_NUM_SAMPLES, &tTotal);
-        char buf[160];
-        // Single-line: pulses (width 6) and distances in cm with 1 decimal (width 6)
-        snprintf(buf, sizeof(buf), "[I] Pulses L:%6ld R:%6ld  Dist cm: L:%6.1f FL:%6.1f B:%6.1f FR:%6.1f R:%6.1f",
-             pL, pR, dL, dFL, dB, dFR, dR);
-        Serial.println(buf);
+    if (diagnosticsActive()) {
+        handleDiagnostics();
+        return;
+    }
+    if (teleopDriving || teleop.isActive()) {
+        handleTeleop();
+        return;
     }
 
-    delay(5); // Pequeña pausa para estabilidad
+    // Manejar giros automáticos
+    handleAutoTurn();
 
-    // manejar cliente WiFi (dashboard server)
-    handleWiFiServer();
+    // Ejecutar ruta (sistema basado en funciones, sin máquina de estados explícita)
+    {
+        PERF_SCOPE(PERF_ROUTE);
+        executeRoute();
+    }
 
-    // Manejo de muestreo IR continuo (si está activo por comando 'K')
-    if (irSampler != nullptr && irSampler->running) {
-        unsigned long now = millis();
-        if (now - irSampler->lastMillis >= irSampler->intervalMs) {
-            irSampler->lastMillis = now;
-            // Leer sensores IR y calcular distancias
-            IRSensors s = readIRSensors();
-            float dL = irRawToCentimeters(s.rawLeft);
-            float dFL = irRawToCentimeters(s.rawFrontLeft);
-            float dB = irRawToCentimeters(s.rawBack);
-            float dFR = irRawToCentimeters(s.rawFrontRight);
-            float dR = irRawToCentimeters(s.rawRight);
-            // Enviar por Serial (puedes cambiar por otro canal si lo deseas)
-            Serial.print(F("K IR: L:")); Serial.print(dL,1);
-            Serial.print(F(" FL:")); Serial.print(dFL,1);
-            Serial.print(F(" B:")); Serial.print(dB,1);
-            Serial.print(F(" FR:")); Serial.print(dFR,1);
-            Serial.print(F(" R:")); Serial.println(dR,1);
-        }
+    {
+        PERF_SCOPE(PERF_WALL_FOLLOW);
+        handleWallFollow();
     }
 }
 
-// ========================================
-//                LOOP NOTES
-// ========================================
-// El loop principal implementa un sistema no bloqueante que ejecuta múltiples
-// tareas de forma cooperativa. El delay(5) al final proporciona:
-// - Estabilidad en lecturas de sensores analógicos
-// - Prevención de saturación de CPU
-// - Mejor responsividad del sistema WiFi
-// 
-// Tareas ejecutadas (en orden de prioridad):
-// 1. Odometría (alta frecuencia, 50ms)
-// 2. Comandos serie (alta prioridad, inmediato)
-// 3. Giros automáticos (verificación continua)
-// 4. Máquina de estados de rutas (si activa)
-// 5. Utilidades (impresión tics, inspección)
-// 6. Servidor WiFi (baja prioridad, no bloqueante)
-
-// ========================================
-//         PROCESAMIENTO COMANDOS
-// ========================================
-// Procesa comandos recibidos por Serial (115200 baudios).
-// Los comandos se agrupan en categorías:
-// - Movimiento: W (adelante), S (atrás), A/D (giro 90°), Q/E (giro continuo)
-// - Utilidades: X (stop), R (reset posición), P (mostrar posición), H (ayuda)
-// - Tests: T (test motores), V (calibración encoder), I (inspección continua)
-//
-// Nota: Durante giros automáticos, solo se acepta el comando 'X' para cancelar.
-void processCommand(char cmd) {
-    cmd = toupper(cmd);
-    
-    // Prevenir comandos durante giro automático (excepto 'X' para cancelar)
-    if (turningInProgress && cmd != 'X') {
-        Serial.println(F("Girando..."));
+// Aplicar la orden del calibrador; al terminar, guardar y aplicar resultados
+void handleCalibration() {
+    static CalibrationOutput lastMode = CAL_OUT_STOP;
+    CalibrationCommand cmd = calibrator.update(millis(), encoders.snapshot(), gyroYawRad, imu.isHealthy());
+
+    if (!calibrator.isActive()) {
+        drive.stop();
+        lastMode = CAL_OUT_STOP;
+        calibrationRunning = false;
+        if (calibrator.getStage() != CAL_DONE) return;
+        calibration = calibrator.result();
+        applyCalibration();
+        bool saved = calibrationSave(calibration);
+        logPrintln(saved ? F("Calibracion completada y guardada en EEPROM") : F("Calibracion completada (error al guardar en EEPROM)"));
+        printCalibration();
         return;
     }
-    switch (cmd) {
-    // ---------------------------
-    // MOVIMIENTO: Adelante / Atrás / Giros
-    // ---------------------------
-    case 'W':
-            Serial.println(F("Adelante (manual hold)"));
+
+    if (cmd.mode == CAL_OUT_PWM) {
+        drive.setOpenLoop();
+        motors.setRawMotors((int)cmd.left, (int)cmd.right);
+    } else if (cmd.mode == CAL_OUT_SPEED) {
+        drive.setWheelSpeeds(cmd.left, cmd.right);
+    } else if (lastMode != CAL_OUT_STOP) {
+        drive.stop();
+    }
+    lastMode = cmd.mode;
+}
+
+bool diagnosticsActive() {
+    return motors.isTestRunning() || oneRevTest.active;
+}
+
+// Algo mueve ya los motores: no arrancar otro diagnóstico
+bool motionBusy() {
+    return routeExec.active || wallFollow.active || turningInProgress || calibrationRunning || diagnosticsActive() ||
+           teleop.isActive();
+}
+
+// Consigna de teleoperación vigente; sin consignas (hombre muerto) se para
+void handleTeleop() {
+    float v, w;
+    if (!teleop.current(millis(), v, w)) {
+        drive.stop();
+        teleopDriving = false;
+        logPrintln(F("Teleop: sin consignas, parado"));
+        return;
+    }
+    if (v == 0.0f && w == 0.0f) drive.stop();
+    else drive.setVelocity(v, w, teleop.deadmanAtMs());
+    teleopDriving = true;
+}
+
+// Fin de teleoperación por orden explícita ('X', otra maniobra)
+void stopTeleop() {
+    teleop.stop();
+    if (teleopDriving) {
+        teleopDriving = false;
+        drive.stop();
+    }
+}
+
+void handleDiagnostics() {
+    unsigned long now = millis();
+    if (motors.isTestRunning()) motors.updateTest(now);
+    if (oneRevTest.active) updateOneRevTest(now);
+}
+
+// Cancelar 'T' / 'V' (motores parados en la misma llamada)
+void stopDiagnostics() {
+    motors.abortTest();
+    if (oneRevTest.active) {
+        oneRevTest.active = false;
+        drive.stop();
+        Serial.println(F("1 vuelta cancelada"));
+    }
+}
+
+// Avanzar exactamente una revolución de rueda (ambas ruedas, promedio de encoders)
+void startOneRevTest() {
+    EncoderSnapshot enc0 = encoders.snapshot();
+    oneRevTest.left0 = enc0.left;
+    oneRevTest.right0 = enc0.right;
+    oneRevTest.target = encoders.getPulsesPerRevolution();
+    oneRevTest.startMs = millis();
+    oneRevTest.lastPrintMs = oneRevTest.startMs;
+    oneRevTest.active = true;
+
+    Serial.print(F("Target pulses: "));
+    Serial.println(oneRevTest.target);
+
+    // Arrancar motores hacia adelante (PWM directo: calibración en lazo abierto)
+    drive.setOpenLoop();
+    motors.moveForward();
+}
+
+void updateOneRevTest(unsigned long now) {
+    EncoderSnapshot enc = encoders.snapshot();
+    long dl = enc.left - oneRevTest.left0;
+    long dr = enc.right - oneRevTest.right0;
+    if (dl < 0) dl = 0; // proteger contra lecturas invertidas momentáneas
+    if (dr < 0) dr = 0;
+    // Objetivo basado en la rueda que más avance
+    long maxv = (dl > dr) ? dl : dr;
+
+    if (maxv < oneRevTest.target) {
+        if (now - oneRevTest.startMs > ONE_REV_TIMEOUT_MS) {
+            oneRevTest.active = false;
+            motors.stop();
+            traceRing.trigger(TELEM_TRACE_DIAG_TIMEOUT, now);
+            Serial.println(F("1 vuelta: timeout sin completar (revisar encoders)"));
+            return;
+        }
+        // Imprimir tics periódicamente para ver progreso
+        if (now - oneRevTest.lastPrintMs >= ONE_REV_PRINT_MS) {
+            long avg = (dl + dr) / 2;
+            Serial.print(F("Ticks L:")); Serial.print(dl);
+            Serial.print(F(" R:")); Serial.print(dr);
+            Serial.print(F(" Avg:")); Serial.print(avg);
+            Serial.print(F(" Max:")); Serial.println(maxv);
+            oneRevTest.lastPrintMs = now;
+        }
+        return;
+    }
+
+    motors.stop();
+    oneRevTest.active = false;
+    // Mostrar conteo final
+    long finalL = enc.left - oneRevTest.left0;
+    long finalR = enc.right - oneRevTest.right0;
+    Serial.print(F("Final L:")); Serial.print(finalL);
+    Serial.print(F(" R:")); Serial.println(finalR);
+    // Calcular pulso medido por vuelta (usar la rueda que más pulses registró)
+    long measured = abs(finalL) > abs(finalR) ? abs(finalL) : abs(finalR);
+    Serial.print(F("Measured pulses/rev:")); Serial.println(measured);
+    // Actualizar configuración runtime
+    encoders.setPulsesPerRevolution((int)measured);
+    Serial.print(F("Pulses_per_rev updated to: ")); Serial.println(encoders.getPulsesPerRevolution());
+    calibration.pulsesPerRevolution = (uint16_t)encoders.getPulsesPerRevolution();
+    if (calibrationSave(calibration)) Serial.println(F("PPR guardado en EEPROM"));
+    Serial.println(F("Hecho: 1 vuelta"));
+}
+
+// Procesar comandos serie
+void serialTask() {
+    PERF_SCOPE(PERF_SERIAL);
+    if (Serial.available()) {
+        char command = Serial.read();
+        processCommand(command);
+        
+        // Limpiar buffer serie
+        while (Serial.available()) {
+            Serial.read();
+        }
+    }
+}
+
+// ========================================
+//          TELEMETRÍA BINARIA
+// ========================================
+// Alternativa al texto (comando 'B'): una trama TELEM_MSG_STATE por periodo
+// (ver TelemetryProtocol.h; decodificar con tools/telemetry_decode).
+// Nunca bloquea: si el buffer TX de Serial no tiene sitio para la trama
+// completa, se descarta y se cuenta en binaryTelemetryDrops.
+bool binaryTelemetry = false;
+uint8_t binaryTelemetrySeq = 0;
+unsigned long binaryTelemetryDrops = 0;
+
+// Empaqueta el estado actual en una trama. Devuelve su longitud.
+// Bits TELEM_FLAG_* del estado actual (telemetría y grabador)
+uint8_t telemFlags() {
+    uint8_t flags = 0;
+    if (routeExec.active) flags |= TELEM_FLAG_ROUTE_ACTIVE;
+    if (routeExec.awaitingConfirm) flags |= TELEM_FLAG_AWAITING_CONFIRM;
+    if (routeExec.obstacleActive) flags |= TELEM_FLAG_OBSTACLE;
+    if (wallFollow.active) flags |= TELEM_FLAG_WALL_FOLLOW;
+    if (drive.isClosedLoop()) flags |= TELEM_FLAG_CLOSED_LOOP;
+    return flags;
+}
+
+void fillTelemState(TelemState& st) {
+    st.timeMs = millis();
+    PoseSample pose = odometry.sample();
+    st.x = (int32_t)lroundf(pose.x * TELEM_POS_PER_CM);
+    st.y = (int32_t)lroundf(pose.y * TELEM_POS_PER_CM);
+    st.theta = (int16_t)lroundf(pose.theta * TELEM_THETA_PER_RAD);
+    st.v = (int16_t)lroundf(pose.linearVelocity * 10.0f);     // cm/s -> mm/s
+    st.w = (int16_t)lroundf(pose.angularVelocity * 1000.0f);  // rad/s -> mrad/s
+    st.encLeft = pose.leftPulses;
+    st.encRight = pose.rightPulses;
+    for (uint8_t ch = 0; ch < IR_CHANNEL_COUNT; ++ch) st.ir[ch] = (uint16_t)irScanner.rawAverage(ch);
+    st.routeState = (uint8_t)routeVirtualState();
+    st.routePoint = (uint8_t)routeExec.currentPoint;
+    st.obstacleState = (uint8_t)routeExec.obstacleState;
+    st.flags = telemFlags();
+}
+
+size_t buildStateFrame(uint8_t* out, size_t cap) {
+    TelemState st;
+    fillTelemState(st);
+    return telemEncodeFrame(out, cap, TELEM_MSG_STATE, binaryTelemetrySeq++, &st, sizeof(st));
+}
+
+// ========================================
+//          GRABADOR DE VUELO
+// ========================================
+// Un registro por pasada de motion (ver TraceRing.h) con el estado sobre el
+// que decide esa pasada; el PWM es la última orden aplicada. Solo copias y
+// conversiones a punto fijo: unos pocos µs.
+void traceRecord() {
+    TelemTraceRecord* r = traceRing.slot();
+    if (!r) return;
+    uint16_t ir[IR_CHANNEL_COUNT];
+    irScanner.rawAverages(ir);
+    r->timeMs = millis();
+    r->encLeft = motionPose.leftPulses;
+    r->encRight = motionPose.rightPulses;
+    r->x = (int16_t)lroundf(motionPose.x * 10.0f);
+    r->y = (int16_t)lroundf(motionPose.y * 10.0f);
+    r->theta = (int16_t)lroundf(motionPose.theta * TELEM_THETA_PER_RAD);
+    r->pwmLeft = (int16_t)lroundf(motors.getLeftOutput() * MOTOR_PWM_SUBSTEPS);
+    r->pwmRight = (int16_t)lroundf(motors.getRightOutput() * MOTOR_PWM_SUBSTEPS);
+    memcpy(r->ir, ir, sizeof(ir));
+    r->routeState = (uint8_t)routeVirtualState();
+    r->routePoint = (uint8_t)routeExec.currentPoint;
+    r->obstacleState = (uint8_t)routeExec.obstacleState;
+    uint8_t flags = telemFlags();
+    if (turningInProgress) flags |= TELEM_FLAG_TURNING;
+    if (teleop.isActive()) flags |= TELEM_FLAG_TELEOP;
+    r->flags = flags;
+    traceRing.commit();
+}
+
+size_t encodeTraceInfo(uint8_t* out, size_t cap) {
+    TelemTraceInfo info;
+    traceRing.info(info, MOTION_PERIOD_US / 1000);
+    return telemEncodeFrame(out, cap, TELEM_MSG_TRACE_INFO, 0, &info, sizeof(info));
+}
+
+size_t encodeTraceRecord(uint8_t* out, size_t cap, uint16_t i) {
+    return telemEncodeFrame(out, cap, TELEM_MSG_TRACE, (uint8_t)i, &traceRing.at(i), sizeof(TelemTraceRecord));
+}
+
+// Volcado por Serial ('G') sin bloquear: tantas tramas como quepan en el
+// buffer TX en cada pasada de bintelem. -1 = sin volcado; 0 = falta la cabecera.
+int traceDumpNext = -1;
+
+void startTraceDump() {
+    traceRing.freeze(TELEM_TRACE_MANUAL, millis());
+    traceDumpNext = 0;
+}
+
+void serviceTraceDump() {
+    if (traceDumpNext < 0) return;
+    uint8_t frame[TELEM_MAX_FRAME];
+    while (true) {
+        uint16_t n = traceRing.size();
+        if (traceDumpNext > (int)n) {
+            traceDumpNext = -1;
+            if (!binaryTelemetry) {
+                Serial.print(F("\nTraza enviada: "));
+                Serial.print(n);
+                Serial.println(F(" registros ('Y' o nueva ruta para volver a grabar)"));
+            }
+            return;
+        }
+        size_t len = (traceDumpNext == 0) ? encodeTraceInfo(frame, sizeof(frame))
+                                          : encodeTraceRecord(frame, sizeof(frame), (uint16_t)(traceDumpNext - 1));
+        if ((size_t)Serial.availableForWrite() < len) return;
+        Serial.write(frame, len);
+        traceDumpNext++;
+    }
+}
+
+void binaryTelemetryTask() {
+    serviceTraceDump();
+    if (!binaryTelemetry) return;
+    uint8_t frame[TELEM_MAX_FRAME];
+    size_t n = buildStateFrame(frame, sizeof(frame));
+    if ((size_t)Serial.availableForWrite() < n) {
+        binaryTelemetryDrops++;
+        return;
+    }
+    Serial.write(frame, n);
+}
+
+// Salidas periódicas por Serial: tics ('W'), inspección ('I') y muestreo IR ('K')
+void telemetryTask() {
+    // En modo binario la salida periódica en texto corrompería el flujo de tramas
+    if (binaryTelemetry) return;
+    PERF_SCOPE(PERF_SERIAL);
+
+    // Si estamos en modo impresión de tics mientras avanzamos (comando 'W')
+    if (printTicksWhileMoving && millis() - lastTickPrintMillis >= TICK_PRINT_INTERVAL) {
+        EncoderSnapshot enc = encoders.snapshot();
+        long dl = enc.left - tickPrintLeft0;
+        long dr = enc.right - tickPrintRight0;
+        if (dl < 0) dl = 0;
+        if (dr < 0) dr = 0;
+        long avg = (dl + dr) / 2;
+        Serial.print(F("Ticks L:")); Serial.print(dl);
+        Serial.print(F(" R:")); Serial.print(dr);
+        Serial.print(F(" Avg:")); Serial.println(avg);
+        lastTickPrintMillis = millis();
+    }
+    
+    // Inspección continua (comando 'I') - ejecuta las mismas acciones que la
+    // inspección rápida pero de forma periódica hasta que se envíe 'X'.
+    if (inspectionActive && (millis() - inspectionLastMillis >= INSPECTION_INTERVAL_MS)) {
+        inspectionLastMillis = millis();
+        // Single-line output: pulses and IR distances from the background scanner snapshot
+        IRSnapshot ir = irScanner.snapshot(IR_THRESHOLD);
+        EncoderSnapshot enc = encoders.snapshot();
+        long pL = enc.left;
+        long pR = enc.right;
+        char buf[192];
+        // Single-line: pulses (width 6), quadrature errors and distances in cm with 1 decimal (width 6)
+        snprintf(buf, sizeof(buf), "[I] Pulses L:%6ld R:%6ld Err L:%lu R:%lu  Dist cm: L:%6.1f FL:%6.1f B:%6.1f FR:%6.1f R:%6.1f",
+             pL, pR, encoders.getLeftErrors(), encoders.getRightErrors(),
+             ir.cm[IR_CH_LEFT], ir.cm[IR_CH_FRONT_LEFT], ir.cm[IR_CH_BACK],
+             ir.cm[IR_CH_FRONT_RIGHT], ir.cm[IR_CH_RIGHT]);
+        Serial.println(buf);
+    }
+
+    // Manejo de muestreo IR continuo (si está activo por comando 'K')
+    if (irSampler != nullptr && irSampler->running) {
+        unsigned long now = millis();
+        if (now - irSampler->lastMillis >= irSampler->intervalMs) {
+            irSampler->lastMillis = now;
+            // Distancias del último snapshot del escáner IR
+            IRSnapshot ir = irScanner.snapshot(IR_THRESHOLD);
+            // Enviar por Serial (puedes cambiar por otro canal si lo deseas)
+            Serial.print(F("K IR: L:")); Serial.print(ir.cm[IR_CH_LEFT],1);
+            Serial.print(F(" FL:")); Serial.print(ir.cm[IR_CH_FRONT_LEFT],1);
+            Serial.print(F(" B:")); Serial.print(ir.cm[IR_CH_BACK],1);
+            Serial.print(F(" FR:")); Serial.print(ir.cm[IR_CH_FRONT_RIGHT],1);
+            Serial.print(F(" R:")); Serial.println(ir.cm[IR_CH_RIGHT],1);
+        }
+    }
+}
+
+// Manejar cliente WiFi (dashboard server)
+void webTask() {
+    {
+        PERF_SCOPE(PERF_HTTP);
+        handleWiFiServer();
+        serviceTeleopChannel();
+    }
+    {
+        PERF_SCOPE(PERF_SSE);
+        serviceEventStreams();
+    }
+}
+
+// Tareas del sistema: periodo y prioridad (0 = más alta). control y odometry
+// son de tiempo real y las ejecuta la ISR del tick.
+void setupScheduler() {
+    scheduler.addTask(F("control"), controlTask, CONTROL_PERIOD_US, 0, true);
+    scheduler.addTask(F("odometry"), odometryTask, ODOMETRY_PERIOD_US, 1, true);
+    scheduler.addTask(F("ir"), irScanTask, IR_SCAN_PERIOD_US, 1);
+    scheduler.addTask(F("imu"), imuTask, IMU_PERIOD_US, 1);
+    scheduler.addTask(F("motion"), motionTask, MOTION_PERIOD_US, 2);
+    scheduler.addTask(F("serial"), serialTask, SERIAL_PERIOD_US, 3);
+    scheduler.addTask(F("telemetry"), telemetryTask, TELEMETRY_PERIOD_US, 4);
+    scheduler.addTask(F("bintelem"), binaryTelemetryTask, BINARY_TELEMETRY_PERIOD_US, 4);
+    scheduler.addTask(F("map"), mapTask, MAP_PERIOD_US, 4);
+    scheduler.addTask(F("fleet"), fleetTask, FLEET_PERIOD_US, 4);
+    scheduler.addTask(F("web"), webTask, 0, 5);
+    motors.setPIDInterval(VELOCITY_PID_INTERVAL_MS);
+    scheduler.begin();
+}
+
+// ========================================
+//            LOOP PRINCIPAL
+// ========================================
+// Todo el trabajo está repartido en tareas del scheduler (ver setupScheduler()):
+// 1. control (200 Hz, tiempo real): velocidad por flancos + PID de velocidad
+// 2. odometry (200 Hz, tiempo real): integración de posición
+// 3. ir (1 kHz): barrido IR en segundo plano
+// 4. imu (200 Hz): FIFO del MPU-6050 + filtro de rumbo
+// 5. motion (100 Hz): giros automáticos, rutas y seguimiento de pared
+//    - isWaiting: Espera delay o confirmación
+//    - isTurning: Espera finalización del giro de 180° de fin de tramo
+//    - isMoving: Pure pursuit sobre los waypoints con evasión de obstáculos
+// 6. serial (50 Hz): comandos por consola
+// 7. telemetry (10 Hz): impresión de tics ('W'), inspección ('I'), muestreo ('K')
+// 8. bintelem (100 Hz): tramas binarias (comando 'B')
+// 9. map (10 Hz): rayos IR al mapa de ocupación
+// 10. web (best-effort): dashboard, API HTTP y flujos /events
+//
+// Las tareas de tiempo real las dispara el tick del timer, así que un cliente
+// HTTP lento o una ráfaga por Serial ya no retrasan el control de motores.
+void loop() {
+    scheduler.run();
+}
+
+// ========================================
+//                LOOP NOTES
+// ========================================
+// loop() solo despacha el scheduler; ya no hay delay() al final. El comando
+// 'O' imprime por tarea: ejecuciones, overruns (ejecución más larga que el
+// periodo o activación perdida) y tiempos de ejecución último/máximo.
+// Una tarea de loop que bloquea retrasa a las demás tareas de loop, pero no a
+// control ni odometry: las secuencias largas ('T', 'V', 'C') son máquinas de
+// estados que avanza motionTask. Si motion deja de refrescar la consigna de
+// las ruedas (p.ej. web enviando una página), control frena el robot hasta
+// que vuelva (DriveController); 'O' cuenta esas frenadas.
+
+// ========================================
+//         PROCESAMIENTO COMANDOS
+// ========================================
+// Procesa comandos recibidos por Serial (115200 baudios).
+// Los comandos se agrupan en categorías:
+// - Movimiento: W (adelante), S (atrás), A/D (giro 90°), Q/E (giro continuo)
+// - Utilidades: X (stop), R (reset posición), P (mostrar posición), H (ayuda)
+// - Tests: T (test motores), V (calibración encoder), I (inspección continua)
+//
+// Nota: Durante giros automáticos, solo se acepta el comando 'X' para cancelar.
+void processCommand(char cmd) {
+    cmd = toupper(cmd);
+    
+    // Prevenir comandos durante giro automático (excepto 'X' para cancelar)
+    if (turningInProgress && cmd != 'X') {
+        Serial.println(F("Girando..."));
+        return;
+    }
+    switch (cmd) {
+    // ---------------------------
+    // MOVIMIENTO: Adelante / Atrás / Giros
+    // ---------------------------
+    case 'W':
+            Serial.println(F("Adelante (manual hold)"));
             // manual forward at 40% PWM while holding
             {
                 int manualFwdSpeed = (int)(MAX_SPEED * 0.40f);
                 // Iniciar impresión de tics mientras avanzamos
-                tickPrintLeft0 = encoders.readLeft();
-                tickPrintRight0 = encoders.readRight();
+                EncoderSnapshot enc = encoders.snapshot();
+                tickPrintLeft0 = enc.left;
+                tickPrintRight0 = enc.right;
                 lastTickPrintMillis = millis();
                 printTicksWhileMoving = true;
                 Serial.print(F("Imprimiendo tics cada "));
                 Serial.print(TICK_PRINT_INTERVAL);
                 Serial.println(F(" ms"));
+                drive.setOpenLoop();
                 motors.moveForward(manualFwdSpeed);
             }
             break;
@@ -1735,6 +1836,7 @@ void processCommand(char cmd) {
             Serial.println(F("Atras (manual hold)"));
             {
                 int manualBackSpeed = (int)(MAX_SPEED * 0.40f);
+                drive.setOpenLoop();
                 motors.moveBackward(manualBackSpeed);
             }
             break;
@@ -1754,6 +1856,7 @@ void processCommand(char cmd) {
             {
                 int manualTurnSpeed = (int)(MAX_SPEED * 0.20f);
                 Serial.print(F("Giro Izq manual (hold). speed=")); Serial.println(manualTurnSpeed);
+                drive.setOpenLoop();
                 motors.turnLeft(manualTurnSpeed);
             }
             break;
@@ -1763,6 +1866,7 @@ void processCommand(char cmd) {
             {
                 int manualTurnSpeed = (int)(MAX_SPEED * 0.20f);
                 Serial.print(F("Giro Der manual (hold). speed=")); Serial.println(manualTurnSpeed);
+                drive.setOpenLoop();
                 motors.turnRight(manualTurnSpeed);
             }
             break;
@@ -1771,56 +1875,28 @@ void processCommand(char cmd) {
     // TEST: Avanzar 1 vuelta (calibración de encoder)
     // ---------------------------
     case 'V':
-            // Avanzar exactamente una revolución de rueda (ambas ruedas, promedio de encoders)
-            Serial.println(F("Avanzar 1 vuelta"));
-            {
-                // Leer contadores iniciales
-                long left0 = encoders.readLeft();
-                long right0 = encoders.readRight();
-                int target = encoders.getPulsesPerRevolution();
-                unsigned long lastPrint = millis();
-
-                Serial.print(F("Target pulses: "));
-                Serial.println(target);
-
-                // Arrancar motores hacia adelante
-                motors.moveForward();
-
-                // Esperar hasta alcanzar el objetivo (basado en la rueda que más avance)
-                while (true) {
-                    long dl = encoders.readLeft() - left0;
-                    long dr = encoders.readRight() - right0;
-                    if (dl < 0) dl = 0; // proteger contra lecturas invertidas momentáneas
-                    if (dr < 0) dr = 0;
-                    long maxv = (dl > dr) ? dl : dr;
-                    if (maxv >= target) break;
-
-                    // Imprimir tics periódicamente para ver progreso
-                    if (millis() - lastPrint >= 100) {
-                        long avg = (dl + dr) / 2;
-                        Serial.print(F("Ticks L:")); Serial.print(dl);
-                        Serial.print(F(" R:")); Serial.print(dr);
-                        Serial.print(F(" Avg:")); Serial.print(avg);
-                        Serial.print(F(" Max:")); Serial.println(maxv);
-                        lastPrint = millis();
-                    }
-
-                    delay(20);
-                }
+            // Avanzar exactamente una revolución de rueda (sin bloquear, ver updateOneRevTest)
+            if (motionBusy()) {
+                Serial.println(F("1 vuelta: robot ocupado"));
+            } else {
+                Serial.println(F("Avanzar 1 vuelta"));
+                startOneRevTest();
+            }
+            break;
 
-                motors.stop();
-                // Mostrar conteo final
-                long finalL = encoders.readLeft() - left0;
-                long finalR = encoders.readRight() - right0;
-                Serial.print(F("Final L:")); Serial.print(finalL);
-                Serial.print(F(" R:")); Serial.println(finalR);
-                // Calcular pulso medido por vuelta (usar la rueda que más pulses registró)
-                long measured = abs(finalL) > abs(finalR) ? abs(finalL) : abs(finalR);
-                Serial.print(F("Measured pulses/rev:")); Serial.println(measured);
-                // Actualizar configuración runtime
-                encoders.setPulsesPerRevolution((int)measured);
-                Serial.print(F("Pulses_per_rev updated to: ")); Serial.println(encoders.getPulsesPerRevolution());
-                Serial.println(F("Hecho: 1 vuelta"));
+    // ---------------------------
+    // CALIBRACIÓN AUTOMÁTICA (ver Calibration.h)
+    // ---------------------------
+    case 'C':
+            if (routeExec.active || wallFollow.active || turningInProgress || diagnosticsActive() || teleop.isActive()) {
+                Serial.println(F("Calibracion: robot ocupado (ruta, pared, giro, test o teleop)"));
+            } else if (calibrationRunning) {
+                Serial.println(F("Calibracion ya en curso ('X' para cancelar)"));
+            } else {
+                Serial.println(F("Calibracion: necesita 1 m libre delante y a cada lado. 'X' cancela."));
+                if (!imu.isHealthy()) Serial.println(F("Aviso: sin IMU, solo barrido PWM"));
+                calibrator.start(calibration, imu.isHealthy());
+                calibrationRunning = true;
             }
             break;
             
@@ -1829,7 +1905,15 @@ void processCommand(char cmd) {
     // ---------------------------
     case 'X':
             Serial.println(F("Stop"));
-            motors.stop();
+            traceRing.trigger(TELEM_TRACE_STOP, millis());
+            // Parada total (botón Stop del dashboard): también rutas y pared,
+            // que si no vuelven a mandar consigna en la siguiente pasada de motion
+            stopRouteExecution();
+            stopWallFollowing();
+            calibrator.abort();
+            stopDiagnostics();
+            stopTeleop();
+            drive.stop();
             turningInProgress = false;
             // Detener impresión de tics si estaba activa
             printTicksWhileMoving = false;
@@ -1848,8 +1932,11 @@ void processCommand(char cmd) {
             
     case 'R':
             Serial.println(F("Reset"));
-            motors.stop();
+            drive.stop();
             odometry.resetPosition();
+            headingFilter.reset(0.0f);
+            occupancyGrid.clear(0.0f, 0.0f);
+            encoders.resetErrors();
             turningInProgress = false;
             break;
             
@@ -1865,8 +1952,93 @@ void processCommand(char cmd) {
     // TEST: Test completo de motores
     // ---------------------------
         case 'T':
-            Serial.println(F("Test"));
-            motors.testMotors();
+            // Secuencia sin bloquear: la avanza motionTask, 'X' la corta
+            if (motionBusy()) {
+                Serial.println(F("Test: robot ocupado"));
+            } else {
+                Serial.println(F("Test"));
+                drive.setOpenLoop();
+                motors.startTest(millis());
+            }
+            break;
+
+        case 'O':
+            // Estadísticas del scheduler (periodos, overruns y tiempos por tarea)
+            scheduler.printStats(Serial);
+            scheduler.resetStats();
+            Serial.print(F("Frenadas sin consigna: ")); Serial.print(drive.getStaleStops());
+            Serial.print(F(" caducadas: ")); Serial.println(drive.getExpiredStops());
+            break;
+
+        case 'F':
+            // Tiempos por tramo caliente (Perf.h) y reinicio de contadores
+            perfPrint(Serial);
+            perfReset();
+            break;
+
+        case 'L':
+            // Alternar curvas IR por sensor / de fábrica (se guarda)
+            if (irCurves.fittedMask == 0) {
+                Serial.println(F("IR: sin curvas por sensor (capturar con /ir_cal)"));
+            } else {
+                irCurves.useSensor = !irCurves.useSensor;
+                irCurveApply(irCurves);
+                if (!irCurveSave(irCurves)) Serial.println(F("Error grabando curvas IR"));
+            }
+            printIrCurves();
+            break;
+
+        case 'G':
+            // Volcar el grabador de vuelo en tramas binarias (lo congela)
+            if (traceDumpNext >= 0) {
+                Serial.println(F("Traza: volcado en curso"));
+            } else {
+                Serial.print(F("Traza: "));
+                Serial.print(traceRing.size());
+                Serial.println(F(" registros en tramas binarias (tools/telemetry_decode --trace)"));
+                Serial.flush();
+                startTraceDump();
+            }
+            break;
+
+        case 'Y':
+            // Rearmar el grabador (vacía el anillo)
+            if (traceDumpNext >= 0) {
+                Serial.println(F("Traza: volcado en curso"));
+            } else {
+                traceRing.rearm();
+                Serial.println(F("Traza: grabando"));
+            }
+            break;
+
+        case 'U':
+            // Microbenchmarks de tramos calientes (ver runBenchmarks)
+            runBenchmarks();
+            break;
+
+        case 'M':
+            // Olvidar el mapa de ocupación (p.ej. tras mover obstáculos)
+            {
+                PoseSample pose = odometry.sample();
+                occupancyGrid.clear(pose.x, pose.y);
+            }
+            Serial.println(F("Mapa borrado"));
+            break;
+
+        case 'B':
+            // Alternar telemetría binaria (ver TelemetryProtocol.h)
+            if (!binaryTelemetry) {
+                Serial.print(F("Telemetria binaria ON v"));
+                Serial.print(TELEM_VERSION);
+                Serial.println(F(" (enviar 'B' para volver a texto)"));
+                Serial.flush();
+                binaryTelemetryDrops = 0;
+                binaryTelemetry = true;
+            } else {
+                binaryTelemetry = false;
+                Serial.print(F("\nTelemetria binaria OFF, tramas descartadas: "));
+                Serial.println(binaryTelemetryDrops);
+            }
             break;
 
         case 'I':
@@ -1901,9 +2073,10 @@ void processCommand(char cmd) {
 // 
 // Funcionamiento:
 // 1. Calcula pulsos necesarios según ángulo y geometría del robot
-// 2. Inicia movimiento de giro en sitio (motores en sentido opuesto)
-// 3. Monitorea encoders hasta alcanzar pulsos objetivo
-// 4. Timeout de seguridad (4 segundos) para prevenir bloqueos
+// 2. Planifica un perfil en S (turnProfile) para el ángulo: w sube y baja
+//    con aceleración y jerk limitados en lugar de arrancar en escalón
+// 3. Sigue el perfil con el avance medido (rumbo IMU o pulsos) hasta el objetivo
+// 4. Timeout de seguridad (duración del perfil + 4 s) para prevenir bloqueos
 //
 // Integración con máquina de estados:
 // - Se usa en navegación automática (beginNextWaypoint)
@@ -1919,26 +2092,33 @@ void startAutoTurn(float angleDelta) {
     while (targetAngle < -180) targetAngle += 360;
 
     // Calcular pulsos necesarios para este ángulo (por rueda)
-    float pulsesF = (abs(angleDelta) * (float)encoders.getPulsesPerRevolution() * (float)WHEEL_BASE_CM) / (360.0 * (float)WHEEL_DIAMETER_CM);
+    float pulsesF = (abs(angleDelta) * (float)encoders.getPulsesPerRevolution() * odometry.getWheelBase()) / (360.0 * (float)WHEEL_DIAMETER_CM);
     turnTargetPulses = (long)(pulsesF + 0.5);
 
     // Guardar contadores de inicio
-    turnStartLeft0 = encoders.readLeft();
-    turnStartRight0 = encoders.readRight();
+    // Puede llamarse fuera de motionTask (comandos A/D): pose recién publicada
+    PoseSample pose = odometry.sample();
+    turnStartLeft0 = pose.leftPulses;
+    turnStartRight0 = pose.rightPulses;
     turnStartTime = millis();
 
-    // Iniciar movimiento: sentido según signo del ángulo
-    if (angleDelta > 0) {
-        // Giro derecha: motor izquierdo adelante, motor derecho atrás
-        motors.setBothMotors(TURN_SPEED, -TURN_SPEED);
-    } else {
-        // Giro izquierda: motor izquierdo atrás, motor derecho adelante
-        motors.setBothMotors(-TURN_SPEED, TURN_SPEED);
-    }
+    // Con IMU: cerrar el lazo sobre el rumbo fusionado. angleDelta > 0 gira
+    // en sentido horario, que en el rumbo (antihorario +) es negativo.
+    turnUseHeading = imu.isHealthy();
+    turnHeadingStartDeg = headingFilter.getHeadingDegrees();
+    turnHeadingTargetDeg = turnHeadingStartDeg - angleDelta;
+
+    // Sentido según signo del ángulo: derecha (horario) o izquierda (antihorario).
+    // El perfil arranca en w = 0; handleAutoTurn() manda la consigna.
+    turnDirection = (angleDelta > 0) ? -1.0f : 1.0f;
+    turnProfile.plan(angleDelta, DRIVE_TURN_DEG_S, DRIVE_TURN_ACCEL_DEG_S2, DRIVE_TURN_JERK_DEG_S3);
+    turnProfile.setTracking(TURN_PROFILE_KP, TURN_TOLERANCE_DEG, TURN_MIN_DEG_S);
+    drive.setVelocity(0.0f, 0.0f);
 
     Serial.print(F("Obj:"));
     Serial.print(targetAngle, 0);
-    Serial.print(F(" targetPulses:")); Serial.println(turnTargetPulses);
+    Serial.print(F(" targetPulses:")); Serial.print(turnTargetPulses);
+    Serial.println(turnUseHeading ? F(" (IMU)") : F(" (enc)"));
 }
 
 // ========================================
@@ -1954,16 +2134,28 @@ void handleAutoTurn() {
     if (!turningInProgress) return;
 
     // Comprobar avance por encoders
-    long dl = encoders.readLeft() - turnStartLeft0;
-    long dr = encoders.readRight() - turnStartRight0;
+    long dl = motionPose.leftPulses - turnStartLeft0;
+    long dr = motionPose.rightPulses - turnStartRight0;
     long adl = abs(dl);
     long adr = abs(dr);
     long maxMoved = (adl > adr) ? adl : adr;
 
-    // Mostrar progreso ocasionalmente
-    // Si alcanzamos la cantidad de pulsos objetivo, paramos
-    if (maxMoved >= turnTargetPulses) {
-        motors.stop();
+    // Avance del giro (grados): con rumbo fusionado se mide directamente; si
+    // no (o si la IMU deja de responder a mitad de giro) se estima por pulsos.
+    // El perfil da la w de cada pasada y decide el final por tolerancia.
+    float turnedDeg;
+    if (turnUseHeading && imu.isHealthy()) {
+        turnedDeg = turnDirection * (headingFilter.getHeadingDegrees() - turnHeadingStartDeg);
+    } else {
+        turnedDeg = (turnTargetPulses > 0) ? turnProfile.getDistance() * (float)maxMoved / (float)turnTargetPulses : turnProfile.getDistance();
+    }
+    MotionSetpoint sp = turnProfile.track(turnedDeg, motionDtS);
+    bool reached = sp.done;
+    if (!reached) drive.setVelocity(0.0f, turnDirection * sp.vel);
+
+    // Si alcanzamos el objetivo, paramos
+    if (reached) {
+        drive.stop();
         turningInProgress = false;
         Serial.println(F("OK"));
         // If this was a post-finish 180° turn, handle waiting/finishing logic
@@ -1990,37 +2182,12 @@ void handleAutoTurn() {
 
         return;
     }
-        // If an obstacle avoidance sequence was waiting for this turn to finish,
-        // advance the obstacle state machine: after the initial TURN we should
-        // start the forward step; after the TURNBACK we should start the crossing step.
-        if (routeExec.obstacleActive) {
-            if (routeExec.obstacleState == 1) {
-                // Completed initial 90° turn; start forward step
-                routeExec.obstacleState = 2; // FORWARD
-                // compute pulses for AVOID_STEP_CM
-                float pulsesF = (AVOID_STEP_CM / (float)WHEEL_CIRCUMFERENCE_CM) * (float)encoders.getPulsesPerRevolution();
-                routeExec.obstacleMoveTargetPulses = (long)(pulsesF + 0.5f);
-                routeExec.obstacleMoveStartLeft = encoders.readLeft();
-                routeExec.obstacleMoveStartRight = encoders.readRight();
-                motors.moveForward();
-                Serial.print(F("Avoidance: forward step pulses:")); Serial.println(routeExec.obstacleMoveTargetPulses);
-            } else if (routeExec.obstacleState == 3) {
-                // Completed turn back toward original heading; start crossing forward step
-                routeExec.obstacleState = 4; // CROSS_FORWARD
-                float pulsesF = (AVOID_STEP_CM / (float)WHEEL_CIRCUMFERENCE_CM) * (float)encoders.getPulsesPerRevolution();
-                routeExec.obstacleMoveTargetPulses = (long)(pulsesF + 0.5f);
-                routeExec.obstacleMoveStartLeft = encoders.readLeft();
-                routeExec.obstacleMoveStartRight = encoders.readRight();
-                motors.moveForward();
-                Serial.print(F("Avoidance: cross forward pulses:")); Serial.println(routeExec.obstacleMoveTargetPulses);
-            }
-            return;
-        }
 
     // Verificar timeout
-    if (millis() - turnStartTime > MAX_TURN_TIME) {
-        motors.stop();
+    if (millis() - turnStartTime > (unsigned long)(turnProfile.getDuration() * 1000.0f) + MAX_TURN_TIME) {
+        drive.stop();
         turningInProgress = false;
+        traceRing.trigger(TELEM_TRACE_TURN_TIMEOUT, millis());
         Serial.println(F("Timeout"));
         return;
     }
@@ -2029,12 +2196,168 @@ void handleAutoTurn() {
 // ========================================
 //            FUNCIONES AYUDA
 // ========================================
+// ========================================
+//            MICROBENCHMARKS
+// ========================================
+// Casos de Bench.h: coste en ciclos por llamada de los tramos calientes con
+// entradas fijas, comparable entre dos compilaciones ('U' o BENCH_AT_BOOT).
+// Los casos que tienen estado usan instancias propias (benchOdometry,
+// benchMotors) para no alterar la pose ni los motores en uso; benchMotors
+// no llama a init() y su MotorPwm no llega a tocar los pines.
+Odometry benchOdometry(&encoders);
+MotorDriver benchMotors;
+
+// Toda la curva útil del Sharp, en orden no monótono
+void benchIrRawToCm(uint16_t iterations) {
+    for (uint16_t i = 0; i < iterations; ++i) {
+        int raw = 80 + (int)((i * 37u) & 511u);
+        benchSink = (uint32_t)irRawToCentimeters(raw);
+    }
+}
+
+// Misma entrada por la tabla del canal (lo que usan las lecturas)
+void benchIrLutToCm(uint16_t iterations) {
+    for (uint16_t i = 0; i < iterations; ++i) {
+        int raw = 80 + (int)((i * 37u) & 511u);
+        benchSink = (uint32_t)IRScanner::rawToCm(IR_CH_FRONT_LEFT, raw);
+    }
+}
+
+// update() con las ruedas paradas: instantánea, velocidades y publicación
+void benchOdometryUpdate(uint16_t iterations) {
+    for (uint16_t i = 0; i < iterations; ++i) {
+        benchOdometry.update();
+        benchSink = i;
+    }
+}
+
+// Integración de un periodo de 5 ms a ~0.3 m/s con algo de giro
+void benchOdometryStep(uint16_t iterations) {
+    for (uint16_t i = 0; i < iterations; ++i) {
+        benchOdometry.integrate(20 + (long)(i & 7u), 22 - (long)(i & 3u));
+        benchSink = i;
+    }
+}
+
+// ISR completa de un flanco válido (incluye benchPrime(), unos pocos ciclos)
+void benchEncoderIsrLeft(uint16_t iterations) {
+    Encoder::benchSave();
+    for (uint16_t i = 0; i < iterations; ++i) {
+        Encoder::benchPrime(true);
+        Encoder::leftEncoderISR();
+        benchSink = i;
+    }
+    Encoder::benchRestore();
+}
+
+void benchEncoderIsrRight(uint16_t iterations) {
+    Encoder::benchSave();
+    for (uint16_t i = 0; i < iterations; ++i) {
+        Encoder::benchPrime(false);
+        Encoder::rightEncoderISR();
+        benchSink = i;
+    }
+    Encoder::benchRestore();
+}
+
+// Cuerpos de /data y /route_status sin red
+void benchJsonPose(uint16_t iterations) {
+    BenchNullPrint sink;
+    for (uint16_t i = 0; i < iterations; ++i) {
+        JsonWriter json(sink);
+        writePoseJson(json);
+        json.flush();
+    }
+    benchSink = sink.bytes;
+}
+
+void benchJsonRouteStatus(uint16_t iterations) {
+    BenchNullPrint sink;
+    for (uint16_t i = 0; i < iterations; ++i) {
+        JsonWriter json(sink);
+        writeRouteStatusJson(json);
+        json.flush();
+    }
+    benchSink = sink.bytes;
+}
+
+// Una actualización del PID de velocidad por llamada (dt = intervalo del PID)
+void benchVelocityPid(uint16_t iterations) {
+    for (uint16_t i = 0; i < iterations; ++i) {
+        float jitter = (float)(i & 15u);
+        benchMotors.updateVelocityControlPps(3900.0f + jitter, 4100.0f - jitter, VELOCITY_PID_INTERVAL_MS);
+        benchSink = i;
+    }
+}
+
+// Un paso de las pistas frontales con un obstáculo quieto a 40..25 cm
+void benchObstacleTrack(uint16_t iterations) {
+    ObstacleTracker tracker;
+    for (uint16_t i = 0; i < iterations; ++i) {
+        float r = 40.0f - (float)(i & 63u) * 0.25f;
+        float front[OBSTACLE_TRACK_CHANNELS] = { r, r + 1.0f };
+        tracker.update(front, 25.0f, 0.01f);
+        benchSink = tracker.confirmed(OBSTACLE_THRESHOLD_CM);
+    }
+}
+
+const char BENCH_NAME_IR[] PROGMEM = "ir_raw_to_cm";
+const char BENCH_NAME_IR_LUT[] PROGMEM = "ir_lut_to_cm";
+const char BENCH_NAME_ODO_UPDATE[] PROGMEM = "odometry_update";
+const char BENCH_NAME_ODO_STEP[] PROGMEM = "odometry_step";
+const char BENCH_NAME_ENC_LEFT[] PROGMEM = "encoder_isr_left";
+const char BENCH_NAME_ENC_RIGHT[] PROGMEM = "encoder_isr_right";
+const char BENCH_NAME_JSON_POSE[] PROGMEM = "json_pose";
+const char BENCH_NAME_JSON_ROUTE[] PROGMEM = "json_route_status";
+const char BENCH_NAME_PID[] PROGMEM = "velocity_pid";
+const char BENCH_NAME_OBSTACLE[] PROGMEM = "obstacle_track";
+
+// Nombres estables: los scripts comparan informes por nombre de caso
+const BenchCase BENCH_CASES[] PROGMEM = {
+    { BENCH_NAME_IR,         benchIrRawToCm,       64 },
+    { BENCH_NAME_IR_LUT,     benchIrLutToCm,       64 },
+    { BENCH_NAME_ODO_UPDATE, benchOdometryUpdate,  64 },
+    { BENCH_NAME_ODO_STEP,   benchOdometryStep,    64 },
+    { BENCH_NAME_ENC_LEFT,   benchEncoderIsrLeft,  64 },
+    { BENCH_NAME_ENC_RIGHT,  benchEncoderIsrRight, 64 },
+    { BENCH_NAME_JSON_POSE,  benchJsonPose,         8 },
+    { BENCH_NAME_JSON_ROUTE, benchJsonRouteStatus,  8 },
+    { BENCH_NAME_PID,        benchVelocityPid,     64 },
+    { BENCH_NAME_OBSTACLE,   benchObstacleTrack,   64 },
+};
+const uint8_t BENCH_CASE_COUNT = sizeof(BENCH_CASES) / sizeof(BENCH_CASES[0]);
+
+// Solo con el robot quieto: los casos del encoder suspenden el conteo real y
+// en el R4 cada lote corre con interrupciones deshabilitadas
+void runBenchmarks() {
+    if (motionBusy() || encoders.getLeftPulsesPerSecond() != 0 || encoders.getRightPulsesPerSecond() != 0) {
+        Serial.println(F("Bench: robot en movimiento u ocupado"));
+        return;
+    }
+    benchOdometry.init(0.0, 0.0, 0.0);
+    benchMotors.setFeedforward(calibration.kffLeft, calibration.kffRight, calibration.kStaticPwm);
+    benchMotors.setPIDInterval(VELOCITY_PID_INTERVAL_MS);
+    benchMotors.enableVelocityControl(true);
+    benchMotors.setTargetPulsesPerSecondBoth(4000.0f, 4000.0f);
+
+    benchRun(Serial, BENCH_CASES, BENCH_CASE_COUNT);
+
+    // Las ISR llamadas a mano y los lotes sin interrupciones ensucian los
+    // tiempos de 'F' y 'O': empezar de cero
+    perfReset();
+    scheduler.resetStats();
+}
+
 void showHelp() {
     Serial.println(F("=== COMANDOS ==="));
     Serial.println(F("W:Adelante (imprime tics) / S:Atras"));
     Serial.println(F("A/D:Izq/Der 90"));
     Serial.println(F("X:Stop P:Pos R:Reset"));
     Serial.println(F("T:Test (motores) V:Avanzar 1 vuelta I:Inspeccionar"));
+    Serial.println(F("C:Calibracion automatica (PWM, base, cuadrados; guarda en EEPROM)"));
+    Serial.println(F("O:Estadisticas del scheduler B:Telemetria binaria on/off G/Y:Volcar/rearmar traza"));
+    Serial.println(F("F:Tiempos por tramo (min/avg/p99/max) U:Microbenchmarks (ciclos)"));
+    Serial.println(F("M:Borrar mapa de ocupacion L:Curvas IR por sensor/fabrica"));
     odometry.printPosition();
 }
 
@@ -2054,242 +2377,926 @@ bool isPrintable(char c) {
 // ======== SERVIDOR Y RESPUESTAS ========
 void setupWiFi() {
     WiFi.disconnect();
-    WiFi.beginAP(AP_SSID, AP_PASS);
-    Serial.print(F("Iniciando AP... "));
-    Serial.println(AP_SSID);
+#if WIFI_STATION_MODE
+    wifiStation = joinSiteNetwork();
+#endif
+    if (!wifiStation) {
+        WiFi.beginAP(AP_SSID, AP_PASS);
+        Serial.print(F("Iniciando AP... "));
+        Serial.println(AP_SSID);
+    }
     IPAddress ip = WiFi.localIP();
     Serial.print(F("IP local: ")); Serial.println(ip);
     server.begin();
+    setupFleet();
 }
 
-void handleClient(WiFiClient client) {
-    String req = client.readStringUntil('\r');
-    client.flush();
-
-    // Serve routes JSON
-    if (req.indexOf("GET /routes ") >= 0 || req.indexOf("GET /routes\r") >= 0 || req.indexOf("GET /routes?") >= 0) {
-        // Build JSON array of routes
-        String json = "[";
-        for (int i = 0; i < ROUTE_COUNT; ++i) {
-            if (i) json += ",";
-            json += "{";
-            json += "\"name\":\"" + String(routeNames[i]) + "\",";
-            json += "\"points\":[";
-            for (int j = 0; j < routesCounts[i]; ++j) {
-                if (j) json += ",";
-                float px = routesPoints[i][j].x;
-                float py = routesPoints[i][j].y;
-                json += "{";
-                json += "\"x\":" + String(px, 3) + ",";
-                json += "\"y\":" + String(py, 3);
-                json += "}";
-            }
-            json += "]}";
-        }
-        json += "]";
+// Unirse a la red del sitio. Bloquea varios segundos: solo desde setup()
+// o con el robot parado (las tareas de tiempo real siguen en la ISR)
+bool joinSiteNetwork() {
+    for (uint8_t attempt = 0; attempt < WIFI_STA_ATTEMPTS; ++attempt) {
+        Serial.print(F("Conectando a "));
+        Serial.println(STA_SSID);
+        if (WiFi.begin(STA_SSID, STA_PASS) != WL_CONNECTED) continue;
+        // La IP del DHCP llega después de asociarse
+        unsigned long t0 = millis();
+        while (WiFi.localIP()[0] == 0 && millis() - t0 < WIFI_STA_DHCP_TIMEOUT_MS) delay(100);
+        return true;
+    }
+    Serial.println(F("Sin red del sitio"));
+    return false;
+}
+
+// ========================================
+//     MODO FLOTA (UDP + COORDINADOR)
+// ========================================
+// Cada FLEET_PERIOD_US una trama TELEM_MSG_FLEET_STATE (pose, velocidades,
+// encoders, IR, ruta y estado de flota; 53 B) en un datagrama a la
+// dirección de difusión de la subred, puerto FLEET_UDP_PORT. Sin acuse ni
+// reintentos: la siguiente trama sustituye a la perdida y SEQ delata los
+// saltos. El coordinador manda con GET /fleet (ver httpFleet()).
+void setupFleet() {
+    IPAddress ip = WiFi.localIP();
+    IPAddress mask = WiFi.subnetMask();
+    fleetBroadcast = IPAddress(ip[0] | (uint8_t)~mask[0], ip[1] | (uint8_t)~mask[1],
+                               ip[2] | (uint8_t)~mask[2], ip[3] | (uint8_t)~mask[3]);
+    fleetRobotId = FLEET_ROBOT_ID ? FLEET_ROBOT_ID : ip[3];
+    fleetUdp.begin(FLEET_UDP_PORT);
+    Serial.print(F("Flota: robot "));
+    Serial.print(fleetRobotId);
+    Serial.print(F(" difusion "));
+    Serial.print(fleetBroadcast);
+    Serial.print(':');
+    Serial.println(FLEET_UDP_PORT);
+}
+
+uint8_t fleetFlags(unsigned long now) {
+    uint8_t flags = 0;
+    if (fleet.isHeld()) flags |= TELEM_FLEET_HOLD;
+    if (fleet.isLeasing()) flags |= TELEM_FLEET_LEASING;
+    if (fleet.leaseExpired(now)) flags |= TELEM_FLEET_LEASE_EXPIRED;
+    if (wifiStation) flags |= TELEM_FLEET_STATION;
+    return flags;
+}
+
+size_t buildFleetFrame(uint8_t* out, size_t cap, unsigned long now) {
+    TelemFleetState fs;
+    fs.robotId = fleetRobotId;
+    fs.fleetFlags = fleetFlags(now);
+    fs.routeIndex = routeExec.active ? (uint8_t)routeExec.routeIndex : 0xFF;
+    fs.reserved = 0;
+    unsigned long lease = fleet.leaseRemaining(now);
+    fs.leaseLeftMs = (uint16_t)(lease > 0xFFFFUL ? 0xFFFFUL : lease);
+    fillTelemState(fs.state);
+    return telemEncodeFrame(out, cap, TELEM_MSG_FLEET_STATE, fleetSeq++, &fs, sizeof(fs));
+}
 
-        client.println(F("HTTP/1.1 200 OK"));
-        client.println(F("Content-Type: application/json"));
-        client.println(F("Connection: close"));
-        client.println();
-        client.print(json);
+void fleetTask() {
+    unsigned long now = millis();
+#if WIFI_STATION_MODE
+    if (wifiStation && WiFi.status() != WL_CONNECTED) {
+        // Sin red no hay coordinador: la reserva (si la hay) vencerá sola
+        if (!motionBusy() && now - wifiLastReconnectMs >= WIFI_STA_RECONNECT_MS) {
+            wifiLastReconnectMs = now;
+            logPrintln(F("Flota: red del sitio perdida, reconectando"));
+            if (joinSiteNetwork()) setupFleet();
+        }
         return;
     }
+#endif
+
+    bool held = !fleet.mayMove(now);
+    if (held != fleetWasHeld) {
+        fleetWasHeld = held;
+        if (!held) logPrintln(F("Flota: en marcha"));
+        else if (fleet.isHeld()) logPrintln(F("Flota: retenido por el coordinador"));
+        else logPrintln(F("Flota: reserva vencida, retenido"));
+    }
 
-    // Serve the routes UI page
-    if (req.indexOf("GET /routes_ui") >= 0) {
-        client.println(F("HTTP/1.1 200 OK"));
-        client.println(F("Content-Type: text/html"));
-        client.println(F("Connection: close"));
-        client.println();
-        client.print(reinterpret_cast<const __FlashStringHelper*>(routesPageHTML));
+    uint8_t frame[TELEM_MAX_FRAME];
+    size_t n = buildFleetFrame(frame, sizeof(frame), now);
+    if (fleetUdp.beginPacket(fleetBroadcast, FLEET_UDP_PORT) && fleetUdp.write(frame, n) == n &&
+        fleetUdp.endPacket()) {
+        fleetFramesSent++;
+    } else {
+        fleetSendErrors++;
+    }
+}
+
+// Cabeceras comunes de las respuestas JSON (el cuerpo lo emite JsonWriter)
+void sendJsonHeaders(WiFiClient& client) {
+    client.print(F("HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nConnection: close\r\n\r\n"));
+}
+
+// Respuesta corta en texto plano: "HTTP/1.1 <code> <texto>" + cuerpo
+void sendTextResponse(WiFiClient& client, int code, const __FlashStringHelper* body) {
+    client.print(F("HTTP/1.1 "));
+    client.print(code);
+    client.print(' ');
+    client.print(httpStatusText(code));
+    client.print(F("\r\nConnection: close\r\n\r\n"));
+    client.println(body);
+}
+
+// Página de WebAssets.h: gzip tal cual está en flash, con ETag. Si el
+// navegador ya tiene esa versión (If-None-Match) solo se envía un 304.
+// Cache-Control: no-cache obliga a revalidar en cada carga, así una página
+// nueva tras reflashear se ve al momento.
+#define WEB_ASSET_CHUNK 512
+
+void sendWebAsset(WiFiClient& client, HttpRequest& req, const uint8_t* gzProgmem, uint32_t len,
+                  const char* etag, const char* contentType) {
+    bool cached = strstr(req.ifNoneMatch(), etag) != nullptr;
+    client.print(cached ? F("HTTP/1.1 304 Not Modified\r\nETag: ") : F("HTTP/1.1 200 OK\r\nETag: "));
+    client.print(etag);
+    client.print(F("\r\nCache-Control: no-cache\r\nConnection: close\r\n"));
+    if (cached) {
+        client.print(F("\r\n"));
         return;
     }
+    client.print(F("Content-Type: "));
+    client.print(contentType);
+    client.print(F("\r\nContent-Encoding: gzip\r\nContent-Length: "));
+    client.print((unsigned long)len);
+    client.print(F("\r\n\r\n"));
+    // Bloques grandes en lugar de un print por byte desde flash
+    uint8_t chunk[WEB_ASSET_CHUNK];
+    for (uint32_t off = 0; off < len; off += WEB_ASSET_CHUNK) {
+        size_t n = (len - off < WEB_ASSET_CHUNK) ? (size_t)(len - off) : WEB_ASSET_CHUNK;
+        memcpy_P(chunk, gzProgmem + off, n);
+        client.write(chunk, n);
+    }
+}
 
-    // Return route execution status JSON
-    if (req.indexOf("GET /route_status") >= 0) {
-        String json = "{";
-        // Calcular estado virtual para compatibilidad con API (basado en flags)
-        int virtualState = 0; // ROUTE_IDLE
-        if (routeExec.isWaiting) virtualState = 1; // ROUTE_WAITING
-        else if (routeExec.isTurning) virtualState = 2; // ROUTE_TURNING
-        else if (routeExec.isMoving) virtualState = 3; // ROUTE_MOVING
-        else if (!routeExec.active) virtualState = 4; // ROUTE_DONE
-        
-        json += "\"active\":" + String(routeExec.active ? 1 : 0) + ",";
-        json += "\"state\":" + String(virtualState) + ",";
-        json += "\"routeIndex\":" + String(routeExec.routeIndex) + ",";
-        json += "\"direction\":" + String(routeExec.direction) + ",";
-        json += "\"currentPoint\":" + String(routeExec.currentPoint) + ",";
-        json += "\"awaitingConfirm\":" + String(routeExec.awaitingConfirm ? 1 : 0) + ",";
-        json += "\"targetX\":" + String(routeExec.targetX,3) + ",";
-        json += "\"targetY\":" + String(routeExec.targetY,3) + ",";
-        json += "\"obstacleActive\":" + String(routeExec.obstacleActive ? 1 : 0) + ",";
-        json += "\"obstacleState\":" + String(routeExec.obstacleState) + ",";
-        unsigned long remaining = 0;
-        if (routeExec.isWaiting) {
-            unsigned long elapsed = millis() - routeExec.requestMillis;
-            if (elapsed < routeExec.delayMs) remaining = routeExec.delayMs - elapsed;
+// ========================================
+//          MANEJADORES HTTP
+// ========================================
+// Serve routes JSON: /routes[?fmt=bin]
+// Los puntos se emiten tal cual están en EEPROM (mm en punto fijo -> cm con
+// un decimal). fmt=bin devuelve el banco activo byte a byte (ver RouteStore.h).
+void httpRoutes(WiFiClient& client, HttpRequest& req) {
+    const char* fmt = req.param("fmt");
+    if (fmt && strcmp(fmt, "bin") == 0) {
+        uint16_t n = routeStore.storedBytes();
+        client.print(F("HTTP/1.1 200 OK\r\nContent-Type: application/octet-stream\r\nContent-Length: "));
+        client.print(n);
+        client.print(F("\r\nConnection: close\r\n\r\n"));
+        uint8_t chunk[64];
+        uint16_t sent = 0;
+        while (sent < n) {
+            uint8_t len = ((uint16_t)(n - sent) > sizeof(chunk)) ? sizeof(chunk) : (uint8_t)(n - sent);
+            for (uint8_t i = 0; i < len; ++i) chunk[i] = routeStore.storedByte(sent + i);
+            client.write(chunk, len);
+            sent += len;
         }
-        json += "\"remainingDelayMs\":" + String(remaining);
-        json += "}";
-        client.println(F("HTTP/1.1 200 OK"));
-        client.println(F("Content-Type: application/json"));
-        client.println(F("Connection: close"));
-        client.println();
-        client.print(json);
         return;
     }
 
-    // Confirm scheduled route start early: /confirm_route
-    if (req.indexOf("GET /confirm_route") >= 0) {
-        if (routeExec.active && routeExec.isWaiting && routeExec.awaitingConfirm) {
-            // If we are waiting specifically to start the return, enable return mode
-            if (routeExec.waitingForReturnConfirm) {
-                // Operator confirmed return: enable return mode and start return
-                // NOTA: Ya se hizo el giro de 180° al terminar la IDA, así que no necesitamos girar de nuevo
-                routeExec.awaitingConfirm = false;
-                routeExec.waitingForReturnConfirm = false;
-                routeExec.returnModeActive = true;
-                routeExec.direction = -1; // run return
-                routeExec.currentPoint = 0; // start return from first waypoint (omitiendo el último)
-                Serial.println(F("Retorno confirmado. Iniciando ruta de retorno..."));
-                beginNextWaypoint(); // Iniciar directamente el retorno (ya está orientado correctamente)
-                client.println(F("HTTP/1.1 200 OK\r\nConnection: close\r\n\r\nCONFIRMED_RETURN"));
-            } else {
-                // normal confirm to start scheduled route
-                routeExec.awaitingConfirm = false;
-                beginNextWaypoint();
-                client.println(F("HTTP/1.1 200 OK\r\nConnection: close\r\n\r\nCONFIRMED"));
-            }
-        } else {
-            client.println(F("HTTP/1.1 409 Conflict\r\nConnection: close\r\n\r\nNO_SCHEDULE"));
+    sendJsonHeaders(client);
+    JsonWriter json(client);
+    char routeName[ROUTE_STORE_NAME_MAX + 1];
+    json.beginArray();
+    for (uint8_t i = 0; i < routeStore.routeCount(); ++i) {
+        json.beginObject();
+        json.field(F("name"), (const char*)routeStore.name(i, routeName, sizeof(routeName)));
+        json.key(F("points"));
+        json.beginArray();
+        for (uint8_t j = 0; j < routeStore.pointCount(i); ++j) {
+            int16_t xMm, yMm;
+            routeStore.pointMm(i, j, xMm, yMm);
+            json.beginObject();
+            json.key(F("x")); json.valueFixed(xMm, 1);
+            json.key(F("y")); json.valueFixed(yMm, 1);
+            json.endObject();
         }
+        json.endArray();
+        json.endObject();
+    }
+    json.endArray();
+    json.flush();
+}
+
+// Subir o borrar una ruta: POST /routes?slot=N&name=Ruta%20F
+// Cuerpo: puntos en cm "x,y;x,y;..." (admite decimales, resolución 1 mm).
+// slot == nº de rutas la añade; &delete=1 la borra (cuerpo vacío). Solo con
+// el robot parado: la ruta activa no puede cambiar bajo los pies del seguidor.
+void httpRoutesUpload(WiFiClient& client, HttpRequest& req) {
+    // Nada moviendo los motores (ruta, pared, giro, teleop, calibración,
+    // diagnósticos): escribir los bancos de EEPROM no debe solaparse
+    if (motionBusy()) {
+        sendTextResponse(client, 409, F("BUSY"));
+        return;
+    }
+    long slot = req.paramLong("slot", -1);
+    if (slot < 0 || slot > routeStore.routeCount() || slot >= ROUTE_STORE_MAX_ROUTES) {
+        sendTextResponse(client, 400, F("BAD_SLOT"));
+        return;
+    }
+    if (req.paramLong("delete", 0) != 0) {
+        bool ok = routeStore.removeRoute((uint8_t)slot);
+        if (ok) sendTextResponse(client, 200, F("DELETED"));
+        else sendTextResponse(client, 400, F("BAD_SLOT"));
+        return;
+    }
+    const char* name = req.param("name");
+    if (!name || !*name) {
+        sendTextResponse(client, 400, F("MISSING_NAME"));
         return;
     }
 
-    // Start route execution: /start_route?route=0&dir=ida|retorno&delay=ms
-    if (req.indexOf("GET /start_route") >= 0) {
-        int rIdx = 0;
-        bool retorno = false;
-        unsigned long delayMs = 0;
-        int p;
-        p = req.indexOf("route=");
-        if (p >= 0) {
-            p += 6;
-            String num;
-            while (p < req.length()) {
-                char ch = req[p];
-                if (ch >= '0' && ch <= '9') { num += ch; p++; } else break;
-            }
-            rIdx = num.toInt();
-        }
-        p = req.indexOf("dir=");
-        if (p >= 0) {
-            p += 4;
-            String d;
-            while (p < req.length()) {
-                char ch = req[p];
-                if (ch == '&' || ch == ' ' || ch == '\r') break;
-                d += ch; p++;
-            }
-            d.toLowerCase();
-            if (d.indexOf("ret") >= 0) retorno = true;
-        }
-        p = req.indexOf("delay=");
-        if (p >= 0) {
-            p += 6;
-            String num;
-            while (p < req.length()) {
-                char ch = req[p];
-                if (ch >= '0' && ch <= '9') { num += ch; p++; } else break;
-            }
-            delayMs = (unsigned long)num.toInt();
+    int16_t xyMm[2 * ROUTE_STORE_MAX_POINTS];
+    uint8_t n = 0;
+    const char* p = req.bodyData();
+    while (*p) {
+        char* end;
+        float x = (float)strtod(p, &end);
+        if (end == p || *end != ',') break;
+        p = end + 1;
+        float y = (float)strtod(p, &end);
+        if (end == p) break;
+        p = end;
+        // Comparación negada: strtod acepta "nan" y NaN no es mayor que nada
+        if (!(fabsf(x) <= 3000.0f) || !(fabsf(y) <= 3000.0f) || n >= ROUTE_STORE_MAX_POINTS) {
+            sendTextResponse(client, 400, F("BAD_POINTS"));
+            return;
         }
+        xyMm[2 * n] = (int16_t)lroundf(x * 10.0f);
+        xyMm[2 * n + 1] = (int16_t)lroundf(y * 10.0f);
+        n++;
+        while (*p == ';' || *p == ' ' || *p == '\r' || *p == '\n') p++;
+    }
+    if (*p || n == 0) {
+        sendTextResponse(client, 400, F("BAD_POINTS"));
+        return;
+    }
 
-        bool ok = startRouteExecution(rIdx, retorno, delayMs);
-        if (ok) {
-            client.println(F("HTTP/1.1 200 OK\r\nConnection: close\r\n\r\nOK"));
+    if (routeStore.replaceRoute((uint8_t)slot, name, xyMm, n)) {
+        logPrint(F("Ruta ")); logPrint(slot); logPrint(F(" guardada: ")); logPrint(n);
+        logPrint(F(" puntos (seq ")); logPrint((unsigned long)routeStore.getSequence()); logPrintln(F(")"));
+        sendTextResponse(client, 200, F("SAVED"));
+    } else {
+        sendTextResponse(client, 413, F("STORE_FULL"));
+    }
+}
+
+// Serve the routes UI page
+void httpRoutesUi(WiFiClient& client, HttpRequest& req) {
+    sendWebAsset(client, req, WEB_ROUTES_UI_GZ, WEB_ROUTES_UI_GZ_LEN, WEB_ROUTES_UI_ETAG, WEB_ROUTES_UI_TYPE);
+}
+
+// Objeto de estado de ruta (compartido por /route_status y el evento 'route' de /events)
+void writeRouteStatusJson(JsonWriter& json) {
+    int virtualState = routeVirtualState();
+    unsigned long remaining = 0;
+    if (routeExec.isWaiting) {
+        unsigned long elapsed = millis() - routeExec.requestMillis;
+        if (elapsed < routeExec.delayMs) remaining = routeExec.delayMs - elapsed;
+    }
+
+    json.beginObject();
+    json.field(F("active"), routeExec.active ? 1 : 0);
+    json.field(F("state"), virtualState);
+    json.field(F("routeIndex"), routeExec.routeIndex);
+    json.field(F("direction"), routeExec.direction);
+    json.field(F("currentPoint"), routeExec.currentPoint);
+    json.field(F("awaitingConfirm"), routeExec.awaitingConfirm ? 1 : 0);
+    json.field(F("targetX"), routeExec.targetX, 3);
+    json.field(F("targetY"), routeExec.targetY, 3);
+    json.field(F("obstacleActive"), routeExec.obstacleActive ? 1 : 0);
+    json.field(F("obstacleState"), routeExec.obstacleState);
+    json.field(F("remainingDelayMs"), remaining);
+    json.endObject();
+}
+
+// Return route execution status JSON
+void httpRouteStatus(WiFiClient& client, HttpRequest& req) {
+    sendJsonHeaders(client);
+    JsonWriter json(client);
+    writeRouteStatusJson(json);
+    json.flush();
+}
+
+// Confirm scheduled route start early: /confirm_route
+void httpConfirmRoute(WiFiClient& client, HttpRequest& req) {
+    if (routeExec.active && routeExec.isWaiting && routeExec.awaitingConfirm) {
+        // If we are waiting specifically to start the return, enable return mode
+        if (routeExec.waitingForReturnConfirm) {
+            // Operator confirmed return: enable return mode and start return
+            // NOTA: Ya se hizo el giro de 180° al terminar la IDA, así que no necesitamos girar de nuevo
+            routeExec.awaitingConfirm = false;
+            routeExec.waitingForReturnConfirm = false;
+            routeExec.returnModeActive = true;
+            routeExec.direction = -1; // run return
+            routeExec.currentPoint = 0; // start return from first waypoint (omitiendo el último)
+            Serial.println(F("Retorno confirmado. Iniciando ruta de retorno..."));
+            beginNextWaypoint(); // Iniciar directamente el retorno (ya está orientado correctamente)
+            sendTextResponse(client, 200, F("CONFIRMED_RETURN"));
         } else {
-            client.println(F("HTTP/1.1 409 Conflict\r\nConnection: close\r\n\r\nBUSY"));
+            // normal confirm to start scheduled route
+            routeExec.awaitingConfirm = false;
+            beginNextWaypoint();
+            sendTextResponse(client, 200, F("CONFIRMED"));
         }
-        return;
+    } else {
+        sendTextResponse(client, 409, F("NO_SCHEDULE"));
     }
+}
 
-    // Stop route execution: /stop_route
-    if (req.indexOf("GET /stop_route") >= 0) {
-        stopRouteExecution();
-        client.println(F("HTTP/1.1 200 OK\r\nConnection: close\r\n\r\nSTOPPED"));
+// Start route execution: /start_route?route=0&dir=ida|retorno&delay=ms[&la=cm]
+// la: lookahead del pure pursuit (cm); mayor = esquinas más suaves
+void httpStartRoute(WiFiClient& client, HttpRequest& req) {
+    int rIdx = (int)req.paramLong("route", 0);
+    const char* dir = req.param("dir");
+    bool retorno = dir && strncasecmp(dir, "ret", 3) == 0;
+    long delayMs = req.paramLong("delay", 0);
+    if (delayMs < 0) delayMs = 0;
+    long la = req.paramLong("la", 0);
+    if (la > 0 && !routeExec.active) pathFollower.setLookahead((float)la);
+
+    bool ok = startRouteExecution(rIdx, retorno, (unsigned long)delayMs);
+    if (ok) {
+        sendTextResponse(client, 200, F("OK"));
+    } else {
+        sendTextResponse(client, 409, F("BUSY"));
+    }
+}
+
+// Stop route execution: /stop_route
+void httpStopRoute(WiFiClient& client, HttpRequest& req) {
+    stopRouteExecution();
+    stopDiagnostics();
+    stopTeleop();
+    sendTextResponse(client, 200, F("STOPPED"));
+}
+
+// Start wall following: /wall_follow?side=left|right
+void httpWallFollow(WiFiClient& client, HttpRequest& req) {
+    const char* sideStr = req.param("side");
+    if (sideStr) {
+        int side = (strcmp(sideStr, "left") == 0) ? 1 : -1;
+        startWallFollowing(side);
+        sendTextResponse(client, 200, F("WALL_FOLLOW_STARTED"));
+    } else {
+        sendTextResponse(client, 400, F("MISSING_SIDE"));
+    }
+}
+
+// Stop wall following: /stop_wall_follow
+void httpStopWallFollow(WiFiClient& client, HttpRequest& req) {
+    stopWallFollowing();
+    sendTextResponse(client, 200, F("WALL_FOLLOW_STOPPED"));
+}
+
+// Pose + IR (compartido por /data y el evento 'pose' de /events)
+void writePoseJson(JsonWriter& json) {
+    IRSensors s = readIRSensors();
+    PoseSample pose = odometry.sample();
+
+    json.beginObject();
+    json.field(F("x"), pose.x, 2);
+    json.field(F("y"), pose.y, 2);
+    json.field(F("th"), pose.theta * (180.0f / PI), 1);
+    json.field(F("hdg"), headingFilter.getHeadingDegrees(), 1);   // rumbo fusionado (continuo)
+    json.key(F("ir"));
+    json.beginArray();
+    json.value(s.rawLeft);
+    json.value(s.rawFrontLeft);
+    json.value(s.rawBack);
+    json.value(s.rawFrontRight);
+    json.value(s.rawRight);
+    json.endArray();
+    json.endObject();
+}
+
+void httpData(WiFiClient& client, HttpRequest& req) {
+    sendJsonHeaders(client);
+    JsonWriter json(client);
+    writePoseJson(json);
+    json.flush();
+}
+
+// Una trama binaria TELEM_MSG_STATE: /telemetry
+void httpTelemetry(WiFiClient& client, HttpRequest& req) {
+    uint8_t frame[TELEM_MAX_FRAME];
+    size_t n = buildStateFrame(frame, sizeof(frame));
+    client.print(F("HTTP/1.1 200 OK\r\nContent-Type: application/octet-stream\r\nContent-Length: "));
+    client.print((unsigned)n);
+    client.print(F("\r\nConnection: close\r\n\r\n"));
+    client.write(frame, n);
+}
+
+// Tiempos por tramo caliente: /perf (?reset=1 reinicia tras responder)
+void httpPerf(WiFiClient& client, HttpRequest& req) {
+    sendJsonHeaders(client);
+    JsonWriter json(client);
+    perfWriteJson(json);
+    json.flush();
+    if (req.paramLong("reset", 0) == 1) perfReset();
+}
+
+// Estado de las curvas IR y de la captura: /ir_cal
+void writeIrCalJson(JsonWriter& json) {
+    json.beginObject();
+    json.key(F("curve")); json.value(irCurves.useSensor ? F("sensor") : F("factory"));
+    json.key(F("channels")); json.beginArray();
+    for (uint8_t ch = 0; ch < IR_CHANNEL_COUNT; ++ch) {
+        int raw = irScanner.rawAverage(ch);
+        json.beginObject();
+        json.key(F("fitted")); json.value((irCurves.fittedMask & (1u << ch)) != 0);
+        json.key(F("a")); json.value(irCurves.scale[ch], 1);
+        json.key(F("b")); json.value(irCurves.exponent[ch], 4);
+        json.key(F("points")); json.value((unsigned int)irCurveCal.pointCount(ch));
+        json.key(F("raw")); json.value(raw);
+        json.key(F("cm")); json.value(IRScanner::rawToCm(ch, raw), 1);
+        json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+}
+
+// Curvas IR por sensor (IRCurve.h). Con el robot parado:
+//   /ir_cal?ch=N&cm=D   captura el ADC promedio del canal N con un blanco a D cm
+//   /ir_cal?fit=1       ajusta los canales con puntos suficientes, guarda y aplica
+//   /ir_cal?clear=1     descarta los puntos capturados
+//   /ir_cal?curve=sensor|factory   curvas en uso (se guarda)
+// Responde el estado (writeIrCalJson).
+void httpIrCal(WiFiClient& client, HttpRequest& req) {
+    const char* cmText = req.param("cm");
+    const char* curve = req.param("curve");
+    bool fit = req.paramLong("fit", 0) == 1;
+    if ((cmText || fit) && motionBusy()) {
+        sendTextResponse(client, 409, F("BUSY"));
+        return;
+    }
+    if (curve && strcmp(curve, "sensor") != 0 && strcmp(curve, "factory") != 0) {
+        sendTextResponse(client, 400, F("BAD_CURVE"));
         return;
     }
+    if (req.paramLong("clear", 0) == 1) irCurveCal.clear();
+    if (cmText) {
+        long ch = req.paramLong("ch", -1);
+        float cm = (float)strtod(cmText, nullptr);
+        if (ch < 0 || ch >= IR_CHANNEL_COUNT || !irCurveCal.addPoint((uint8_t)ch, irScanner.rawAverage((uint8_t)ch), cm)) {
+            sendTextResponse(client, 400, F("BAD_POINT"));
+            return;
+        }
+    }
+    bool changed = false;
+    if (fit) {
+        uint8_t mask = irCurveCal.fit(irCurves);
+        for (uint8_t ch = 0; ch < IR_CHANNEL_COUNT; ++ch) {
+            if (irCurveCal.pointCount(ch) == 0) continue;
+            logPrint(F("IR ")); logPrint(ch);
+            logPrint((mask & (1u << ch)) ? F(" ajustado, rms ") : F(" descartado, rms "));
+            logPrint(irCurveCal.lastRmsPct(ch)); logPrintln(F(" %"));
+        }
+        if (mask == 0) {
+            sendTextResponse(client, 400, F("FIT_FAILED"));
+            return;
+        }
+        irCurves.useSensor = 1;
+        changed = true;
+    }
+    if (curve) {
+        irCurves.useSensor = (strcmp(curve, "sensor") == 0) ? 1 : 0;
+        changed = true;
+    }
+    if (changed) {
+        irCurveApply(irCurves);
+        if (!irCurveSave(irCurves)) logPrintln(F("Error grabando curvas IR"));
+    }
+    sendJsonHeaders(client);
+    JsonWriter json(client);
+    writeIrCalJson(json);
+    json.flush();
+}
 
-    // Start wall following: /wall_follow?side=left|right
-    if (req.indexOf("GET /wall_follow") >= 0) {
-        int sideIdx = req.indexOf("side=");
-        if (sideIdx >= 0) {
-            sideIdx += 5;
-            String sideStr = req.substring(sideIdx, sideIdx + 5);
-            int side = (sideStr.indexOf("left") >= 0) ? 1 : -1;
-            startWallFollowing(side);
-            client.println(F("HTTP/1.1 200 OK\r\nConnection: close\r\n\r\nWALL_FOLLOW_STARTED"));
-        } else {
-            client.println(F("HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\nMISSING_SIDE"));
+// Grabador de vuelo: /trace congela el anillo y lo devuelve en tramas
+// TELEM_MSG_TRACE_INFO + TELEM_MSG_TRACE (mismo formato que 'G');
+// /trace?rearm=1 lo vacía y vuelve a grabar.
+#define TRACE_HTTP_CHUNK 512
+
+void httpTrace(WiFiClient& client, HttpRequest& req) {
+    if (req.paramLong("rearm", 0) == 1) {
+        traceRing.rearm();
+        sendTextResponse(client, 200, F("REARMED"));
+        return;
+    }
+    traceRing.freeze(TELEM_TRACE_MANUAL, millis());
+    const size_t infoLen = TELEM_HEADER_SIZE + sizeof(TelemTraceInfo) + TELEM_CRC_SIZE;
+    const size_t recordLen = TELEM_HEADER_SIZE + sizeof(TelemTraceRecord) + TELEM_CRC_SIZE;
+    uint16_t n = traceRing.size();
+    client.print(F("HTTP/1.1 200 OK\r\nContent-Type: application/octet-stream\r\nContent-Length: "));
+    client.print((unsigned long)(infoLen + (size_t)n * recordLen));
+    client.print(F("\r\nConnection: close\r\n\r\n"));
+    // Tramas agrupadas en bloques: un write por registro sería muy lento
+    uint8_t chunk[TRACE_HTTP_CHUNK];
+    size_t used = encodeTraceInfo(chunk, sizeof(chunk));
+    for (uint16_t i = 0; i < n; ++i) {
+        if (used + recordLen > sizeof(chunk)) {
+            client.write(chunk, used);
+            used = 0;
         }
+        used += encodeTraceRecord(chunk + used, sizeof(chunk) - used, i);
+    }
+    client.write(chunk, used);
+}
+
+// Mapa de ocupación empaquetado: /map
+// Cabecera de 8 bytes: 'O' 'G' tamaño(celdas/lado) resolución(cm)
+// origenX origenY (int16 LE, cm) y después OG_SIZE*OG_SIZE/2 bytes, fila a
+// fila desde y mínima: celda par en el nibble bajo, 0..15 (8 = desconocido).
+void httpMap(WiFiClient& client, HttpRequest& req) {
+    uint8_t header[8];
+    int16_t ox = occupancyGrid.getOriginX();
+    int16_t oy = occupancyGrid.getOriginY();
+    header[0] = 'O';
+    header[1] = 'G';
+    header[2] = OG_SIZE;
+    header[3] = OG_RESOLUTION_CM;
+    header[4] = (uint8_t)(ox & 0xFF);
+    header[5] = (uint8_t)((uint16_t)ox >> 8);
+    header[6] = (uint8_t)(oy & 0xFF);
+    header[7] = (uint8_t)((uint16_t)oy >> 8);
+    client.print(F("HTTP/1.1 200 OK\r\nContent-Type: application/octet-stream\r\nContent-Length: "));
+    client.print((unsigned)(sizeof(header) + OG_BYTES));
+    client.print(F("\r\nConnection: close\r\n\r\n"));
+    client.write(header, sizeof(header));
+    client.write(occupancyGrid.data(), OG_BYTES);
+}
+
+// Registro de eventos en texto plano: /logs (se lee la arena en el sitio)
+void httpLogs(WiFiClient& client, HttpRequest& req) {
+    client.print(F("HTTP/1.1 200 OK\r\nContent-Type: text/plain; charset=utf-8\r\nConnection: close\r\n\r\n"));
+    logRing.dumpTo(client);
+}
+
+// Comando de un carácter: /cmd?c=W
+void httpCmd(WiFiClient& client, HttpRequest& req) {
+    const char* c = req.param("c");
+    if (!c || !*c) {
+        sendTextResponse(client, 400, F("MISSING_C"));
         return;
     }
+    processCommand(c[0]);
+    sendTextResponse(client, 200, F("OK"));
+}
 
-    // Stop wall following: /stop_wall_follow
-    if (req.indexOf("GET /stop_wall_follow") >= 0) {
-        stopWallFollowing();
-        client.println(F("HTTP/1.1 200 OK\r\nConnection: close\r\n\r\nWALL_FOLLOW_STOPPED"));
+// Respuesta corta que deja la conexión abierta (Content-Length obligatorio)
+void sendKeepAliveText(WiFiClient& client, int code, const __FlashStringHelper* body) {
+    client.print(F("HTTP/1.1 "));
+    client.print(code);
+    client.print(' ');
+    client.print(httpStatusText(code));
+    client.print(F("\r\nContent-Length: "));
+    client.print((unsigned)strlen_P(reinterpret_cast<const char*>(body)));
+    client.print(F("\r\nConnection: keep-alive\r\n\r\n"));
+    client.print(body);
+}
+
+// Lote de consignas de teleoperación: POST /teleop?seq=N, cuerpo "t,v,w;..."
+// (ver Teleop.h). La conexión queda abierta para los lotes siguientes.
+void httpTeleop(WiFiClient& client, HttpRequest& req) {
+    if (routeExec.active || wallFollow.active || turningInProgress || calibrationRunning || diagnosticsActive()) {
+        sendTextResponse(client, 409, F("BUSY"));
+        return;
+    }
+    long seq = req.paramLong("seq", -1);
+    if (seq < 0) {
+        sendTextResponse(client, 400, F("MISSING_SEQ"));
         return;
     }
+    TeleopResult r = teleop.submit((uint16_t)seq, req.bodyData(), millis());
+    if (r == TELEOP_BAD_BATCH) {
+        sendTextResponse(client, 400, F("BAD_BATCH"));
+        return;
+    }
+    sendKeepAliveText(client, 200, r == TELEOP_STALE ? F("STALE") : F("OK"));
+    httpKeepAlive = true;
+}
 
-    if (req.indexOf("GET /data") >= 0) {
-        IRSensors s = readIRSensors();
-        float x = odometry.getX();
-        float y = odometry.getY();
-        float th = odometry.getThetaDegrees();
-
-        String json = "{";
-        json += "\"x\":" + String(x, 2) + ",";
-        json += "\"y\":" + String(y, 2) + ",";
-        json += "\"th\":" + String(th, 1) + ",";
-        json += "\"ir\":[" + String(s.rawLeft) + "," + String(s.rawFrontLeft) + "," + String(s.rawBack) + "," + String(s.rawFrontRight) + "," + String(s.rawRight) + "]";
-        json += "}";
-
-        client.println(F("HTTP/1.1 200 OK"));
-        client.println(F("Content-Type: application/json"));
-        client.println(F("Connection: close"));
-        client.println();
-        client.print(json);
+// Estado de la teleoperación: GET /teleop
+void httpTeleopStatus(WiFiClient& client, HttpRequest& req) {
+    sendJsonHeaders(client);
+    JsonWriter json(client);
+    json.beginObject();
+    json.field(F("active"), teleop.isActive());
+    json.field(F("batches"), teleop.getBatches());
+    json.field(F("stale"), teleop.getStaleBatches());
+    json.field(F("deadman"), teleop.getDeadmanStops());
+    json.field(F("driveDeadman"), drive.getExpiredStops());
+    json.field(F("channel"), teleopChannelOpen);
+    json.endObject();
+    json.flush();
+}
+
+// Coordinador de flota: /fleet[?hold=0|1][&lease=ms][&route=N&dir=ida|retorno]
+// hold retiene el robot sin cancelar la ruta; lease concede una reserva de
+// movimiento de ms (0 vuelve al modo autónomo, ver FleetControl.h); route
+// asigna una ruta como /start_route sin retardo.
+// Primero se validan todos los parámetros (enteros estrictos): 400 BAD_HOLD,
+// BAD_LEASE o BAD_ROUTE sin cambiar nada. Después se aplican route -> hold
+// -> lease; si la ruta no puede arrancar (otra en curso) 409 BUSY, también
+// sin cambios. Si todo va bien responde el estado de flota en JSON.
+void httpFleet(WiFiClient& client, HttpRequest& req) {
+    unsigned long now = millis();
+    // Validar todo antes de aplicar nada: una respuesta de error deja el
+    // estado como estaba
+    bool setHold = req.param("hold") != nullptr;
+    long hold = -1;
+    if (setHold && (!req.paramLongStrict("hold", hold) || (hold != 0 && hold != 1))) {
+        sendTextResponse(client, 400, F("BAD_HOLD"));
         return;
     }
+    bool setLease = req.param("lease") != nullptr;
+    long leaseMs = -1;
+    if (setLease && (!req.paramLongStrict("lease", leaseMs) || leaseMs < 0 ||
+                     !FleetControl::leaseValid((unsigned long)leaseMs))) {
+        sendTextResponse(client, 400, F("BAD_LEASE"));
+        return;
+    }
+    bool setRoute = req.param("route") != nullptr;
+    long routeIndex = -1;
+    if (setRoute && (!req.paramLongStrict("route", routeIndex) || routeIndex < 0 ||
+                     routeIndex >= routeStore.routeCount())) {
+        sendTextResponse(client, 400, F("BAD_ROUTE"));
+        return;
+    }
+    // La ruta es lo único que puede fallar al aplicarse (startRouteExecution
+    // no cambia nada si la rechaza): primero, y el resto solo si arranca
+    if (setRoute) {
+        const char* dir = req.param("dir");
+        bool retorno = dir && strncasecmp(dir, "ret", 3) == 0;
+        if (!startRouteExecution((int)routeIndex, retorno, 0)) {
+            sendTextResponse(client, 409, F("BUSY"));
+            return;
+        }
+        fleet.countCommand();
+    }
+    if (setHold) {
+        fleet.setHold(hold == 1);
+        fleet.countCommand();
+    }
+    if (setLease) {
+        fleet.grantLease(now, (unsigned long)leaseMs);
+        fleet.countCommand();
+    }
+
+    sendJsonHeaders(client);
+    JsonWriter json(client);
+    json.beginObject();
+    json.field(F("id"), fleetRobotId);
+    json.field(F("station"), wifiStation);
+    json.field(F("port"), FLEET_UDP_PORT);
+    json.field(F("periodMs"), FLEET_PERIOD_US / 1000);
+    json.field(F("hold"), fleet.isHeld());
+    json.field(F("leasing"), fleet.isLeasing());
+    json.field(F("leaseLeftMs"), fleet.leaseRemaining(now));
+    json.field(F("mayMove"), fleet.mayMove(now));
+    json.field(F("route"), routeExec.active ? routeExec.routeIndex : -1);
+    json.field(F("state"), routeVirtualState());
+    json.field(F("commands"), fleet.getCommands());
+    json.field(F("sent"), fleetFramesSent);
+    json.field(F("sendErrors"), fleetSendErrors);
+    json.endObject();
+    json.flush();
+}
+
+// Flujo Server-Sent Events: /events?hz=N (ver SERVER-SENT EVENTS más abajo)
+void httpEvents(WiFiClient& client, HttpRequest& req) {
+    long hz = req.paramLong("hz", SSE_DEFAULT_HZ);
+    if (!openEventStream(client, hz)) sendTextResponse(client, 503, F("STREAM_BUSY"));
+}
+
+// Página principal (dashboard)
+void httpDashboard(WiFiClient& client, HttpRequest& req) {
+    sendWebAsset(client, req, WEB_DASHBOARD_GZ, WEB_DASHBOARD_GZ_LEN, WEB_DASHBOARD_ETAG, WEB_DASHBOARD_TYPE);
+}
+
+// ========================================
+//        TABLA DE RUTAS HTTP (PROGMEM)
+// ========================================
+// Coincidencia exacta de ruta (sin query). Para añadir un endpoint basta con
+// una fila nueva; la búsqueda lee cada fila de flash con memcpy_P.
+typedef void (*HttpHandler)(WiFiClient& client, HttpRequest& req);
+
+struct HttpRoute {
+    char path[20];
+    uint8_t method;
+    HttpHandler handler;
+};
 
-    if (req.indexOf("GET /cmd?c=") >= 0) {
-        int idx = req.indexOf("c=") + 2;
-        char c = req[idx];
-        processCommand(c);
-        client.println(F("HTTP/1.1 200 OK\r\nConnection: close\r\n\r\nOK"));
+const HttpRoute HTTP_ROUTES[] PROGMEM = {
+    { "/",                 HTTP_GET, httpDashboard },
+    { "/data",             HTTP_GET, httpData },
+    { "/cmd",              HTTP_GET, httpCmd },
+    { "/routes",           HTTP_GET, httpRoutes },
+    { "/routes",           HTTP_POST, httpRoutesUpload },
+    { "/routes_ui",        HTTP_GET, httpRoutesUi },
+    { "/route_status",     HTTP_GET, httpRouteStatus },
+    { "/confirm_route",    HTTP_GET, httpConfirmRoute },
+    { "/start_route",      HTTP_GET, httpStartRoute },
+    { "/stop_route",       HTTP_GET, httpStopRoute },
+    { "/wall_follow",      HTTP_GET, httpWallFollow },
+    { "/stop_wall_follow", HTTP_GET, httpStopWallFollow },
+    { "/events",           HTTP_GET, httpEvents },
+    { "/telemetry",        HTTP_GET, httpTelemetry },
+    { "/logs",             HTTP_GET, httpLogs },
+    { "/map",              HTTP_GET, httpMap },
+    { "/perf",             HTTP_GET, httpPerf },
+    { "/ir_cal",           HTTP_GET, httpIrCal },
+    { "/trace",            HTTP_GET, httpTrace },
+    { "/fleet",            HTTP_GET, httpFleet },
+    { "/teleop",           HTTP_POST, httpTeleop },
+    { "/teleop",           HTTP_GET, httpTeleopStatus },
+};
+const uint8_t HTTP_ROUTE_COUNT = sizeof(HTTP_ROUTES) / sizeof(HTTP_ROUTES[0]);
+
+void dispatchHttpRequest(WiFiClient& client, HttpRequest& req) {
+    bool pathFound = false;
+    for (uint8_t i = 0; i < HTTP_ROUTE_COUNT; ++i) {
+        HttpRoute route;
+        memcpy_P(&route, &HTTP_ROUTES[i], sizeof(route));
+        if (strcmp(route.path, req.path()) != 0) continue;
+        pathFound = true;
+        if (route.method != req.method()) continue;
+        route.handler(client, req);
         return;
     }
+    if (pathFound) sendTextResponse(client, 405, F("METHOD_NOT_ALLOWED"));
+    else sendTextResponse(client, 404, F("NOT_FOUND"));
+}
 
-    // Página principal (dashboard)
-    client.println(F("HTTP/1.1 200 OK"));
-    client.println(F("Content-Type: text/html"));
-    client.println(F("Connection: close"));
-    client.println();
-    // `dashboardHTML` is stored in flash (PROGMEM). Cast to
-    // __FlashStringHelper so Print::print handles it correctly
-    // and the full HTML is streamed to the client without truncation.
-    client.print(reinterpret_cast<const __FlashStringHelper*>(dashboardHTML));
+// ========================================
+//     SERVIDOR HTTP NO BLOQUEANTE
+// ========================================
+// Un cliente pendiente a la vez: cada pasada de la tarea web consume solo
+// los bytes ya recibidos. Un cliente lento o que no envía nada se corta con
+// 408 pasado HTTP_REQUEST_TIMEOUT_MS, sin bloquear el loop.
+const unsigned long HTTP_REQUEST_TIMEOUT_MS = 1000;
+
+WiFiClient httpClient;
+HttpRequest httpRequest;
+bool httpClientPending = false;
+bool httpClientHandedOff = false;   // el manejador pasó la conexión a un flujo SSE
+bool httpKeepAlive = false;         // el manejador respondió con keep-alive (/teleop)
+unsigned long httpRequestStartMs = 0;
+
+// Canal de teleoperación: la conexión de POST /teleop sigue abierta con su
+// propio parser y los lotes siguientes llegan por ella sin abrir otro
+// socket. Cualquier otra petición por ese canal se atiende y lo cierra.
+#define TELEOP_CHANNEL_IDLE_MS 3000
+WiFiClient teleopClient;
+HttpRequest teleopRequest;
+bool teleopChannelOpen = false;
+unsigned long teleopChannelLastMs = 0;
+
+void closeTeleopChannel() {
+    teleopClient.stop();
+    teleopChannelOpen = false;
+}
+
+void adoptTeleopChannel(WiFiClient& client) {
+    if (teleopChannelOpen) closeTeleopChannel();   // el navegador abrió otro socket
+    teleopClient = client;
+    teleopRequest.reset();
+    teleopChannelOpen = true;
+    teleopChannelLastMs = millis();
+}
+
+void serviceTeleopChannel() {
+    if (!teleopChannelOpen) return;
+    HttpParseState st = teleopRequest.feed(teleopClient);
+    if (st == HTTP_PARSE_DONE) {
+        httpKeepAlive = false;
+        dispatchHttpRequest(teleopClient, teleopRequest);
+        if (httpClientHandedOff) {
+            httpClientHandedOff = false;
+            teleopChannelOpen = false;
+        } else if (httpKeepAlive) {
+            httpKeepAlive = false;
+            teleopRequest.reset();
+            teleopChannelLastMs = millis();
+        } else {
+            closeTeleopChannel();
+        }
+    } else if (st == HTTP_PARSE_ERROR) {
+        sendTextResponse(teleopClient, teleopRequest.errorStatus(), F("REJECTED"));
+        closeTeleopChannel();
+    } else if (!teleopClient.connected() && teleopClient.available() == 0) {
+        closeTeleopChannel();
+    } else if (millis() - teleopChannelLastMs >= TELEOP_CHANNEL_IDLE_MS) {
+        closeTeleopChannel();
+    }
+}
+
+void finishHttpClient() {
+    delay(1);
+    httpClient.stop();
+    httpClientPending = false;
 }
 
 void handleWiFiServer() {
-    WiFiClient client = server.available();
-    if (client) {
-        handleClient(client);
-        delay(1);
-        client.stop();
+    if (!httpClientPending) {
+        WiFiClient incoming = server.available();
+        if (!incoming) return;
+        httpClient = incoming;
+        httpRequest.reset();
+        httpRequestStartMs = millis();
+        httpClientPending = true;
+    }
+
+    HttpParseState st = httpRequest.feed(httpClient);
+    if (st == HTTP_PARSE_DONE) {
+        httpKeepAlive = false;
+        dispatchHttpRequest(httpClient, httpRequest);
+        if (httpClientHandedOff) {
+            // /events se quedó con la conexión: liberar el slot sin cerrarla
+            httpClientHandedOff = false;
+            httpClientPending = false;
+        } else if (httpKeepAlive) {
+            // /teleop: la conexión pasa al canal de teleoperación
+            httpKeepAlive = false;
+            adoptTeleopChannel(httpClient);
+            httpClientPending = false;
+        } else {
+            finishHttpClient();
+        }
+    } else if (st == HTTP_PARSE_ERROR) {
+        sendTextResponse(httpClient, httpRequest.errorStatus(), F("REJECTED"));
+        finishHttpClient();
+    } else if (!httpClient.connected() && httpClient.available() == 0) {
+        // El cliente cerró sin completar la petición
+        finishHttpClient();
+    } else if (millis() - httpRequestStartMs >= HTTP_REQUEST_TIMEOUT_MS) {
+        sendTextResponse(httpClient, 408, F("TIMEOUT"));
+        finishHttpClient();
+    }
+}
+
+// ========================================
+//          SERVER-SENT EVENTS
+// ========================================
+// /events mantiene abierta la conexión y empuja tramas a tasa fija en lugar
+// de que el navegador abra un socket por cada sondeo:
+//     event: pose   data: {"x":..,"y":..,"th":..,"ir":[..]}
+//     event: route  data: {...mismo objeto que /route_status...}
+// Hasta SSE_MAX_CLIENTS flujos (dashboard + página de rutas); no ocupan el
+// slot de petición pendiente, así que /cmd y demás siguen respondiendo.
+// Un flujo se descarta cuando el cliente se desconecta o falla una escritura.
+
+EventStream eventStreams[SSE_MAX_CLIENTS];
+
+bool openEventStream(WiFiClient& client, long hz) {
+    if (hz < 1) hz = 1;
+    if (hz > SSE_MAX_HZ) hz = SSE_MAX_HZ;
+    for (uint8_t i = 0; i < SSE_MAX_CLIENTS; ++i) {
+        EventStream& es = eventStreams[i];
+        if (es.active) continue;
+        client.print(F("HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\n"
+                       "Cache-Control: no-cache\r\nConnection: keep-alive\r\n\r\n"));
+        // Reintento del EventSource del navegador si se corta el flujo
+        client.print(F("retry: 2000\n\n"));
+        es.client = client;
+        es.active = true;
+        es.periodMs = 1000UL / (unsigned long)hz;
+        es.lastSendMs = millis() - es.periodMs; // primera trama inmediata
+        httpClientHandedOff = true;
+        return true;
     }
-}
\ No newline at end of file
+    return false;
+}
+
+void closeEventStream(EventStream& es) {
+    es.client.stop();
+    es.active = false;
+}
+
+// Una trama SSE: "event: <nombre>\ndata: <json>\n\n". false si la escritura falló.
+bool sendEvent(EventStream& es, const __FlashStringHelper* name, void (*writeBody)(JsonWriter&)) {
+    es.client.print(F("event: "));
+    es.client.print(name);
+    es.client.print(F("\ndata: "));
+    JsonWriter json(es.client);
+    writeBody(json);
+    json.flush();
+    return es.client.print(F("\n\n")) > 0;
+}
+
+void serviceEventStreams() {
+    unsigned long now = millis();
+    for (uint8_t i = 0; i < SSE_MAX_CLIENTS; ++i) {
+        EventStream& es = eventStreams[i];
+        if (!es.active) continue;
+        if (!es.client.connected()) {
+            closeEventStream(es);
+            continue;
+        }
+        if (now - es.lastSendMs < es.periodMs) continue;
+        es.lastSendMs = now;
+        if (!sendEvent(es, F("pose"), writePoseJson) ||
+            !sendEvent(es, F("route"), writeRouteStatusJson)) {
+            closeEventStream(es);
+        }
+    }
+}
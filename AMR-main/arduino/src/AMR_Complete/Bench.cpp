@@ -0,0 +1,109 @@
+#include "Bench.h"
+#include "CriticalSection.h"
+
+volatile uint32_t benchSink = 0;
+
+#if BENCH_CLOCK_DWT
+static void benchClockBegin() {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+static inline uint32_t benchNow() { return DWT->CYCCNT; }
+static uint32_t benchHz() { return SystemCoreClock; }
+#else
+static void benchClockBegin() {}
+static inline uint32_t benchNow() { return micros(); }
+#if defined(F_CPU)
+static uint32_t benchHz() { return F_CPU; }
+#else
+static uint32_t benchHz() { return 1000000UL; }  // sin F_CPU: "ciclos" = µs
+#endif
+#endif
+
+// Lote vacío: mismo bucle y escritura al sumidero que los casos
+static void benchEmpty(uint16_t iterations) {
+    for (uint16_t i = 0; i < iterations; ++i) benchSink = i;
+}
+
+static uint32_t measureBatch(BenchFn fn, uint16_t iterations) {
+#if BENCH_CLOCK_DWT
+    CriticalSection cs;
+#endif
+    uint32_t t0 = benchNow();
+    fn(iterations);
+    return benchNow() - t0;
+}
+
+// Tics del reloj del banco -> ciclos
+static uint32_t toCycles(uint32_t ticks) {
+#if BENCH_CLOCK_DWT
+    return ticks;
+#else
+    return (uint32_t)((uint64_t)ticks * benchHz() / 1000000UL);
+#endif
+}
+
+static void sortSamples(uint32_t* v, uint8_t n) {
+    for (uint8_t i = 1; i < n; ++i) {
+        uint32_t x = v[i];
+        uint8_t j = i;
+        while (j > 0 && v[j - 1] > x) {
+            v[j] = v[j - 1];
+            j--;
+        }
+        v[j] = x;
+    }
+}
+
+void benchRun(Print& out, const BenchCase* cases, uint8_t count) {
+    benchClockBegin();
+    uint32_t hz = benchHz();
+    unsigned long startMs = millis();
+
+    out.print(F("BENCH begin clock="));
+    out.print(BENCH_CLOCK_DWT ? F("dwt") : F("micros"));
+    out.print(F(" hz="));
+    out.print((unsigned long)hz);
+    out.print(F(" repeats="));
+    out.println(BENCH_REPEATS);
+
+    uint32_t samples[BENCH_REPEATS];
+    for (uint8_t c = 0; c < count; ++c) {
+        BenchCase bc;
+        memcpy_P(&bc, &cases[c], sizeof(bc));
+        uint16_t n = bc.batch * BENCH_BATCH_SCALE;
+
+        // Coste del bucle vacío con el mismo tamaño de lote (mediana)
+        for (uint8_t r = 0; r < BENCH_REPEATS; ++r) samples[r] = measureBatch(benchEmpty, n);
+        sortSamples(samples, BENCH_REPEATS);
+        uint32_t overhead = samples[BENCH_REPEATS / 2];
+
+        bc.fn(n);   // calentar (caché de flash, primeras ramas)
+        for (uint8_t r = 0; r < BENCH_REPEATS; ++r) {
+            uint32_t t = measureBatch(bc.fn, n);
+            t = (t > overhead) ? t - overhead : 0;
+            samples[r] = toCycles(t) / n;
+        }
+        sortSamples(samples, BENCH_REPEATS);
+        uint32_t med = samples[BENCH_REPEATS / 2];
+
+        out.print(F("BENCH case="));
+        out.print(reinterpret_cast<const __FlashStringHelper*>(bc.name));
+        out.print(F(" batch="));
+        out.print(n);
+        out.print(F(" min="));
+        out.print((unsigned long)samples[0]);
+        out.print(F(" med="));
+        out.print((unsigned long)med);
+        out.print(F(" max="));
+        out.print((unsigned long)samples[BENCH_REPEATS - 1]);
+        out.print(F(" med_ns="));
+        out.println((unsigned long)((uint64_t)med * 1000000000ULL / hz));
+    }
+
+    out.print(F("BENCH end cases="));
+    out.print(count);
+    out.print(F(" ms="));
+    out.println(millis() - startMs);
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <Arduino.h>
+
+// ========================================
+//   MICROBENCHMARKS DE TRAMOS CALIENTES
+// ========================================
+// Mide en ciclos de CPU el coste por llamada de funciones concretas del
+// firmware (la tabla de casos está en el sketch, ver runBenchmarks()), para
+// comparar objetivamente una optimización entre dos compilaciones:
+// - UNO R4 (Cortex-M4): contador de ciclos DWT->CYCCNT, exacto. Cada lote
+//   corre con interrupciones deshabilitadas (unos cientos de µs como mucho).
+// - Otras placas: micros() convertido a ciclos con F_CPU. Resolución de
+//   4 µs en AVR: los lotes son más largos y sin deshabilitar interrupciones
+//   (micros() dejaría de avanzar).
+//
+// Cada caso se ejecuta BENCH_REPEATS veces en lotes de 'batch' llamadas;
+// al coste del lote se le resta el de un lote vacío (bucle + llamada
+// indirecta) y se divide por batch. Se informa mín/mediana/máx entre
+// repeticiones: la mediana es la cifra que comparar, mín y máx indican cuánto
+// ruido hubo (caché de flash, interrupciones en AVR).
+//
+// Informe (Serial, una línea por caso, claves fijas y en este orden):
+//     BENCH begin clock=dwt hz=48000000 repeats=15
+//     BENCH case=ir_raw_to_cm batch=64 min=412 med=415 max=431 med_ns=8645
+//     BENCH end cases=10 ms=40
+// Las líneas llevan el prefijo "BENCH " para filtrarlas entre el resto de
+// la salida (grep '^BENCH ' en dos volcados y diff).
+
+#define BENCH_REPEATS 15
+
+#if defined(ARDUINO_ARCH_RENESAS)
+#define BENCH_CLOCK_DWT 1
+#define BENCH_BATCH_SCALE 1
+#else
+#define BENCH_CLOCK_DWT 0
+#define BENCH_BATCH_SCALE 16          // lotes 16 veces mayores con micros()
+#endif
+
+// Ejecuta el caso 'iterations' veces con entradas deterministas
+typedef void (*BenchFn)(uint16_t iterations);
+
+struct BenchCase {
+    const char* name;                 // en flash (PROGMEM)
+    BenchFn fn;
+    uint16_t batch;                   // llamadas por lote (antes de BENCH_BATCH_SCALE)
+};
+
+// Sumidero para que el compilador no elimine los cálculos medidos
+extern volatile uint32_t benchSink;
+
+// Print que descarta lo escrito (JSON y demás salidas sin red)
+class BenchNullPrint : public Print {
+public:
+    size_t bytes = 0;
+    size_t write(uint8_t) override { bytes++; return 1; }
+    size_t write(const uint8_t* buf, size_t n) override { (void)buf; bytes += n; return n; }
+};
+
+// Ejecuta los casos (tabla PROGMEM) y escribe el informe
+void benchRun(Print& out, const BenchCase* cases, uint8_t count);
+
+#endif // BENCH_H
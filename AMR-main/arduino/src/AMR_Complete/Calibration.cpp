@@ -0,0 +1,259 @@
+#include "Calibration.h"
+#include "MotorDriver.h"         // DEFAULT_SPEED, RIGHT_MOTOR_COMPENSATION
+#include "LogRing.h"
+#include "TelemetryProtocol.h"   // telemCrc16
+#include <EEPROM.h>
+#include <string.h>
+
+static const uint8_t CAL_SWEEP_PWM[CAL_SWEEP_LEVELS] = { 70, 100, 130, 160 };
+static const uint8_t CAL_SPIN_STEPS = 2;       // 360° horario + antihorario
+static const uint8_t CAL_SQUARE_STEPS = 16;    // 2 cuadrados x (tramo + esquina) x 4
+
+// ----------------------------------------
+// Persistencia en EEPROM
+// ----------------------------------------
+void calibrationDefaults(CalibrationData& d) {
+    d.pulsesPerRevolution = DEFAULT_PULSES_PER_REVOLUTION;
+    d.wheelBaseCm = WHEEL_BASE_CM;
+    d.wheelRatio = 1.0f;
+    d.rightCompensation = RIGHT_MOTOR_COMPENSATION;
+    d.kffLeft = 0.02f;
+    d.kffRight = 0.02f;
+    d.kStaticPwm = 40.0f;
+    d.irThreshold = 150;
+}
+
+bool calibrationLoad(CalibrationData& d) {
+    const uint16_t base = CAL_EEPROM_ADDR;
+    if (EEPROM.read(base) != CAL_MAGIC0 || EEPROM.read(base + 1) != CAL_MAGIC1) return false;
+    if (EEPROM.read(base + 2) != CAL_VERSION || EEPROM.read(base + 3) != sizeof(CalibrationData)) return false;
+    uint8_t buf[sizeof(CalibrationData)];
+    for (uint8_t i = 0; i < sizeof(buf); ++i) buf[i] = EEPROM.read(base + 4 + i);
+    uint8_t head[2] = { CAL_VERSION, (uint8_t)sizeof(CalibrationData) };
+    uint16_t crc = telemCrc16(buf, sizeof(buf), telemCrc16(head, 2));
+    uint16_t stored = (uint16_t)EEPROM.read(base + 4 + sizeof(buf)) | ((uint16_t)EEPROM.read(base + 5 + sizeof(buf)) << 8);
+    if (crc != stored) return false;
+    memcpy(&d, buf, sizeof(d));
+    return true;
+}
+
+bool calibrationSave(const CalibrationData& d) {
+    const uint16_t base = CAL_EEPROM_ADDR;
+    uint8_t buf[sizeof(CalibrationData)];
+    memcpy(buf, &d, sizeof(buf));
+    uint8_t head[2] = { CAL_VERSION, (uint8_t)sizeof(CalibrationData) };
+    uint16_t crc = telemCrc16(buf, sizeof(buf), telemCrc16(head, 2));
+    EEPROM.update(base, CAL_MAGIC0);
+    EEPROM.update(base + 1, CAL_MAGIC1);
+    EEPROM.update(base + 2, head[0]);
+    EEPROM.update(base + 3, head[1]);
+    for (uint8_t i = 0; i < sizeof(buf); ++i) EEPROM.update(base + 4 + i, buf[i]);
+    EEPROM.update(base + 4 + sizeof(buf), (uint8_t)(crc & 0xFF));
+    EEPROM.update(base + 5 + sizeof(buf), (uint8_t)(crc >> 8));
+    CalibrationData check;
+    return calibrationLoad(check);
+}
+
+// ----------------------------------------
+// Máquina de estados
+// ----------------------------------------
+void Calibrator::start(const CalibrationData& current, bool gyroOk) {
+    data = current;
+    gyroAvailable = gyroOk;
+    sRR = sLL = sRL = sPR = sPL = 0.0;
+    motionSamples = 0;
+    stage = CAL_SWEEP;
+    step = 0;
+    pausing = true;           // primero una pausa: arrancar desde parado
+    measuring = false;
+    stepStartMs = millis();
+    logPrintln(F("Calibracion: barrido PWM en sitio"));
+}
+
+void Calibrator::abort() {
+    if (!isActive()) return;
+    stage = CAL_FAILED;
+    logPrintln(F("Calibracion cancelada"));
+}
+
+void Calibrator::fail(const __FlashStringHelper* why) {
+    stage = CAL_FAILED;
+    logPrint(F("Calibracion fallida: "));
+    logPrintln(why);
+}
+
+void Calibrator::beginStep(unsigned long nowMs, const EncoderSnapshot& enc, float gyro) {
+    stepStartMs = nowMs;
+    stepEnc = enc;
+    stepGyro = gyro;
+    pausing = false;
+    measuring = false;
+}
+
+void Calibrator::nextStage(unsigned long nowMs, const EncoderSnapshot& enc, float gyro) {
+    step = 0;
+    if (stage == CAL_SWEEP) {
+        if (!fitSweep()) {
+            fail(F("barrido PWM sin respuesta valida"));
+            return;
+        }
+        if (!gyroAvailable) {
+            logPrintln(F("Calibracion: sin IMU, se omiten giros y cuadrados"));
+            stage = CAL_DONE;
+            return;
+        }
+        stage = CAL_SPIN;
+        logPrintln(F("Calibracion: giros de 360 grados"));
+    } else if (stage == CAL_SPIN) {
+        stage = CAL_SQUARE;
+        logPrintln(F("Calibracion: cuadrados horario y antihorario"));
+    } else {
+        if (!fitGeometry()) logPrintln(F("Calibracion: geometria fuera de rango, se conserva la anterior"));
+        stage = CAL_DONE;
+        return;
+    }
+    beginStep(nowMs, enc, gyro);
+}
+
+CalibrationCommand Calibrator::stepCommand(unsigned long nowMs, const EncoderSnapshot& enc, float gyro, bool& finished) {
+    CalibrationCommand cmd = { CAL_OUT_STOP, 0.0f, 0.0f };
+    unsigned long elapsed = nowMs - stepStartMs;
+    finished = false;
+    float turned = fabsf(gyro - stepGyro) * (180.0f / PI);
+
+    if (stage == CAL_SWEEP) {
+        float pwm = CAL_SWEEP_PWM[step / 2];
+        float dir = (step & 1) ? -1.0f : 1.0f;
+        cmd.mode = CAL_OUT_PWM;
+        cmd.left = dir * pwm;
+        cmd.right = -dir * pwm;
+        if (!measuring && elapsed >= CAL_SWEEP_SETTLE_MS) {
+            measureEnc = enc;
+            measuring = true;
+        } else if (measuring && elapsed >= CAL_SWEEP_SETTLE_MS + CAL_SWEEP_MEASURE_MS) {
+            float dt = (enc.timestampUs - measureEnc.timestampUs) * 1e-6f;
+            sweepPps[step][0] = (dt > 0.0f) ? fabsf((float)(enc.left - measureEnc.left)) / dt : 0.0f;
+            sweepPps[step][1] = (dt > 0.0f) ? fabsf((float)(enc.right - measureEnc.right)) / dt : 0.0f;
+            finished = true;
+        }
+    } else if (stage == CAL_SPIN) {
+        // step 0 horario (rumbo baja), step 1 antihorario
+        float ccw = (step == 0) ? -1.0f : 1.0f;
+        cmd.mode = CAL_OUT_SPEED;
+        cmd.left = -ccw * CAL_TURN_MM_S;
+        cmd.right = ccw * CAL_TURN_MM_S;
+        finished = turned >= 360.0f - CAL_TURN_LEAD_DEG;
+    } else {
+        // Primer cuadrado horario, segundo antihorario; tramos en pasos pares
+        float ccw = (step < CAL_SQUARE_STEPS / 2) ? -1.0f : 1.0f;
+        cmd.mode = CAL_OUT_SPEED;
+        if ((step & 1) == 0) {
+            cmd.left = CAL_LEG_MM_S;
+            cmd.right = CAL_LEG_MM_S;
+            long dl = labs(enc.left - stepEnc.left);
+            long dr = labs(enc.right - stepEnc.right);
+            finished = (dl + dr) * 0.5f * Encoder::getCmPerPulse() >= CAL_SQUARE_SIDE_CM;
+        } else {
+            cmd.left = -ccw * CAL_TURN_MM_S;
+            cmd.right = ccw * CAL_TURN_MM_S;
+            finished = turned >= 90.0f - CAL_TURN_LEAD_DEG;
+        }
+    }
+
+    if (!finished && elapsed > CAL_SEGMENT_TIMEOUT_MS) {
+        fail(F("tramo sin terminar (timeout)"));
+        cmd.mode = CAL_OUT_STOP;
+    }
+    return cmd;
+}
+
+CalibrationCommand Calibrator::update(unsigned long nowMs, const EncoderSnapshot& enc, float gyroRad, bool gyroValid) {
+    CalibrationCommand stop = { CAL_OUT_STOP, 0.0f, 0.0f };
+    if (!isActive()) return stop;
+    if (stage != CAL_SWEEP && !gyroValid) {
+        fail(F("IMU no disponible"));
+        return stop;
+    }
+
+    if (pausing) {
+        if (nowMs - stepStartMs < CAL_PAUSE_MS) return stop;
+        // Tramo terminado y robot quieto: registrar giro real y pulsos totales
+        if (stage == CAL_SPIN || stage == CAL_SQUARE) {
+            double c = Encoder::getCmPerPulse();
+            double sR = (enc.right - stepEnc.right) * c;
+            double sL = (enc.left - stepEnc.left) * c;
+            double psi = gyroRad - stepGyro;
+            sRR += sR * sR; sLL += sL * sL; sRL += sR * sL;
+            sPR += psi * sR; sPL += psi * sL;
+            motionSamples++;
+        }
+        uint8_t steps = (stage == CAL_SWEEP) ? CAL_SWEEP_LEVELS * 2 : (stage == CAL_SPIN) ? CAL_SPIN_STEPS : CAL_SQUARE_STEPS;
+        if (step >= steps) nextStage(nowMs, enc, gyroRad);
+        else beginStep(nowMs, enc, gyroRad);
+        return stop;
+    }
+
+    bool finished = false;
+    CalibrationCommand cmd = stepCommand(nowMs, enc, gyroRad, finished);
+    if (!isActive()) return stop;
+    if (finished) {
+        pausing = true;
+        stepStartMs = nowMs;
+        step++;
+        return stop;
+    }
+    return cmd;
+}
+
+// ----------------------------------------
+// Ajustes
+// ----------------------------------------
+// PWM = kff * pps + k0 por rueda (solo niveles en los que la rueda giró)
+bool Calibrator::fitSweep() {
+    float kff[2], k0[2];
+    for (uint8_t w = 0; w < 2; ++w) {
+        double sx = 0, sy = 0, sxx = 0, sxy = 0;
+        uint8_t n = 0;
+        for (uint8_t i = 0; i < CAL_SWEEP_LEVELS * 2; ++i) {
+            double x = sweepPps[i][w];
+            if (x < CAL_MIN_PPS) continue;
+            double y = CAL_SWEEP_PWM[i / 2];
+            sx += x; sy += y; sxx += x * x; sxy += x * y;
+            n++;
+        }
+        double den = n * sxx - sx * sx;
+        if (n < 3 || den <= 0.0) return false;
+        kff[w] = (float)((n * sxy - sx * sy) / den);
+        k0[w] = (float)((sy - kff[w] * sx) / n);
+        if (kff[w] <= 0.0f) return false;
+    }
+    float kStatic = constrain((k0[0] + k0[1]) * 0.5f, 0.0f, 150.0f);
+    // Lazo abierto a DEFAULT_SPEED: PWM derecho que iguala la velocidad izquierda
+    float p0 = DEFAULT_SPEED;
+    float comp = (k0[1] + (p0 - k0[0]) * kff[1] / kff[0]) / p0;
+    if (comp < 0.5f || comp > 1.5f) return false;
+
+    data.kffLeft = kff[0];
+    data.kffRight = kff[1];
+    data.kStaticPwm = kStatic;
+    data.rightCompensation = comp;
+    return true;
+}
+
+// giro = a * sR - d * sL con a = kR / b, d = kL / b y kL + kR = 2
+bool Calibrator::fitGeometry() {
+    // u = sR, w = -sL
+    double uu = sRR, ww = sLL, uw = -sRL, up = sPR, wp = -sPL;
+    double det = uu * ww - uw * uw;
+    if (motionSamples < 4 || det <= 0.0) return false;
+    double a = (up * ww - uw * wp) / det;
+    double d = (uu * wp - uw * up) / det;
+    if (a <= 0.0 || d <= 0.0) return false;
+    float base = (float)(2.0 / (a + d));
+    float ratio = (float)(a / d);
+    if (base < 0.7f * WHEEL_BASE_CM || base > 1.4f * WHEEL_BASE_CM) return false;
+    if (ratio < 0.9f || ratio > 1.1f) return false;
+    data.wheelBaseCm = base;
+    data.wheelRatio = ratio;
+    return true;
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#ifndef CALIBRATION_H
+#define CALIBRATION_H
+
+#include <Arduino.h>
+#include "Encoder.h"
+#include "RouteStore.h"   // ROUTE_STORE_END
+
+// ========================================
+//     CALIBRACIÓN AUTOMÁTICA EN EL ROBOT
+// ========================================
+// Comando 'C'. Tres etapas, con el robot parado 0.4 s entre tramos para
+// medir sin inercia (la IMU aprovecha para seguir su sesgo):
+//
+// 1. BARRIDO PWM en sitio (lazo abierto, ruedas en sentidos opuestos) a
+//    varios niveles y en ambos sentidos: velocidad estable de cada rueda
+//    (pps) frente a PWM. Ajuste por mínimos cuadrados PWM = kff * pps + k0
+//    por rueda -> feedforward del PID y RIGHT_MOTOR_COMPENSATION (misma
+//    velocidad en ambas ruedas a DEFAULT_SPEED en lazo abierto).
+//
+// 2. GIROS de 360° en ambos sentidos (lazo cerrado), medidos con el
+//    giróscopo.
+//
+// 3. CUADRADOS tipo UMBmark (horario y antihorario, lado
+//    CAL_SQUARE_SIDE_CM): tramos rectos con el mismo número de pulsos por
+//    rueda y esquinas de 90° por giróscopo.
+//
+// Cada giro, esquina y tramo recto da una muestra (pulsos izq/der, giro
+// medido por el gyro). Con cm/pulso por rueda cL, cR y base b:
+//     giro = (nR * cR - nL * cL) / b
+// lineal en a = cR / b y d = cL / b: un único ajuste 2x2 por mínimos
+// cuadrados da la base efectiva (incluye el patinaje en giros) y la
+// relación de diámetros der/izq (la curvatura de los tramos rectos).
+// Los PPR absolutos no se pueden medir sin referencia externa: siguen
+// saliendo de la prueba 'V' (una vuelta de rueda), que también se guarda.
+//
+// Sin IMU saludable solo se hace la etapa 1. Resultados fuera de rango se
+// descartan (se conservan los anteriores).
+//
+// Calibrator no toca hardware: update() devuelve la orden de motores y el
+// sketch la aplica (igual que PathFollower).
+//
+// Los datos se guardan en EEPROM tras el almacén de rutas
+// ('C' 'A' | versión | tamaño | CalibrationData | CRC16) y se cargan en setup().
+
+#define CAL_EEPROM_ADDR ROUTE_STORE_END
+#define CAL_MAGIC0 'C'
+#define CAL_MAGIC1 'A'
+#define CAL_VERSION 1
+// Primera dirección EEPROM libre tras el bloque de calibración
+#define CAL_EEPROM_END (CAL_EEPROM_ADDR + 6 + sizeof(CalibrationData))
+
+#define CAL_SWEEP_LEVELS 4
+#define CAL_SWEEP_SETTLE_MS 700       // hasta velocidad estable
+#define CAL_SWEEP_MEASURE_MS 500      // ventana de medida
+#define CAL_MIN_PPS 200.0f            // por debajo: rueda parada (fricción)
+#define CAL_PAUSE_MS 400              // parado entre tramos
+#define CAL_TURN_MM_S 150.0f          // velocidad de rueda en giros (360° en ~13 s)
+#define CAL_LEG_MM_S 200.0f           // velocidad en tramos rectos
+#define CAL_SQUARE_SIDE_CM 100.0f
+#define CAL_TURN_LEAD_DEG 4.0f        // cortar antes por la inercia (se mide igual)
+#define CAL_SEGMENT_TIMEOUT_MS 25000
+
+// Parámetros persistentes (los aplica applyCalibration() en el sketch)
+struct CalibrationData {
+    uint16_t pulsesPerRevolution;
+    float wheelBaseCm;
+    float wheelRatio;             // diámetro der / izq
+    float rightCompensation;      // lazo abierto
+    float kffLeft;                // PWM por pps
+    float kffRight;
+    float kStaticPwm;
+    int16_t irThreshold;
+};
+
+enum CalibrationStage : uint8_t {
+    CAL_IDLE = 0,
+    CAL_SWEEP,
+    CAL_SPIN,
+    CAL_SQUARE,
+    CAL_DONE,
+    CAL_FAILED
+};
+
+enum CalibrationOutput : uint8_t {
+    CAL_OUT_STOP = 0,
+    CAL_OUT_PWM,                  // left/right = PWM directo
+    CAL_OUT_SPEED                 // left/right = mm/s en lazo cerrado
+};
+
+struct CalibrationCommand {
+    CalibrationOutput mode;
+    float left;
+    float right;
+};
+
+void calibrationDefaults(CalibrationData& d);
+bool calibrationLoad(CalibrationData& d);
+bool calibrationSave(const CalibrationData& d);
+
+class Calibrator {
+private:
+    CalibrationStage stage = CAL_IDLE;
+    uint8_t step = 0;
+    bool pausing = false;
+    bool measuring = false;
+    bool gyroAvailable = false;
+    unsigned long stepStartMs = 0;
+    EncoderSnapshot stepEnc;
+    EncoderSnapshot measureEnc;
+    float stepGyro = 0.0f;
+    CalibrationData data;
+
+    // Barrido: pps medidos por nivel y sentido
+    float sweepPps[CAL_SWEEP_LEVELS * 2][2];
+
+    // Ajuste giro = a * sR - d * sL (sR, sL en cm nominales)
+    double sRR = 0.0, sLL = 0.0, sRL = 0.0, sPR = 0.0, sPL = 0.0;
+    uint8_t motionSamples = 0;
+
+    void beginStep(unsigned long nowMs, const EncoderSnapshot& enc, float gyro);
+    void nextStage(unsigned long nowMs, const EncoderSnapshot& enc, float gyro);
+    void fail(const __FlashStringHelper* why);
+    bool fitSweep();
+    bool fitGeometry();
+    CalibrationCommand stepCommand(unsigned long nowMs, const EncoderSnapshot& enc, float gyro, bool& finished);
+
+public:
+    // Empieza desde los parámetros actuales (se conservan los no medidos)
+    void start(const CalibrationData& current, bool gyroOk);
+    void abort();
+    bool isActive() const { return stage >= CAL_SWEEP && stage <= CAL_SQUARE; }
+    CalibrationStage getStage() const { return stage; }
+
+    // Llamar a tasa fija con los contadores y el giro integrado del gyro
+    // (rad, antihorario +, continuo)
+    CalibrationCommand update(unsigned long nowMs, const EncoderSnapshot& enc, float gyroRad, bool gyroValid);
+
+    // Válido cuando getStage() == CAL_DONE
+    const CalibrationData& result() const { return data; }
+};
+
+#endif // CALIBRATION_H
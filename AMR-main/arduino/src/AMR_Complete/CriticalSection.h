@@ -0,0 +1,50 @@
+#pragma once
+
+#ifndef CRITICAL_SECTION_H
+#define CRITICAL_SECTION_H
+
+#include <Arduino.h>
+
+// Sección crítica RAII que guarda y restaura el estado de interrupciones.
+// A diferencia de noInterrupts()/interrupts(), es segura dentro de una ISR
+// (p.ej. las tareas de tiempo real del Scheduler): al salir no re-habilita
+// interrupciones que ya estaban deshabilitadas.
+//
+// Uso:
+//     { CriticalSection cs; a = sharedA; b = sharedB; }
+class CriticalSection {
+private:
+#if defined(__AVR__)
+    uint8_t savedState;
+#elif defined(__arm__)
+    uint32_t savedState;
+#endif
+
+public:
+    CriticalSection() {
+#if defined(__AVR__)
+        savedState = SREG;
+        cli();
+#elif defined(__arm__)
+        savedState = __get_PRIMASK();
+        __disable_irq();
+#else
+        noInterrupts();
+#endif
+    }
+
+    ~CriticalSection() {
+#if defined(__AVR__)
+        SREG = savedState;
+#elif defined(__arm__)
+        __set_PRIMASK(savedState);
+#else
+        interrupts();
+#endif
+    }
+
+    CriticalSection(const CriticalSection&) = delete;
+    CriticalSection& operator=(const CriticalSection&) = delete;
+};
+
+#endif // CRITICAL_SECTION_H
@@ -0,0 +1,106 @@
+#include "DriveController.h"
+#include "Odometry.h"  // WHEEL_BASE_CM
+#include "CriticalSection.h"
+
+DriveController::DriveController(MotorDriver* m, Encoder* e) {
+    motors = m;
+    encoder = e;
+}
+
+float DriveController::mmPerSecondToPps(float mmPerSec) {
+    // PPR ajustable en runtime (comando 'V'): recalcular cada vez
+    float mmPerPulse = encoder->pulsesToCentimeters(1) * 10.0f;
+    return mmPerSec / mmPerPulse;
+}
+
+void DriveController::clearExpiry() {
+    CriticalSection cs;
+    hasExpiry = false;
+    expired = false;
+}
+
+void DriveController::setWheelSpeeds(float leftMmS, float rightMmS) {
+    {
+        CriticalSection cs;
+        hasExpiry = false;
+        expired = false;
+        refreshedAtMs = millis();
+        stale = false;
+    }
+    applyWheelSpeeds(leftMmS, rightMmS);
+}
+
+void DriveController::applyWheelSpeeds(float leftMmS, float rightMmS) {
+    leftMmS = constrain(leftMmS, -DRIVE_MAX_WHEEL_MM_S, DRIVE_MAX_WHEEL_MM_S);
+    rightMmS = constrain(rightMmS, -DRIVE_MAX_WHEEL_MM_S, DRIVE_MAX_WHEEL_MM_S);
+    cmdLinearMmS = (leftMmS + rightMmS) * 0.5f;
+    cmdAngularDegS = ((rightMmS - leftMmS) / (wheelBaseCm * 10.0f)) * 180.0f / PI;
+
+    // Rueda de mayor diámetro: menos pulsos para la misma velocidad
+    float leftScale = (1.0f + wheelRatio) * 0.5f;
+    float rightScale = leftScale / wheelRatio;
+    motors->setTargetPulsesPerSecondBoth(mmPerSecondToPps(leftMmS) * leftScale, mmPerSecondToPps(rightMmS) * rightScale);
+    if (!closedLoop) {
+        closedLoop = true;
+        motors->enableVelocityControl(true);
+    }
+}
+
+void DriveController::setVelocity(float linearMmS, float angularDegS) {
+    // Cinemática diferencial: v_rueda = v -/+ w * b/2
+    float halfTrackMm = wheelBaseCm * 10.0f * 0.5f;
+    float wRad = angularDegS * PI / 180.0f;
+    setWheelSpeeds(linearMmS - wRad * halfTrackMm, linearMmS + wRad * halfTrackMm);
+}
+
+void DriveController::setVelocity(float linearMmS, float angularDegS, unsigned long expiresAt) {
+    setVelocity(linearMmS, angularDegS);
+    CriticalSection cs;
+    expiresAtMs = expiresAt;
+    hasExpiry = true;
+}
+
+void DriveController::enforceExpiry(unsigned long nowMs) {
+    if (!closedLoop || !hasExpiry || expired) return;
+    if ((long)(nowMs - expiresAtMs) < 0) return;
+    // Sin enableVelocityControl(false) (escribe en Serial): el PID sigue
+    // activo con consigna 0 hasta que loop() llame a stop() o mande otra
+    motors->zeroTargets();
+    cmdLinearMmS = 0.0f;
+    cmdAngularDegS = 0.0f;
+    expired = true;
+    expiredStops++;
+}
+
+void DriveController::enforceFreshness(unsigned long nowMs, unsigned long dtMs) {
+    if (!closedLoop || nowMs - refreshedAtMs <= DRIVE_SETPOINT_TIMEOUT_MS) return;
+    if (!stale) {
+        stale = true;
+        staleStops++;
+        cmdLinearMmS = 0.0f;
+        cmdAngularDegS = 0.0f;
+    }
+    motors->rampTargetsToZero(mmPerSecondToPps(DRIVE_STALE_DECEL_MM_S2 * dtMs * 0.001f));
+}
+
+void DriveController::stop() {
+    clearExpiry();
+    // Desactivar primero: la tarea de control no debe volver a escribir PWM
+    if (closedLoop) {
+        closedLoop = false;
+        motors->enableVelocityControl(false);
+    }
+    motors->setTargetPulsesPerSecondBoth(0.0f, 0.0f);
+    cmdLinearMmS = 0.0f;
+    cmdAngularDegS = 0.0f;
+    motors->stop();
+}
+
+void DriveController::setOpenLoop() {
+    clearExpiry();
+    if (!closedLoop) return;
+    closedLoop = false;
+    motors->enableVelocityControl(false);
+    cmdLinearMmS = 0.0f;
+    cmdAngularDegS = 0.0f;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#ifndef DRIVE_CONTROLLER_H
+#define DRIVE_CONTROLLER_H
+
+#include <Arduino.h>
+#include "MotorDriver.h"
+#include "Encoder.h"
+
+// ========================================
+//     MODO DE CONDUCCIÓN EN LAZO CERRADO
+// ========================================
+// Traduce consignas de cuerpo (v en mm/s, w en grados/s) o de rueda (mm/s)
+// a pulsos/s por rueda y las entrega al PID de velocidad de MotorDriver,
+// que corre a tasa fija en la tarea de control del Scheduler.
+//
+// Convención: w > 0 = giro antihorario (rueda derecha más rápida), igual que
+// theta en Odometry.
+//
+// Rutas, giros automáticos y seguimiento de pared mandan a través de aquí;
+// los comandos manuales (W/S/Q/E) siguen en PWM directo con setOpenLoop().
+//
+// Caducidad: una consigna puede llevar el instante (millis) en que deja de
+// valer. La comprueba enforceExpiry() desde la tarea de control (ISR), así
+// que el hombre muerto para las ruedas aunque loop() esté bloqueado (p.ej.
+// en una escritura WiFi con el enlace caído).
+//
+// Frescura: los modos automáticos refrescan la consigna en cada pasada de
+// motion (100 Hz), y con ella las paradas por obstáculo o TTC. Si pasan
+// DRIVE_SETPOINT_TIMEOUT_MS sin refresco (loop() atascado en una respuesta
+// HTTP larga), enforceFreshness() baja las ruedas a 0 con
+// DRIVE_STALE_DECEL_MM_S2; la siguiente consigna retoma el control.
+
+// Consignas por defecto de los modos automáticos
+#define DRIVE_CRUISE_MM_S 200.0f     // pasos de evasión
+#define DRIVE_ROUTE_MM_S 300.0f      // crucero de rutas (con perfil, ver MotionProfile)
+#define DRIVE_TURN_DEG_S 90.0f       // pico de los giros en sitio (con perfil)
+#define DRIVE_MAX_WHEEL_MM_S 600.0f  // límite de consigna por rueda
+
+// Límites de los perfiles en S de avances y giros automáticos
+#define DRIVE_ACCEL_MM_S2 400.0f
+#define DRIVE_JERK_MM_S3 2000.0f
+#define DRIVE_TURN_ACCEL_DEG_S2 180.0f
+#define DRIVE_TURN_JERK_DEG_S3 900.0f
+
+// Vigilancia de la consigna desde la tarea de control
+#define DRIVE_SETPOINT_TIMEOUT_MS 50UL   // 5 pasadas de motion sin refresco
+#define DRIVE_STALE_DECEL_MM_S2 800.0f   // frenada sin consigna (2x la aceleración de rutas)
+
+class DriveController {
+private:
+    MotorDriver* motors;
+    Encoder* encoder;
+    bool closedLoop = false;
+    float cmdLinearMmS = 0.0f;
+    float cmdAngularDegS = 0.0f;
+    // Caducidad de la consigna vigente (la lee la ISR de control)
+    volatile bool hasExpiry = false;
+    volatile bool expired = false;
+    unsigned long expiresAtMs = 0;
+    unsigned long expiredStops = 0;
+    // Último refresco de la consigna (millis) y frenada por falta de él
+    volatile unsigned long refreshedAtMs = 0;
+    volatile bool stale = false;
+    unsigned long staleStops = 0;
+    // Geometría calibrada (la misma que Odometry::setGeometry)
+    float wheelBaseCm = WHEEL_BASE_CM;
+    float wheelRatio = 1.0f;
+
+    float mmPerSecondToPps(float mmPerSec);
+    void applyWheelSpeeds(float leftMmS, float rightMmS);
+    void clearExpiry();
+
+public:
+    DriveController(MotorDriver* m, Encoder* e);
+
+    // Consigna de cuerpo: v (mm/s) y w (grados/s)
+    void setVelocity(float linearMmS, float angularDegS);
+    // Igual, válida hasta expiresAtMs (millis); pasado ese instante la
+    // tarea de control pone las ruedas a 0
+    void setVelocity(float linearMmS, float angularDegS, unsigned long expiresAtMs);
+    // Consigna por rueda (mm/s)
+    void setWheelSpeeds(float leftMmS, float rightMmS);
+
+    // Parada inmediata: desactiva el PID y pone PWM a 0
+    void stop();
+    // Ceder los motores a PWM directo (comandos manuales)
+    void setOpenLoop();
+
+    // Tarea de control (ISR): consigna caducada -> ruedas a 0. Sin Serial
+    void enforceExpiry(unsigned long nowMs);
+    // La ISR paró las ruedas por caducidad desde la última consigna
+    bool hasExpired() const { return expired; }
+    unsigned long getExpiredStops() const { return expiredStops; }
+    // Tarea de control (ISR): consigna sin refrescar -> frenar hasta 0. Sin Serial
+    void enforceFreshness(unsigned long nowMs, unsigned long dtMs);
+    unsigned long getStaleStops() const { return staleStops; }
+
+    // Base efectiva (cm) y relación de diámetros der/izq
+    void setGeometry(float wheelBase, float ratio) { wheelBaseCm = wheelBase; wheelRatio = ratio; }
+
+    bool isClosedLoop() { return closedLoop; }
+    float getLinearCommand() { return cmdLinearMmS; }
+    float getAngularCommand() { return cmdAngularDegS; }
+};
+
+#endif // DRIVE_CONTROLLER_H
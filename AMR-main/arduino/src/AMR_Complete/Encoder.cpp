@@ -1,13 +1,64 @@
 #include "Encoder.h"
+#include "CriticalSection.h"
+#include "Perf.h"
 
 // Inicialización de variables estáticas
 volatile long Encoder::leftPulses = 0;
 volatile long Encoder::rightPulses = 0;
 // Pulses per revolution (runtime adjustable). Start from default measured value.
 int Encoder::pulsesPerRevolution = DEFAULT_PULSES_PER_REVOLUTION;
+volatile float Encoder::cmPerPulse = WHEEL_CIRCUMFERENCE_CM / (float)DEFAULT_PULSES_PER_REVOLUTION;
+volatile uint8_t Encoder::configGeneration = 0;
 // Invert flags (default: not inverted)
 bool Encoder::leftInverted = false;
 bool Encoder::rightInverted = true;
+volatile uint8_t Encoder::leftState = 0;
+volatile uint8_t Encoder::rightState = 0;
+volatile unsigned long Encoder::leftErrors = 0;
+volatile unsigned long Encoder::rightErrors = 0;
+bool Encoder::leftQuad4x = false;
+bool Encoder::rightQuad4x = false;
+EncoderPortReg* Encoder::leftAReg = nullptr;
+EncoderPortReg* Encoder::leftBReg = nullptr;
+EncoderPortReg* Encoder::rightAReg = nullptr;
+EncoderPortReg* Encoder::rightBReg = nullptr;
+uint16_t Encoder::leftAMask = 0;
+uint16_t Encoder::leftBMask = 0;
+uint16_t Encoder::rightAMask = 0;
+uint16_t Encoder::rightBMask = 0;
+volatile unsigned long Encoder::leftEdgeUs[ENCODER_EDGE_RING_SIZE];
+volatile unsigned long Encoder::rightEdgeUs[ENCODER_EDGE_RING_SIZE];
+volatile uint8_t Encoder::leftEdgeHead = 0;
+volatile uint8_t Encoder::rightEdgeHead = 0;
+volatile int8_t Encoder::leftLastDir = 1;
+volatile int8_t Encoder::rightLastDir = 1;
+long Encoder::velLastLeft = 0;
+long Encoder::velLastRight = 0;
+unsigned long Encoder::velLastUs = 0;
+volatile float Encoder::leftPps = 0.0f;
+volatile float Encoder::rightPps = 0.0f;
+
+// Paso por transición, índice = (prev << 2) | cur con estado = (A << 1) | B.
+// Mismo sentido que la regla 2x original (flanco de B: A==B -> -1, A!=B -> +1).
+// QUAD_ERR marca las transiciones ilegales (ambos canales cambian a la vez).
+#define QUAD_ERR 2
+static const int8_t QUAD_TABLE[16] = {
+//  cur: 00        01        10        11
+         0,       +1,       -1,  QUAD_ERR,   // prev 00
+        -1,        0,  QUAD_ERR,       +1,   // prev 01
+        +1,  QUAD_ERR,        0,       -1,   // prev 10
+  QUAD_ERR,       -1,       +1,        0    // prev 11
+};
+
+#if defined(__AVR__)
+// Pines A 8/9 = PB0/PB1 -> PCINT0/PCINT1 (vector PCINT0_vect compartido).
+// Entrar en ambos decodificadores es barato: si una rueda no cambió, su
+// transición es 0 en la tabla.
+ISR(PCINT0_vect) {
+    Encoder::leftEncoderISR();
+    Encoder::rightEncoderISR();
+}
+#endif
 
 void Encoder::init() {
     // Configurar pines como entrada con pull-up interno
@@ -16,6 +67,26 @@ void Encoder::init() {
     pinMode(ENCODER_RIGHT_A_PIN, INPUT_PULLUP);
     pinMode(ENCODER_RIGHT_B_PIN, INPUT_PULLUP);
     
+    // Cachear registros de entrada y máscaras para leer A/B sin digitalRead()
+    leftAReg = (EncoderPortReg*)portInputRegister(digitalPinToPort(ENCODER_LEFT_A_PIN));
+    leftBReg = (EncoderPortReg*)portInputRegister(digitalPinToPort(ENCODER_LEFT_B_PIN));
+    rightAReg = (EncoderPortReg*)portInputRegister(digitalPinToPort(ENCODER_RIGHT_A_PIN));
+    rightBReg = (EncoderPortReg*)portInputRegister(digitalPinToPort(ENCODER_RIGHT_B_PIN));
+    leftAMask = digitalPinToBitMask(ENCODER_LEFT_A_PIN);
+    leftBMask = digitalPinToBitMask(ENCODER_LEFT_B_PIN);
+    rightAMask = digitalPinToBitMask(ENCODER_RIGHT_A_PIN);
+    rightBMask = digitalPinToBitMask(ENCODER_RIGHT_B_PIN);
+    leftState = readLeftState();
+    rightState = readRightState();
+
+    // Anillos con marcas antiguas: hasta que lleguen flancos la velocidad es 0
+    unsigned long t0 = micros() - ENCODER_STOP_TIMEOUT_US;
+    for (uint8_t i = 0; i < ENCODER_EDGE_RING_SIZE; ++i) {
+        leftEdgeUs[i] = t0;
+        rightEdgeUs[i] = t0;
+    }
+    velLastUs = micros();
+
     // Configurar interrupciones para Arduino Uno
     // Usar digitalPinToInterrupt para enlazar ISRs a los pines B configurados.
     int intLeft = digitalPinToInterrupt(ENCODER_LEFT_B_PIN);
@@ -31,6 +102,29 @@ void Encoder::init() {
         attachInterrupt(intLeft, leftEncoderISR, CHANGE);
         attachInterrupt(intRight, rightEncoderISR, CHANGE);
     }
+
+    // Canal A: con interrupción -> 4x; sin ella la rueda queda en 2x
+#if defined(__AVR__)
+    {
+        CriticalSection cs;
+        PCMSK0 |= _BV(PCINT0) | _BV(PCINT1);
+        PCIFR = _BV(PCIF0);
+        PCICR |= _BV(PCIE0);
+    }
+    leftQuad4x = true;
+    rightQuad4x = true;
+#else
+    int intLeftA = digitalPinToInterrupt(ENCODER_LEFT_A_PIN);
+    int intRightA = digitalPinToInterrupt(ENCODER_RIGHT_A_PIN);
+    if (intLeftA >= 0 && intLeft >= 0) {
+        attachInterrupt(intLeftA, leftEncoderISR, CHANGE);
+        leftQuad4x = true;
+    }
+    if (intRightA >= 0 && intRight >= 0) {
+        attachInterrupt(intRightA, rightEncoderISR, CHANGE);
+        rightQuad4x = true;
+    }
+#endif
     
     // Reset contadores
     resetBoth();
@@ -42,58 +136,144 @@ void Encoder::init() {
     Serial.print(F(" L_B:")); Serial.print(ENCODER_LEFT_B_PIN);
     Serial.print(F(" R_A:")); Serial.print(ENCODER_RIGHT_A_PIN);
     Serial.print(F(" R_B:")); Serial.println(ENCODER_RIGHT_B_PIN);
+    Serial.print(F("Quad L:")); Serial.print(leftQuad4x ? F("4x") : F("2x"));
+    Serial.print(F(" R:")); Serial.println(rightQuad4x ? F("4x") : F("2x"));
 
     // Imprimir información de calibración útil
-    float cmPerPulse = WHEEL_CIRCUMFERENCE_CM / (float)Encoder::pulsesPerRevolution;
-    Serial.print(F("cm/pulse:")); Serial.println(cmPerPulse, 6);
+    float cmPulse = getCmPerPulse();
+    Serial.print(F("cm/pulse:")); Serial.println(cmPulse, 6);
     // grados por tic cuando solo una rueda avanza (rad = cm_per_pulse / wheel_base)
-    float degPerPulseSingle = (cmPerPulse / (float)WHEEL_BASE_CM) * 180.0 / PI;
+    float degPerPulseSingle = (cmPulse / (float)WHEEL_BASE_CM) * 180.0 / PI;
     Serial.print(F("deg/pulse(single):")); Serial.println(degPerPulseSingle, 6);
     // grados por par de tics opuestos (una rueda adelante, otra atras)
-    float degPerPulsePair = (2.0 * cmPerPulse / (float)WHEEL_BASE_CM) * 180.0 / PI;
+    float degPerPulsePair = (2.0 * cmPulse / (float)WHEEL_BASE_CM) * 180.0 / PI;
     Serial.print(F("deg/pulse(pair):")); Serial.println(degPerPulsePair, 6);
 }
 
+// Lecturas/resets con CriticalSection: también se llaman desde la tarea de
+// odometría, que corre dentro de la ISR del Scheduler.
 long Encoder::readLeft() {
-    long temp;
-    noInterrupts();
-    temp = leftPulses;
-    interrupts();
-    return temp;
+    CriticalSection cs;
+    return leftPulses;
 }
 
 long Encoder::readRight() {
-    long temp;
-    noInterrupts();
-    temp = rightPulses;
-    interrupts();
-    return temp;
+    CriticalSection cs;
+    return rightPulses;
 }
 
+EncoderSnapshot Encoder::snapshot() {
+    EncoderSnapshot snap;
+    CriticalSection cs;
+    snap.left = leftPulses;
+    snap.right = rightPulses;
+    snap.timestampUs = micros();
+    return snap;
+}
+
+// El estimador de velocidad también se reinicia para que el salto del
+// contador no se interprete como movimiento.
 void Encoder::resetLeft() {
-    noInterrupts();
+    CriticalSection cs;
     leftPulses = 0;
-    interrupts();
+    velLastLeft = 0;
 }
 
 void Encoder::resetRight() {
-    noInterrupts();
+    CriticalSection cs;
     rightPulses = 0;
-    interrupts();
+    velLastRight = 0;
 }
 
 void Encoder::resetBoth() {
-    noInterrupts();
+    CriticalSection cs;
     leftPulses = 0;
     rightPulses = 0;
-    interrupts();
+    velLastLeft = 0;
+    velLastRight = 0;
+}
+
+float Encoder::edgeRate(const volatile unsigned long* ring, const volatile uint8_t& head,
+                        unsigned long nowUs) {
+    // Copia consistente sin bloquear la ISR
+    unsigned long t[ENCODER_EDGE_RING_SIZE];
+    uint8_t h;
+    do {
+        h = head;
+        for (uint8_t i = 0; i < ENCODER_EDGE_RING_SIZE; ++i) t[i] = ring[i];
+    } while (h != head);
+
+    const uint8_t mask = ENCODER_EDGE_RING_SIZE - 1;
+    unsigned long newest = t[(uint8_t)(h - 1) & mask];
+    unsigned long sinceLast = nowUs - newest;
+    if (sinceLast >= ENCODER_STOP_TIMEOUT_US) return 0.0f;
+
+    // Intervalos entre flancos recientes (dentro de la ventana)
+    uint8_t intervals = 0;
+    unsigned long span = 0;
+    for (uint8_t k = 1; k < ENCODER_EDGE_RING_SIZE; ++k) {
+        unsigned long age = newest - t[(uint8_t)(h - 1 - k) & mask];
+        if (age > ENCODER_EDGE_WINDOW_US) break;
+        span = age;
+        intervals = k;
+    }
+    if (intervals == 0 || span == 0) return 0.0f;
+
+    float periodUs = (float)span / (float)intervals;
+    // Deceleración: el siguiente flanco aún no llegó, el periodo real es mayor
+    if ((float)sinceLast > periodUs) periodUs = (float)sinceLast;
+    return 1000000.0f / periodUs;
+}
+
+void Encoder::sampleVelocity(unsigned long nowUs) {
+    long l, r;
+    int8_t dirL, dirR;
+    {
+        CriticalSection cs;
+        l = leftPulses;
+        r = rightPulses;
+        dirL = leftLastDir;
+        dirR = rightLastDir;
+    }
+    unsigned long dtUs = nowUs - velLastUs;
+    if (dtUs == 0) return;
+    long dl = l - velLastLeft;
+    long dr = r - velLastRight;
+    velLastLeft = l;
+    velLastRight = r;
+    velLastUs = nowUs;
+
+    // En modo 2x cada flanco vale 2 cuentas
+    float ppsL, ppsR;
+    if (labs(dl) >= ENCODER_EDGE_RING_SIZE) {
+        ppsL = (float)dl * 1000000.0f / (float)dtUs;
+    } else {
+        ppsL = edgeRate(leftEdgeUs, leftEdgeHead, nowUs) * (leftQuad4x ? 1.0f : 2.0f) * dirL;
+    }
+    if (labs(dr) >= ENCODER_EDGE_RING_SIZE) {
+        ppsR = (float)dr * 1000000.0f / (float)dtUs;
+    } else {
+        ppsR = edgeRate(rightEdgeUs, rightEdgeHead, nowUs) * (rightQuad4x ? 1.0f : 2.0f) * dirR;
+    }
+
+    CriticalSection cs;
+    leftPps = ppsL;
+    rightPps = ppsR;
+}
+
+float Encoder::getLeftPulsesPerSecond() {
+    CriticalSection cs;
+    return leftPps;
+}
+
+float Encoder::getRightPulsesPerSecond() {
+    CriticalSection cs;
+    return rightPps;
 }
 
 float Encoder::pulsesToCentimeters(long pulses) {
-    // Convertir pulsos a distancia en centímetros
-    // Distancia = (pulsos / pulsos_por_revolución) * circunferencia
-    float revolutions = (float)pulses / (float)Encoder::pulsesPerRevolution;
-    return revolutions * WHEEL_CIRCUMFERENCE_CM;
+    // Distancia = pulsos * (circunferencia / pulsos_por_revolución)
+    return (float)pulses * cmPerPulse;
 }
 
 float Encoder::pulsesToRevolutions(long pulses) {
@@ -103,7 +283,13 @@ float Encoder::pulsesToRevolutions(long pulses) {
 
 // Getter/Setter for runtime pulses/revolution
 int Encoder::getPulsesPerRevolution() { return pulsesPerRevolution; }
-void Encoder::setPulsesPerRevolution(int v) { if (v > 0) pulsesPerRevolution = v; }
+void Encoder::setPulsesPerRevolution(int v) {
+    if (v <= 0) return;
+    CriticalSection cs;
+    pulsesPerRevolution = v;
+    cmPerPulse = WHEEL_CIRCUMFERENCE_CM / (float)v;
+    configGeneration++;
+}
 
 float Encoder::getLeftDistanceCm() {
     return pulsesToCentimeters(readLeft());
@@ -115,26 +301,121 @@ float Encoder::getRightDistanceCm() {
 
 // Función de interrupción para encoder izquierdo
 void Encoder::leftEncoderISR() {
-    // Leer estados de ambos canales
-    bool A = digitalRead(ENCODER_LEFT_A_PIN);
-    bool B = digitalRead(ENCODER_LEFT_B_PIN);
+    unsigned long t0 = micros();   // sello del flanco y medida de la ISR
+    uint8_t cur = readLeftState();
+    uint8_t prev = leftState;
+    leftState = cur;
 
-    // Determinar dirección usando cuadratura
-    int delta = (A == B) ? -1 : 1; // default: A==B -> -1, else +1
+    int8_t delta;
+    if (leftQuad4x) {
+        delta = QUAD_TABLE[(prev << 2) | cur];
+        if (delta == 0) return;  // sin cambio (vector PCINT compartido)
+        if (delta == QUAD_ERR) { leftErrors++; return; }
+    } else {
+        // 2x: solo flancos de B; cada uno vale 2 cuentas 4x
+        delta = ((cur >> 1) == (cur & 1)) ? -2 : 2;
+    }
     if (Encoder::leftInverted) delta = -delta;
     leftPulses += delta;
+    leftLastDir = (delta > 0) ? 1 : -1;
+    leftEdgeUs[leftEdgeHead & (ENCODER_EDGE_RING_SIZE - 1)] = t0;
+    leftEdgeHead++;
+    PERF_RECORD(PERF_ENC_LEFT_ISR, micros() - t0);
 }
 
 // Función de interrupción para encoder derecho
 void Encoder::rightEncoderISR() {
-    // Leer estados de ambos canales
-    bool A = digitalRead(ENCODER_RIGHT_A_PIN);
-    bool B = digitalRead(ENCODER_RIGHT_B_PIN);
+    unsigned long t0 = micros();   // sello del flanco y medida de la ISR
+    uint8_t cur = readRightState();
+    uint8_t prev = rightState;
+    rightState = cur;
 
-    // Determinar dirección usando cuadratura
-    int delta = (A == B) ? -1 : 1;
+    int8_t delta;
+    if (rightQuad4x) {
+        delta = QUAD_TABLE[(prev << 2) | cur];
+        if (delta == 0) return;
+        if (delta == QUAD_ERR) { rightErrors++; return; }
+    } else {
+        delta = ((cur >> 1) == (cur & 1)) ? -2 : 2;
+    }
     if (Encoder::rightInverted) delta = -delta;
     rightPulses += delta;
+    rightLastDir = (delta > 0) ? 1 : -1;
+    rightEdgeUs[rightEdgeHead & (ENCODER_EDGE_RING_SIZE - 1)] = t0;
+    rightEdgeHead++;
+    PERF_RECORD(PERF_ENC_RIGHT_ISR, micros() - t0);
+}
+
+unsigned long Encoder::getLeftErrors() {
+    CriticalSection cs;
+    return leftErrors;
+}
+
+unsigned long Encoder::getRightErrors() {
+    CriticalSection cs;
+    return rightErrors;
+}
+
+void Encoder::resetErrors() {
+    CriticalSection cs;
+    leftErrors = 0;
+    rightErrors = 0;
+}
+
+// Copia del estado de las ISR mientras el banco de pruebas las llama a mano
+struct EncoderBenchCopy {
+    long leftPulses, rightPulses;
+    uint8_t leftState, rightState;
+    unsigned long leftErrors, rightErrors;
+    unsigned long leftEdgeUs[ENCODER_EDGE_RING_SIZE];
+    unsigned long rightEdgeUs[ENCODER_EDGE_RING_SIZE];
+    uint8_t leftEdgeHead, rightEdgeHead;
+    int8_t leftLastDir, rightLastDir;
+};
+static EncoderBenchCopy benchCopy;
+
+// Estado que, seguido del actual, es un paso +1 en QUAD_TABLE
+static const uint8_t QUAD_PREVIOUS[4] = { 0x2, 0x0, 0x3, 0x1 };
+
+void Encoder::benchSave() {
+    CriticalSection cs;
+    benchCopy.leftPulses = leftPulses;
+    benchCopy.rightPulses = rightPulses;
+    benchCopy.leftState = leftState;
+    benchCopy.rightState = rightState;
+    benchCopy.leftErrors = leftErrors;
+    benchCopy.rightErrors = rightErrors;
+    for (uint8_t i = 0; i < ENCODER_EDGE_RING_SIZE; ++i) {
+        benchCopy.leftEdgeUs[i] = leftEdgeUs[i];
+        benchCopy.rightEdgeUs[i] = rightEdgeUs[i];
+    }
+    benchCopy.leftEdgeHead = leftEdgeHead;
+    benchCopy.rightEdgeHead = rightEdgeHead;
+    benchCopy.leftLastDir = leftLastDir;
+    benchCopy.rightLastDir = rightLastDir;
+}
+
+void Encoder::benchPrime(bool left) {
+    if (left) leftState = QUAD_PREVIOUS[readLeftState()];
+    else rightState = QUAD_PREVIOUS[readRightState()];
+}
+
+void Encoder::benchRestore() {
+    CriticalSection cs;
+    leftPulses = benchCopy.leftPulses;
+    rightPulses = benchCopy.rightPulses;
+    leftState = benchCopy.leftState;
+    rightState = benchCopy.rightState;
+    leftErrors = benchCopy.leftErrors;
+    rightErrors = benchCopy.rightErrors;
+    for (uint8_t i = 0; i < ENCODER_EDGE_RING_SIZE; ++i) {
+        leftEdgeUs[i] = benchCopy.leftEdgeUs[i];
+        rightEdgeUs[i] = benchCopy.rightEdgeUs[i];
+    }
+    leftEdgeHead = benchCopy.leftEdgeHead;
+    rightEdgeHead = benchCopy.rightEdgeHead;
+    leftLastDir = benchCopy.leftLastDir;
+    rightLastDir = benchCopy.rightLastDir;
 }
 
 void Encoder::setLeftInverted(bool inv) { leftInverted = inv; }
@@ -8,9 +8,11 @@
 // Configuración del encoder
 // Observación: durante la inspección y la prueba "Avanzar 1 vuelta" (comando 'V') los
 // contadores mostraron un valor consistente cercano a 3418 pulsos por revolución.
-// Actualizamos el valor por defecto para reflejar esta medición. Si vuelves a
+// Esa medición era con decodificación 2x (solo flancos de B). Ahora se cuentan
+// los 4 flancos (A y B), así que el valor por defecto es el doble. Si vuelves a
 // calibrar con la prueba 'V', ajusta este número.
-#define DEFAULT_PULSES_PER_REVOLUTION 3418  // Valor por defecto (ajustado tras medición)
+#define ENCODER_MEASURED_PPR_2X 3418
+#define DEFAULT_PULSES_PER_REVOLUTION (2 * ENCODER_MEASURED_PPR_2X)  // cuentas 4x por vuelta
 #define WHEEL_DIAMETER_CM 15.50       // Diámetro de la rueda en centímetros
 #define WHEEL_CIRCUMFERENCE_CM (PI * WHEEL_DIAMETER_CM)  // Circunferencia en cm
 
@@ -26,18 +28,107 @@
 // Encoder IZQ: A = 8, B = 2
 // Encoder DER: A = 9, B = 3
 // Nota: en Arduino UNO sólo los pines 2 y 3 soportan interrupciones externas
-// (INT0/INT1). Por eso las señales B deben ir a 2 o 3.
+// (INT0/INT1). Por eso las señales B deben ir a 2 o 3. Las señales A (8/9)
+// usan la interrupción de cambio de pin PCINT0 (PB0/PB1) en AVR, o
+// attachInterrupt() donde el core lo permita (UNO R4: el pin 8 sí, el 9 no).
 #define ENCODER_LEFT_A_PIN 8         // Pin A del encoder izquierdo
 #define ENCODER_LEFT_B_PIN 2         // Pin B del encoder izquierdo (INT0)
 #define ENCODER_RIGHT_A_PIN 9        // Pin A del encoder derecho
 #define ENCODER_RIGHT_B_PIN 3        // Pin B del encoder derecho (INT1)
 
+// ========================================
+//   DECODIFICACIÓN EN CUADRATURA (4x)
+// ========================================
+// Cada ISR lee A y B directamente del registro de entrada del puerto (sin
+// digitalRead) y busca el paso en una tabla de 16 entradas indexada por
+// (estadoPrevio << 2) | estadoActual, con estado = (A << 1) | B.
+// Las transiciones ilegales (A y B cambian a la vez = flanco perdido) no
+// mueven el contador y se acumulan en un contador de errores por encoder.
+//
+// Si el pin A de una rueda no admite interrupción, esa rueda cae a modo 2x
+// (solo flancos de B) y suma ±2 por flanco para mantener las unidades en
+// cuentas 4x; ver isLeftFullQuadrature()/isRightFullQuadrature().
+
+// ========================================
+//   CAPTURA DE FLANCOS CON MARCA DE TIEMPO
+// ========================================
+// La ISR guarda micros() de los últimos ENCODER_EDGE_RING_SIZE flancos de
+// cada rueda en un anillo sin locks: escribe la entrada y después avanza la
+// cabeza; el lector copia el anillo y repite si la cabeza cambió entretanto.
+// sampleVelocity() (tarea de control) estima pulsos/s:
+// - Baja/media velocidad: periodo medio entre flancos dentro de
+//   ENCODER_EDGE_WINDOW_US (dato fresco sin esperar una ventana completa).
+//   Si desde el último flanco pasó más que ese periodo, la velocidad decae
+//   con 1/tiempo-desde-el-último-flanco; pasado ENCODER_STOP_TIMEOUT_US = 0.
+// - Alta velocidad: si en el periodo de muestreo llegaron al menos
+//   ENCODER_EDGE_RING_SIZE cuentas, se usa conteo (delta cuentas / dt), que
+//   ya tiene buena resolución y no depende del jitter de micros().
+#define ENCODER_EDGE_RING_SIZE 8          // potencia de 2
+#define ENCODER_EDGE_WINDOW_US 50000UL    // antigüedad máxima de flancos promediados
+#define ENCODER_STOP_TIMEOUT_US 100000UL  // sin flancos en este tiempo -> parado
+
+// Ambos contadores leídos en la misma sección crítica, con su instante
+struct EncoderSnapshot {
+    long left;
+    long right;
+    unsigned long timestampUs;   // micros() de la captura
+};
+
+#if defined(__AVR__)
+typedef volatile uint8_t EncoderPortReg;
+#else
+typedef volatile uint16_t EncoderPortReg;
+#endif
+
 class Encoder {
 private:
     static volatile long leftPulses;     // Contador de pulsos del encoder izquierdo
     static volatile long rightPulses;    // Contador de pulsos del encoder derecho
+    // Estado de cuadratura previo (A << 1 | B) y transiciones ilegales
+    static volatile uint8_t leftState;
+    static volatile uint8_t rightState;
+    static volatile unsigned long leftErrors;
+    static volatile unsigned long rightErrors;
+    // true = 4x (interrupción en A y B); false = 2x (solo B)
+    static bool leftQuad4x;
+    static bool rightQuad4x;
+    // Registros de entrada y máscaras cacheados en init()
+    static EncoderPortReg* leftAReg;
+    static EncoderPortReg* leftBReg;
+    static EncoderPortReg* rightAReg;
+    static EncoderPortReg* rightBReg;
+    static uint16_t leftAMask, leftBMask, rightAMask, rightBMask;
+
+    // Anillos de marcas de tiempo (escritos por la ISR)
+    static volatile unsigned long leftEdgeUs[ENCODER_EDGE_RING_SIZE];
+    static volatile unsigned long rightEdgeUs[ENCODER_EDGE_RING_SIZE];
+    static volatile uint8_t leftEdgeHead;
+    static volatile uint8_t rightEdgeHead;
+    static volatile int8_t leftLastDir;    // signo del último flanco (+1/-1)
+    static volatile int8_t rightLastDir;
+
+    // Estado del estimador (solo lo toca sampleVelocity())
+    static long velLastLeft;
+    static long velLastRight;
+    static unsigned long velLastUs;
+    static volatile float leftPps;
+    static volatile float rightPps;
+
+    static float edgeRate(const volatile unsigned long* ring, const volatile uint8_t& head,
+                          unsigned long nowUs);
+
+    static inline uint8_t readLeftState() {
+        return (uint8_t)((((*leftAReg & leftAMask) != 0) << 1) | ((*leftBReg & leftBMask) != 0));
+    }
+    static inline uint8_t readRightState() {
+        return (uint8_t)((((*rightAReg & rightAMask) != 0) << 1) | ((*rightBReg & rightBMask) != 0));
+    }
     // Pulsos por revolución (ajustable en runtime)
     static int pulsesPerRevolution;
+    // cm por pulso precalculado (evita la división en cada conversión) y
+    // contador que cambia con cada ajuste, para que Odometry refresque su caché
+    static volatile float cmPerPulse;
+    static volatile uint8_t configGeneration;
     // Flags para invertir el sentido de conteo si el encoder está cableado al revés
     static bool leftInverted;
     static bool rightInverted;
@@ -49,12 +140,21 @@ public:
     // Lectura de pulsos
     long readLeft();
     long readRight();
+    // Lectura atómica de ambos contadores (usar en lugar de readLeft()+readRight()
+    // cuando se necesitan los dos del mismo instante)
+    EncoderSnapshot snapshot();
     
     // Reset de contadores
     void resetLeft();
     void resetRight();
     void resetBoth();
     
+    // Velocidad instantánea (cuentas 4x por segundo, con signo).
+    // sampleVelocity() se llama a tasa fija desde la tarea de control.
+    void sampleVelocity(unsigned long nowUs);
+    float getLeftPulsesPerSecond();
+    float getRightPulsesPerSecond();
+    
     // Conversión de pulsos a distancia
     float pulsesToCentimeters(long pulses);
     float pulsesToRevolutions(long pulses);
@@ -63,10 +163,26 @@ public:
     float getLeftDistanceCm();
     float getRightDistanceCm();
     
-    // Funciones de interrupción estáticas
+    // Funciones de interrupción estáticas (flanco en A o B de cada rueda)
     static void leftEncoderISR();
     static void rightEncoderISR();
 
+    // Diagnóstico de cuadratura
+    static unsigned long getLeftErrors();
+    static unsigned long getRightErrors();
+    static void resetErrors();
+    static bool isLeftFullQuadrature() { return leftQuad4x; }
+    static bool isRightFullQuadrature() { return rightQuad4x; }
+
+    // Banco de pruebas (Bench.h): benchSave() guarda contadores, estados y
+    // anillos; benchPrime() deja el estado previo una cuenta por detrás del
+    // que marcan los pines, para que la siguiente llamada a la ISR recorra el
+    // camino completo de un flanco válido; benchRestore() lo devuelve todo.
+    // Solo con el robot parado (un flanco real entretanto se perdería).
+    static void benchSave();
+    static void benchPrime(bool left);
+    static void benchRestore();
+
     // Ajuste del sentido (runtime)
     static void setLeftInverted(bool inv);
     static void setRightInverted(bool inv);
@@ -77,6 +193,8 @@ public:
     static int getPulsesPerRevolution();
     static void setPulsesPerRevolution(int v);
     static float getWheelDiameter() { return WHEEL_DIAMETER_CM; }
+    static float getCmPerPulse() { return cmPerPulse; }
+    static uint8_t getConfigGeneration() { return configGeneration; }
 };
 
 #endif // ENCODER_H
\ No newline at end of file
@@ -0,0 +1,19 @@
+#include "FleetControl.h"
+
+void FleetControl::setHold(bool on) {
+    hold = on;
+}
+
+bool FleetControl::grantLease(unsigned long now, unsigned long ms) {
+    if (!leaseValid(ms)) return false;
+    leasing = ms > 0;
+    leaseStart = now;
+    leaseMs = ms;
+    return true;
+}
+
+unsigned long FleetControl::leaseRemaining(unsigned long now) const {
+    if (!leasing) return 0;
+    unsigned long elapsed = now - leaseStart;
+    return (elapsed < leaseMs) ? leaseMs - elapsed : 0;
+}
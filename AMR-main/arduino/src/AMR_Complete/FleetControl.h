@@ -0,0 +1,52 @@
+#pragma once
+
+#ifndef FLEET_CONTROL_H
+#define FLEET_CONTROL_H
+
+#include <Arduino.h>
+
+// ========================================
+//     MODO FLOTA: RETENCIÓN Y RESERVAS
+// ========================================
+// Órdenes de un coordinador central (GET /fleet) que deciden si el robot
+// puede avanzar por su ruta:
+// - Retención (hold): el coordinador para el robot donde esté, sin
+//   cancelar la ruta; al soltarla continúa desde el mismo punto.
+// - Reserva (lease): permiso de movimiento limitado en el tiempo. Mientras
+//   haya reservas en uso, el robot solo avanza si la última concedida no ha
+//   vencido; si el coordinador cae o pierde la red, el robot se queda
+//   retenido en cuanto vence. Con reserva 0 se vuelve al modo autónomo.
+//
+// FleetControl no toca hardware ni red: el sketch consulta mayMove() en la
+// ejecución de rutas y emite el estado en las tramas TELEM_MSG_FLEET_STATE.
+
+#define FLEET_LEASE_MAX_MS 10000UL     // reserva más larga aceptada
+
+class FleetControl {
+private:
+    bool hold = false;
+    bool leasing = false;              // hay reservas en uso
+    unsigned long leaseStart = 0;
+    unsigned long leaseMs = 0;
+    uint32_t commands = 0;             // órdenes aceptadas (estado de /fleet)
+
+public:
+    void setHold(bool on);
+    // Conceder una reserva de ms desde now; 0 deja de usar reservas.
+    // Devuelve false si ms supera FLEET_LEASE_MAX_MS
+    bool grantLease(unsigned long now, unsigned long ms);
+    static bool leaseValid(unsigned long ms) { return ms <= FLEET_LEASE_MAX_MS; }
+    void countCommand() { commands++; }
+
+    // El robot puede moverse: sin retención y con la reserva vigente
+    bool mayMove(unsigned long now) const { return !hold && !leaseExpired(now); }
+
+    bool isHeld() const { return hold; }
+    bool isLeasing() const { return leasing; }
+    bool leaseExpired(unsigned long now) const { return leasing && now - leaseStart >= leaseMs; }
+    // ms que le quedan a la reserva (0 vencida o sin reservas)
+    unsigned long leaseRemaining(unsigned long now) const;
+    uint32_t getCommands() const { return commands; }
+};
+
+#endif // FLEET_CONTROL_H
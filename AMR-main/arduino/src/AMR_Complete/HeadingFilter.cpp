@@ -0,0 +1,19 @@
+#include "HeadingFilter.h"
+
+void HeadingFilter::reset(float odoTheta) {
+    heading = odoTheta;
+    lastOdoTheta = odoTheta;
+}
+
+void HeadingFilter::update(float odoTheta, float gyroDelta, bool gyroValid, bool stationary) {
+    // Incremento de odometría en (-π, π]: theta de Odometry sí se envuelve
+    float odoDelta = odoTheta - lastOdoTheta;
+    if (odoDelta > PI) odoDelta -= 2 * PI;
+    else if (odoDelta < -PI) odoDelta += 2 * PI;
+    lastOdoTheta = odoTheta;
+
+    gyroUsed = gyroValid;
+    if (stationary) return;
+    if (gyroValid) heading += HEADING_GYRO_WEIGHT * gyroDelta + (1.0f - HEADING_GYRO_WEIGHT) * odoDelta;
+    else heading += odoDelta;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#ifndef HEADING_FILTER_H
+#define HEADING_FILTER_H
+
+#include <Arduino.h>
+
+// ========================================
+//     FILTRO COMPLEMENTARIO DE RUMBO
+// ========================================
+// Fusiona, a tasa fija, el giro integrado del giróscopo (IMU::takeYawDelta)
+// con el incremento de theta de Odometry en el mismo periodo:
+//     rumbo += k * dGyro + (1 - k) * dOdo
+// El giróscopo no sufre el patinaje de ruedas de los giros en sitio y
+// domina (k cercano a 1); la parte de odometría amortigua el error de
+// escala del giróscopo. Con ruedas paradas el rumbo se congela (el gyro
+// solo mide sesgo, que la IMU aprende en ese momento).
+// Sin IMU saludable el filtro sigue solo a la odometría.
+//
+// El rumbo es continuo (no se envuelve a ±180°): los giros automáticos
+// restan rumbos sin preocuparse por el salto de -180 a 180.
+
+#define HEADING_GYRO_WEIGHT 0.98f
+
+class HeadingFilter {
+private:
+    float heading = 0.0f;           // rad, continuo, antihorario positivo
+    float lastOdoTheta = 0.0f;
+    bool gyroUsed = false;
+
+public:
+    // Alinear con la orientación de Odometry (tras init/reset de posición)
+    void reset(float odoTheta);
+
+    // Un paso: theta actual de Odometry, giro del gyro en el periodo,
+    // si el gyro es válido y si las ruedas están paradas
+    void update(float odoTheta, float gyroDelta, bool gyroValid, bool stationary);
+
+    float getHeading() { return heading; }
+    float getHeadingDegrees() { return heading * (180.0f / PI); }
+    bool isGyroAided() { return gyroUsed; }
+};
+
+#endif // HEADING_FILTER_H
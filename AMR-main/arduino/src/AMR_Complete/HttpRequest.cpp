@@ -0,0 +1,224 @@
+#include "HttpRequest.h"
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+
+void HttpRequest::reset() {
+    lineLen = 0;
+    headerLen = 0;
+    headerBytes = 0;
+    bodyLen = 0;
+    contentLength = 0;
+    body[0] = '\0';
+    etagView[0] = '\0';
+    state = HTTP_PARSE_REQUEST_LINE;
+    status = 0;
+    httpMethod = HTTP_OTHER;
+    pathView = "";
+    paramCount = 0;
+}
+
+void HttpRequest::fail(int code) {
+    state = HTTP_PARSE_ERROR;
+    status = code;
+}
+
+HttpParseState HttpRequest::feed(Stream& in) {
+    uint16_t budget = HTTP_FEED_BUDGET;
+    while (budget-- > 0 && state < HTTP_PARSE_DONE && in.available() > 0) {
+        int r = in.read();
+        if (r < 0) break;
+        char c = (char)r;
+
+        switch (state) {
+            case HTTP_PARSE_REQUEST_LINE:
+                if (c == '\r') break;
+                if (c == '\n') {
+                    if (lineLen == 0) break;  // líneas vacías previas: ignorar
+                    line[lineLen] = '\0';
+                    if (parseRequestLine()) state = HTTP_PARSE_HEADERS;
+                    else fail(400);
+                } else if (lineLen >= HTTP_MAX_REQUEST_LINE - 1) {
+                    fail(414);
+                } else {
+                    line[lineLen++] = c;
+                }
+                break;
+
+            case HTTP_PARSE_HEADERS:
+                if (++headerBytes > HTTP_MAX_HEADER_BYTES) { fail(431); break; }
+                if (c == '\r') break;
+                if (c == '\n') {
+                    if (headerLen == 0) {
+                        // Fin de cabeceras
+                        if (contentLength > HTTP_MAX_BODY) fail(413);
+                        else if (contentLength > 0) state = HTTP_PARSE_BODY;
+                        else state = HTTP_PARSE_DONE;
+                    } else {
+                        header[headerLen] = '\0';
+                        parseHeaderLine();
+                        headerLen = 0;
+                    }
+                } else if (headerLen < HTTP_MAX_HEADER_LINE - 1) {
+                    header[headerLen++] = c;  // lo que exceda se descarta
+                }
+                break;
+
+            case HTTP_PARSE_BODY:
+                body[bodyLen++] = c;
+                if (bodyLen >= contentLength) {
+                    body[bodyLen] = '\0';
+                    state = HTTP_PARSE_DONE;
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+    return state;
+}
+
+bool HttpRequest::parseRequestLine() {
+    // MÉTODO SP destino SP versión
+    char* sp1 = strchr(line, ' ');
+    if (!sp1) return false;
+    *sp1 = '\0';
+    char* target = sp1 + 1;
+    char* sp2 = strchr(target, ' ');
+    if (!sp2) return false;
+    *sp2 = '\0';
+    if (strncmp(sp2 + 1, "HTTP/", 5) != 0) return false;
+    if (target[0] != '/') return false;
+
+    if (strcmp(line, "GET") == 0) httpMethod = HTTP_GET;
+    else if (strcmp(line, "POST") == 0) httpMethod = HTTP_POST;
+    else httpMethod = HTTP_OTHER;
+
+    char* q = strchr(target, '?');
+    if (q) {
+        *q = '\0';
+        parseQuery(q + 1);
+    }
+    urlDecode(target);
+    pathView = target;
+    return true;
+}
+
+void HttpRequest::parseQuery(char* q) {
+    while (*q && paramCount < HTTP_MAX_PARAMS) {
+        char* amp = strchr(q, '&');
+        if (amp) *amp = '\0';
+        char* eq = strchr(q, '=');
+        const char* value = "";
+        if (eq) {
+            *eq = '\0';
+            value = eq + 1;
+        }
+        urlDecode(q);
+        urlDecode((char*)value);
+        if (*q) {
+            params[paramCount].key = q;
+            params[paramCount].value = value;
+            paramCount++;
+        }
+        if (!amp) break;
+        q = amp + 1;
+    }
+}
+
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+void HttpRequest::urlDecode(char* s) {
+    char* out = s;
+    while (*s) {
+        if (*s == '+') {
+            *out++ = ' ';
+            s++;
+        } else if (*s == '%' && hexValue(s[1]) >= 0 && hexValue(s[2]) >= 0) {
+            *out++ = (char)((hexValue(s[1]) << 4) | hexValue(s[2]));
+            s += 3;
+        } else {
+            *out++ = *s++;
+        }
+    }
+    *out = '\0';
+}
+
+// Longitud del nombre si la cabecera empieza por name (en minúsculas, con
+// ':'), sin distinguir mayúsculas; 0 si no
+static uint8_t headerNameLength(const char* header, uint8_t len, const char* name) {
+    uint8_t n = strlen(name);
+    if (len < n) return 0;
+    for (uint8_t i = 0; i < n; ++i) {
+        char c = header[i];
+        if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+        if (c != name[i]) return 0;
+    }
+    return n;
+}
+
+void HttpRequest::parseHeaderLine() {
+    // Solo interesan Content-Length e If-None-Match (caché de páginas)
+    uint8_t n = headerNameLength(header, headerLen, "content-length:");
+    if (n) {
+        unsigned long v = strtoul(header + n, nullptr, 10);
+        contentLength = (v > 0xFFFF) ? 0xFFFF : (uint16_t)v;
+        return;
+    }
+    n = headerNameLength(header, headerLen, "if-none-match:");
+    if (n) {
+        const char* v = header + n;
+        while (*v == ' ') v++;
+        strncpy(etagView, v, HTTP_MAX_ETAG);
+        etagView[HTTP_MAX_ETAG] = '\0';
+    }
+}
+
+const char* HttpRequest::param(const char* key) {
+    for (uint8_t i = 0; i < paramCount; ++i) {
+        if (strcmp(params[i].key, key) == 0) return params[i].value;
+    }
+    return nullptr;
+}
+
+long HttpRequest::paramLong(const char* key, long defaultValue) {
+    const char* v = param(key);
+    if (!v || !*v) return defaultValue;
+    return strtol(v, nullptr, 10);
+}
+
+bool HttpRequest::paramLongStrict(const char* key, long& out) {
+    const char* v = param(key);
+    if (!v) return false;
+    const char* digits = (*v == '-') ? v + 1 : v;
+    if (*digits < '0' || *digits > '9') return false;   // vacío, "+1", " 1", "nan"...
+    char* end = nullptr;
+    errno = 0;
+    long n = strtol(v, &end, 10);
+    if (*end != '\0' || errno == ERANGE) return false;
+    out = n;
+    return true;
+}
+
+const __FlashStringHelper* httpStatusText(int code) {
+    switch (code) {
+        case 200: return F("OK");
+        case 304: return F("Not Modified");
+        case 400: return F("Bad Request");
+        case 404: return F("Not Found");
+        case 405: return F("Method Not Allowed");
+        case 408: return F("Request Timeout");
+        case 409: return F("Conflict");
+        case 413: return F("Payload Too Large");
+        case 414: return F("URI Too Long");
+        case 431: return F("Request Header Fields Too Large");
+        case 503: return F("Service Unavailable");
+        default:  return F("Error");
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#ifndef HTTP_REQUEST_H
+#define HTTP_REQUEST_H
+
+#include <Arduino.h>
+
+// ========================================
+//   PARSER HTTP INCREMENTAL SIN MEMORIA DINÁMICA
+// ========================================
+// feed() consume solo los bytes ya disponibles en el cliente (nunca espera
+// al timeout del Stream) y avanza una máquina de estados:
+//   línea de petición -> cabeceras -> cuerpo (Content-Length) -> completo
+// Todo vive en buffers fijos. La ruta y la query se parten in situ: path()
+// y param() devuelven vistas (char*) dentro del propio buffer, ya
+// decodificadas (%XX y '+').
+//
+// Errores (errorStatus()):
+//   400 petición mal formada       414 línea de petición demasiado larga
+//   413 cuerpo demasiado grande    431 cabeceras demasiado grandes
+// El timeout (408) lo decide quien llama, con el tiempo desde reset().
+
+#define HTTP_MAX_REQUEST_LINE 128   // "GET /ruta?query HTTP/1.1"
+#define HTTP_MAX_HEADER_LINE 48     // solo se interpretan prefijos cortos
+#define HTTP_MAX_HEADER_BYTES 2048  // total de cabeceras aceptado
+#define HTTP_MAX_BODY 256
+#define HTTP_MAX_ETAG 24            // If-None-Match (ETag de WebAssets.h: 18)
+#define HTTP_MAX_PARAMS 8
+#define HTTP_FEED_BUDGET 256        // bytes máximos procesados por llamada a feed()
+
+enum HttpMethod {
+    HTTP_GET = 0,
+    HTTP_POST,
+    HTTP_OTHER
+};
+
+enum HttpParseState {
+    HTTP_PARSE_REQUEST_LINE = 0,
+    HTTP_PARSE_HEADERS,
+    HTTP_PARSE_BODY,
+    HTTP_PARSE_DONE,
+    HTTP_PARSE_ERROR
+};
+
+struct HttpParam {
+    const char* key;
+    const char* value;
+};
+
+class HttpRequest {
+private:
+    char line[HTTP_MAX_REQUEST_LINE];
+    uint8_t lineLen;
+    char header[HTTP_MAX_HEADER_LINE];
+    uint8_t headerLen;
+    uint16_t headerBytes;
+    char body[HTTP_MAX_BODY + 1];
+    uint16_t bodyLen;
+    uint16_t contentLength;
+    char etagView[HTTP_MAX_ETAG + 1];
+
+    HttpParseState state;
+    int status;               // código de error cuando state == HTTP_PARSE_ERROR
+    HttpMethod httpMethod;
+    const char* pathView;
+    HttpParam params[HTTP_MAX_PARAMS];
+    uint8_t paramCount;
+
+    void fail(int code);
+    bool parseRequestLine();
+    void parseHeaderLine();
+    void parseQuery(char* q);
+    static void urlDecode(char* s);
+
+public:
+    HttpRequest() { reset(); }
+
+    void reset();
+    HttpParseState feed(Stream& in);
+
+    HttpParseState parseState() { return state; }
+    bool isComplete() { return state == HTTP_PARSE_DONE; }
+    bool isError() { return state == HTTP_PARSE_ERROR; }
+    int errorStatus() { return status; }
+
+    HttpMethod method() { return httpMethod; }
+    const char* path() { return pathView; }
+
+    // Parámetros de la query (nullptr si no existe)
+    uint8_t paramCountValue() { return paramCount; }
+    const HttpParam& paramAt(uint8_t i) { return params[i]; }
+    const char* param(const char* key);
+    long paramLong(const char* key, long defaultValue);
+    // Entero estricto: dígitos (con '-' opcional) hasta el final del valor.
+    // false si falta, está vacío, lleva otros caracteres o desborda
+    bool paramLongStrict(const char* key, long& out);
+
+    // Valor de If-None-Match ("" si no vino)
+    const char* ifNoneMatch() { return etagView; }
+
+    // Cuerpo (terminado en '\0')
+    const char* bodyData() { return body; }
+    uint16_t bodyLength() { return bodyLen; }
+};
+
+// Texto de estado para los códigos que usa el servidor
+const __FlashStringHelper* httpStatusText(int code);
+
+#endif // HTTP_REQUEST_H
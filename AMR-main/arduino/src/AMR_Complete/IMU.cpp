@@ -0,0 +1,159 @@
+#include "IMU.h"
+
+// Registros del MPU-6050
+#define MPU_SMPLRT_DIV   0x19
+#define MPU_CONFIG       0x1A
+#define MPU_GYRO_CONFIG  0x1B
+#define MPU_ACCEL_CONFIG 0x1C
+#define MPU_FIFO_EN      0x23
+#define MPU_INT_STATUS   0x3A
+#define MPU_USER_CTRL    0x6A
+#define MPU_PWR_MGMT_1   0x6B
+#define MPU_FIFO_COUNTH  0x72
+#define MPU_FIFO_R_W     0x74
+#define MPU_WHO_AM_I     0x75
+
+#define MPU_FIFO_ACCEL_GYRO 0x78    // XG | YG | ZG | ACCEL
+#define MPU_USER_FIFO_EN    0x40
+#define MPU_USER_FIFO_RESET 0x04
+#define MPU_INT_FIFO_OFLOW  0x10
+#define MPU_FIFO_SIZE       1024
+
+// Escalas: giróscopo ±500 °/s, acelerómetro ±2 g
+static const float GYRO_LSB_PER_DPS = 65.5f;
+static const float ACCEL_LSB_PER_G = 16384.0f;
+static const float GYRO_RAD_PER_LSB = (PI / 180.0f) / GYRO_LSB_PER_DPS;
+static const float SAMPLE_DT_S = 1.0f / (float)IMU_SAMPLE_RATE_HZ;
+
+bool IMU::writeRegister(uint8_t reg, uint8_t value) {
+    IMU_WIRE.beginTransmission(IMU_I2C_ADDRESS);
+    IMU_WIRE.write(reg);
+    IMU_WIRE.write(value);
+    return IMU_WIRE.endTransmission() == 0;
+}
+
+bool IMU::readRegisters(uint8_t reg, uint8_t* out, uint8_t n) {
+    IMU_WIRE.beginTransmission(IMU_I2C_ADDRESS);
+    IMU_WIRE.write(reg);
+    if (IMU_WIRE.endTransmission(false) != 0) return false;
+    if (IMU_WIRE.requestFrom((uint8_t)IMU_I2C_ADDRESS, n) != n) return false;
+    for (uint8_t i = 0; i < n; ++i) out[i] = (uint8_t)IMU_WIRE.read();
+    return true;
+}
+
+uint16_t IMU::fifoCount() {
+    uint8_t b[2];
+    if (!readRegisters(MPU_FIFO_COUNTH, b, 2)) return 0;
+    return ((uint16_t)b[0] << 8) | b[1];
+}
+
+void IMU::resetFifo() {
+    writeRegister(MPU_USER_CTRL, MPU_USER_FIFO_RESET);
+    writeRegister(MPU_USER_CTRL, MPU_USER_FIFO_EN);
+}
+
+void IMU::consumeSample(const uint8_t* p) {
+    for (uint8_t i = 0; i < 6; ++i) raw[i] = (int16_t)(((uint16_t)p[2 * i] << 8) | p[2 * i + 1]);
+
+    if (stationary) {
+        for (uint8_t i = 0; i < 3; ++i) gyroBias[i] += IMU_BIAS_ALPHA * ((float)raw[3 + i] - gyroBias[i]);
+    }
+    yawDeltaRad += IMU_YAW_SIGN * ((float)raw[5] - gyroBias[2]) * GYRO_RAD_PER_LSB * SAMPLE_DT_S;
+    samples++;
+}
+
+void IMU::init() {
+#if IMU_ENABLED
+    IMU_WIRE.begin();
+    IMU_WIRE.setClock(400000);
+
+    uint8_t who = 0;
+    if (!readRegisters(MPU_WHO_AM_I, &who, 1) || who != IMU_I2C_ADDRESS) {
+        Serial.println(F("IMU: no detectada (giros por encoders)"));
+        present = false;
+        return;
+    }
+
+    writeRegister(MPU_PWR_MGMT_1, 0x01);   // despertar, reloj PLL del giro X
+    delay(10);
+    writeRegister(MPU_CONFIG, 0x03);       // DLPF ~44 Hz, base 1 kHz
+    writeRegister(MPU_SMPLRT_DIV, (uint8_t)(1000 / IMU_SAMPLE_RATE_HZ - 1));
+    writeRegister(MPU_GYRO_CONFIG, 0x08);  // ±500 °/s
+    writeRegister(MPU_ACCEL_CONFIG, 0x00); // ±2 g
+    writeRegister(MPU_FIFO_EN, MPU_FIFO_ACCEL_GYRO);
+    resetFifo();
+    present = true;
+
+    // Sesgo inicial: promedio de IMU_CALIBRATION_SAMPLES con el robot quieto
+    for (uint8_t i = 0; i < 3; ++i) gyroBias[i] = 0.0f;
+    float sum[3] = { 0.0f, 0.0f, 0.0f };
+    unsigned long n = 0;
+    unsigned long t0 = millis();
+    while (n < IMU_CALIBRATION_SAMPLES && millis() - t0 < 2000) {
+        unsigned long before = samples;
+        service();
+        if (samples == before) {
+            delay(2);
+            continue;
+        }
+        for (uint8_t i = 0; i < 3; ++i) sum[i] += raw[3 + i];
+        n += samples - before;
+    }
+    if (n > 0) {
+        for (uint8_t i = 0; i < 3; ++i) gyroBias[i] = sum[i] / (float)n;
+    }
+    yawDeltaRad = 0.0f;
+
+    Serial.print(F("IMU OK MPU-6050 "));
+    Serial.print(IMU_SAMPLE_RATE_HZ);
+    Serial.print(F(" Hz bias Z:"));
+    Serial.println(gyroBias[2] / GYRO_LSB_PER_DPS, 3);
+#else
+    present = false;
+    Serial.println(F("IMU: desactivada (A4/A5 ocupados por IR)"));
+#endif
+}
+
+uint8_t IMU::service() {
+    if (!present) return 0;
+
+    uint8_t status = 0;
+    readRegisters(MPU_INT_STATUS, &status, 1);
+    uint16_t count = fifoCount();
+    if ((status & MPU_INT_FIFO_OFLOW) || count >= MPU_FIFO_SIZE) {
+        // La FIFO desbordó: los datos están desalineados, empezar de nuevo
+        overflows++;
+        resetFifo();
+        return 0;
+    }
+
+    uint8_t pending = count / IMU_SAMPLE_BYTES;
+    if (pending > IMU_MAX_SAMPLES_PER_SERVICE) pending = IMU_MAX_SAMPLES_PER_SERVICE;
+
+    uint8_t done = 0;
+    uint8_t burst[IMU_BURST_SAMPLES * IMU_SAMPLE_BYTES];
+    while (done < pending) {
+        uint8_t chunk = pending - done;
+        if (chunk > IMU_BURST_SAMPLES) chunk = IMU_BURST_SAMPLES;
+        if (!readRegisters(MPU_FIFO_R_W, burst, chunk * IMU_SAMPLE_BYTES)) break;
+        for (uint8_t i = 0; i < chunk; ++i) consumeSample(burst + i * IMU_SAMPLE_BYTES);
+        done += chunk;
+    }
+    if (done > 0) lastSampleMs = millis();
+    return done;
+}
+
+void IMU::read(float& ax, float& ay, float& az, float& gx, float& gy, float& gz) {
+    ax = raw[0] / ACCEL_LSB_PER_G;
+    ay = raw[1] / ACCEL_LSB_PER_G;
+    az = raw[2] / ACCEL_LSB_PER_G;
+    gx = ((float)raw[3] - gyroBias[0]) * GYRO_RAD_PER_LSB;
+    gy = ((float)raw[4] - gyroBias[1]) * GYRO_RAD_PER_LSB;
+    gz = ((float)raw[5] - gyroBias[2]) * GYRO_RAD_PER_LSB;
+}
+
+float IMU::takeYawDelta() {
+    float d = yawDeltaRad;
+    yawDeltaRad = 0.0f;
+    return d;
+}
@@ -1,7 +1,102 @@
 #pragma once
 
+#ifndef IMU_H
+#define IMU_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+// ========================================
+//        IMU MPU-6050 (FIFO POR I2C)
+// ========================================
+// El MPU-6050 muestrea acelerómetro + giróscopo a IMU_SAMPLE_RATE_HZ y deja
+// cada muestra (12 bytes) en su FIFO. service() lee el contador y vacía la
+// FIFO en ráfagas de varias muestras por transacción I2C, en lugar de leer
+// registros sueltos en cada ciclo.
+//
+// Bus I2C:
+// - UNO R4 WiFi: Wire1 (conector Qwiic). Los pines SDA/SCL de la cabecera
+//   comparten A4/A5 con los sensores IR frontal izq./lateral izq.
+// - AVR (Uno): SDA/SCL SON A4/A5, ocupados por los IR: IMU desactivada por
+//   defecto (definir IMU_ENABLED 1 si se reasignan los IR).
+//
+// Sesgo del giróscopo: se promedia en init() con el robot quieto y después
+// se sigue ajustando mientras setStationary(true) (ruedas paradas).
+//
+// service() usa Wire (interrupciones): llamarlo desde tareas de loop, nunca
+// desde la ISR del Scheduler.
+
+#ifndef IMU_ENABLED
+#if defined(__AVR__)
+#define IMU_ENABLED 0
+#else
+#define IMU_ENABLED 1
+#endif
+#endif
+
+#if defined(ARDUINO_UNOR4_WIFI)
+#define IMU_WIRE Wire1
+#else
+#define IMU_WIRE Wire
+#endif
+
+#define IMU_I2C_ADDRESS 0x68
+#define IMU_SAMPLE_RATE_HZ 200          // 1 kHz (DLPF activo) / (1 + SMPLRT_DIV)
+#define IMU_SAMPLE_BYTES 12             // ax ay az gx gy gz (int16 big-endian)
+#if defined(__AVR__)
+#define IMU_BURST_SAMPLES 2             // buffer de Wire de 32 bytes
+#else
+#define IMU_BURST_SAMPLES 8
+#endif
+#define IMU_MAX_SAMPLES_PER_SERVICE 16  // acota el tiempo de una llamada
+#define IMU_CALIBRATION_SAMPLES 100     // 0.5 s quieto en init()
+#define IMU_BIAS_ALPHA 0.002f           // seguimiento del sesgo en reposo (por muestra)
+#define IMU_STALE_MS 50                 // sin muestras en este tiempo -> no saludable
+
+// Signo del eje Z respecto a theta de Odometry (antihorario positivo).
+// +1 con el chip montado con la cara de componentes hacia arriba.
+#ifndef IMU_YAW_SIGN
+#define IMU_YAW_SIGN 1
+#endif
+
 class IMU {
+private:
+    bool present = false;
+    bool stationary = false;
+    int16_t raw[6] = { 0 };       // última muestra (ax ay az gx gy gz)
+    float gyroBias[3] = { 0 };    // cuentas
+    float yawDeltaRad = 0.0f;   // giro Z integrado desde takeYawDelta()
+    unsigned long lastSampleMs = 0;
+    unsigned long samples = 0;
+    unsigned long overflows = 0;
+
+    bool writeRegister(uint8_t reg, uint8_t value);
+    bool readRegisters(uint8_t reg, uint8_t* out, uint8_t n);
+    uint16_t fifoCount();
+    void resetFifo();
+    void consumeSample(const uint8_t* p);
+
 public:
+    // Configura el sensor y calibra el sesgo (bloquea ~0.5 s; robot quieto)
     void init();
+
+    // Vacía la FIFO. Devuelve el número de muestras procesadas.
+    uint8_t service();
+
+    // Última muestra escalada: aceleración en g, velocidad angular en rad/s
     void read(float& ax, float& ay, float& az, float& gx, float& gy, float& gz);
-};
\ No newline at end of file
+
+    // Giro acumulado en Z (rad, antihorario positivo, sin sesgo) desde la
+    // llamada anterior; lo consume el filtro de rumbo.
+    float takeYawDelta();
+
+    // Con el robot parado el giróscopo solo mide sesgo: seguirlo
+    void setStationary(bool s) { stationary = s; }
+
+    bool isPresent() { return present; }
+    bool isHealthy() { return present && millis() - lastSampleMs < IMU_STALE_MS; }
+    unsigned long getSampleCount() { return samples; }
+    unsigned long getOverflowCount() { return overflows; }
+};
+
+#endif // IMU_H
@@ -0,0 +1,123 @@
+#include "IRCurve.h"
+#include "TelemetryProtocol.h"   // telemCrc16
+#include <EEPROM.h>
+#include <string.h>
+#include <math.h>
+
+// ----------------------------------------
+// Persistencia en EEPROM
+// ----------------------------------------
+void irCurveDefaults(IRCurveData& d) {
+    for (uint8_t ch = 0; ch < IR_CHANNEL_COUNT; ++ch) {
+        d.scale[ch] = IR_FACTORY_SCALE;
+        d.exponent[ch] = IR_FACTORY_EXPONENT;
+    }
+    d.fittedMask = 0;
+    d.useSensor = 0;
+}
+
+bool irCurveLoad(IRCurveData& d) {
+    const uint16_t base = IR_CURVE_EEPROM_ADDR;
+    if (EEPROM.read(base) != IR_CURVE_MAGIC0 || EEPROM.read(base + 1) != IR_CURVE_MAGIC1) return false;
+    if (EEPROM.read(base + 2) != IR_CURVE_VERSION || EEPROM.read(base + 3) != sizeof(IRCurveData)) return false;
+    uint8_t buf[sizeof(IRCurveData)];
+    for (uint8_t i = 0; i < sizeof(buf); ++i) buf[i] = EEPROM.read(base + 4 + i);
+    uint8_t head[2] = { IR_CURVE_VERSION, (uint8_t)sizeof(IRCurveData) };
+    uint16_t crc = telemCrc16(buf, sizeof(buf), telemCrc16(head, 2));
+    uint16_t stored = (uint16_t)EEPROM.read(base + 4 + sizeof(buf)) | ((uint16_t)EEPROM.read(base + 5 + sizeof(buf)) << 8);
+    if (crc != stored) return false;
+    memcpy(&d, buf, sizeof(d));
+    return true;
+}
+
+bool irCurveSave(const IRCurveData& d) {
+    const uint16_t base = IR_CURVE_EEPROM_ADDR;
+    uint8_t buf[sizeof(IRCurveData)];
+    memcpy(buf, &d, sizeof(buf));
+    uint8_t head[2] = { IR_CURVE_VERSION, (uint8_t)sizeof(IRCurveData) };
+    uint16_t crc = telemCrc16(buf, sizeof(buf), telemCrc16(head, 2));
+    EEPROM.update(base, IR_CURVE_MAGIC0);
+    EEPROM.update(base + 1, IR_CURVE_MAGIC1);
+    EEPROM.update(base + 2, head[0]);
+    EEPROM.update(base + 3, head[1]);
+    for (uint8_t i = 0; i < sizeof(buf); ++i) EEPROM.update(base + 4 + i, buf[i]);
+    EEPROM.update(base + 4 + sizeof(buf), (uint8_t)(crc & 0xFF));
+    EEPROM.update(base + 5 + sizeof(buf), (uint8_t)(crc >> 8));
+    IRCurveData check;
+    return irCurveLoad(check);
+}
+
+void irCurveApply(const IRCurveData& d) {
+    for (uint8_t ch = 0; ch < IR_CHANNEL_COUNT; ++ch) {
+        if (d.useSensor && (d.fittedMask & (1u << ch))) IRScanner::setCurve(ch, d.scale[ch], d.exponent[ch]);
+        else IRScanner::setCurve(ch, IR_FACTORY_SCALE, IR_FACTORY_EXPONENT);
+    }
+}
+
+// ----------------------------------------
+// Captura y ajuste
+// ----------------------------------------
+bool IRCurveCalibrator::addPoint(uint8_t channel, int raw, float cm) {
+    if (channel >= IR_CHANNEL_COUNT || counts[channel] >= IR_CAL_MAX_POINTS) return false;
+    if (raw < IR_CAL_MIN_RAW || raw > 1023) return false;
+    if (!(cm >= IR_CAL_MIN_CM && cm <= IR_CAL_MAX_CM)) return false;
+    IRCalPoint& p = points[channel][counts[channel]++];
+    p.raw = (uint16_t)raw;
+    p.mm = (uint16_t)lroundf(cm * 10.0f);
+    return true;
+}
+
+void IRCurveCalibrator::clear() {
+    for (uint8_t ch = 0; ch < IR_CHANNEL_COUNT; ++ch) {
+        counts[ch] = 0;
+        rmsPct[ch] = 0.0f;
+    }
+}
+
+bool IRCurveCalibrator::fitChannel(uint8_t ch, float& scale, float& exponent) {
+    uint8_t n = counts[ch];
+    if (n < IR_CAL_MIN_POINTS) return false;
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    uint16_t rawMin = 1023, rawMax = 0;
+    for (uint8_t i = 0; i < n; ++i) {
+        const IRCalPoint& p = points[ch][i];
+        double x = log((double)p.raw);
+        double y = log((double)p.mm * 0.1);
+        sx += x; sy += y; sxx += x * x; sxy += x * y;
+        if (p.raw < rawMin) rawMin = p.raw;
+        if (p.raw > rawMax) rawMax = p.raw;
+    }
+    // Sin recorrido de ADC la pendiente no está determinada
+    if ((float)rawMax < IR_CAL_MIN_RAW_RATIO * (float)rawMin) return false;
+    double den = n * sxx - sx * sx;
+    if (den <= 0.0) return false;
+    double b = (n * sxy - sx * sy) / den;
+    double a = exp((sy - b * sx) / n);
+    if (b < IR_CAL_EXPONENT_MIN || b > IR_CAL_EXPONENT_MAX || !(a > 0.0) || isinf(a)) return false;
+
+    double se = 0.0;
+    for (uint8_t i = 0; i < n; ++i) {
+        const IRCalPoint& p = points[ch][i];
+        double d = (double)p.mm * 0.1;
+        double e = (a * pow((double)p.raw, b) - d) / d;
+        se += e * e;
+    }
+    rmsPct[ch] = (float)(100.0 * sqrt(se / n));
+    if (rmsPct[ch] > IR_CAL_MAX_RMS_PCT) return false;
+    scale = (float)a;
+    exponent = (float)b;
+    return true;
+}
+
+uint8_t IRCurveCalibrator::fit(IRCurveData& d) {
+    uint8_t mask = 0;
+    for (uint8_t ch = 0; ch < IR_CHANNEL_COUNT; ++ch) {
+        float a, b;
+        if (!fitChannel(ch, a, b)) continue;
+        d.scale[ch] = a;
+        d.exponent[ch] = b;
+        d.fittedMask |= (uint8_t)(1u << ch);
+        mask |= (uint8_t)(1u << ch);
+    }
+    return mask;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#ifndef IR_CURVE_H
+#define IR_CURVE_H
+
+#include <Arduino.h>
+#include "IRScanner.h"
+#include "Calibration.h"   // CAL_EEPROM_END
+
+// ========================================
+//   CURVAS IR POR SENSOR (CAPTURA Y AJUSTE)
+// ========================================
+// Los cinco Sharp comparten por defecto la curva de fábrica
+// (IR_FACTORY_SCALE * adc^IR_FACTORY_EXPONENT), pero cada unidad se desvía
+// unos centímetros. Modo captura (GET /ir_cal, robot parado): con un blanco
+// a distancia conocida delante de un sensor se registra su ADC promedio;
+// con IR_CAL_MIN_POINTS o más distancias por canal, un ajuste por mínimos
+// cuadrados en log-log
+//     ln d = ln a + b * ln adc   ->   d = a * adc^b
+// da la curva propia del canal. Se descarta si el exponente sale de rango
+// o el error relativo RMS pasa de IR_CAL_MAX_RMS_PCT (se conserva la
+// anterior).
+//
+// Las curvas solo se evalúan al regenerar las tablas de IRScanner
+// (irCurveApply()); useSensor elige en caliente entre las curvas por sensor
+// y la de fábrica ('L' o /ir_cal?curve=). Un canal sin curva propia usa
+// siempre la de fábrica.
+//
+// Se guardan en EEPROM tras la calibración
+// ('I' 'R' | versión | tamaño | IRCurveData | CRC16) y se cargan en setup().
+
+#define IR_CURVE_EEPROM_ADDR CAL_EEPROM_END
+#define IR_CURVE_MAGIC0 'I'
+#define IR_CURVE_MAGIC1 'R'
+#define IR_CURVE_VERSION 1
+
+#define IR_CAL_MAX_POINTS 12          // por canal
+#define IR_CAL_MIN_POINTS 3
+#define IR_CAL_MIN_RAW 20             // menos: sin blanco o fuera de alcance
+#define IR_CAL_MIN_CM 4.0f            // más cerca la curva del Sharp se dobla
+#define IR_CAL_MAX_CM 150.0f
+#define IR_CAL_MIN_RAW_RATIO 1.5f     // adc máx / mín entre los puntos del canal
+#define IR_CAL_EXPONENT_MIN -2.5f
+#define IR_CAL_EXPONENT_MAX -0.5f
+#define IR_CAL_MAX_RMS_PCT 10.0f
+
+// Parámetros persistentes (los aplica irCurveApply())
+struct IRCurveData {
+    float scale[IR_CHANNEL_COUNT];    // a de d = a * adc^b (cm)
+    float exponent[IR_CHANNEL_COUNT]; // b
+    uint8_t fittedMask;               // bit por canal (IRChannel) con curva propia
+    uint8_t useSensor;                // 1: curvas por sensor; 0: de fábrica
+};
+
+void irCurveDefaults(IRCurveData& d);
+bool irCurveLoad(IRCurveData& d);
+bool irCurveSave(const IRCurveData& d);
+
+// Regenerar las tablas de los cinco canales según d
+void irCurveApply(const IRCurveData& d);
+
+struct IRCalPoint {
+    uint16_t raw;
+    uint16_t mm;
+};
+
+// Puntos capturados y ajuste; no toca hardware ni EEPROM
+class IRCurveCalibrator {
+private:
+    IRCalPoint points[IR_CHANNEL_COUNT][IR_CAL_MAX_POINTS];
+    uint8_t counts[IR_CHANNEL_COUNT] = { 0 };
+    float rmsPct[IR_CHANNEL_COUNT] = { 0 };
+
+    bool fitChannel(uint8_t ch, float& scale, float& exponent);
+
+public:
+    // false si el canal está lleno o el punto fuera de rango
+    bool addPoint(uint8_t channel, int raw, float cm);
+    void clear();
+    uint8_t pointCount(uint8_t channel) const { return channel < IR_CHANNEL_COUNT ? counts[channel] : 0; }
+
+    // Ajustar los canales con puntos suficientes y escribir en d los que
+    // salgan válidos. Devuelve la máscara de canales ajustados.
+    uint8_t fit(IRCurveData& d);
+
+    // Error relativo RMS (%) del último ajuste del canal
+    float lastRmsPct(uint8_t channel) const { return channel < IR_CHANNEL_COUNT ? rmsPct[channel] : 0.0f; }
+};
+
+#endif // IR_CURVE_H
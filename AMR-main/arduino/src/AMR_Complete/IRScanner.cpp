@@ -0,0 +1,181 @@
+#include "IRScanner.h"
+#include "CriticalSection.h"
+#include <math.h>
+
+// Orden de barrido = orden de IRChannel
+const uint8_t IRScanner::channelPins[IR_CHANNEL_COUNT] = {
+    IR_LEFT_SIDE_PIN, IR_FRONT_LEFT_PIN, IR_BACK_CENTER_PIN, IR_FRONT_RIGHT_PIN, IR_RIGHT_SIDE_PIN
+};
+volatile uint16_t IRScanner::ring[IR_CHANNEL_COUNT][IR_RING_SIZE];
+volatile uint16_t IRScanner::ringSum[IR_CHANNEL_COUNT];
+volatile uint8_t IRScanner::ringPos[IR_CHANNEL_COUNT];
+volatile uint8_t IRScanner::currentChannel = 0;
+volatile unsigned long IRScanner::scans = 0;
+volatile unsigned long IRScanner::lastSampleMs = 0;
+unsigned long IRScanner::lastServiceMicros = 0;
+uint16_t IRScanner::lutMm[IR_CHANNEL_COUNT][IR_LUT_POINTS];
+
+float irCurveCentimeters(float scale, float exponent, int raw) {
+    if (raw <= 0) return IR_MAX_CM;
+    float d = scale * powf((float)raw, exponent);
+    if (d < IR_MIN_CM) d = IR_MIN_CM;
+    if (d > IR_MAX_CM) d = IR_MAX_CM;
+    return d;
+}
+
+float irRawToCentimeters(int raw) {
+    return irCurveCentimeters(IR_FACTORY_SCALE, IR_FACTORY_EXPONENT, raw);
+}
+
+void IRScanner::setCurve(uint8_t channel, float scale, float exponent) {
+    if (channel >= IR_CHANNEL_COUNT) return;
+    uint16_t table[IR_LUT_POINTS];
+    for (uint8_t i = 0; i < IR_LUT_POINTS; ++i) {
+        float cm = irCurveCentimeters(scale, exponent, (int)i << IR_LUT_SHIFT);
+        table[i] = (uint16_t)lroundf(cm * 10.0f);
+    }
+    // Las tareas leen la tabla: cambiarla entera de una vez
+    CriticalSection cs;
+    memcpy(lutMm[channel], table, sizeof(table));
+}
+
+float IRScanner::rawToCm(uint8_t channel, int raw) {
+    if (channel >= IR_CHANNEL_COUNT) return IR_MAX_CM;
+    if (raw < 0) raw = 0;
+    if (raw > 1023) raw = 1023;
+    const uint16_t* t = lutMm[channel];
+    uint8_t i = (uint8_t)(raw >> IR_LUT_SHIFT);
+    uint16_t frac = (uint16_t)raw & ((1u << IR_LUT_SHIFT) - 1);
+    // Curva decreciente: a >= b
+    uint16_t a = t[i];
+    uint16_t b = t[i + 1];
+    uint16_t mm = a - (uint16_t)(((uint32_t)(a - b) * frac) >> IR_LUT_SHIFT);
+    return (float)mm * 0.1f;
+}
+
+#if defined(__AVR__)
+// Canal del MUX para un pin analógico del Uno (A0 -> 0 ... A5 -> 5)
+static inline uint8_t adcMuxForPin(uint8_t pin) {
+    return (pin >= A0) ? (pin - A0) : pin;
+}
+
+ISR(ADC_vect) {
+    IRScanner::adcISR();
+}
+#endif
+
+void IRScanner::init() {
+    for (uint8_t ch = 0; ch < IR_CHANNEL_COUNT; ++ch) setCurve(ch, IR_FACTORY_SCALE, IR_FACTORY_EXPONENT);
+
+    // Llenar los anillos con una lectura real por canal para que los
+    // promedios sean válidos desde el primer snapshot.
+    for (uint8_t ch = 0; ch < IR_CHANNEL_COUNT; ++ch) {
+        uint16_t v = analogRead(channelPins[ch]);
+        for (uint8_t i = 0; i < IR_RING_SIZE; ++i) ring[ch][i] = v;
+        ringSum[ch] = v << IR_RING_SHIFT;
+        ringPos[ch] = 0;
+    }
+    currentChannel = 0;
+    scans = 0;
+    lastSampleMs = millis();
+    lastServiceMicros = micros();
+
+#if defined(__AVR__)
+    // ADC con auto-trigger por overflow del Timer0 (el mismo que usa millis()),
+    // prescaler 128 (125 kHz @16 MHz) y referencia AVcc.
+    noInterrupts();
+    ADMUX = _BV(REFS0) | adcMuxForPin(channelPins[0]);
+    ADCSRB = _BV(ADTS2);
+    ADCSRA = _BV(ADEN) | _BV(ADATE) | _BV(ADIE) | _BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0);
+    interrupts();
+    Serial.println(F("IR scan: ADC ISR (Timer0)"));
+#else
+    Serial.print(F("IR scan: poll cada "));
+    Serial.print(IR_SCAN_INTERVAL_US);
+    Serial.println(F(" us"));
+#endif
+}
+
+void IRScanner::pushSample(uint8_t ch, uint16_t value) {
+    uint8_t pos = ringPos[ch];
+    ringSum[ch] = ringSum[ch] - ring[ch][pos] + value;
+    ring[ch][pos] = value;
+    ringPos[ch] = (pos + 1) & (IR_RING_SIZE - 1);
+    lastSampleMs = millis();
+}
+
+void IRScanner::adcISR() {
+#if defined(__AVR__)
+    uint8_t ch = currentChannel;
+    pushSample(ch, ADC);
+    ch++;
+    if (ch >= IR_CHANNEL_COUNT) { ch = 0; scans++; }
+    currentChannel = ch;
+    // El cambio de MUX aplica a la siguiente conversión (siguiente overflow del Timer0)
+    ADMUX = (ADMUX & 0xF0) | adcMuxForPin(channelPins[ch]);
+#endif
+}
+
+void IRScanner::service() {
+#if !defined(__AVR__)
+    unsigned long now = micros();
+    if (now - lastServiceMicros < IR_SCAN_INTERVAL_US) return;
+    lastServiceMicros = now;
+    uint8_t ch = currentChannel;
+    pushSample(ch, (uint16_t)analogRead(channelPins[ch]));
+    ch++;
+    if (ch >= IR_CHANNEL_COUNT) { ch = 0; scans++; }
+    currentChannel = ch;
+#endif
+}
+
+int IRScanner::rawAverage(uint8_t channel) {
+    if (channel >= IR_CHANNEL_COUNT) return 0;
+    uint16_t sum;
+    noInterrupts();
+    sum = ringSum[channel];
+    interrupts();
+    return (int)(sum >> IR_RING_SHIFT);
+}
+
+void IRScanner::rawAverages(uint16_t* out) {
+    uint16_t sums[IR_CHANNEL_COUNT];
+    noInterrupts();
+    for (uint8_t ch = 0; ch < IR_CHANNEL_COUNT; ++ch) sums[ch] = ringSum[ch];
+    interrupts();
+    for (uint8_t ch = 0; ch < IR_CHANNEL_COUNT; ++ch) out[ch] = sums[ch] >> IR_RING_SHIFT;
+}
+
+float IRScanner::distanceCm(uint8_t channel) {
+    return rawToCm(channel, rawAverage(channel));
+}
+
+IRSnapshot IRScanner::snapshot(int threshold) {
+    IRSnapshot snap;
+    uint16_t sums[IR_CHANNEL_COUNT];
+    noInterrupts();
+    for (uint8_t ch = 0; ch < IR_CHANNEL_COUNT; ++ch) sums[ch] = ringSum[ch];
+    snap.timestampMs = lastSampleMs;
+    snap.scanCount = scans;
+    interrupts();
+
+    int raw[IR_CHANNEL_COUNT];
+    for (uint8_t ch = 0; ch < IR_CHANNEL_COUNT; ++ch) {
+        raw[ch] = (int)(sums[ch] >> IR_RING_SHIFT);
+        snap.cm[ch] = rawToCm(ch, raw[ch]);
+    }
+
+    snap.sensors.rawLeft = raw[IR_CH_LEFT];
+    snap.sensors.rawFrontLeft = raw[IR_CH_FRONT_LEFT];
+    snap.sensors.rawBack = raw[IR_CH_BACK];
+    snap.sensors.rawFrontRight = raw[IR_CH_FRONT_RIGHT];
+    snap.sensors.rawRight = raw[IR_CH_RIGHT];
+
+    // Detección booleana (suponer HIGH -> mayor valor -> detectado)
+    snap.sensors.left = snap.sensors.rawLeft >= threshold;
+    snap.sensors.frontLeft = snap.sensors.rawFrontLeft >= threshold;
+    snap.sensors.back = snap.sensors.rawBack >= threshold;
+    snap.sensors.frontRight = snap.sensors.rawFrontRight >= threshold;
+    snap.sensors.right = snap.sensors.rawRight >= threshold;
+    return snap;
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#ifndef IR_SCANNER_H
+#define IR_SCANNER_H
+
+#include <Arduino.h>
+
+// ========================================
+//   MOTOR DE MUESTREO IR EN SEGUNDO PLANO
+// ========================================
+// Recorre los 5 sensores IR en round-robin sin bloquear el loop:
+// - AVR (Uno): el ADC se dispara con el overflow del Timer0 (~976 Hz) y la
+//   ISR ADC_vect guarda la muestra y cambia el MUX al siguiente canal.
+// - Otras placas (UNO R4): service() hace como máximo una conversión cada
+//   IR_SCAN_INTERVAL_US, llamado desde el loop/scheduler (sin delay()).
+// Cada canal mantiene un anillo de IR_RING_SIZE muestras con suma corrida,
+// de modo que obtener el promedio es O(1).
+//
+// IMPORTANTE (AVR): mientras el escáner está activo el ADC le pertenece;
+// no usar analogRead() en otras partes del sketch.
+
+// Mapeo de pines (ajustado: swap L<->R)
+// LEFT_SIDE (lateral izquierdo)  -> A5 (antes A0)
+// FRONT_LEFT (frontal izquierdo) -> A4 (antes A1)
+// BACK_CENTER (trasero central)  -> A2 (sin cambios)
+// FRONT_RIGHT (frontal derecho)  -> A1 (antes A4)
+// RIGHT_SIDE (lateral derecho)   -> A0 (antes A5)
+const int IR_LEFT_SIDE_PIN   = A5; // Lateral izquierdo (swapped)
+const int IR_FRONT_LEFT_PIN  = A4; // Frontal izquierdo (swapped)
+const int IR_BACK_CENTER_PIN = A2; // Trasero central
+const int IR_FRONT_RIGHT_PIN = A1; // Frontal derecho (swapped)
+const int IR_RIGHT_SIDE_PIN  = A0; // Lateral derecho (swapped)
+
+#define IR_CHANNEL_COUNT 5
+#define IR_RING_SIZE 8              // muestras por canal (potencia de 2)
+#define IR_RING_SHIFT 3             // log2(IR_RING_SIZE) para el promedio
+#define IR_SCAN_INTERVAL_US 1000    // periodo entre conversiones (ruta no-AVR)
+
+// Curva de fábrica (modelo empírico común a los 5 sensores):
+// distancia_cm = IR_FACTORY_SCALE * adc^IR_FACTORY_EXPONENT
+#define IR_FACTORY_SCALE 17569.7f
+#define IR_FACTORY_EXPONENT -1.2062f
+#define IR_MIN_CM 2.0f
+#define IR_MAX_CM 1000.0f
+
+// Tabla ADC -> mm por canal, lineal a tramos: un punto cada 2^IR_LUT_SHIFT
+// cuentas de ADC (0, 16, ... 1024). Con la curva de fábrica el error de
+// interpolación es < 2 % (< 2 cm) entre 10 y 100 cm, menor que el ruido.
+#define IR_LUT_SHIFT 4
+#define IR_LUT_POINTS ((1024 >> IR_LUT_SHIFT) + 1)
+
+// Índice de canal (mismo orden que el array "ir" de /data: L, FL, B, FR, R)
+enum IRChannel {
+    IR_CH_LEFT = 0,
+    IR_CH_FRONT_LEFT,
+    IR_CH_BACK,
+    IR_CH_FRONT_RIGHT,
+    IR_CH_RIGHT
+};
+
+// Estructura para devolver lecturas
+struct IRSensors {
+    int rawLeft;
+    int rawFrontLeft;
+    int rawBack;
+    int rawFrontRight;
+    int rawRight;
+    bool left;
+    bool frontLeft;
+    bool back;
+    bool frontRight;
+    bool right;
+};
+
+// Copia consistente del estado del escáner
+struct IRSnapshot {
+    IRSensors sensors;               // raws promediados + detección por umbral
+    float cm[IR_CHANNEL_COUNT];      // distancias en cm (indexadas por IRChannel)
+    unsigned long timestampMs;       // millis() de la última muestra guardada
+    unsigned long scanCount;         // barridos completos desde init()
+};
+
+// Conversión exacta con la curva de fábrica (powf). Referencia para
+// generar tablas y para comparar; las lecturas usan IRScanner::rawToCm().
+float irRawToCentimeters(int raw);
+
+// Misma forma con parámetros propios: scale * adc^exponent, en [2, 1000] cm
+float irCurveCentimeters(float scale, float exponent, int raw);
+
+class IRScanner {
+private:
+    static const uint8_t channelPins[IR_CHANNEL_COUNT];
+    static volatile uint16_t ring[IR_CHANNEL_COUNT][IR_RING_SIZE];
+    static volatile uint16_t ringSum[IR_CHANNEL_COUNT];   // máx 8*1023, cabe en 16 bits
+    static volatile uint8_t ringPos[IR_CHANNEL_COUNT];
+    static volatile uint8_t currentChannel;               // canal en conversión
+    static volatile unsigned long scans;
+    static volatile unsigned long lastSampleMs;
+    static unsigned long lastServiceMicros;
+    static uint16_t lutMm[IR_CHANNEL_COUNT][IR_LUT_POINTS];
+
+    static void pushSample(uint8_t ch, uint16_t value);
+
+public:
+    // Inicialización: tablas de fábrica, llena los anillos con una lectura
+    // por canal y arranca el barrido
+    void init();
+
+    // Regenerar la tabla de un canal con la curva scale * adc^exponent
+    // (powf solo aquí, no en cada lectura; ver IRCurve.h)
+    static void setCurve(uint8_t channel, float scale, float exponent);
+
+    // ADC -> cm por tabla del canal (sin aritmética trascendente)
+    static float rawToCm(uint8_t channel, int raw);
+
+    // Avanza el barrido (no-AVR). En AVR no hace nada: lo lleva la ISR del ADC.
+    void service();
+
+    // Lectura no bloqueante de los últimos promedios
+    IRSnapshot snapshot(int threshold);
+    int rawAverage(uint8_t channel);
+    // Los cinco promedios en una sola sección crítica (orden IRChannel)
+    void rawAverages(uint16_t* out);
+    float distanceCm(uint8_t channel);
+
+    // Llamada desde ISR(ADC_vect) en AVR
+    static void adcISR();
+};
+
+#endif // IR_SCANNER_H
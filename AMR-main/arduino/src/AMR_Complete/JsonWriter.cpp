@@ -0,0 +1,190 @@
+#include "JsonWriter.h"
+#include <math.h>
+
+void JsonWriter::put(char c) {
+    if (len >= JSON_WRITER_BUFFER) flush();
+    buf[len++] = c;
+    total++;
+}
+
+void JsonWriter::putRaw(const char* s) {
+    while (*s) put(*s++);
+}
+
+void JsonWriter::putRaw_P(const __FlashStringHelper* s) {
+    const char* p = reinterpret_cast<const char*>(s);
+    char c;
+    while ((c = pgm_read_byte(p++)) != 0) put(c);
+}
+
+void JsonWriter::flush() {
+    if (len == 0) return;
+    out.write(reinterpret_cast<const uint8_t*>(buf), len);
+    len = 0;
+}
+
+// Coma antes de cada elemento salvo el primero del nivel (no tras una clave)
+void JsonWriter::separator() {
+    if (afterKey) {
+        afterKey = false;
+        return;
+    }
+    if (depth == 0) return;
+    uint8_t bit = 1 << (depth - 1);
+    if (firstMask & bit) firstMask &= ~bit;
+    else put(',');
+}
+
+void JsonWriter::beginObject() {
+    separator();
+    put('{');
+    if (depth < JSON_WRITER_DEPTH) {
+        depth++;
+        firstMask |= 1 << (depth - 1);
+    }
+}
+
+void JsonWriter::endObject() {
+    put('}');
+    if (depth > 0) depth--;
+}
+
+void JsonWriter::beginArray() {
+    separator();
+    put('[');
+    if (depth < JSON_WRITER_DEPTH) {
+        depth++;
+        firstMask |= 1 << (depth - 1);
+    }
+}
+
+void JsonWriter::endArray() {
+    put(']');
+    if (depth > 0) depth--;
+}
+
+void JsonWriter::key(const __FlashStringHelper* k) {
+    separator();
+    put('"');
+    putRaw_P(k);
+    put('"');
+    put(':');
+    afterKey = true;
+}
+
+void JsonWriter::putUnsigned(unsigned long v) {
+    char tmp[11];
+    uint8_t n = 0;
+    do {
+        tmp[n++] = (char)('0' + (v % 10));
+        v /= 10;
+    } while (v > 0);
+    while (n > 0) put(tmp[--n]);
+}
+
+void JsonWriter::value(long v) {
+    separator();
+    if (v < 0) {
+        put('-');
+        putUnsigned((unsigned long)(-(v + 1)) + 1);  // sin desbordar en LONG_MIN
+    } else {
+        putUnsigned((unsigned long)v);
+    }
+}
+
+void JsonWriter::value(unsigned long v) {
+    separator();
+    putUnsigned(v);
+}
+
+void JsonWriter::value(bool v) {
+    separator();
+    putRaw(v ? "true" : "false");
+}
+
+void JsonWriter::null() {
+    separator();
+    putRaw("null");
+}
+
+void JsonWriter::value(float v, uint8_t decimals) {
+    separator();
+    // JSON no admite NaN/Inf
+    if (isnan(v) || isinf(v)) {
+        putRaw("null");
+        return;
+    }
+    if (decimals > 6) decimals = 6;
+    unsigned long scale = 1;
+    for (uint8_t i = 0; i < decimals; ++i) scale *= 10;
+
+    if (v < 0) {
+        v = -v;
+        // Evitar "-0.00": solo signo si el valor redondeado no es cero
+        if (v * (float)scale >= 0.5f) put('-');
+    }
+    // Valores fuera de rango del entero escalado: sin decimales
+    if (v >= 4.0e9f / (float)scale) {
+        putUnsigned((unsigned long)(v > 4.0e9f ? 4.0e9f : v));
+        return;
+    }
+    unsigned long fixed = (unsigned long)(v * (float)scale + 0.5f);
+    putUnsigned(fixed / scale);
+    if (decimals == 0) return;
+    put('.');
+    unsigned long frac = fixed % scale;
+    // ceros a la izquierda de la parte fraccionaria
+    for (unsigned long d = scale / 10; d > 1 && frac < d; d /= 10) put('0');
+    putUnsigned(frac);
+}
+
+void JsonWriter::valueFixed(long scaled, uint8_t decimals) {
+    separator();
+    unsigned long mag = (scaled < 0) ? (unsigned long)(-(scaled + 1)) + 1 : (unsigned long)scaled;
+    if (scaled < 0) put('-');
+    if (decimals > 6) decimals = 6;
+    unsigned long scale = 1;
+    for (uint8_t i = 0; i < decimals; ++i) scale *= 10;
+    putUnsigned(mag / scale);
+    if (decimals == 0) return;
+    put('.');
+    unsigned long frac = mag % scale;
+    for (unsigned long d = scale / 10; d > 1 && frac < d; d /= 10) put('0');
+    putUnsigned(frac);
+}
+
+void JsonWriter::putEscaped(char c) {
+    switch (c) {
+        case '"':  put('\\'); put('"'); break;
+        case '\\': put('\\'); put('\\'); break;
+        case '\n': put('\\'); put('n'); break;
+        case '\r': put('\\'); put('r'); break;
+        case '\t': put('\\'); put('t'); break;
+        default:
+            if ((uint8_t)c < 0x20) {
+                static const char hex[] = "0123456789abcdef";
+                putRaw("\\u00");
+                put(hex[(c >> 4) & 0x0F]);
+                put(hex[c & 0x0F]);
+            } else {
+                put(c);
+            }
+            break;
+    }
+}
+
+void JsonWriter::value(const char* s) {
+    separator();
+    put('"');
+    while (*s) putEscaped(*s++);
+    put('"');
+}
+
+void JsonWriter::value(const __FlashStringHelper* s) {
+    separator();
+    put('"');
+    const char* p = reinterpret_cast<const char*>(s);
+    char c;
+    while ((c = pgm_read_byte(p++)) != 0) putEscaped(c);
+    put('"');
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <Arduino.h>
+
+// ========================================
+//      EMISOR JSON EN STREAMING
+// ========================================
+// Escribe JSON directamente en un buffer fijo que se vuelca a un Print
+// (WiFiClient, Serial) cuando se llena: cero reservas de heap y tiempo de
+// respuesta acotado por el tamaño del documento, no por realloc de String.
+// Las claves van en flash con F("...") y las comas se insertan solas según
+// el nivel de anidamiento.
+//
+// Uso:
+//     JsonWriter json(client);
+//     json.beginObject();
+//     json.field(F("x"), odometry.getX(), 2);
+//     json.key(F("ir")); json.beginArray(); json.value(raw); json.endArray();
+//     json.endObject();
+//     json.flush();
+
+#define JSON_WRITER_BUFFER 64   // bytes por escritura al Print (segmento TCP pequeño)
+#define JSON_WRITER_DEPTH 8     // anidamiento máximo de objetos/arrays
+
+class JsonWriter {
+private:
+    Print& out;
+    char buf[JSON_WRITER_BUFFER];
+    uint8_t len = 0;
+    uint8_t depth = 0;
+    uint8_t firstMask = 0;      // bit n = el nivel n aún no tiene elementos
+    bool afterKey = false;      // la próxima escritura es el valor de una clave
+    size_t total = 0;
+
+    void put(char c);
+    void putRaw(const char* s);
+    void putRaw_P(const __FlashStringHelper* s);
+    void separator();
+    void putEscaped(char c);
+    void putUnsigned(unsigned long v);
+
+public:
+    explicit JsonWriter(Print& target) : out(target) {}
+    ~JsonWriter() { flush(); }
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+
+    void key(const __FlashStringHelper* k);
+
+    void value(long v);
+    void value(unsigned long v);
+    void value(int v) { value((long)v); }
+    void value(unsigned int v) { value((unsigned long)v); }
+    void value(bool v);
+    // Punto fijo propio (sin printf de float ni String(float, n))
+    void value(float v, uint8_t decimals = 2);
+    // Entero en punto fijo: valueFixed(1234, 1) -> 123.4 (sin pasar por float)
+    void valueFixed(long scaled, uint8_t decimals);
+    void value(const char* s);
+    void value(const __FlashStringHelper* s);
+    void null();
+
+    // Clave + valor
+    template <typename T>
+    void field(const __FlashStringHelper* k, T v) { key(k); value(v); }
+    void field(const __FlashStringHelper* k, float v, uint8_t decimals) { key(k); value(v, decimals); }
+
+    // Volcar lo pendiente al Print
+    void flush();
+    // Bytes emitidos (incluye lo aún no volcado)
+    size_t size() { return total; }
+};
+
+#endif // JSON_WRITER_H
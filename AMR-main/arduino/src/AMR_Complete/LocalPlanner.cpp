@@ -0,0 +1,239 @@
+#include "LocalPlanner.h"
+#include <math.h>
+
+#define INFO_CLOSED 0x80
+#define INFO_SEEN   0x40
+#define INFO_DIR    0x07
+
+#define COST_STRAIGHT 10
+#define COST_DIAGONAL 14
+
+// Vecinos en sentido antihorario desde +x; el opuesto de d es (d + 4) & 7
+static const int8_t DIR_I[8] = { 1, 1, 0, -1, -1, -1, 0, 1 };
+static const int8_t DIR_J[8] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+
+static uint16_t octile(int di, int dj) {
+    di = abs(di);
+    dj = abs(dj);
+    int dmin = (di < dj) ? di : dj;
+    int dmax = (di < dj) ? dj : di;
+    return (uint16_t)(COST_DIAGONAL * dmin + COST_STRAIGHT * (dmax - dmin));
+}
+
+bool LocalPlanner::isBlockedNode(int i, int j) const {
+    if (i < 0 || j < 0 || i >= PLANNER_SIZE || j >= PLANNER_SIZE) return true;
+    uint16_t n = (uint16_t)j * PLANNER_SIZE + i;
+    if (!(blocked[n >> 3] & (1 << (n & 7)))) return false;
+    // Zona que ya ocupa el robot: siempre transitable para poder salir
+    long di = i - startI;
+    long dj = j - startJ;
+    return (float)(di * di + dj * dj) * PLANNER_NODE_CM * PLANNER_NODE_CM > PLANNER_CLEARANCE_CM * PLANNER_CLEARANCE_CM;
+}
+
+bool LocalPlanner::lineClear(int i0, int j0, int i1, int j1) const {
+    int dx = abs(i1 - i0), sx = (i0 < i1) ? 1 : -1;
+    int dy = -abs(j1 - j0), sy = (j0 < j1) ? 1 : -1;
+    int err = dx + dy;
+    while (true) {
+        if (isBlockedNode(i0, j0)) return false;
+        if (i0 == i1 && j0 == j1) return true;
+        int e2 = 2 * err;
+        if (e2 >= dy) { err += dy; i0 += sx; }
+        if (e2 <= dx) { err += dx; j0 += sy; }
+    }
+}
+
+bool LocalPlanner::push(uint16_t node, uint16_t f) {
+    if (openCount >= PLANNER_OPEN_MAX) return false;
+    uint8_t k = openCount++;
+    while (k > 0) {
+        uint8_t parent = (k - 1) / 2;
+        if (open[parent].f <= f) break;
+        open[k] = open[parent];
+        k = parent;
+    }
+    open[k].f = f;
+    open[k].node = node;
+    return true;
+}
+
+uint16_t LocalPlanner::pop() {
+    uint16_t top = open[0].node;
+    OpenEntry last = open[--openCount];
+    uint8_t k = 0;
+    while (true) {
+        uint8_t child = 2 * k + 1;
+        if (child >= openCount) break;
+        if (child + 1 < openCount && open[child + 1].f < open[child].f) child++;
+        if (last.f <= open[child].f) break;
+        open[k] = open[child];
+        k = child;
+    }
+    if (openCount > 0) open[k] = last;
+    return top;
+}
+
+void LocalPlanner::nodeCenter(int i, int j, PathPoint& p) const {
+    p.x = originX + (i + 0.5f) * PLANNER_NODE_CM;
+    p.y = originY + (j + 0.5f) * PLANNER_NODE_CM;
+}
+
+void LocalPlanner::prepare(const OccupancyGrid& grid, float sx, float sy) {
+    originX = grid.getOriginX();
+    originY = grid.getOriginY();
+    startI = (int)floorf((sx - originX) / PLANNER_NODE_CM);
+    startJ = (int)floorf((sy - originY) / PLANNER_NODE_CM);
+
+    // 1) Nodo ocupado si alguna de sus celdas lo está (info como temporal)
+    memset(info, 0, sizeof(info));
+    for (int cy = 0; cy < OG_SIZE; ++cy) {
+        for (int cx = 0; cx < OG_SIZE; ++cx) {
+            if (grid.cell(cx, cy) >= OG_OCCUPIED_MIN) {
+                info[(cy / PLANNER_NODE_CELLS) * PLANNER_SIZE + cx / PLANNER_NODE_CELLS] = 1;
+            }
+        }
+    }
+
+    // 2) Inflar cada nodo ocupado con un disco de PLANNER_CLEARANCE_CM
+    const int r = (int)(PLANNER_CLEARANCE_CM / PLANNER_NODE_CM);
+    const long r2 = (long)((PLANNER_CLEARANCE_CM * PLANNER_CLEARANCE_CM) / (PLANNER_NODE_CM * PLANNER_NODE_CM));
+    memset(blocked, 0, sizeof(blocked));
+    for (int j = 0; j < PLANNER_SIZE; ++j) {
+        for (int i = 0; i < PLANNER_SIZE; ++i) {
+            if (!info[j * PLANNER_SIZE + i]) continue;
+            for (int dj = -r; dj <= r; ++dj) {
+                int nj = j + dj;
+                if (nj < 0 || nj >= PLANNER_SIZE) continue;
+                for (int di = -r; di <= r; ++di) {
+                    int ni = i + di;
+                    if (ni < 0 || ni >= PLANNER_SIZE || (long)(di * di + dj * dj) > r2) continue;
+                    uint16_t n = (uint16_t)nj * PLANNER_SIZE + ni;
+                    blocked[n >> 3] |= (uint8_t)(1 << (n & 7));
+                }
+            }
+        }
+    }
+}
+
+int LocalPlanner::plan(const OccupancyGrid& grid, float sx, float sy, float gx, float gy, PathPoint* out, uint8_t maxOut) {
+    prepare(grid, sx, sy);
+    expansions = 0;
+    if (startI < 0 || startJ < 0 || startI >= PLANNER_SIZE || startJ >= PLANNER_SIZE) return -1;
+
+    // Meta en coordenadas de nodo; fuera de la ventana -> punto del borde en
+    // la recta robot-meta
+    float pi = (sx - originX) / PLANNER_NODE_CM;
+    float pj = (sy - originY) / PLANNER_NODE_CM;
+    float qi = (gx - originX) / PLANNER_NODE_CM;
+    float qj = (gy - originY) / PLANNER_NODE_CM;
+    float t = 1.0f;
+    const float lo = 0.5f;
+    const float hi = PLANNER_SIZE - 0.5f;
+    if (qi < lo) t = min(t, (lo - pi) / (qi - pi));
+    if (qi > hi) t = min(t, (hi - pi) / (qi - pi));
+    if (qj < lo) t = min(t, (lo - pj) / (qj - pj));
+    if (qj > hi) t = min(t, (hi - pj) / (qj - pj));
+    int goalI = (int)floorf(pi + t * (qi - pi));
+    int goalJ = (int)floorf(pj + t * (qj - pj));
+    if (isBlockedNode(goalI, goalJ)) return -1;
+    if (goalI == startI && goalJ == startJ) return 0;
+
+    const uint16_t startNode = (uint16_t)startJ * PLANNER_SIZE + startI;
+    const uint16_t goalNode = (uint16_t)goalJ * PLANNER_SIZE + goalI;
+
+    memset(info, 0, sizeof(info));
+    openCount = 0;
+    gCost[startNode] = 0;
+    info[startNode] = INFO_SEEN;
+    push(startNode, octile(goalI - startI, goalJ - startJ));
+
+    bool found = false;
+    while (openCount > 0 && expansions < PLANNER_MAX_EXPANSIONS) {
+        uint16_t n = pop();
+        if (info[n] & INFO_CLOSED) continue;   // entrada repetida (g mejorado después)
+        info[n] |= INFO_CLOSED;
+        expansions++;
+        if (n == goalNode) {
+            found = true;
+            break;
+        }
+
+        int i = n % PLANNER_SIZE;
+        int j = n / PLANNER_SIZE;
+        for (uint8_t d = 0; d < 8; ++d) {
+            int ni = i + DIR_I[d];
+            int nj = j + DIR_J[d];
+            if (isBlockedNode(ni, nj)) continue;
+            bool diagonal = (d & 1) != 0;
+            // Sin cortar esquinas: en diagonal ambos vecinos rectos libres
+            if (diagonal && (isBlockedNode(ni, j) || isBlockedNode(i, nj))) continue;
+            uint16_t nn = (uint16_t)nj * PLANNER_SIZE + ni;
+            if (info[nn] & INFO_CLOSED) continue;
+            uint16_t g = gCost[n] + (diagonal ? COST_DIAGONAL : COST_STRAIGHT);
+            if ((info[nn] & INFO_SEEN) && g >= gCost[nn]) continue;
+            gCost[nn] = g;
+            info[nn] = INFO_SEEN | ((d + 4) & INFO_DIR);
+            push(nn, g + octile(goalI - ni, goalJ - nj));   // montículo lleno: se descarta
+        }
+    }
+    if (!found) return -1;
+
+    // Reconstruir meta -> inicio siguiendo la dirección al padre
+    uint16_t path[PLANNER_MAX_PATH];
+    uint8_t len = 0;
+    uint16_t n = goalNode;
+    while (true) {
+        if (len >= PLANNER_MAX_PATH) return -1;
+        path[len++] = n;
+        if (n == startNode) break;
+        uint8_t d = info[n] & INFO_DIR;
+        int i = n % PLANNER_SIZE + DIR_I[d];
+        int j = n / PLANNER_SIZE + DIR_J[d];
+        n = (uint16_t)j * PLANNER_SIZE + i;
+    }
+
+    // Simplificar por línea de visión: desde el ancla, saltar al nodo más
+    // cercano a la meta que se vea directamente
+    uint8_t count = 0;
+    int anchor = len - 1;
+    while (anchor > 0) {
+        int ai = path[anchor] % PLANNER_SIZE;
+        int aj = path[anchor] / PLANNER_SIZE;
+        int next = anchor - 1;
+        for (int k = 0; k < anchor - 1; ++k) {
+            if (lineClear(ai, aj, path[k] % PLANNER_SIZE, path[k] / PLANNER_SIZE)) {
+                next = k;
+                break;
+            }
+        }
+        if (next == 0) break;   // la meta la añade el llamador
+        if (count >= maxOut) return -1;
+        nodeCenter(path[next] % PLANNER_SIZE, path[next] / PLANNER_SIZE, out[count++]);
+        anchor = next;
+    }
+    // Meta en el borde de la ventana (waypoint lejano): incluir el punto
+    // del borde para no cortar por zona no planificada
+    if (t < 1.0f) {
+        if (count >= maxOut) return -1;
+        nodeCenter(goalI, goalJ, out[count++]);
+    }
+    return count;
+}
+
+bool LocalPlanner::segmentBlocked(float x0, float y0, float x1, float y1) const {
+    int i0 = (int)floorf((x0 - originX) / PLANNER_NODE_CM);
+    int j0 = (int)floorf((y0 - originY) / PLANNER_NODE_CM);
+    int i1 = (int)floorf((x1 - originX) / PLANNER_NODE_CM);
+    int j1 = (int)floorf((y1 - originY) / PLANNER_NODE_CM);
+    int dx = abs(i1 - i0), sx = (i0 < i1) ? 1 : -1;
+    int dy = -abs(j1 - j0), sy = (j0 < j1) ? 1 : -1;
+    int err = dx + dy;
+    while (true) {
+        bool inside = i0 >= 0 && j0 >= 0 && i0 < PLANNER_SIZE && j0 < PLANNER_SIZE;
+        if (inside && isBlockedNode(i0, j0)) return true;
+        if (i0 == i1 && j0 == j1) return false;
+        int e2 = 2 * err;
+        if (e2 >= dy) { err += dy; i0 += sx; }
+        if (e2 <= dx) { err += dx; j0 += sy; }
+    }
+}
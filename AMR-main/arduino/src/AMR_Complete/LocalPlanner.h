@@ -0,0 +1,80 @@
+#pragma once
+
+#ifndef LOCAL_PLANNER_H
+#define LOCAL_PLANNER_H
+
+#include <Arduino.h>
+#include "OccupancyGrid.h"
+#include "PathFollower.h"
+
+// ========================================
+//     PLANIFICADOR LOCAL (A* ACOTADO)
+// ========================================
+// Busca un desvío sobre el mapa de ocupación cuando los sensores frontales
+// confirman un bloqueo. Trabaja sobre nodos de PLANNER_NODE_CELLS x
+// PLANNER_NODE_CELLS celdas del mapa (10 cm en UNO R4) que cubren toda la
+// ventana de OccupancyGrid.
+//
+// - Obstáculos inflados PLANNER_CLEARANCE_CM (medio ancho del robot + margen);
+//   las celdas desconocidas se consideran libres.
+// - 8-conexión, costes 10/14, heurística octil.
+// - Memoria fija (miembros de la clase, sin heap) y como mucho
+//   PLANNER_MAX_EXPANSIONS nodos expandidos por llamada: si no encuentra
+//   camino en ese presupuesto falla y el llamador reintenta más tarde, con
+//   más mapa.
+// - El resultado se simplifica por línea de visión a unos pocos puntos
+//   intermedios para PathFollower.
+//
+// Los nodos a menos de PLANNER_CLEARANCE_CM del robot no se consideran
+// bloqueados: el robot siempre puede salir de la zona que ya ocupa.
+
+#define PLANNER_NODE_CELLS 2
+#define PLANNER_SIZE (OG_SIZE / PLANNER_NODE_CELLS)       // nodos por lado
+#define PLANNER_NODES (PLANNER_SIZE * PLANNER_SIZE)
+#define PLANNER_NODE_CM (OG_RESOLUTION_CM * PLANNER_NODE_CELLS)
+#define PLANNER_CLEARANCE_CM 35.0f
+#define PLANNER_MAX_EXPANSIONS 700
+#define PLANNER_OPEN_MAX 192          // entradas del montículo abierto
+#define PLANNER_MAX_PATH 96           // nodos de la solución antes de simplificar
+
+class LocalPlanner {
+private:
+    struct OpenEntry {
+        uint16_t f;
+        uint16_t node;
+    };
+
+    uint8_t blocked[(PLANNER_NODES + 7) / 8];
+    uint16_t gCost[PLANNER_NODES];
+    uint8_t info[PLANNER_NODES];      // bit7 cerrado, bit6 visto, bits0-2 dirección al padre
+    OpenEntry open[PLANNER_OPEN_MAX];
+    uint8_t openCount = 0;
+    uint16_t expansions = 0;
+    int16_t originX = 0;
+    int16_t originY = 0;
+    int startI = 0, startJ = 0;
+
+    bool isBlockedNode(int i, int j) const;
+    bool lineClear(int i0, int j0, int i1, int j1) const;
+    bool push(uint16_t node, uint16_t f);
+    uint16_t pop();
+    void nodeCenter(int i, int j, PathPoint& p) const;
+
+public:
+    // Inflar los obstáculos del mapa actual con el robot en (sx, sy). Lo
+    // hace plan(); llamarlo solo para consultar segmentBlocked() sin planificar.
+    void prepare(const OccupancyGrid& grid, float sx, float sy);
+
+    // Inflar el mapa actual y buscar un camino de (sx, sy) a (gx, gy) en cm.
+    // Si la meta queda fuera de la ventana se apunta al borde en su
+    // dirección. Escribe en out los puntos intermedios (sin el inicio ni la
+    // meta) y devuelve cuántos; -1 si no hay camino en el presupuesto.
+    int plan(const OccupancyGrid& grid, float sx, float sy, float gx, float gy, PathPoint* out, uint8_t maxOut);
+
+    // ¿El segmento cruza obstáculos inflados del último prepare()/plan()?
+    bool segmentBlocked(float x0, float y0, float x1, float y1) const;
+
+    uint16_t getExpansions() const { return expansions; }
+};
+
+#endif // LOCAL_PLANNER_H
@@ -0,0 +1,136 @@
+#include "LogRing.h"
+
+#define LOG_ARENA_MASK (LOG_ARENA_BYTES - 1)
+#define LOG_RECORD_HEADER 2
+
+LogRing logRing;
+
+void LogRing::dropOldest() {
+    uint8_t len = arena[tail & LOG_ARENA_MASK];
+    tail += len;
+    droppedRecords++;
+}
+
+void LogRing::append(uint8_t kind, const void* data, uint8_t n, bool eol) {
+    // Sello de tiempo al empezar cada línea
+    if (!lineOpen && kind != REC_STAMP) {
+        lineOpen = true;
+        uint32_t now = millis();
+        append(REC_STAMP, &now, sizeof(now), false);
+    }
+
+    uint8_t total = n + LOG_RECORD_HEADER;
+    if ((uint16_t)(LOG_ARENA_BYTES - used()) < total) {
+        while ((uint16_t)(LOG_ARENA_BYTES - used()) < total) dropOldest();
+        // Descartar líneas completas: el volcado siempre empieza en un sello
+        while (tail != head && (arena[(tail + 1) & LOG_ARENA_MASK] & ~REC_EOL_FLAG) != REC_STAMP) dropOldest();
+    }
+
+    arena[head & LOG_ARENA_MASK] = total;
+    arena[(head + 1) & LOG_ARENA_MASK] = eol ? (kind | REC_EOL_FLAG) : kind;
+    const uint8_t* src = static_cast<const uint8_t*>(data);
+    for (uint8_t i = 0; i < n; ++i) arena[(head + LOG_RECORD_HEADER + i) & LOG_ARENA_MASK] = src[i];
+    head += total;
+    if (eol) lineOpen = false;
+}
+
+void LogRing::print(const __FlashStringHelper* s) {
+    if (mirror) mirror->print(s);
+    append(REC_FLASH, &s, sizeof(s), false);
+}
+
+void LogRing::print(const char* s) {
+    if (mirror) mirror->print(s);
+    size_t n = strlen(s);
+    if (n > LOG_MAX_TEXT) n = LOG_MAX_TEXT;
+    append(REC_TEXT, s, (uint8_t)n, false);
+}
+
+void LogRing::print(char c) {
+    if (mirror) mirror->print(c);
+    append(REC_TEXT, &c, 1, false);
+}
+
+void LogRing::print(long v) {
+    if (mirror) mirror->print(v);
+    int32_t x = (int32_t)v;
+    append(REC_LONG, &x, sizeof(x), false);
+}
+
+void LogRing::print(unsigned long v) {
+    if (mirror) mirror->print(v);
+    uint32_t x = (uint32_t)v;
+    append(REC_ULONG, &x, sizeof(x), false);
+}
+
+void LogRing::print(double v, int decimals) {
+    if (mirror) mirror->print(v, decimals);
+    uint8_t rec[sizeof(float) + 1];
+    float f = (float)v;
+    memcpy(rec, &f, sizeof(f));
+    rec[sizeof(f)] = (uint8_t)decimals;
+    append(REC_FLOAT, rec, sizeof(rec), false);
+}
+
+void LogRing::println() {
+    if (mirror) mirror->println();
+    append(REC_TEXT, nullptr, 0, true);
+}
+
+void LogRing::dumpTo(Print& out) const {
+    uint16_t pos = tail;
+    while (pos != head) {
+        uint8_t len = arena[pos & LOG_ARENA_MASK];
+        uint8_t kind = arena[(pos + 1) & LOG_ARENA_MASK];
+        uint8_t n = len - LOG_RECORD_HEADER;
+        // Copia del registro actual (como mucho LOG_MAX_TEXT bytes)
+        uint8_t data[LOG_MAX_TEXT];
+        for (uint8_t i = 0; i < n; ++i) data[i] = arena[(pos + LOG_RECORD_HEADER + i) & LOG_ARENA_MASK];
+        pos += len;
+
+        switch (kind & ~REC_EOL_FLAG) {
+            case REC_STAMP: {
+                uint32_t ms;
+                memcpy(&ms, data, sizeof(ms));
+                out.print('[');
+                out.print((unsigned long)ms);
+                out.print(F("] "));
+                break;
+            }
+            case REC_FLASH: {
+                const __FlashStringHelper* s;
+                memcpy(&s, data, sizeof(s));
+                out.print(s);
+                break;
+            }
+            case REC_TEXT:
+                out.write(data, n);
+                break;
+            case REC_LONG: {
+                int32_t v;
+                memcpy(&v, data, sizeof(v));
+                out.print((long)v);
+                break;
+            }
+            case REC_ULONG: {
+                uint32_t v;
+                memcpy(&v, data, sizeof(v));
+                out.print((unsigned long)v);
+                break;
+            }
+            case REC_FLOAT: {
+                float f;
+                memcpy(&f, data, sizeof(f));
+                out.print(f, data[sizeof(f)]);
+                break;
+            }
+        }
+        if (kind & REC_EOL_FLAG) out.print('\n');
+    }
+}
+
+void LogRing::clear() {
+    head = tail = 0;
+    lineOpen = false;
+    droppedRecords = 0;
+}
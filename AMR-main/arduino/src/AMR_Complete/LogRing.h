@@ -0,0 +1,85 @@
+#pragma once
+
+#ifndef LOG_RING_H
+#define LOG_RING_H
+
+#include <Arduino.h>
+
+// ========================================
+//       REGISTRO CIRCULAR SIN HEAP
+// ========================================
+// Arena de bytes de tamaño fijo con registros [len][tipo][datos]:
+// - Textos F("...") se guardan como puntero a flash (no se copian)
+// - Números se guardan binarios y se formatean al volcar
+// - const char* se copia (truncado a LOG_MAX_TEXT)
+// Cada línea empieza con un sello millis(). Añadir es O(1) y nunca reserva
+// memoria: si no hay sitio se descartan los registros más antiguos.
+// dumpTo() recorre la arena en el sitio y escribe al Print registro a registro.
+//
+// Productor y lector viven en el contexto de loop() (tareas no tiempo real),
+// así que no hacen falta locks. NO llamar desde ISR ni desde tareas de
+// tiempo real del Scheduler.
+//
+// Uso:
+//     logPrint(F("Waypoint ")); logPrint(i); logPrintln(F(" alcanzado"));
+
+#define LOG_ARENA_BYTES 1024   // potencia de 2
+#define LOG_MAX_TEXT 48        // copia máxima de un const char*
+
+class LogRing {
+private:
+    enum : uint8_t {
+        REC_STAMP = 1,
+        REC_FLASH,
+        REC_TEXT,
+        REC_LONG,
+        REC_ULONG,
+        REC_FLOAT,
+        REC_EOL_FLAG = 0x80    // el registro cierra la línea
+    };
+
+    uint8_t arena[LOG_ARENA_BYTES];
+    uint16_t head = 0;         // índices libres (se enmascaran al acceder)
+    uint16_t tail = 0;
+    bool lineOpen = false;
+    unsigned long droppedRecords = 0;
+    Print* mirror = nullptr;
+
+    void append(uint8_t kind, const void* data, uint8_t n, bool eol);
+    void dropOldest();
+
+public:
+    // Copiar también cada mensaje a un Print (p.ej. Serial); nullptr = solo arena
+    void begin(Print* mirrorTo) { mirror = mirrorTo; }
+
+    void print(const __FlashStringHelper* s);
+    void print(const char* s);
+    void print(char c);
+    void print(long v);
+    void print(unsigned long v);
+    void print(int v) { print((long)v); }
+    void print(unsigned int v) { print((unsigned long)v); }
+    void print(double v, int decimals = 2);
+
+    void println();
+    template <typename T> void println(T v) { print(v); println(); }
+    void println(double v, int decimals) { print(v, decimals); println(); }
+
+    // Vuelca todas las líneas (de la más antigua a la más nueva)
+    void dumpTo(Print& out) const;
+    void clear();
+
+    size_t used() const { return (uint16_t)(head - tail); }
+    unsigned long dropped() const { return droppedRecords; }
+};
+
+extern LogRing logRing;
+
+// Atajos históricos del sketch (imprimen en el mirror y guardan en la arena)
+template <typename T> inline void logPrint(const T& v) { logRing.print(v); }
+template <typename T> inline void logPrintln(const T& v) { logRing.println(v); }
+inline void logPrint(double v, int decimals) { logRing.print(v, decimals); }
+inline void logPrintln(double v, int decimals) { logRing.println(v, decimals); }
+inline void logPrintln() { logRing.println(); }
+
+#endif // LOG_RING_H
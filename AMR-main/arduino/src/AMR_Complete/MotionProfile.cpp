@@ -0,0 +1,132 @@
+#include "MotionProfile.h"
+#include <math.h>
+
+#define PROFILE_SOLVE_ITERATIONS 24
+#define PROFILE_HOLD_SLACK_FACTOR 4.0f   // holdSlack = factor * tolerancia
+
+void MotionProfile::rampFor(float v, float aMax) {
+    // Rampa 0 -> v: si v < aMax²/jerk la aceleración no llega a aMax
+    if (v * jerk < aMax * aMax) {
+        peakAcc = sqrtf(v * jerk);
+        tJerk = peakAcc / jerk;
+        tAccel = 0.0f;
+    } else {
+        peakAcc = aMax;
+        tJerk = aMax / jerk;
+        tAccel = v / aMax - tJerk;
+    }
+    tRamp = 2.0f * tJerk + tAccel;
+    rampDistance = 0.5f * v * tRamp;   // rampa simétrica: velocidad media v/2
+}
+
+void MotionProfile::plan(float dist, float vMax, float aMax, float jMax) {
+    distance = fabs(dist);
+    jerk = (jMax > 0.0f) ? jMax : 1.0f;
+    clock = 0.0f;
+    if (distance <= 0.0f || vMax <= 0.0f || aMax <= 0.0f) {
+        peakVel = peakAcc = tJerk = tAccel = tRamp = tCruise = rampDistance = 0.0f;
+        return;
+    }
+
+    peakVel = vMax;
+    rampFor(peakVel, aMax);
+    if (2.0f * rampDistance > distance) {
+        // No hay tramo de crucero: buscar el pico cuyas dos rampas suman la
+        // distancia (la distancia de rampa crece con v: bisección)
+        float lo = 0.0f;
+        float hi = vMax;
+        for (uint8_t i = 0; i < PROFILE_SOLVE_ITERATIONS; ++i) {
+            float mid = 0.5f * (lo + hi);
+            rampFor(mid, aMax);
+            if (2.0f * rampDistance > distance) hi = mid; else lo = mid;
+        }
+        peakVel = lo;
+        rampFor(peakVel, aMax);
+    }
+    tCruise = (peakVel > 0.0f) ? (distance - 2.0f * rampDistance) / peakVel : 0.0f;
+    if (tCruise < 0.0f) tCruise = 0.0f;
+}
+
+void MotionProfile::setTracking(float gain, float tol, float minVelocity) {
+    kp = gain;
+    tolerance = tol;
+    minVel = minVelocity;
+}
+
+MotionSetpoint MotionProfile::rampSample(float t) const {
+    MotionSetpoint sp;
+    sp.done = false;
+    if (t < tJerk) {
+        // jerk+
+        sp.acc = jerk * t;
+        sp.vel = 0.5f * jerk * t * t;
+        sp.pos = jerk * t * t * t / 6.0f;
+    } else if (t < tJerk + tAccel) {
+        // aceleración constante
+        float v1 = 0.5f * jerk * tJerk * tJerk;
+        float s1 = jerk * tJerk * tJerk * tJerk / 6.0f;
+        float tau = t - tJerk;
+        sp.acc = peakAcc;
+        sp.vel = v1 + peakAcc * tau;
+        sp.pos = s1 + v1 * tau + 0.5f * peakAcc * tau * tau;
+    } else {
+        // jerk-: simétrico del primer tramo visto desde el final de la rampa
+        float tau = tRamp - t;
+        if (tau < 0.0f) tau = 0.0f;
+        sp.acc = jerk * tau;
+        sp.vel = peakVel - 0.5f * jerk * tau * tau;
+        sp.pos = rampDistance - (peakVel * tau - jerk * tau * tau * tau / 6.0f);
+    }
+    return sp;
+}
+
+MotionSetpoint MotionProfile::sample(float t) const {
+    MotionSetpoint sp;
+    sp.done = false;
+    float total = getDuration();
+    if (t <= 0.0f) {
+        sp.pos = sp.vel = sp.acc = 0.0f;
+    } else if (t >= total) {
+        sp.pos = distance;
+        sp.vel = sp.acc = 0.0f;
+    } else if (t < tRamp) {
+        sp = rampSample(t);
+    } else if (t < tRamp + tCruise) {
+        sp.pos = rampDistance + peakVel * (t - tRamp);
+        sp.vel = peakVel;
+        sp.acc = 0.0f;
+    } else {
+        // Frenado: espejo de la rampa de subida
+        MotionSetpoint r = rampSample(total - t);
+        sp.pos = distance - r.pos;
+        sp.vel = r.vel;
+        sp.acc = -r.acc;
+    }
+    return sp;
+}
+
+MotionSetpoint MotionProfile::track(float measured, float dt) {
+    float total = getDuration();
+    // No adelantar el perfil si el robot va retrasado
+    MotionSetpoint now = sample(clock);
+    if (measured >= now.pos - PROFILE_HOLD_SLACK_FACTOR * tolerance) {
+        clock += dt;
+        if (clock > total) clock = total;
+    }
+
+    MotionSetpoint sp = sample(clock);
+    float remaining = distance - measured;
+    sp.done = remaining <= tolerance;
+    if (sp.done) {
+        sp.vel = 0.0f;
+        return sp;
+    }
+
+    sp.vel += kp * (sp.pos - measured);
+    // Al final del perfil (o si se quedó corto) acercarse a velocidad mínima
+    if (clock >= total && sp.vel < minVel) sp.vel = minVel;
+    if (sp.vel < 0.0f) sp.vel = 0.0f;           // nunca invertir el sentido
+    float cap = (peakVel > minVel) ? peakVel : minVel;
+    if (sp.vel > cap) sp.vel = cap;
+    return sp;
+}
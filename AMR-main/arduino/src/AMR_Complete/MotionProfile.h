@@ -0,0 +1,77 @@
+#pragma once
+
+#ifndef MOTION_PROFILE_H
+#define MOTION_PROFILE_H
+
+#include <Arduino.h>
+
+// ========================================
+//     PERFIL DE MOVIMIENTO (CURVA S)
+// ========================================
+// Genera consignas de velocidad parametrizadas en el tiempo para recorrer
+// una distancia (o un ángulo) partiendo y terminando en reposo, con límites
+// de velocidad, aceleración y jerk (perfil en S de 7 tramos):
+//
+//   jerk+ | a cte | jerk- | crucero | jerk- | a cte | jerk+
+//
+// Si la distancia es corta no se llega a vMax (o ni siquiera a aMax) y el
+// pico se reduce para que el perfil siga siendo simétrico.
+//
+// Las unidades son libres pero coherentes (mm, mm/s, mm/s², mm/s³ para
+// avances; grados, °/s... para giros). Se trabaja en magnitud: el llamador
+// aplica el sentido.
+//
+// Seguimiento (track): el reloj del perfil solo avanza si la medida no se
+// queda atrás más de holdSlack, así un robot frenado (curva cerrada, giro
+// en sitio del pure pursuit) no "pierde" la rampa de frenado. La consigna
+// incluye una corrección proporcional al error de posición.
+
+struct MotionSetpoint {
+    float pos;    // posición del perfil
+    float vel;    // velocidad a mandar (perfil + corrección)
+    float acc;    // aceleración del perfil
+    bool done;    // medida dentro de la tolerancia del final
+};
+
+class MotionProfile {
+private:
+    float distance = 0.0f;
+    float peakVel = 0.0f;
+    float jerk = 1.0f;
+    float peakAcc = 0.0f;
+    float tJerk = 0.0f;       // duración de cada tramo con jerk
+    float tAccel = 0.0f;      // duración del tramo con aceleración constante
+    float tRamp = 0.0f;       // 2 * tJerk + tAccel
+    float tCruise = 0.0f;
+    float rampDistance = 0.0f;
+    float clock = 0.0f;
+
+    float kp = 3.0f;          // 1/s
+    float tolerance = 0.0f;
+    float minVel = 0.0f;      // velocidad mínima para terminar de acercarse
+
+    void rampFor(float v, float aMax);
+    MotionSetpoint rampSample(float t) const;
+
+public:
+    // Calcular el perfil para recorrer |dist| desde reposo hasta reposo
+    void plan(float dist, float vMax, float aMax, float jMax);
+
+    // Parámetros de seguimiento: ganancia de posición (1/s), tolerancia de
+    // llegada y velocidad mínima de aproximación (unidades del perfil)
+    void setTracking(float gain, float tol, float minVelocity);
+
+    // Consigna pura en el instante t (s) desde el inicio
+    MotionSetpoint sample(float t) const;
+
+    // Un paso de seguimiento: avanza el reloj dt (s) y devuelve la consigna
+    // de velocidad para la posición medida
+    MotionSetpoint track(float measured, float dt);
+
+    float getDistance() const { return distance; }
+    float getDuration() const { return 2.0f * tRamp + tCruise; }
+    float getPeakVelocity() const { return peakVel; }
+    float getClock() const { return clock; }
+};
+
+#endif // MOTION_PROFILE_H
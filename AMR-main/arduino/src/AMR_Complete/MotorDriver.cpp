@@ -1,41 +1,66 @@
 #include "MotorDriver.h"
 
 void MotorDriver::init() {
-    // Configurar solo pines PWM como salida (enables externos)
-    // Motor Izquierdo
-    pinMode(MOTOR_LEFT_RPWM, OUTPUT);  // PWM Adelante
-    pinMode(MOTOR_LEFT_LPWM, OUTPUT);  // PWM Atrás
-    
-    // Motor Derecho
-    pinMode(MOTOR_RIGHT_RPWM, OUTPUT); // PWM Adelante
-    pinMode(MOTOR_RIGHT_LPWM, OUTPUT); // PWM Atrás
-    
-    // Los enables están alimentados externamente (siempre HIGH)
-    // No necesitamos configurar REN/LEN
+    // Solo pines PWM (enables externos, siempre HIGH): los configura el
+    // backend de timers, que deja todos los canales a 0
+    pwm.begin();
     
     // Inicializar en estado parado
     stop();
     
     Serial.println(F("=== BTS7960 Init ==="));
     Serial.println(F("MotIzq:10,11 MotDer:5,6"));
+    pwm.printInfo(Serial);
     Serial.println(F("Enables externos. Usa 'T'"));
 }
 
+// PWM 0..255 (con fracción si MOTOR_PWM_FINE) -> duty del backend
+static uint16_t pwmToDuty(float pwm) {
+#if MOTOR_PWM_FINE
+    long duty = lroundf(pwm * MOTOR_PWM_SUBSTEPS);
+#else
+    long duty = lroundf(pwm) * MOTOR_PWM_SUBSTEPS;
+#endif
+    if (duty < 0) duty = 0;
+    if (duty > (long)MOTOR_PWM_FULL) duty = MOTOR_PWM_FULL;
+    return (uint16_t)duty;
+}
+
+// PWM con signo en un puente BTS7960: adelante = LPWM, atrás = RPWM
+void MotorDriver::writeBridge(uint8_t rpwmChannel, uint8_t lpwmChannel, float pwmValue) {
+    if (pwmValue > 0.0f) {
+        pwm.write(rpwmChannel, 0);
+        pwm.write(lpwmChannel, pwmToDuty(pwmValue));
+    } else if (pwmValue < 0.0f) {
+        pwm.write(rpwmChannel, pwmToDuty(-pwmValue));
+        pwm.write(lpwmChannel, 0);
+    } else {
+        pwm.write(rpwmChannel, 0);
+        pwm.write(lpwmChannel, 0);
+    }
+}
+
+void MotorDriver::writeLeft(float pwmValue) {
+    outputLeft = pwmValue;
+    writeBridge(MOTOR_PWM_LEFT_R, MOTOR_PWM_LEFT_L, pwmValue);
+}
+
+void MotorDriver::writeRight(float pwmValue) {
+    outputRight = pwmValue;
+    writeBridge(MOTOR_PWM_RIGHT_R, MOTOR_PWM_RIGHT_L, pwmValue);
+}
+
 void MotorDriver::moveForward(int speed) {
     // Limitar velocidad mínima y máxima
     speed = constrain(speed, MIN_SPEED, MAX_SPEED);
     
     // Aplicar factor de compensación al motor derecho para corregir curva a la derecha
-    int rightSpeed = (int)round((float)speed * RIGHT_MOTOR_COMPENSATION);
+    int rightSpeed = (int)round((float)speed * rightCompensation);
     rightSpeed = constrain(rightSpeed, 0, MAX_SPEED); // Asegurar que no exceda el máximo
     
-    // Motor izquierdo hacia adelante (LPWM activo - corregido)
-    analogWrite(MOTOR_LEFT_RPWM, 0);       // PWM adelante = 0
-    analogWrite(MOTOR_LEFT_LPWM, speed);   // PWM atrás
-    
-    // Motor derecho hacia adelante (LPWM activo - corregido) con compensación
-    analogWrite(MOTOR_RIGHT_RPWM, 0);      // PWM adelante = 0
-    analogWrite(MOTOR_RIGHT_LPWM, rightSpeed);  // PWM atrás con compensación
+    // Ambos motores hacia adelante (LPWM activo - corregido), derecho con compensación
+    writeLeft(speed);
+    writeRight(rightSpeed);
 }
 
 void MotorDriver::moveBackward(int speed) {
@@ -43,16 +68,12 @@ void MotorDriver::moveBackward(int speed) {
     speed = constrain(speed, MIN_SPEED, MAX_SPEED);
     
     // Aplicar factor de compensación al motor derecho para corregir curva a la derecha
-    int rightSpeed = (int)round((float)speed * RIGHT_MOTOR_COMPENSATION);
+    int rightSpeed = (int)round((float)speed * rightCompensation);
     rightSpeed = constrain(rightSpeed, 0, MAX_SPEED); // Asegurar que no exceda el máximo
     
-    // Motor izquierdo hacia atrás (RPWM activo - corregido)
-    analogWrite(MOTOR_LEFT_RPWM, speed);   // PWM adelante
-    analogWrite(MOTOR_LEFT_LPWM, 0);       // PWM atrás = 0
-    
-    // Motor derecho hacia atrás (RPWM activo - corregido) con compensación
-    analogWrite(MOTOR_RIGHT_RPWM, rightSpeed);  // PWM adelante con compensación
-    analogWrite(MOTOR_RIGHT_LPWM, 0);      // PWM atrás = 0
+    // Ambos motores hacia atrás (RPWM activo - corregido), derecho con compensación
+    writeLeft(-speed);
+    writeRight(-rightSpeed);
 }
 
 void MotorDriver::turnLeft(int speed) {
@@ -66,22 +87,17 @@ void MotorDriver::turnLeft(int speed) {
 
     if (speed == 0) {
         // stop motors if zero requested
-        analogWrite(MOTOR_LEFT_RPWM, 0);
-        analogWrite(MOTOR_LEFT_LPWM, 0);
-        analogWrite(MOTOR_RIGHT_RPWM, 0);
-        analogWrite(MOTOR_RIGHT_LPWM, 0);
+        stop();
         return;
     }
 
     // Motor izquierdo hacia atrás (giro en su lugar)
-    analogWrite(MOTOR_LEFT_RPWM, speed);   // PWM adelante
-    analogWrite(MOTOR_LEFT_LPWM, 0);       // PWM atrás = 0
+    writeLeft(-speed);
     Serial.print(F("IzqR="));
     Serial.println(speed);
 
     // Motor derecho hacia adelante
-    analogWrite(MOTOR_RIGHT_RPWM, 0);      // PWM adelante = 0
-    analogWrite(MOTOR_RIGHT_LPWM, speed);  // PWM atrás
+    writeRight(speed);
     Serial.print(F("DerL="));
     Serial.println(speed);
 }
@@ -94,54 +110,35 @@ void MotorDriver::turnRight(int speed) {
     Serial.println(speed);
 
     if (speed == 0) {
-        analogWrite(MOTOR_LEFT_RPWM, 0);
-        analogWrite(MOTOR_LEFT_LPWM, 0);
-        analogWrite(MOTOR_RIGHT_RPWM, 0);
-        analogWrite(MOTOR_RIGHT_LPWM, 0);
+        stop();
         return;
     }
 
     // Motor izquierdo hacia adelante
-    analogWrite(MOTOR_LEFT_RPWM, 0);       // PWM adelante = 0
-    analogWrite(MOTOR_LEFT_LPWM, speed);   // PWM atrás
+    writeLeft(speed);
     Serial.print(F("IzqL="));
     Serial.println(speed);
 
     // Motor derecho hacia atrás
-    analogWrite(MOTOR_RIGHT_RPWM, speed);  // PWM adelante
-    analogWrite(MOTOR_RIGHT_LPWM, 0);      // PWM atrás = 0
+    writeRight(-speed);
     Serial.print(F("DerR="));
     Serial.println(speed);
 }
 
 void MotorDriver::stop() {
     // Parar ambos motores BTS7960 (todos los PWM a 0)
-    analogWrite(MOTOR_LEFT_RPWM, 0);
-    analogWrite(MOTOR_LEFT_LPWM, 0);
-    analogWrite(MOTOR_RIGHT_RPWM, 0);
-    analogWrite(MOTOR_RIGHT_LPWM, 0);
+    writeLeft(0.0f);
+    writeRight(0.0f);
 }
 
 void MotorDriver::setLeftMotor(int speed) {
     // Limitar velocidad entre -255 y 255
     speed = constrain(speed, -MAX_SPEED, MAX_SPEED);
     
-    if (speed > 0) {
-        // Hacia adelante - usar LPWM (corregido)
-        if (speed < MIN_SPEED) speed = MIN_SPEED; // Velocidad mínima
-        analogWrite(MOTOR_LEFT_RPWM, 0);
-        analogWrite(MOTOR_LEFT_LPWM, speed);
-    } else if (speed < 0) {
-        // Hacia atrás - usar RPWM (corregido)
-        int absSpeed = -speed;
-        if (absSpeed < MIN_SPEED) absSpeed = MIN_SPEED;
-        analogWrite(MOTOR_LEFT_RPWM, absSpeed);
-        analogWrite(MOTOR_LEFT_LPWM, 0);
-    } else {
-        // Parado
-        analogWrite(MOTOR_LEFT_RPWM, 0);
-        analogWrite(MOTOR_LEFT_LPWM, 0);
-    }
+    // Velocidad mínima en ambos sentidos (0 = parado)
+    if (speed > 0 && speed < MIN_SPEED) speed = MIN_SPEED;
+    if (speed < 0 && speed > -MIN_SPEED) speed = -MIN_SPEED;
+    writeLeft(speed);
 }
 
 void MotorDriver::setRightMotor(int speed) {
@@ -149,26 +146,12 @@ void MotorDriver::setRightMotor(int speed) {
     speed = constrain(speed, -MAX_SPEED, MAX_SPEED);
     
     // Aplicar factor de compensación para corregir curva a la derecha
-    int compensatedSpeed = (int)round((float)speed * RIGHT_MOTOR_COMPENSATION);
+    int compensatedSpeed = (int)round((float)speed * rightCompensation);
     compensatedSpeed = constrain(compensatedSpeed, -MAX_SPEED, MAX_SPEED);
     
-    if (compensatedSpeed > 0) {
-        // Hacia adelante - usar LPWM (corregido)
-        int finalSpeed = compensatedSpeed;
-        if (finalSpeed < MIN_SPEED && finalSpeed > 0) finalSpeed = MIN_SPEED;
-        analogWrite(MOTOR_RIGHT_RPWM, 0);
-        analogWrite(MOTOR_RIGHT_LPWM, finalSpeed);
-    } else if (compensatedSpeed < 0) {
-        // Hacia atrás - usar RPWM (corregido)
-        int absSpeed = -compensatedSpeed;
-        if (absSpeed < MIN_SPEED && absSpeed > 0) absSpeed = MIN_SPEED;
-        analogWrite(MOTOR_RIGHT_RPWM, absSpeed);
-        analogWrite(MOTOR_RIGHT_LPWM, 0);
-    } else {
-        // Parado
-        analogWrite(MOTOR_RIGHT_RPWM, 0);
-        analogWrite(MOTOR_RIGHT_LPWM, 0);
-    }
+    if (compensatedSpeed > 0 && compensatedSpeed < MIN_SPEED) compensatedSpeed = MIN_SPEED;
+    if (compensatedSpeed < 0 && compensatedSpeed > -MIN_SPEED) compensatedSpeed = -MIN_SPEED;
+    writeRight(compensatedSpeed);
 }
 
 void MotorDriver::setBothMotors(int leftSpeed, int rightSpeed) {
@@ -176,42 +159,75 @@ void MotorDriver::setBothMotors(int leftSpeed, int rightSpeed) {
     setRightMotor(rightSpeed);
 }
 
-void MotorDriver::testMotors() {
+void MotorDriver::setRawMotors(int leftPwm, int rightPwm) {
+    setRawMotorsFine((float)leftPwm, (float)rightPwm);
+}
+
+void MotorDriver::setRawMotorsFine(float leftPwm, float rightPwm) {
+    // En lazo cerrado el PID corrige la asimetría entre motores: sin
+    // RIGHT_MOTOR_COMPENSATION ni MIN_SPEED (que saturaría velocidades bajas)
+    writeLeft(constrain(leftPwm, (float)-MAX_SPEED, (float)MAX_SPEED));
+    writeRight(constrain(rightPwm, (float)-MAX_SPEED, (float)MAX_SPEED));
+}
+
+// Test de motores: cada tramo de TEST_RUN_MS y después TEST_PAUSE_MS parado
+struct MotorTestStep {
+    int8_t left;                  // -1, 0, 1: sentido de cada motor
+    int8_t right;
+};
+static const MotorTestStep MOTOR_TEST_STEPS[] = {
+    { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }
+};
+static const uint8_t MOTOR_TEST_STEP_COUNT = sizeof(MOTOR_TEST_STEPS) / sizeof(MOTOR_TEST_STEPS[0]);
+static const unsigned long TEST_RUN_MS = 1000;
+static const unsigned long TEST_PAUSE_MS = 300;
+static const int TEST_PWM = 150;
+
+void MotorDriver::startTest(unsigned long nowMs) {
     Serial.println(F("=== TEST MOTORES ==="));
-    
-    // Test Motor Izquierdo Adelante
-    Serial.println(F("Izq+"));
-    analogWrite(MOTOR_LEFT_RPWM, 0);
-    analogWrite(MOTOR_LEFT_LPWM, 150);
-    delay(1000);
-    stop();
-    delay(300);
-    
-    // Test Motor Izquierdo Atrás  
-    Serial.println(F("Izq-"));
-    analogWrite(MOTOR_LEFT_RPWM, 150);
-    analogWrite(MOTOR_LEFT_LPWM, 0);
-    delay(1000);
-    stop();
-    delay(300);
-    
-    // Test Motor Derecho Adelante
-    Serial.println(F("Der+"));
-    analogWrite(MOTOR_RIGHT_RPWM, 0);
-    analogWrite(MOTOR_RIGHT_LPWM, 150);
-    delay(1000);
-    stop();
-    delay(300);
-    
-    // Test Motor Derecho Atrás
-    Serial.println(F("Der-"));
-    analogWrite(MOTOR_RIGHT_RPWM, 150);
-    analogWrite(MOTOR_RIGHT_LPWM, 0);
-    delay(1000);
+    testRunning = true;
+    testStep = 0;
+    testPausing = true;           // arranca con el primer tramo en la siguiente pasada
+    testStepStartMs = nowMs - TEST_PAUSE_MS;
+}
+
+bool MotorDriver::updateTest(unsigned long nowMs) {
+    if (!testRunning) return false;
+    unsigned long elapsed = nowMs - testStepStartMs;
+
+    if (testPausing) {
+        if (elapsed < TEST_PAUSE_MS) return true;
+        if (testStep >= MOTOR_TEST_STEP_COUNT) {
+            testRunning = false;
+            Serial.println(F("Test OK"));
+            return false;
+        }
+        const MotorTestStep& st = MOTOR_TEST_STEPS[testStep];
+        if (st.left > 0) Serial.println(F("Izq+"));
+        else if (st.left < 0) Serial.println(F("Izq-"));
+        else if (st.right > 0) Serial.println(F("Der+"));
+        else Serial.println(F("Der-"));
+        writeLeft(st.left * TEST_PWM);
+        writeRight(st.right * TEST_PWM);
+        testPausing = false;
+        testStepStartMs = nowMs;
+        return true;
+    }
+
+    if (elapsed >= TEST_RUN_MS) {
+        stop();
+        testStep++;
+        testPausing = true;
+        testStepStartMs = nowMs;
+    }
+    return true;
+}
+
+void MotorDriver::abortTest() {
+    if (!testRunning) return;
+    testRunning = false;
     stop();
-    delay(300);
-    
-    Serial.println(F("Test OK"));
+    Serial.println(F("Test cancelado"));
 }
 
 // --------------------
@@ -229,7 +245,9 @@ void MotorDriver::enableVelocityControl(bool en) {
         appliedPpsRight = 0.0f;
         // ensure motors are stopped or left under direct control
     } else {
-        lastPIDMillis = millis();
+        accDeltaLeft = 0;
+        accDeltaRight = 0;
+        accDtMs = 0;
     }
     Serial.print(F("VelocityControl "));
     Serial.println(en ? F("ENABLED") : F("DISABLED"));
@@ -268,6 +286,31 @@ void MotorDriver::setTargetPulsesPerSecondBoth(float leftPps, float rightPps) {
     }
 }
 
+void MotorDriver::zeroTargets() {
+    // La rampa no baja hacia un objetivo 0 (su paso es proporcional a él):
+    // fijar también lo aplicado. El integral de avance ya no sirve
+    targetPpsLeft = 0.0f;
+    targetPpsRight = 0.0f;
+    appliedPpsLeft = 0.0f;
+    appliedPpsRight = 0.0f;
+    integralL = 0.0f;
+    integralR = 0.0f;
+}
+
+bool MotorDriver::rampTargetsToZero(float maxDeltaPps) {
+    float peak = max(fabsf(appliedPpsLeft), fabsf(appliedPpsRight));
+    if (peak <= maxDeltaPps) {
+        zeroTargets();
+        return true;
+    }
+    float scale = 1.0f - maxDeltaPps / peak;
+    appliedPpsLeft *= scale;
+    appliedPpsRight *= scale;
+    targetPpsLeft = appliedPpsLeft;
+    targetPpsRight = appliedPpsRight;
+    return false;
+}
+
 void MotorDriver::setPIDGains(float kp, float ki, float kd) {
     // set same gains for both motors
     KpL = KpR = kp;
@@ -283,6 +326,12 @@ void MotorDriver::setRightPIDGains(float kp, float ki, float kd) {
     KpR = kp; KiR = ki; KdR = kd;
 }
 
+void MotorDriver::setFeedforward(float kffLeft, float kffRight, float staticPwm) {
+    kffL = kffLeft;
+    kffR = kffRight;
+    kStaticPwm = staticPwm;
+}
+
 void MotorDriver::setPIDInterval(unsigned int ms) {
     if (ms < 5) ms = 5;
     pidIntervalMs = ms;
@@ -292,23 +341,49 @@ void MotorDriver::setRampTime(unsigned long ms) {
     rampTimeMs = ms;
 }
 
-// updateVelocityControl: called from main loop with encoder delta counts and elapsed ms
+// updateVelocityControl: called from the control task with encoder delta counts and elapsed ms
 // Interpola lecturas de ambos encoders para generar un valor único y aplicar un solo PID
 void MotorDriver::updateVelocityControl(long leftDeltaPulses, long rightDeltaPulses, unsigned long dtMs) {
     if (!velocityControlEnabled) return;
     if (dtMs == 0) return;
 
-    // Only run at configured interval
-    unsigned long now = millis();
-    if (now - lastPIDMillis < pidIntervalMs) return;
-    unsigned long elapsed = now - lastPIDMillis;
-    lastPIDMillis = now;
+    // Acumular deltas hasta completar el intervalo del PID. El scheduler llama
+    // a 200 Hz con deltas de 5 ms; medir con el dt recibido (y no con millis())
+    // evita mezclar pulsos de una ventana con el tiempo de otra.
+    accDeltaLeft += leftDeltaPulses;
+    accDeltaRight += rightDeltaPulses;
+    accDtMs += dtMs;
+    if (accDtMs < pidIntervalMs) return;
+    unsigned long elapsed = accDtMs;
+    long deltaL = accDeltaLeft;
+    long deltaR = accDeltaRight;
+    accDeltaLeft = 0;
+    accDeltaRight = 0;
+    accDtMs = 0;
 
     float dt = (float)elapsed / 1000.0f; // seconds
 
     // Measured pulses per second per motor
-    float measPpsL = ((float)leftDeltaPulses) / dt;
-    float measPpsR = ((float)rightDeltaPulses) / dt;
+    applyVelocityPID(((float)deltaL) / dt, ((float)deltaR) / dt, elapsed);
+}
+
+// Variante con velocidad ya estimada (Encoder::sampleVelocity, por periodos
+// entre flancos): el PID usa la medida más reciente en cada actualización en
+// lugar de esperar a que se acumule una ventana de pulsos.
+void MotorDriver::updateVelocityControlPps(float measPpsL, float measPpsR, unsigned long dtMs) {
+    if (!velocityControlEnabled) return;
+    if (dtMs == 0) return;
+
+    accDtMs += dtMs;
+    if (accDtMs < pidIntervalMs) return;
+    unsigned long elapsed = accDtMs;
+    accDtMs = 0;
+    applyVelocityPID(measPpsL, measPpsR, elapsed);
+}
+
+// Rampa + PID por motor con la velocidad medida y el tiempo transcurrido
+void MotorDriver::applyVelocityPID(float measPpsL, float measPpsR, unsigned long elapsed) {
+    float dt = (float)elapsed / 1000.0f; // seconds
 
     // Soft-start ramp applied setpoint towards target (per motor)
     if (rampTimeMs > 0) {
@@ -345,6 +420,9 @@ void MotorDriver::updateVelocityControl(long leftDeltaPulses, long rightDeltaPul
     float derivativeL = (errorL - prevErrorL) / dt;
     prevErrorL = errorL;
     float pidOutL = KpL * errorL + KiL * integralL + KdL * derivativeL;
+    if (appliedPpsLeft != 0.0f) {
+        pidOutL += kffL * appliedPpsLeft + (appliedPpsLeft > 0.0f ? kStaticPwm : -kStaticPwm);
+    }
 
     float errorR = appliedPpsRight - measPpsR;
     integralR += errorR * dt;
@@ -353,14 +431,17 @@ void MotorDriver::updateVelocityControl(long leftDeltaPulses, long rightDeltaPul
     float derivativeR = (errorR - prevErrorR) / dt;
     prevErrorR = errorR;
     float pidOutR = KpR * errorR + KiR * integralR + KdR * derivativeR;
+    if (appliedPpsRight != 0.0f) {
+        pidOutR += kffR * appliedPpsRight + (appliedPpsRight > 0.0f ? kStaticPwm : -kStaticPwm);
+    }
 
-    int pwmLeft = (int)round(pidOutL);
-    int pwmRight = (int)round(pidOutR * RIGHT_MOTOR_COMPENSATION);
-    pwmLeft = constrain(pwmLeft, -MAX_SPEED, MAX_SPEED);
-    pwmRight = constrain(pwmRight, -MAX_SPEED, MAX_SPEED);
+    // Sin RIGHT_MOTOR_COMPENSATION: el PID del motor derecho ya la corrige.
+    // Sin redondear: el backend conserva la fracción (MOTOR_PWM_FINE)
+    float pwmLeft = constrain(pidOutL, (float)-MAX_SPEED, (float)MAX_SPEED);
+    float pwmRight = constrain(pidOutR, (float)-MAX_SPEED, (float)MAX_SPEED);
 
     // Aplicar PWM a ambos motores
-    setBothMotors(pwmLeft, pwmRight);
+    setRawMotorsFine(pwmLeft, pwmRight);
 
     // Optional debug print (comment/uncomment for tuning)
     // Serial.print(F("PID dt:")); Serial.print(dt, 3);
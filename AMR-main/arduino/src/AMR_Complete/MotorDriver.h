@@ -4,6 +4,7 @@
 #define MOTOR_DRIVER_H
 
 #include <Arduino.h>
+#include "MotorPwm.h"
 
 // Pines para control de motores BTS7960 - Configuración real
 // Motor Izquierdo (BTS7960 #1)
@@ -25,13 +26,17 @@
 #define DEFAULT_SPEED 102    // Velocidad por defecto para avance (≈40% de MAX)
 #define TURN_SPEED 51        // Velocidad para giros automáticos (≈20% de MAX)
 #define MIN_SPEED 80         // Velocidad mínima para superar fricción
+#define RIGHT_MOTOR_COMPENSATION 0.85f   // valor por defecto sin calibración
 
 class MotorDriver {
 private:
     // --- PID velocity control members ---
     bool velocityControlEnabled = false;
-    unsigned long lastPIDMillis = 0;
     unsigned int pidIntervalMs = 50; // PID update interval (ms)
+    // Deltas acumulados entre actualizaciones del PID
+    long accDeltaLeft = 0;
+    long accDeltaRight = 0;
+    unsigned long accDtMs = 0;
 
     // Target speed (pulses per second) - ahora por motor
     float targetPpsLeft = 0.0f;
@@ -52,7 +57,15 @@ private:
     float integralR = 0.0f;
     float prevErrorR = 0.0f;
 
-    float integralClamp = 500.0f; // anti-windup (shared)
+    // anti-windup (shared). Con Ki = 0.02 limita la corrección integral a ±50 PWM
+    float integralClamp = 2500.0f;
+
+    // Feedforward: PWM ≈ kff * pps + kStatic * signo. El PID solo corrige
+    // alrededor de esta estimación. Valores iniciales (cuentas 4x), afinar en
+    // hardware: con PWM fijo en el suelo, kff = (PWM - kStatic) / pps estable.
+    float kffL = 0.02f;
+    float kffR = 0.02f;
+    float kStaticPwm = 40.0f;
 
     // Soft-start ramp time in ms (time to go from 0 -> target)
     unsigned long rampTimeMs = 600;
@@ -60,7 +73,26 @@ private:
     // Factor de compensación para motor derecho (corrige curva a la derecha)
     // Si el robot se curva a la derecha, reducir este valor (< 1.0)
     // Si el robot se curva a la izquierda, aumentar este valor (> 1.0)
-    static constexpr float RIGHT_MOTOR_COMPENSATION = 0.85f;
+    // Solo en lazo abierto; lo ajusta la calibración ('C', ver Calibration.h)
+    float rightCompensation = RIGHT_MOTOR_COMPENSATION;
+
+    // Test de motores en curso (ver startTest)
+    bool testRunning = false;
+    bool testPausing = false;
+    uint8_t testStep = 0;
+    unsigned long testStepStartMs = 0;
+
+    // Backend de timers (MotorPwm.h): todos los PWM pasan por aquí
+    MotorPwm pwm;
+    // Última orden de cada puente (PWM con signo), para el grabador
+    float outputLeft = 0.0f;
+    float outputRight = 0.0f;
+
+    void applyVelocityPID(float measPpsL, float measPpsR, unsigned long elapsedMs);
+    // PWM con signo (-255..255, adelante > 0) en cada puente
+    void writeBridge(uint8_t rpwmChannel, uint8_t lpwmChannel, float pwmValue);
+    void writeLeft(float pwmValue);
+    void writeRight(float pwmValue);
     
 public:
     void init();
@@ -76,9 +108,21 @@ public:
     void setLeftMotor(int speed);   // speed: -255 a 255
     void setRightMotor(int speed);  // speed: -255 a 255
     void setBothMotors(int leftSpeed, int rightSpeed);
+    // PWM directo sin mínimo ni compensación (lo usa el PID de velocidad)
+    void setRawMotors(int leftPwm, int rightPwm);
+    // Igual con fracción de paso (resolución del timer, ver MotorPwm.h)
+    void setRawMotorsFine(float leftPwm, float rightPwm);
     
-    // Funciones de diagnóstico
-    void testMotors();              // Test automático de motores
+    // Test automático de motores (izq +/-, der +/-), sin bloquear: start
+    // y después updateTest() periódico hasta que devuelva false
+    void startTest(unsigned long nowMs);
+    bool updateTest(unsigned long nowMs);
+    void abortTest();               // para los motores
+    bool isTestRunning() const { return testRunning; }
+
+    // PWM con signo escrito por última vez en cada motor (adelante > 0)
+    float getLeftOutput() const { return outputLeft; }
+    float getRightOutput() const { return outputRight; }
     
     // --- Velocity PID API ---
     // Enable/disable closed-loop velocity control
@@ -90,6 +134,16 @@ public:
     void setLeftPIDGains(float kp, float ki, float kd);
     void setRightPIDGains(float kp, float ki, float kd);
 
+    // Feedforward por motor (PWM por pps) y PWM estático para vencer fricción
+    void setFeedforward(float kffLeft, float kffRight, float staticPwm);
+    float getFeedforwardLeft() { return kffL; }
+    float getFeedforwardRight() { return kffR; }
+    float getStaticPwm() { return kStaticPwm; }
+
+    // Compensación del motor derecho en los movimientos de lazo abierto
+    void setRightCompensation(float k) { rightCompensation = k; }
+    float getRightCompensation() { return rightCompensation; }
+
     // Set PID update interval
     void setPIDInterval(unsigned int ms);
 
@@ -103,10 +157,19 @@ public:
     void setTargetPulsesPerSecondLeft(float pps);
     void setTargetPulsesPerSecondRight(float pps);
     void setTargetPulsesPerSecondBoth(float leftPps, float rightPps);
-
-    // Must be called periodically (from main loop) with encoder deltas and dt
-    // Interpola lecturas de ambos encoders y usa un solo PID
+    // Consigna a 0 sin rampa y sin soltar el PID (frena activamente). Apta
+    // para la tarea de control (ISR): no escribe en Serial
+    void zeroTargets();
+    // Bajar la consigna aplicada hacia 0, como mucho maxDeltaPps en la rueda
+    // más rápida y en proporción en la otra (conserva la curvatura). Apta
+    // para la ISR de control; devuelve true cuando ya está en 0
+    bool rampTargetsToZero(float maxDeltaPps);
+
+    // Must be called periodically (control task) with encoder deltas and dt.
+    // Acumula deltas y ejecuta el PID cada pidIntervalMs de dt acumulado
     void updateVelocityControl(long leftDeltaPulses, long rightDeltaPulses, unsigned long dtMs);
+    // Igual, pero con velocidades medidas (pulsos/s) en lugar de deltas
+    void updateVelocityControlPps(float measPpsL, float measPpsR, unsigned long dtMs);
 };
 
 #endif // MOTOR_DRIVER_H
\ No newline at end of file
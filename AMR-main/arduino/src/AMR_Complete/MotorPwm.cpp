@@ -0,0 +1,132 @@
+#include "MotorPwm.h"
+#include "MotorDriver.h"         // pines MOTOR_*_PWM
+#include "CriticalSection.h"
+
+static const uint8_t MOTOR_PWM_PINS[MOTOR_PWM_CHANNELS] = {
+    MOTOR_LEFT_RPWM, MOTOR_LEFT_LPWM, MOTOR_RIGHT_RPWM, MOTOR_RIGHT_LPWM
+};
+
+#if defined(ARDUINO_ARCH_RENESAS)
+#include <pwm.h>
+
+static PwmOut pwmOut0(MOTOR_LEFT_RPWM);
+static PwmOut pwmOut1(MOTOR_LEFT_LPWM);
+static PwmOut pwmOut2(MOTOR_RIGHT_RPWM);
+static PwmOut pwmOut3(MOTOR_RIGHT_LPWM);
+static PwmOut* const pwmOuts[MOTOR_PWM_CHANNELS] = { &pwmOut0, &pwmOut1, &pwmOut2, &pwmOut3 };
+
+#elif defined(__AVR__)
+// Timer1: fase correcta, TOP = ICR1 -> F_CPU / (2 * ICR1)
+#define MOTOR_PWM_TIMER1_TOP (F_CPU / (2UL * MOTOR_PWM_FREQUENCY_HZ))
+
+static void avrConnect(volatile uint8_t& tccrA, uint8_t comBit, uint16_t counts) {
+    if (counts == 0) tccrA &= ~_BV(comBit);
+    else tccrA |= _BV(comBit);
+}
+
+// Devuelve el TOP del timer del pin, 0 si el pin no tiene salida de comparación
+static uint16_t avrPinTop(uint8_t pin) {
+    switch (pin) {
+        case 5: case 6: return 255;
+        case 9: case 10: return MOTOR_PWM_TIMER1_TOP;
+        case 3: case 11: return 255;
+        default: return 0;
+    }
+}
+
+static void avrSetDuty(uint8_t pin, uint16_t counts) {
+    switch (pin) {
+        case 6: OCR0A = counts; avrConnect(TCCR0A, COM0A1, counts); break;
+        case 5: OCR0B = counts; avrConnect(TCCR0A, COM0B1, counts); break;
+        case 9: { CriticalSection cs; OCR1A = counts; } avrConnect(TCCR1A, COM1A1, counts); break;
+        case 10: { CriticalSection cs; OCR1B = counts; } avrConnect(TCCR1A, COM1B1, counts); break;
+        case 11: OCR2A = counts; avrConnect(TCCR2A, COM2A1, counts); break;
+        case 3: OCR2B = counts; avrConnect(TCCR2A, COM2B1, counts); break;
+    }
+}
+#endif
+
+void MotorPwm::begin() {
+#if defined(__AVR__)
+    // Timer0 no se toca (millis y Scheduler). Timer1 modo 10, sin prescaler
+    TCCR1A = _BV(WGM11);
+    TCCR1B = _BV(WGM13) | _BV(CS10);
+    ICR1 = MOTOR_PWM_TIMER1_TOP;
+    // Timer2 modo 1 (fase correcta 8 bits), sin prescaler
+    TCCR2A = _BV(WGM20);
+    TCCR2B = _BV(CS20);
+#endif
+
+    for (uint8_t ch = 0; ch < MOTOR_PWM_CHANNELS; ++ch) {
+        uint8_t pin = MOTOR_PWM_PINS[ch];
+        pinMode(pin, OUTPUT);
+        digitalWrite(pin, LOW);
+        top[ch] = 255;
+        hardware[ch] = false;
+#if defined(ARDUINO_ARCH_RENESAS)
+        uint32_t period = R_FSP_SystemClockHzGet(FSP_PRIV_CLOCK_PCLKD) / MOTOR_PWM_FREQUENCY_HZ;
+        if (period <= 0xFFFF && pwmOuts[ch]->begin(period, 0, true)) {
+            top[ch] = (uint16_t)period;
+            hardware[ch] = true;
+        }
+#elif defined(__AVR__)
+        uint16_t t = avrPinTop(pin);
+        if (t != 0) {
+            top[ch] = t;
+            hardware[ch] = true;
+        }
+#endif
+        last[ch] = 0xFFFF;        // forzar la primera escritura
+        apply(ch, 0);
+    }
+    started = true;
+}
+
+void MotorPwm::apply(uint8_t ch, uint16_t counts) {
+    if (counts == last[ch]) return;
+    last[ch] = counts;
+    if (!hardware[ch]) {
+        analogWrite(MOTOR_PWM_PINS[ch], counts);
+        return;
+    }
+#if defined(ARDUINO_ARCH_RENESAS)
+    pwmOuts[ch]->pulseWidth_raw(counts);
+#elif defined(__AVR__)
+    avrSetDuty(MOTOR_PWM_PINS[ch], counts);
+#endif
+}
+
+void MotorPwm::write(uint8_t ch, uint16_t duty) {
+    if (ch >= MOTOR_PWM_CHANNELS || !started) return;
+    if (duty > MOTOR_PWM_FULL) duty = MOTOR_PWM_FULL;
+    uint16_t counts = (uint16_t)(((uint32_t)duty * top[ch] + MOTOR_PWM_FULL / 2) / MOTOR_PWM_FULL);
+    apply(ch, counts);
+}
+
+unsigned long MotorPwm::getFrequencyHz(uint8_t ch) const {
+    if (ch >= MOTOR_PWM_CHANNELS) return 0;
+    if (!hardware[ch]) return 490;            // analogWrite del core
+#if defined(__AVR__)
+    switch (MOTOR_PWM_PINS[ch]) {
+        case 5: case 6: return F_CPU / (64UL * 256UL);
+        case 9: case 10: return F_CPU / (2UL * MOTOR_PWM_TIMER1_TOP);
+        default: return F_CPU / 510UL;
+    }
+#else
+    return MOTOR_PWM_FREQUENCY_HZ;
+#endif
+}
+
+void MotorPwm::printInfo(Print& out) const {
+    out.print(F("PWM"));
+    for (uint8_t ch = 0; ch < MOTOR_PWM_CHANNELS; ++ch) {
+        out.print(F(" D"));
+        out.print(MOTOR_PWM_PINS[ch]);
+        out.print(':');
+        out.print(getFrequencyHz(ch));
+        out.print(F("Hz/"));
+        out.print(top[ch]);
+        if (!hardware[ch]) out.print(F("(aw)"));
+    }
+    out.println();
+}
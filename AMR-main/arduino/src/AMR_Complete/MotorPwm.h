@@ -0,0 +1,73 @@
+#pragma once
+
+#ifndef MOTOR_PWM_H
+#define MOTOR_PWM_H
+
+#include <Arduino.h>
+
+// ========================================
+//     PWM DE MOTORES POR TIMER HARDWARE
+// ========================================
+// Sustituye a analogWrite en los 4 pines PWM de los BTS7960: configura los
+// timers una vez en begin() y después cada actualización solo escribe el
+// registro de comparación del canal (sin la búsqueda de pin de analogWrite,
+// y nada si el duty no cambia).
+//
+// El duty se da en dieciseisavos de paso PWM (0..MOTOR_PWM_FULL, es decir
+// 0..255 * 16) y cada backend lo escala a sus cuentas de periodo:
+// - UNO R4 (Renesas): PwmOut del core en modo raw a MOTOR_PWM_FREQUENCY_HZ
+//   (20 kHz, fuera del rango audible). GPT a 48 MHz -> 2400 cuentas por
+//   periodo (~11 bits). El GPT escribe en los registros buffer y el cambio
+//   se aplica en el siguiente fin de periodo: sin glitches.
+// - AVR (Uno): pin 10 en Timer1 fase correcta con TOP = ICR1 (20 kHz,
+//   400 cuentas); pin 11 en Timer2 fase correcta 8 bits sin prescaler
+//   (31 kHz). Los pines 5 y 6 son del Timer0, que lleva millis() y el tick
+//   del Scheduler: siguen a ~976 Hz (solo se evita analogWrite). En los tres
+//   timers OCRnx tiene doble buffer y se actualiza en TOP/BOTTOM.
+//   Duty 0 desconecta la salida (el modo rápido del Timer0 deja un pulso de
+//   1/256 con OCR = 0).
+// - Otras placas: analogWrite de 8 bits.
+//
+// MOTOR_PWM_FINE 1 conserva la fracción del duty que calcula el PID
+// (mejor control a baja velocidad cerca de MIN_SPEED); con 0 se redondea a
+// pasos enteros de 0..255 como antes.
+
+#ifndef MOTOR_PWM_FINE
+#define MOTOR_PWM_FINE 1
+#endif
+
+#define MOTOR_PWM_FREQUENCY_HZ 20000UL
+#define MOTOR_PWM_SUBSTEPS 16                          // fracciones por paso 0..255
+#define MOTOR_PWM_FULL (255U * MOTOR_PWM_SUBSTEPS)     // duty 100 %
+
+enum MotorPwmChannel : uint8_t {
+    MOTOR_PWM_LEFT_R = 0,         // MOTOR_LEFT_RPWM
+    MOTOR_PWM_LEFT_L,             // MOTOR_LEFT_LPWM
+    MOTOR_PWM_RIGHT_R,            // MOTOR_RIGHT_RPWM
+    MOTOR_PWM_RIGHT_L,            // MOTOR_RIGHT_LPWM
+    MOTOR_PWM_CHANNELS
+};
+
+class MotorPwm {
+private:
+    uint16_t top[MOTOR_PWM_CHANNELS];       // cuentas de un periodo (duty 100 %)
+    uint16_t last[MOTOR_PWM_CHANNELS];      // últimas cuentas escritas
+    bool hardware[MOTOR_PWM_CHANNELS];      // false: analogWrite
+    bool started = false;                   // sin begin() no se tocan pines (instancias del banco)
+
+    void apply(uint8_t ch, uint16_t counts);
+
+public:
+    // Configurar timers y dejar todos los canales a 0
+    void begin();
+
+    // duty: 0..MOTOR_PWM_FULL (dieciseisavos de paso PWM)
+    void write(uint8_t ch, uint16_t duty);
+
+    uint16_t getTop(uint8_t ch) const { return top[ch]; }
+    bool isHardware(uint8_t ch) const { return hardware[ch]; }
+    unsigned long getFrequencyHz(uint8_t ch) const;
+    void printInfo(Print& out) const;
+};
+
+#endif // MOTOR_PWM_H
@@ -0,0 +1,109 @@
+#include "ObstacleTracker.h"
+
+void ObstacleTracker::reset() {
+    for (uint8_t i = 0; i < OBSTACLE_TRACK_CHANNELS; ++i) tracks[i] = ObstacleTrack();
+    robotSpeed = 0.0f;
+}
+
+void ObstacleTracker::update(const float* rangesCm, float robotSpeedCmS, float dtS) {
+    robotSpeed = robotSpeedCmS;
+    if (!(dtS > 0.0f)) return;
+    for (uint8_t i = 0; i < OBSTACLE_TRACK_CHANNELS; ++i) updateTrack(tracks[i], rangesCm[i], dtS);
+}
+
+void ObstacleTracker::startCandidate(ObstacleTrack& t, float rangeCm) {
+    t.valid = false;
+    t.consistentS = 0.0f;
+    t.outliers = 0;
+    t.candidate = rangeCm;
+    t.candidateCount = 1;
+}
+
+void ObstacleTracker::updateTrack(ObstacleTrack& t, float rangeCm, float dtS) {
+    // Nada delante dentro del alcance útil (también descarta NaN)
+    if (!(rangeCm <= OBSTACLE_TRACK_MAX_CM)) {
+        t.valid = false;
+        t.consistentS = 0.0f;
+        t.candidateCount = 0;
+        return;
+    }
+
+    if (!t.valid) {
+        float gate = OBSTACLE_TRACK_GATE_CM + OBSTACLE_TRACK_GATE_RATIO * t.candidate;
+        if (t.candidateCount == 0 || fabsf(rangeCm - t.candidate) > gate) {
+            startCandidate(t, rangeCm);
+            return;
+        }
+        t.candidate = rangeCm;
+        if (++t.candidateCount < OBSTACLE_TRACK_START) return;
+        t.valid = true;
+        t.range = rangeCm;
+        t.rate = -robotSpeed;
+        t.outliers = 0;
+        return;
+    }
+
+    float predicted = t.range + t.rate * dtS;
+    float residual = rangeCm - predicted;
+    float gate = OBSTACLE_TRACK_GATE_CM + OBSTACLE_TRACK_GATE_RATIO * predicted;
+    if (fabsf(residual) > gate) {
+        // Sin corrección: la pista sigue con la predicción
+        t.range = predicted;
+        t.consistentS = 0.0f;
+        if (++t.outliers >= OBSTACLE_TRACK_MAX_OUTLIERS) startCandidate(t, rangeCm);
+        return;
+    }
+    t.outliers = 0;
+    t.range = predicted + OBSTACLE_TRACK_ALPHA * residual;
+    t.rate += OBSTACLE_TRACK_BETA * residual / dtS;
+
+    float tol = OBSTACLE_RATE_TOL_CM_S + OBSTACLE_RATE_TOL_RATIO * fabsf(robotSpeed);
+    if (t.rate <= -robotSpeed + tol) t.consistentS += dtS;
+    else t.consistentS = 0.0f;
+}
+
+float ObstacleTracker::nearestRange() const {
+    float best = OBSTACLE_NONE_CM;
+    for (uint8_t i = 0; i < OBSTACLE_TRACK_CHANNELS; ++i) {
+        if (tracks[i].valid && tracks[i].range < best) best = tracks[i].range;
+    }
+    return best;
+}
+
+float ObstacleTracker::nearestRate() const {
+    float best = OBSTACLE_NONE_CM;
+    float rate = 0.0f;
+    for (uint8_t i = 0; i < OBSTACLE_TRACK_CHANNELS; ++i) {
+        if (tracks[i].valid && tracks[i].range < best) {
+            best = tracks[i].range;
+            rate = tracks[i].rate;
+        }
+    }
+    return rate;
+}
+
+bool ObstacleTracker::confirmed(float maxRangeCm) const {
+    for (uint8_t i = 0; i < OBSTACLE_TRACK_CHANNELS; ++i) {
+        const ObstacleTrack& t = tracks[i];
+        if (t.valid && t.range <= maxRangeCm && t.consistentS >= OBSTACLE_CONFIRM_S) return true;
+    }
+    return false;
+}
+
+float ObstacleTracker::timeToCollision(float speedCmS, float stopCm) const {
+    float best = OBSTACLE_TTC_NONE_S;
+    for (uint8_t i = 0; i < OBSTACLE_TRACK_CHANNELS; ++i) {
+        const ObstacleTrack& t = tracks[i];
+        if (!t.valid) continue;
+        float gap = t.range - stopCm;
+        if (gap <= 0.0f) return 0.0f;
+        // Velocidad propia del obstáculo hacia el robot (0 si está quieto o se aleja)
+        float own = -(t.rate + robotSpeed);
+        if (own < 0.0f) own = 0.0f;
+        float closing = speedCmS + own;
+        if (closing <= 0.0f) continue;
+        float ttc = gap / closing;
+        if (ttc < best) best = ttc;
+    }
+    return best;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#ifndef OBSTACLE_TRACKER_H
+#define OBSTACLE_TRACKER_H
+
+#include <Arduino.h>
+
+// ========================================
+//   SEGUIMIENTO DE OBSTÁCULOS FRONTALES
+// ========================================
+// Filtro alfa-beta por sensor frontal (FL, FR) sobre las distancias del
+// snapshot IR, a la tasa de la tarea motion:
+//     predicción  r' = r + v * dt
+//     residuo     e  = medida - r'
+//     r = r' + ALPHA * e,   v += BETA * e / dt
+// La velocidad de acercamiento v se contrasta con la del propio robot
+// (Odometry): un obstáculo quieto se acerca a la velocidad del robot.
+// - Una pista nueva necesita OBSTACLE_TRACK_START lecturas seguidas que
+//   coincidan; arranca con v = -velocidad del robot (obstáculo quieto).
+//   Un pico aislado nunca llega a pista.
+// - Residuos fuera de la ventana (OBSTACLE_TRACK_GATE_CM + ratio * r) no
+//   corrigen la pista; OBSTACLE_TRACK_MAX_OUTLIERS seguidos la terminan.
+// - Consistente: se acerca al menos a la velocidad del robot menos la
+//   tolerancia (quieto o viniendo hacia el robot). Tras OBSTACLE_CONFIRM_S
+//   consistente la pista queda confirmada; algo que cruza o se aleja no.
+// - TTC (tiempo hasta colisión) para una velocidad del robot dada: hueco
+//   hasta el margen de parada / (velocidad + velocidad propia del
+//   obstáculo hacia el robot).
+//
+// Unidades: cm, cm/s, s. Sin memoria dinámica.
+
+#define OBSTACLE_TRACK_CHANNELS 2          // FL, FR (orden de update())
+#define OBSTACLE_TRACK_ALPHA 0.4f
+#define OBSTACLE_TRACK_BETA 0.1f
+#define OBSTACLE_TRACK_MAX_CM 80.0f        // más allá la curva del Sharp es plana: sin pista
+#define OBSTACLE_TRACK_GATE_CM 4.0f
+#define OBSTACLE_TRACK_GATE_RATIO 0.15f    // la ventana crece con la distancia
+#define OBSTACLE_TRACK_START 2
+#define OBSTACLE_TRACK_MAX_OUTLIERS 3
+#define OBSTACLE_RATE_TOL_CM_S 8.0f
+#define OBSTACLE_RATE_TOL_RATIO 0.25f      // más la fracción de la velocidad del robot
+#define OBSTACLE_CONFIRM_S 0.2f
+#define OBSTACLE_NONE_CM 1000.0f           // nearestRange() sin pistas
+#define OBSTACLE_TTC_NONE_S 1000.0f        // timeToCollision() sin acercamiento
+
+struct ObstacleTrack {
+    bool valid = false;
+    float range = 0.0f;          // cm
+    float rate = 0.0f;           // cm/s (negativo: se acerca)
+    float consistentS = 0.0f;    // tiempo seguido con acercamiento consistente
+    float candidate = 0.0f;      // lectura que abre una pista nueva
+    uint8_t candidateCount = 0;
+    uint8_t outliers = 0;
+};
+
+class ObstacleTracker {
+private:
+    ObstacleTrack tracks[OBSTACLE_TRACK_CHANNELS];
+    float robotSpeed = 0.0f;     // cm/s de la última actualización
+
+    void updateTrack(ObstacleTrack& t, float rangeCm, float dtS);
+    void startCandidate(ObstacleTrack& t, float rangeCm);
+
+public:
+    void reset();
+
+    // Un paso: distancias frontales (cm, en el orden FL, FR), velocidad
+    // lineal del robot (cm/s, adelante +) y periodo (s)
+    void update(const float* rangesCm, float robotSpeedCmS, float dtS);
+
+    // Distancia filtrada de la pista más cercana (OBSTACLE_NONE_CM sin pistas)
+    float nearestRange() const;
+    // Velocidad de acercamiento de la pista más cercana (0 sin pistas)
+    float nearestRate() const;
+    // Alguna pista a menos de maxRangeCm confirmada por consistencia
+    bool confirmed(float maxRangeCm) const;
+    // TTC mínimo si el robot avanzara a speedCmS, con parada a stopCm
+    float timeToCollision(float speedCmS, float stopCm) const;
+
+    const ObstacleTrack& track(uint8_t i) const { return tracks[i]; }
+};
+
+#endif // OBSTACLE_TRACKER_H
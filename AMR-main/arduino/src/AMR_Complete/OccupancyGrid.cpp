@@ -0,0 +1,114 @@
+#include "OccupancyGrid.h"
+#include <math.h>
+
+// Celda par en el nibble bajo, impar en el alto
+uint8_t OccupancyGrid::get(int cx, int cy) const {
+    uint16_t i = (uint16_t)cy * OG_SIZE + cx;
+    uint8_t b = cells[i >> 1];
+    return (i & 1) ? (b >> 4) : (b & 0x0F);
+}
+
+void OccupancyGrid::set(int cx, int cy, uint8_t v) {
+    uint16_t i = (uint16_t)cy * OG_SIZE + cx;
+    uint8_t& b = cells[i >> 1];
+    b = (i & 1) ? (uint8_t)((b & 0x0F) | (v << 4)) : (uint8_t)((b & 0xF0) | (v & 0x0F));
+}
+
+void OccupancyGrid::adjust(int cx, int cy, int delta) {
+    if (cx < 0 || cy < 0 || cx >= OG_SIZE || cy >= OG_SIZE) return;
+    int v = get(cx, cy) + delta;
+    if (v < 0) v = 0;
+    if (v > 15) v = 15;
+    set(cx, cy, (uint8_t)v);
+}
+
+void OccupancyGrid::clear(float x, float y) {
+    memset(cells, (OG_UNKNOWN << 4) | OG_UNKNOWN, sizeof(cells));
+    // Origen alineado a la resolución para que las celdas no "bailen"
+    originX = (int16_t)(floorf(x / OG_RESOLUTION_CM) - OG_SIZE / 2) * OG_RESOLUTION_CM;
+    originY = (int16_t)(floorf(y / OG_RESOLUTION_CM) - OG_SIZE / 2) * OG_RESOLUTION_CM;
+    updates = 0;
+}
+
+void OccupancyGrid::recenter(float x, float y) {
+    int cx = (int)floorf((x - originX) / OG_RESOLUTION_CM);
+    int cy = (int)floorf((y - originY) / OG_RESOLUTION_CM);
+    int sx = 0, sy = 0;
+    if (cx < OG_SIZE / 4 || cx >= OG_SIZE * 3 / 4) sx = cx - OG_SIZE / 2;
+    if (cy < OG_SIZE / 4 || cy >= OG_SIZE * 3 / 4) sy = cy - OG_SIZE / 2;
+    if (sx == 0 && sy == 0) return;
+    if (abs(sx) >= OG_SIZE || abs(sy) >= OG_SIZE) {
+        clear(x, y);
+        return;
+    }
+
+    // nueva(i, j) = vieja(i + sx, j + sy). Recorrer en el sentido del
+    // desplazamiento para leer cada celda antes de sobrescribirla.
+    for (int n = 0; n < OG_SIZE; ++n) {
+        int j = (sy >= 0) ? n : OG_SIZE - 1 - n;
+        for (int m = 0; m < OG_SIZE; ++m) {
+            int i = (sx >= 0) ? m : OG_SIZE - 1 - m;
+            int si = i + sx;
+            int sj = j + sy;
+            bool inside = si >= 0 && sj >= 0 && si < OG_SIZE && sj < OG_SIZE;
+            set(i, j, inside ? get(si, sj) : OG_UNKNOWN);
+        }
+    }
+    originX += sx * OG_RESOLUTION_CM;
+    originY += sy * OG_RESOLUTION_CM;
+}
+
+bool OccupancyGrid::worldToCell(float x, float y, int& cx, int& cy) const {
+    cx = (int)floorf((x - originX) / OG_RESOLUTION_CM);
+    cy = (int)floorf((y - originY) / OG_RESOLUTION_CM);
+    return cx >= 0 && cy >= 0 && cx < OG_SIZE && cy < OG_SIZE;
+}
+
+uint8_t OccupancyGrid::valueAt(float x, float y) const {
+    int cx, cy;
+    if (!worldToCell(x, y, cx, cy)) return OG_UNKNOWN;
+    return get(cx, cy);
+}
+
+void OccupancyGrid::integrateRay(float x0, float y0, float angleRad, float rangeCm, bool hit) {
+    float x1 = x0 + rangeCm * cosf(angleRad);
+    float y1 = y0 + rangeCm * sinf(angleRad);
+    int cx0 = (int)floorf((x0 - originX) / OG_RESOLUTION_CM);
+    int cy0 = (int)floorf((y0 - originY) / OG_RESOLUTION_CM);
+    int cx1 = (int)floorf((x1 - originX) / OG_RESOLUTION_CM);
+    int cy1 = (int)floorf((y1 - originY) / OG_RESOLUTION_CM);
+
+    // Bresenham: todas las celdas menos la última son espacio libre
+    int dx = abs(cx1 - cx0), sx = (cx0 < cx1) ? 1 : -1;
+    int dy = -abs(cy1 - cy0), sy = (cy0 < cy1) ? 1 : -1;
+    int err = dx + dy;
+    while (cx0 != cx1 || cy0 != cy1) {
+        adjust(cx0, cy0, -OG_MISS_DEC);
+        int e2 = 2 * err;
+        if (e2 >= dy) { err += dy; cx0 += sx; }
+        if (e2 <= dx) { err += dx; cy0 += sy; }
+    }
+    adjust(cx1, cy1, hit ? OG_HIT_INC : -OG_MISS_DEC);
+    updates++;
+}
+
+uint8_t OccupancyGrid::occupiedAlong(float x0, float y0, float x1, float y1) const {
+    int cx0 = (int)floorf((x0 - originX) / OG_RESOLUTION_CM);
+    int cy0 = (int)floorf((y0 - originY) / OG_RESOLUTION_CM);
+    int cx1 = (int)floorf((x1 - originX) / OG_RESOLUTION_CM);
+    int cy1 = (int)floorf((y1 - originY) / OG_RESOLUTION_CM);
+
+    uint8_t n = 0;
+    int dx = abs(cx1 - cx0), sx = (cx0 < cx1) ? 1 : -1;
+    int dy = -abs(cy1 - cy0), sy = (cy0 < cy1) ? 1 : -1;
+    int err = dx + dy;
+    while (true) {
+        bool inside = cx0 >= 0 && cy0 >= 0 && cx0 < OG_SIZE && cy0 < OG_SIZE;
+        if (inside && get(cx0, cy0) >= OG_OCCUPIED_MIN && n < 255) n++;
+        if (cx0 == cx1 && cy0 == cy1) break;
+        int e2 = 2 * err;
+        if (e2 >= dy) { err += dy; cx0 += sx; }
+        if (e2 <= dx) { err += dx; cy0 += sy; }
+    }
+    return n;
+}
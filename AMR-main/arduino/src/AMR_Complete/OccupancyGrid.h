@@ -0,0 +1,81 @@
+#pragma once
+
+#ifndef OCCUPANCY_GRID_H
+#define OCCUPANCY_GRID_H
+
+#include <Arduino.h>
+
+// ========================================
+//     MAPA LOCAL DE OCUPACIÓN (LOG-ODDS)
+// ========================================
+// Rejilla cuadrada centrada en el robot, en coordenadas de Odometry (cm).
+// Cada celda guarda un log-odds de 4 bits (dos celdas por byte):
+//   0 = libre seguro, OG_UNKNOWN = sin información, 15 = ocupado seguro
+// integrateRay() recorre las celdas del rayo de un sensor (Bresenham):
+// las atravesadas bajan (libre) y la del impacto sube (ocupada).
+//
+// Cuando el robot se aleja del centro más de un cuarto de ventana, la
+// rejilla se desplaza celdas enteras (recenter()): lo que sale se olvida
+// y lo que entra queda desconocido.
+//
+// Tamaño: 64x64 celdas de 5 cm (3.2 m, 2 KB) en UNO R4; en AVR 32x32 de
+// 10 cm (512 bytes).
+
+#if defined(__AVR__)
+#define OG_SIZE 32                // celdas por lado
+#define OG_RESOLUTION_CM 10
+#else
+#define OG_SIZE 64
+#define OG_RESOLUTION_CM 5
+#endif
+#define OG_BYTES (OG_SIZE * OG_SIZE / 2)
+
+#define OG_UNKNOWN 8
+#define OG_HIT_INC 3              // impacto: +3
+#define OG_MISS_DEC 1             // atravesada: -1
+#define OG_OCCUPIED_MIN 11        // >= ocupado
+#define OG_FREE_MAX 5             // <= libre
+
+class OccupancyGrid {
+private:
+    uint8_t cells[OG_BYTES];
+    int16_t originX = 0;          // esquina de la celda (0,0) en cm
+    int16_t originY = 0;
+    unsigned long updates = 0;
+
+    uint8_t get(int cx, int cy) const;
+    void set(int cx, int cy, uint8_t v);
+    void adjust(int cx, int cy, int delta);
+
+public:
+    OccupancyGrid() { clear(0.0f, 0.0f); }
+
+    // Vaciar (todo desconocido) con la ventana centrada en (x, y)
+    void clear(float x, float y);
+
+    // Mantener (x, y) en la mitad central de la ventana
+    void recenter(float x, float y);
+
+    // Rayo desde (x0, y0) con rumbo angleRad y alcance rangeCm; hit = el
+    // sensor vio un objeto a esa distancia (si no, solo se libera el rayo)
+    void integrateRay(float x0, float y0, float angleRad, float rangeCm, bool hit);
+
+    bool worldToCell(float x, float y, int& cx, int& cy) const;
+    // Valor 0..15 de la celda que contiene (x, y); OG_UNKNOWN fuera de la ventana
+    uint8_t valueAt(float x, float y) const;
+    bool isOccupied(float x, float y) const { return valueAt(x, y) >= OG_OCCUPIED_MIN; }
+    bool isFree(float x, float y) const { return valueAt(x, y) <= OG_FREE_MAX; }
+    // Celdas ocupadas atravesadas por el segmento (x0,y0)->(x1,y1)
+    uint8_t occupiedAlong(float x0, float y0, float x1, float y1) const;
+
+    // Valor de la celda (cx, cy), ambos en 0..OG_SIZE-1 (sin comprobar)
+    uint8_t cell(int cx, int cy) const { return get(cx, cy); }
+
+    // Acceso a la rejilla empaquetada (descarga por HTTP)
+    const uint8_t* data() const { return cells; }
+    int16_t getOriginX() const { return originX; }
+    int16_t getOriginY() const { return originY; }
+    unsigned long getUpdateCount() const { return updates; }
+};
+
+#endif // OCCUPANCY_GRID_H
@@ -1,71 +1,149 @@
 #include "Odometry.h"
 #include <math.h>
+#include <string.h>
 
 Odometry::Odometry(Encoder* enc) {
     encoder = enc;
     x = 0.0;
     y = 0.0;
     theta = 0.0;
+    linearVelocity = 0.0;
+    angularVelocity = 0.0;
     lastLeftPulses = 0;
     lastRightPulses = 0;
+    cosTheta = 1.0;
+    sinTheta = 0.0;
+    wheelBaseCm = WHEEL_BASE_CM;
+    wheelRatio = 1.0f;
+    refreshConstants();
+    memset(&published, 0, sizeof(published));
+}
+
+// Por encima de este giro por tick la serie de ángulo pequeño pierde
+// precisión (error de cos ~ dθ^6/720): usar cos()/sin() completos
+static const float SMALL_ANGLE_MAX_RAD = 0.25f;
+
+// La relación de diámetros reparte el cm/pulso nominal entre las ruedas
+// conservando su media: izq = c * 2 / (1 + r), der = c * 2r / (1 + r)
+void Odometry::refreshConstants() {
+    cachedGeneration = Encoder::getConfigGeneration();
+    float cmPerPulse = Encoder::getCmPerPulse();
+    cmPerPulseLeft = cmPerPulse * 2.0f / (1.0f + wheelRatio);
+    cmPerPulseRight = cmPerPulseLeft * wheelRatio;
+    halfCmPerPulseLeft = cmPerPulseLeft * 0.5f;
+    halfCmPerPulseRight = cmPerPulseRight * 0.5f;
+    radPerPulseLeft = cmPerPulseLeft / wheelBaseCm;
+    radPerPulseRight = cmPerPulseRight / wheelBaseCm;
+}
+
+void Odometry::setGeometry(float wheelBase, float ratio) {
+    CriticalSection cs;
+    wheelBaseCm = wheelBase;
+    wheelRatio = ratio;
+    refreshConstants();
+}
+
+void Odometry::setHeading(float thetaRad) {
+    theta = thetaRad;
+    cosTheta = cos(thetaRad);
+    sinTheta = sin(thetaRad);
+}
+
+void Odometry::publish(const EncoderSnapshot& enc) {
+    published.x = x;
+    published.y = y;
+    published.theta = theta;
+    published.linearVelocity = linearVelocity;
+    published.angularVelocity = angularVelocity;
+    published.leftPulses = enc.left;
+    published.rightPulses = enc.right;
+    published.timestampUs = enc.timestampUs;
+    published.seq++;
 }
 
 void Odometry::init(float startX, float startY, float startTheta) {
-    x = startX;
-    y = startY;
-    theta = degreesToRadians(startTheta);
-    
-    // Inicializar lecturas previas
-    lastLeftPulses = encoder->readLeft();
-    lastRightPulses = encoder->readRight();
-    
+    {
+        CriticalSection cs;
+        x = startX;
+        y = startY;
+        setHeading(degreesToRadians(startTheta));
+        refreshConstants();
+
+        // Inicializar lecturas previas
+        EncoderSnapshot enc = encoder->snapshot();
+        lastLeftPulses = enc.left;
+        lastRightPulses = enc.right;
+        publish(enc);
+    }
+
     Serial.println(F("Odo OK"));
 }
 
-void Odometry::update() {
-    // Leer pulsos actuales
-    long currentLeftPulses = encoder->readLeft();
-    long currentRightPulses = encoder->readRight();
-    
-    // Calcular diferencias desde la última actualización
-    long deltaLeftPulses = currentLeftPulses - lastLeftPulses;
-    long deltaRightPulses = currentRightPulses - lastRightPulses;
-    
-    // Convertir a distancia
-    float deltaLeftCm = encoder->pulsesToCentimeters(deltaLeftPulses);
-    float deltaRightCm = encoder->pulsesToCentimeters(deltaRightPulses);
-    
-    // Calcular movimiento del robot
-    float deltaDistance = (deltaLeftCm + deltaRightCm) / 2.0;
-    float deltaTheta = (deltaRightCm - deltaLeftCm) / WHEEL_BASE_CM;
+// Movimiento del robot: dos multiplicaciones por magnitud (cada rueda con
+// su cm/pulso calibrado)
+void Odometry::integrate(long deltaLeftPulses, long deltaRightPulses) {
+    float deltaDistance = (float)deltaLeftPulses * halfCmPerPulseLeft + (float)deltaRightPulses * halfCmPerPulseRight;
+    float deltaTheta = (float)deltaRightPulses * radPerPulseRight - (float)deltaLeftPulses * radPerPulseLeft;
 
-    // Guardar theta previo y calcular nueva orientación
-    float prevTheta = theta;
-    float newTheta = theta + deltaTheta;
+    // Rotación de medio paso (cos/sin de dθ/2) por serie de ángulo pequeño
+    float half = deltaTheta * 0.5f;
+    float ch, sh;
+    if (fabs(half) < SMALL_ANGLE_MAX_RAD) {
+        float h2 = half * half;
+        ch = 1.0f - h2 * 0.5f + h2 * h2 * (1.0f / 24.0f);
+        sh = half * (1.0f - h2 * (1.0f / 6.0f) + h2 * h2 * (1.0f / 120.0f));
+    } else {
+        ch = cos(half);
+        sh = sin(half);
+    }
 
-    // Normalizar nueva orientación entre -π y π
-    while (newTheta > PI) newTheta -= 2 * PI;
-    while (newTheta < -PI) newTheta += 2 * PI;
-
-    // Para integrar posición correctamente durante giros parciales, usar el
-    // ángulo medio (prevTheta + deltaTheta/2). Además, si no hay un avance
-    // significativo (p.ej. giro en sitio), no actualizar X/Y.
-    const float DIST_EPS_CM = 0.001f; // umbral para considerar movimiento nulo
-    if (fabs(deltaDistance) > DIST_EPS_CM) {
-        float midTheta = prevTheta + deltaTheta * 0.5f;
-        // normalizar midTheta en rango [-PI,PI]
-        while (midTheta > PI) midTheta -= 2 * PI;
-        while (midTheta < -PI) midTheta += 2 * PI;
-        x += deltaDistance * cos(midTheta);
-        y += deltaDistance * sin(midTheta);
+    // Integrar posición con el ángulo medio (prevTheta + dθ/2); en giro
+    // en sitio (deltaDistance == 0) X/Y no cambian
+    float cMid = cosTheta * ch - sinTheta * sh;
+    float sMid = sinTheta * ch + cosTheta * sh;
+    if (deltaDistance != 0.0f) {
+        x += deltaDistance * cMid;
+        y += deltaDistance * sMid;
     }
 
-    // Finalmente asignar la nueva orientación normalizada
+    // Segundo medio paso -> nueva orientación. Renormalizar el vector
+    // (primer orden de 1/sqrt) para que el error de redondeo no se acumule.
+    float c = cMid * ch - sMid * sh;
+    float sn = sMid * ch + cMid * sh;
+    float k = 1.5f - 0.5f * (c * c + sn * sn);
+    cosTheta = c * k;
+    sinTheta = sn * k;
+
+    // Normalizar entre -π y π (dθ por tick es pequeño: basta una corrección)
+    float newTheta = theta + deltaTheta;
+    if (newTheta > PI) newTheta -= 2 * PI;
+    else if (newTheta < -PI) newTheta += 2 * PI;
     theta = newTheta;
+}
+
+void Odometry::update() {
+    if (cachedGeneration != Encoder::getConfigGeneration()) refreshConstants();
+
+    // Leer ambos contadores en el mismo instante
+    EncoderSnapshot enc = encoder->snapshot();
+    long currentLeftPulses = enc.left;
+    long currentRightPulses = enc.right;
     
-    // Guardar lecturas para próxima iteración
+    // Calcular diferencias desde la última actualización
+    long deltaLeftPulses = currentLeftPulses - lastLeftPulses;
+    long deltaRightPulses = currentRightPulses - lastRightPulses;
     lastLeftPulses = currentLeftPulses;
     lastRightPulses = currentRightPulses;
+
+    if (deltaLeftPulses != 0 || deltaRightPulses != 0) integrate(deltaLeftPulses, deltaRightPulses);
+
+    // Velocidades instantáneas a partir de los periodos entre flancos
+    float vLeft = cmPerPulseLeft * encoder->getLeftPulsesPerSecond();
+    float vRight = cmPerPulseRight * encoder->getRightPulsesPerSecond();
+    linearVelocity = (vLeft + vRight) * 0.5f;
+    angularVelocity = (vRight - vLeft) / wheelBaseCm;
+
+    publish(enc);
 }
 
 float Odometry::radiansToDegrees(float radians) {
@@ -77,30 +155,42 @@ float Odometry::degreesToRadians(float degrees) {
 }
 
 void Odometry::setPosition(float newX, float newY, float newTheta) {
+    CriticalSection cs;
     x = newX;
     y = newY;
-    theta = degreesToRadians(newTheta);
+    setHeading(degreesToRadians(newTheta));
+    publish(encoder->snapshot());
 }
 
 void Odometry::resetPosition() {
+    CriticalSection cs;
     x = 0.0;
     y = 0.0;
-    theta = 0.0;
+    setHeading(0.0);
     encoder->resetBoth();
     lastLeftPulses = 0;
     lastRightPulses = 0;
+    publish(encoder->snapshot());
 }
 
 void Odometry::printPosition() {
+    float px = getX();
+    float py = getY();
     Serial.print(F("("));
-    Serial.print(x, 1);
+    Serial.print(px, 1);
     Serial.print(F(","));
-    Serial.print(y, 1);
+    Serial.print(py, 1);
     Serial.print(F(") "));
-    Serial.print(radiansToDegrees(theta), 0);
-    Serial.println(F("°"));
+    Serial.print(getThetaDegrees(), 0);
+    Serial.print(F("° v:"));
+    Serial.print(getLinearVelocity(), 1);
+    Serial.print(F("cm/s w:"));
+    Serial.print(radiansToDegrees(getAngularVelocity()), 0);
+    Serial.println(F("°/s"));
 }
 
 float Odometry::getDistanceFromOrigin() {
-    return sqrt(x*x + y*y);
+    float px = getX();
+    float py = getY();
+    return sqrt(px*px + py*py);
 }
\ No newline at end of file
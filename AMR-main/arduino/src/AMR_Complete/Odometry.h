@@ -5,6 +5,7 @@
 
 #include <Arduino.h>
 #include "Encoder.h"
+#include "CriticalSection.h"
 
 // Configuración del robot
 // IMPORTANTE: actualizar a la distancia centro-a-centro real entre ruedas
@@ -12,6 +13,20 @@
 #define WHEEL_BASE_CM 63.5   // Distancia entre ruedas en cm (centro a centro)
 #endif
 
+// Pose publicada por update() una vez por ciclo. Los consumidores copian
+// la estructura entera con sample() en lugar de leer campos o contadores
+// volátiles por separado: x/y/theta y los pulsos son del mismo instante.
+struct PoseSample {
+    float x, y;              // cm
+    float theta;             // rad
+    float linearVelocity;    // cm/s
+    float angularVelocity;   // rad/s
+    long leftPulses;         // contadores usados para esta pose
+    long rightPulses;
+    unsigned long timestampUs;
+    uint32_t seq;            // se incrementa en cada publicación
+};
+
 class Odometry {
 private:
     Encoder* encoder;
@@ -20,10 +35,37 @@ private:
     float x, y;           // Posición en cm
     float theta;          // Orientación en radianes
     
+    // Velocidades instantáneas (de Encoder::sampleVelocity)
+    float linearVelocity;   // cm/s
+    float angularVelocity;  // rad/s
+    
     // Lecturas anteriores del encoder
     long lastLeftPulses;
     long lastRightPulses;
     
+    // Orientación como vector unitario (cos, sin): se rota de forma
+    // incremental en cada tick en lugar de llamar a cos()/sin()
+    float cosTheta, sinTheta;
+    
+    // Geometría calibrada (ver Calibration.h): distancia efectiva entre
+    // ruedas y relación de diámetros derecha/izquierda
+    float wheelBaseCm;
+    float wheelRatio;
+
+    // Constantes por pulso de cada rueda, recalculadas solo cuando cambia la
+    // configuración del encoder (Encoder::getConfigGeneration()) o la geometría
+    uint8_t cachedGeneration;
+    float cmPerPulseLeft, cmPerPulseRight;
+    float halfCmPerPulseLeft, halfCmPerPulseRight;   // aporte de cada rueda al avance
+    float radPerPulseLeft, radPerPulseRight;         // aporte de cada rueda al giro
+    
+    // Última pose publicada (escrita en la ISR del Scheduler)
+    PoseSample published;
+    
+    void refreshConstants();
+    void setHeading(float thetaRad);
+    void publish(const EncoderSnapshot& enc);
+    
     // Conversiones
     float radiansToDegrees(float radians);
     float degreesToRadians(float degrees);
@@ -38,11 +80,26 @@ public:
     // Actualización de odometría
     void update();
     
-    // Getters de posición
-    float getX() { return x; }
-    float getY() { return y; }
-    float getTheta() { return theta; }
-    float getThetaDegrees() { return radiansToDegrees(theta); }
+    // Integrar un paso de pulsos ya leídos (update() lo llama; público para
+    // medirlo en el banco sin mover las ruedas)
+    void integrate(long deltaLeftPulses, long deltaRightPulses);
+    
+    // Copia consistente de la última pose publicada (update() corre en la
+    // ISR del Scheduler: se copia dentro de una sección crítica)
+    PoseSample sample() { CriticalSection cs; return published; }
+    
+    // Getters de campo sueltos (leen la pose publicada)
+    float getX() { CriticalSection cs; return published.x; }
+    float getY() { CriticalSection cs; return published.y; }
+    float getTheta() { CriticalSection cs; return published.theta; }
+    float getThetaDegrees() { return radiansToDegrees(getTheta()); }
+    float getLinearVelocity() { CriticalSection cs; return published.linearVelocity; }   // cm/s
+    float getAngularVelocity() { CriticalSection cs; return published.angularVelocity; } // rad/s
+    
+    // Geometría: base efectiva (cm) y relación de diámetros (der/izq, 1 = iguales)
+    void setGeometry(float wheelBase, float ratio);
+    float getWheelBase() { return wheelBaseCm; }
+    float getWheelRatio() { return wheelRatio; }
     
     // Setters de posición (para corrección)
     void setPosition(float newX, float newY, float newTheta);
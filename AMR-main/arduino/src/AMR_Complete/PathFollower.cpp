@@ -0,0 +1,151 @@
+#include "PathFollower.h"
+#include <math.h>
+
+void PathFollower::reset(float startX, float startY) {
+    count = 0;
+    segment = 0;
+    finished = false;
+    addPoint(startX, startY);
+}
+
+bool PathFollower::addPoint(float x, float y) {
+    if (count >= PATH_MAX_POINTS) return false;
+    // Los puntos repetidos crearían segmentos de longitud 0
+    if (count > 0 && fabs(points[count - 1].x - x) < 0.01f && fabs(points[count - 1].y - y) < 0.01f) return true;
+    points[count].x = x;
+    points[count].y = y;
+    count++;
+    finished = false;
+    return true;
+}
+
+float PathFollower::distanceToGoal(float x, float y) {
+    if (count == 0) return 0.0f;
+    float dx = points[count - 1].x - x;
+    float dy = points[count - 1].y - y;
+    return sqrtf(dx * dx + dy * dy);
+}
+
+// Proyección de (px, py) en el segmento a->b: parámetro t (sin recortar)
+static float projectOnSegment(const PathPoint& a, const PathPoint& b, float px, float py, float& segLen) {
+    float sx = b.x - a.x;
+    float sy = b.y - a.y;
+    float len2 = sx * sx + sy * sy;
+    segLen = sqrtf(len2);
+    if (len2 < 1e-6f) return 1.0f;
+    return ((px - a.x) * sx + (py - a.y) * sy) / len2;
+}
+
+float PathFollower::remainingDistance(float x, float y) {
+    if (count < 2) return 0.0f;
+    if (segment + 2 >= count) return distanceToGoal(x, y);
+    float segLen;
+    float t = projectOnSegment(points[segment], points[segment + 1], x, y, segLen);
+    if (t < 0.0f) t = 0.0f;
+    if (t > 1.0f) t = 1.0f;
+    float remaining = (1.0f - t) * segLen;
+    for (uint8_t i = segment + 1; i + 1 < count; ++i) {
+        float sx = points[i + 1].x - points[i].x;
+        float sy = points[i + 1].y - points[i].y;
+        remaining += sqrtf(sx * sx + sy * sy);
+    }
+    return remaining;
+}
+
+PathPoint PathFollower::lookaheadPoint(float px, float py) {
+    // Avanzar "lookahead" cm sobre la trayectoria desde la proyección del robot
+    float segLen;
+    float t = projectOnSegment(points[segment], points[segment + 1], px, py, segLen);
+    if (t < 0.0f) t = 0.0f;
+    if (t > 1.0f) t = 1.0f;
+
+    float remaining = lookahead;
+    uint8_t i = segment;
+    float along = t * segLen;
+    while (true) {
+        const PathPoint& a = points[i];
+        const PathPoint& b = points[i + 1];
+        float len = sqrtf((b.x - a.x) * (b.x - a.x) + (b.y - a.y) * (b.y - a.y));
+        float left = len - along;
+        if (remaining <= left && len > 1e-3f) {
+            float f = (along + remaining) / len;
+            PathPoint p = { a.x + (b.x - a.x) * f, a.y + (b.y - a.y) * f };
+            return p;
+        }
+        remaining -= left;
+        if (i + 2 >= count) return points[count - 1];
+        i++;
+        along = 0.0f;
+    }
+}
+
+PathCommand PathFollower::wheels(float vMmS, float wRadS, bool done) {
+    float halfBaseMm = wheelBaseCm * 5.0f;   // (cm * 10) / 2
+    PathCommand cmd;
+    cmd.leftMmS = vMmS - wRadS * halfBaseMm;
+    cmd.rightMmS = vMmS + wRadS * halfBaseMm;
+    cmd.done = done;
+    return cmd;
+}
+
+PathCommand PathFollower::update(float x, float y, float theta) {
+    if (finished || count < 2) {
+        finished = true;
+        return wheels(0.0f, 0.0f, true);
+    }
+
+    // Pasar al siguiente segmento cuando la proyección supera el final del actual
+    float segLen;
+    float t = projectOnSegment(points[segment], points[segment + 1], x, y, segLen);
+    while (t >= 1.0f && segment + 2 < count) {
+        segment++;
+        t = projectOnSegment(points[segment], points[segment + 1], x, y, segLen);
+    }
+
+    // Meta por distancia, solo en el último segmento (una ruta cerrada
+    // termina donde empieza). También si se rebasa la meta estando cerca.
+    float goalDist = distanceToGoal(x, y);
+    bool lastSegment = segment + 2 >= count;
+    if (lastSegment && (goalDist <= PATH_GOAL_TOLERANCE_CM || (t >= 1.0f && goalDist < PATH_SLOWDOWN_CM))) {
+        finished = true;
+        return wheels(0.0f, 0.0f, true);
+    }
+
+    // Distancia restante sobre la trayectoria (para frenar antes de la meta)
+    float remaining = remainingDistance(x, y);
+
+    // Punto objetivo en el marco del robot
+    PathPoint target = lookaheadPoint(x, y);
+    float dx = target.x - x;
+    float dy = target.y - y;
+    float c = cosf(theta);
+    float s = sinf(theta);
+    float lx = c * dx + s * dy;
+    float ly = -s * dx + c * dy;
+    float alpha = atan2f(ly, lx);
+
+    // Muy desalineado: girar en sitio hacia el objetivo
+    if (fabs(alpha) > PATH_SPIN_ANGLE_DEG * (PI / 180.0f)) {
+        float w = 2.0f * alpha;
+        if (w > PATH_SPIN_RAD_S) w = PATH_SPIN_RAD_S;
+        if (w < -PATH_SPIN_RAD_S) w = -PATH_SPIN_RAD_S;
+        return wheels(0.0f, w, false);
+    }
+
+    // Arco de pure pursuit
+    float l2 = lx * lx + ly * ly;
+    float k = (l2 > 1e-6f) ? 2.0f * ly / l2 : 0.0f;   // 1/cm
+
+    float v = cruiseMmS;
+    if (remaining < PATH_SLOWDOWN_CM) {
+        v = cruiseMmS * remaining / PATH_SLOWDOWN_CM;
+        if (v < PATH_MIN_SPEED_MM_S) v = PATH_MIN_SPEED_MM_S;
+    }
+    float w = (v * 0.1f) * k;                          // (cm/s) * (1/cm) = rad/s
+    if (fabs(w) > PATH_MAX_TURN_RAD_S) {
+        // Curva cerrada: bajar v para respetar el límite de giro
+        v = PATH_MAX_TURN_RAD_S / fabs(k) * 10.0f;
+        w = (w > 0.0f) ? PATH_MAX_TURN_RAD_S : -PATH_MAX_TURN_RAD_S;
+    }
+    return wheels(v, w, false);
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#ifndef PATH_FOLLOWER_H
+#define PATH_FOLLOWER_H
+
+#include <Arduino.h>
+
+// ========================================
+//     SEGUIDOR DE TRAYECTORIA (PURE PURSUIT)
+// ========================================
+// Sigue una polilínea de waypoints sin detenerse en cada uno: en cada ciclo
+// busca el punto de la trayectoria a una distancia "lookahead" por delante
+// de la proyección del robot y calcula la curvatura del arco que lo alcanza:
+//     k = 2 * y_local / L^2
+// Las esquinas se redondean solas (radio del orden del lookahead). Las
+// velocidades salen por rueda (mm/s) para DriveController::setWheelSpeeds().
+//
+// - Si el punto objetivo queda a más de PATH_SPIN_ANGLE_DEG del frente
+//   (p.ej. al arrancar mirando a otro lado) se gira en sitio primero.
+// - La velocidad baja cerca de la meta y en curvas cerradas. setCruiseSpeed()
+//   puede cambiarse en cada ciclo (p.ej. desde un MotionProfile).
+// - La meta se da por alcanzada por distancia (PATH_GOAL_TOLERANCE_CM),
+//   no por pulsos contados.
+//
+// Unidades: posiciones en cm, theta en rad (antihorario +), como Odometry.
+
+#define PATH_MAX_POINTS 16
+#define PATH_DEFAULT_LOOKAHEAD_CM 30.0f
+#define PATH_GOAL_TOLERANCE_CM 3.0f
+#define PATH_SLOWDOWN_CM 40.0f        // distancia a meta donde empieza a frenar
+#define PATH_MIN_SPEED_MM_S 60.0f     // velocidad mínima de avance al frenar
+#define PATH_MAX_TURN_RAD_S 1.2f      // límite de w en arco (~70 °/s)
+#define PATH_SPIN_ANGLE_DEG 60.0f
+#define PATH_SPIN_RAD_S 1.0f          // w máximo al girar en sitio
+
+struct PathPoint {
+    float x, y;
+};
+
+struct PathCommand {
+    float leftMmS;
+    float rightMmS;
+    bool done;
+};
+
+class PathFollower {
+private:
+    PathPoint points[PATH_MAX_POINTS];
+    uint8_t count = 0;
+    uint8_t segment = 0;           // segmento actual: points[segment] -> points[segment + 1]
+    float lookahead = PATH_DEFAULT_LOOKAHEAD_CM;
+    float cruiseMmS = 200.0f;
+    float wheelBaseCm;
+    bool finished = false;
+
+    PathPoint lookaheadPoint(float px, float py);
+    PathCommand wheels(float vMmS, float wRadS, bool done);
+
+public:
+    explicit PathFollower(float wheelBase) : wheelBaseCm(wheelBase) {}
+    void setWheelBase(float wheelBase) { wheelBaseCm = wheelBase; }
+
+    // Construir la trayectoria: reset(pose actual) + addPoint() por waypoint
+    void reset(float startX, float startY);
+    bool addPoint(float x, float y);
+
+    void setLookahead(float cm) { if (cm > 1.0f) lookahead = cm; }
+    float getLookahead() { return lookahead; }
+    void setCruiseSpeed(float mmS) { cruiseMmS = mmS; }
+
+    // Un paso de control con la pose actual
+    PathCommand update(float x, float y, float theta);
+
+    bool isFinished() { return finished; }
+    // Waypoint al que se dirige (índice en la trayectoria, 1..count-1)
+    uint8_t targetIndex() { return segment + 1; }
+    uint8_t pointCount() { return count; }
+    PathPoint point(uint8_t i) { return points[i]; }
+    float distanceToGoal(float x, float y);
+    // Longitud que falta por recorrer sobre la polilínea (cm)
+    float remainingDistance(float x, float y);
+};
+
+#endif // PATH_FOLLOWER_H
@@ -0,0 +1,128 @@
+#include "Perf.h"
+#include "JsonWriter.h"
+#include "CriticalSection.h"
+#include <string.h>
+
+#if PERF_ENABLED
+
+static PerfCounter counters[PERF_COUNT];
+
+static const char PERF_NAME_ODOMETRY[] PROGMEM = "odometry";
+static const char PERF_NAME_ROUTE[] PROGMEM = "route";
+static const char PERF_NAME_WALL[] PROGMEM = "wall_follow";
+static const char PERF_NAME_HTTP[] PROGMEM = "http";
+static const char PERF_NAME_SSE[] PROGMEM = "sse";
+static const char PERF_NAME_IR[] PROGMEM = "ir_scan";
+static const char PERF_NAME_SERIAL[] PROGMEM = "serial";
+static const char PERF_NAME_ENC_L[] PROGMEM = "enc_left_isr";
+static const char PERF_NAME_ENC_R[] PROGMEM = "enc_right_isr";
+
+static const char* const PERF_NAMES[PERF_COUNT] = {
+    PERF_NAME_ODOMETRY, PERF_NAME_ROUTE, PERF_NAME_WALL, PERF_NAME_HTTP, PERF_NAME_SSE,
+    PERF_NAME_IR, PERF_NAME_SERIAL, PERF_NAME_ENC_L, PERF_NAME_ENC_R
+};
+
+#endif // PERF_ENABLED
+
+// Bin = posición del bit más alto (0 y 1 µs comparten el bin 0)
+void PerfCounter::record(uint32_t us) {
+    if (count == 0 || us < minUs) minUs = us;
+    if (us > maxUs) maxUs = us;
+    count++;
+    totalUs += us;
+    uint8_t bin = 0;
+    while ((us >>= 1) != 0 && bin < PERF_BINS - 1) bin++;
+    if (bins[bin] != 0xFFFF) bins[bin]++;
+}
+
+uint32_t PerfCounter::percentileUs(uint16_t perMille) const {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < PERF_BINS; ++i) total += bins[i];
+    if (total == 0) return 0;
+    uint32_t target = (total * perMille + 999) / 1000;
+    uint32_t acc = 0;
+    for (uint8_t i = 0; i < PERF_BINS; ++i) {
+        acc += bins[i];
+        if (acc >= target) {
+            uint32_t upper = (i == PERF_BINS - 1) ? maxUs : ((2UL << i) - 1);
+            return (upper < maxUs) ? upper : maxUs;
+        }
+    }
+    return maxUs;
+}
+
+#if PERF_ENABLED
+
+void perfRecord(PerfId id, uint32_t us) {
+    counters[id].record(us);
+}
+
+PerfCounter perfSnapshot(PerfId id) {
+    CriticalSection cs;
+    return counters[id];
+}
+
+const __FlashStringHelper* perfName(PerfId id) {
+    return reinterpret_cast<const __FlashStringHelper*>(PERF_NAMES[id]);
+}
+
+void perfReset() {
+    CriticalSection cs;
+    memset(counters, 0, sizeof(counters));
+}
+
+void perfPrint(Print& out) {
+    out.println(F("=== PERF (us) ==="));
+    out.println(F("Tramo          N          Min     Avg     P99     Max"));
+    for (uint8_t i = 0; i < PERF_COUNT; ++i) {
+        PerfCounter c = perfSnapshot((PerfId)i);
+        const __FlashStringHelper* name = perfName((PerfId)i);
+        out.print(name);
+        size_t len = strlen_P(reinterpret_cast<const char*>(name));
+        for (size_t k = len; k < 14; ++k) out.print(' ');
+        char line[64];
+        unsigned long avg = c.count ? (unsigned long)(c.totalUs / c.count) : 0;
+        snprintf(line, sizeof(line), " %-10lu %-7lu %-7lu %-7lu %lu",
+                 (unsigned long)c.count, (unsigned long)c.minUs, avg,
+                 (unsigned long)c.percentileUs(990), (unsigned long)c.maxUs);
+        out.println(line);
+    }
+}
+
+void perfWriteJson(JsonWriter& json) {
+    json.beginObject();
+    json.field(F("enabled"), true);
+    json.key(F("bins_us"));
+    json.beginArray();
+    for (uint8_t b = 0; b < PERF_BINS; ++b) json.value((unsigned long)(b == 0 ? 0UL : 1UL << b));
+    json.endArray();
+    json.key(F("sections"));
+    json.beginArray();
+    for (uint8_t i = 0; i < PERF_COUNT; ++i) {
+        PerfCounter c = perfSnapshot((PerfId)i);
+        json.beginObject();
+        json.field(F("name"), perfName((PerfId)i));
+        json.field(F("n"), (unsigned long)c.count);
+        json.field(F("min"), (unsigned long)c.minUs);
+        json.field(F("avg"), c.count ? (unsigned long)(c.totalUs / c.count) : 0UL);
+        json.field(F("p99"), (unsigned long)c.percentileUs(990));
+        json.field(F("max"), (unsigned long)c.maxUs);
+        json.key(F("hist"));
+        json.beginArray();
+        for (uint8_t b = 0; b < PERF_BINS; ++b) json.value((unsigned int)c.bins[b]);
+        json.endArray();
+        json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+}
+
+#else
+
+void perfWriteJson(JsonWriter& json) {
+    json.beginObject();
+    json.field(F("enabled"), false);
+    json.endObject();
+}
+
+#endif // PERF_ENABLED
@@ -0,0 +1,101 @@
+#pragma once
+
+#ifndef PERF_H
+#define PERF_H
+
+#include <Arduino.h>
+
+// ========================================
+//     INSTRUMENTACIÓN DE TRAMOS CALIENTES
+// ========================================
+// Contadores de tiempo por tramo de código (basados en micros()):
+// número de ejecuciones, mín/medio/máx e histograma en bins fijos de
+// potencias de 2 (bin k = [2^k, 2^(k+1)) µs; el 0 cubre 0-1 µs), del que
+// sale un p99 aproximado (límite superior del bin, acotado por el máximo).
+//
+// Los bins dan la forma de la distribución que el máximo de Scheduler
+// ('O') no muestra: un único pico raro frente a un tramo lento siempre.
+//
+// Uso:
+//     void odometryTask() {
+//         PERF_SCOPE(PERF_ODOMETRY);       // mide hasta el final del bloque
+//         odometry.update();
+//     }
+//     PERF_RECORD(PERF_ENC_LEFT_ISR, micros() - t0);
+//
+// record() puede llamarse desde ISR (encoders, tareas de tiempo real): cada
+// tramo tiene su contador y los lectores copian bajo CriticalSection.
+//
+// Con PERF_ENABLED 0 las macros no generan código y /perf responde
+// {"enabled":false}: comparar el mismo binario con y sin instrumentación.
+
+#ifndef PERF_ENABLED
+#define PERF_ENABLED 1
+#endif
+
+#define PERF_BINS 16                  // último bin: >= 32768 µs
+
+enum PerfId : uint8_t {
+    PERF_ODOMETRY = 0,                // odometry.update() (ISR del tick)
+    PERF_ROUTE,                       // executeRoute()
+    PERF_WALL_FOLLOW,                 // handleWallFollow()
+    PERF_HTTP,                        // handleWiFiServer() (cliente HTTP)
+    PERF_SSE,                         // serviceEventStreams()
+    PERF_IR_SCAN,                     // irScanner.service()
+    PERF_SERIAL,                      // comandos + telemetría en texto por Serial
+    PERF_ENC_LEFT_ISR,                // ISR del encoder izquierdo
+    PERF_ENC_RIGHT_ISR,
+    PERF_COUNT
+};
+
+struct PerfCounter {
+    uint32_t count;
+    uint32_t minUs;
+    uint32_t maxUs;
+    uint64_t totalUs;
+    uint16_t bins[PERF_BINS];         // saturan en 65535
+
+    void record(uint32_t us);
+    uint32_t percentileUs(uint16_t perMille) const;
+};
+
+class JsonWriter;
+
+#if PERF_ENABLED
+
+void perfRecord(PerfId id, uint32_t us);
+// Copia consistente de un contador
+PerfCounter perfSnapshot(PerfId id);
+const __FlashStringHelper* perfName(PerfId id);
+void perfReset();
+void perfPrint(Print& out);
+void perfWriteJson(JsonWriter& json);
+
+// Mide desde la construcción hasta el final del ámbito
+class PerfScope {
+private:
+    PerfId id;
+    unsigned long startUs;
+
+public:
+    explicit PerfScope(PerfId i) : id(i), startUs(micros()) {}
+    ~PerfScope() { perfRecord(id, micros() - startUs); }
+};
+
+#define PERF_CONCAT_(a, b) a##b
+#define PERF_CONCAT(a, b) PERF_CONCAT_(a, b)
+#define PERF_SCOPE(id) PerfScope PERF_CONCAT(perfScope_, __LINE__)(id)
+#define PERF_RECORD(id, us) perfRecord((id), (us))
+
+#else
+
+inline void perfReset() {}
+inline void perfPrint(Print& out) { out.println(F("Perf deshabilitado (PERF_ENABLED 0)")); }
+void perfWriteJson(JsonWriter& json);
+
+#define PERF_SCOPE(id) do {} while (0)
+#define PERF_RECORD(id, us) do {} while (0)
+
+#endif // PERF_ENABLED
+
+#endif // PERF_H
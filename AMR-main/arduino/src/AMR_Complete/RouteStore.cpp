@@ -0,0 +1,239 @@
+#include "RouteStore.h"
+#include "TelemetryProtocol.h"   // telemCrc16
+#include <EEPROM.h>
+
+uint16_t RouteStore::readU16(uint16_t addr) {
+    return (uint16_t)EEPROM.read(addr) | ((uint16_t)EEPROM.read(addr + 1) << 8);
+}
+
+// Cabecera coherente y CRC correcto (rutas y después bytes 2..7)
+bool RouteStore::checkBank(uint8_t bank, uint16_t& seq) const {
+    uint16_t base = bankAddress(bank);
+    if (EEPROM.read(base) != ROUTE_STORE_MAGIC0 || EEPROM.read(base + 1) != ROUTE_STORE_MAGIC1) return false;
+    if (EEPROM.read(base + 2) != ROUTE_STORE_VERSION) return false;
+    if (EEPROM.read(base + 3) > ROUTE_STORE_MAX_ROUTES) return false;
+    uint16_t len = readU16(base + 6);
+    if (len > ROUTE_STORE_BANK_BYTES - ROUTE_STORE_HEADER_BYTES) return false;
+
+    uint16_t crc = 0xFFFF;
+    for (uint16_t i = 0; i < len; ++i) {
+        uint8_t b = EEPROM.read(base + ROUTE_STORE_HEADER_BYTES + i);
+        crc = telemCrc16(&b, 1, crc);
+    }
+    for (uint8_t i = 2; i < 8; ++i) {
+        uint8_t b = EEPROM.read(base + i);
+        crc = telemCrc16(&b, 1, crc);
+    }
+    if (crc != readU16(base + 8)) return false;
+    seq = readU16(base + 4);
+    return true;
+}
+
+// Recorrer las rutas del banco y rellenar offsets/counts
+bool RouteStore::indexBank(uint8_t bank) {
+    uint16_t base = bankAddress(bank);
+    uint8_t n = EEPROM.read(base + 3);
+    uint16_t end = ROUTE_STORE_HEADER_BYTES + readU16(base + 6);
+    uint16_t pos = ROUTE_STORE_HEADER_BYTES;
+    for (uint8_t r = 0; r < n; ++r) {
+        offsets[r] = pos;
+        uint8_t len = 0;
+        while (pos < end && EEPROM.read(base + pos) != 0) {
+            if (++len > ROUTE_STORE_NAME_MAX) return false;
+            pos++;
+        }
+        pos++;   // '\0'
+        if (pos >= end) return false;
+        counts[r] = EEPROM.read(base + pos++);
+        if (counts[r] > ROUTE_STORE_MAX_POINTS) return false;
+        pos += 4 * counts[r];
+        if (pos > end) return false;
+    }
+    count = n;
+    return true;
+}
+
+bool RouteStore::begin() {
+    uint16_t seq0 = 0, seq1 = 0;
+    bool ok0 = checkBank(0, seq0);
+    bool ok1 = checkBank(1, seq1);
+    valid = false;
+    count = 0;
+    writing = false;
+    if (!ok0 && !ok1) return false;
+
+    // Secuencia con aritmética modular: sobrevive al desborde de u16
+    uint8_t bank = (ok0 && (!ok1 || (int16_t)(seq0 - seq1) > 0)) ? 0 : 1;
+    if (!indexBank(bank)) {
+        uint8_t other = 1 - bank;
+        if (!(other ? ok1 : ok0) || !indexBank(other)) return false;
+        bank = other;
+    }
+    activeBank = bank;
+    sequence = bank ? seq1 : seq0;
+    valid = true;
+    return true;
+}
+
+uint16_t RouteStore::pointsAddress(uint8_t r) const {
+    uint16_t addr = nameAddress(r);
+    while (EEPROM.read(addr) != 0) addr++;
+    return addr + 2;   // '\0' y nº de puntos
+}
+
+bool RouteStore::pointMm(uint8_t r, uint8_t i, int16_t& xMm, int16_t& yMm) const {
+    if (r >= count || i >= counts[r]) return false;
+    uint16_t addr = pointsAddress(r) + 4 * i;
+    xMm = (int16_t)readU16(addr);
+    yMm = (int16_t)readU16(addr + 2);
+    return true;
+}
+
+bool RouteStore::point(uint8_t r, uint8_t i, float& x, float& y) const {
+    int16_t xMm, yMm;
+    if (!pointMm(r, i, xMm, yMm)) return false;
+    x = xMm * 0.1f;
+    y = yMm * 0.1f;
+    return true;
+}
+
+char* RouteStore::name(uint8_t r, char* out, uint8_t size) const {
+    uint8_t n = 0;
+    if (r < count && size > 0) {
+        uint16_t addr = nameAddress(r);
+        char c;
+        while (n + 1 < size && (c = (char)EEPROM.read(addr + n)) != 0) out[n++] = c;
+    }
+    if (size > 0) out[n] = '\0';
+    return out;
+}
+
+uint16_t RouteStore::storedBytes() const {
+    if (!valid) return 0;
+    return ROUTE_STORE_HEADER_BYTES + readU16(bankAddress(activeBank) + 6);
+}
+
+uint8_t RouteStore::storedByte(uint16_t i) const {
+    return EEPROM.read(bankAddress(activeBank) + i);
+}
+
+// ----------------------------------------
+// Escritura en el banco inactivo
+// ----------------------------------------
+void RouteStore::beginWrite() {
+    uint16_t base = bankAddress(1 - activeBank);
+    // Invalidar primero la cabecera: un corte a medias no deja un banco
+    // viejo con cabecera aparentemente buena sobre rutas nuevas
+    EEPROM.update(base, 0);
+    EEPROM.update(base + 1, 0);
+    writing = true;
+    writePos = ROUTE_STORE_HEADER_BYTES;
+    writeCount = 0;
+    writeCrc = 0xFFFF;
+}
+
+bool RouteStore::putByte(uint8_t b) {
+    if (writePos >= ROUTE_STORE_BANK_BYTES) {
+        writing = false;
+        return false;
+    }
+    EEPROM.update(bankAddress(1 - activeBank) + writePos, b);
+    writeCrc = telemCrc16(&b, 1, writeCrc);
+    writePos++;
+    return true;
+}
+
+bool RouteStore::writeRoute(const char* routeName, const int16_t* xyMm, uint8_t n) {
+    if (!writing) return false;
+    uint8_t nameLen = 0;
+    while (routeName[nameLen] && nameLen < ROUTE_STORE_NAME_MAX) nameLen++;
+    uint16_t need = nameLen + 2 + 4 * (uint16_t)n;
+    if (writeCount >= ROUTE_STORE_MAX_ROUTES || n > ROUTE_STORE_MAX_POINTS ||
+        writePos + need > ROUTE_STORE_BANK_BYTES) {
+        writing = false;
+        return false;
+    }
+    for (uint8_t i = 0; i < nameLen; ++i) putByte((uint8_t)routeName[i]);
+    putByte(0);
+    putByte(n);
+    for (uint16_t i = 0; i < 2 * (uint16_t)n; ++i) {
+        putByte((uint8_t)((uint16_t)xyMm[i] & 0xFF));
+        putByte((uint8_t)((uint16_t)xyMm[i] >> 8));
+    }
+    writeCount++;
+    return true;
+}
+
+bool RouteStore::copyRoute(uint8_t r) {
+    if (!writing || r >= count) return false;
+    uint16_t from = nameAddress(r);
+    uint16_t len = pointsAddress(r) + 4 * counts[r] - from;
+    if (writeCount >= ROUTE_STORE_MAX_ROUTES || writePos + len > ROUTE_STORE_BANK_BYTES) {
+        writing = false;
+        return false;
+    }
+    for (uint16_t i = 0; i < len; ++i) putByte(EEPROM.read(from + i));
+    writeCount++;
+    return true;
+}
+
+bool RouteStore::commit() {
+    if (!writing) return false;
+    writing = false;
+    uint8_t target = 1 - activeBank;
+    uint16_t base = bankAddress(target);
+    uint16_t seq = valid ? (uint16_t)(sequence + 1) : 1;
+    uint16_t len = writePos - ROUTE_STORE_HEADER_BYTES;
+
+    uint8_t header[ROUTE_STORE_HEADER_BYTES] = {
+        ROUTE_STORE_MAGIC0, ROUTE_STORE_MAGIC1, ROUTE_STORE_VERSION, writeCount,
+        (uint8_t)(seq & 0xFF), (uint8_t)(seq >> 8),
+        (uint8_t)(len & 0xFF), (uint8_t)(len >> 8),
+        0, 0
+    };
+    uint16_t crc = telemCrc16(header + 2, 6, writeCrc);
+    header[8] = (uint8_t)(crc & 0xFF);
+    header[9] = (uint8_t)(crc >> 8);
+    // Magic lo último: el banco solo cuenta cuando todo lo demás está grabado
+    for (uint8_t i = ROUTE_STORE_HEADER_BYTES; i-- > 0;) EEPROM.update(base + i, header[i]);
+
+    // Releer del medio: si no verifica se sigue con el banco anterior
+    uint16_t check = 0;
+    if (!checkBank(target, check) || !indexBank(target)) {
+        begin();
+        return false;
+    }
+    activeBank = target;
+    sequence = seq;
+    valid = true;
+    return true;
+}
+
+bool RouteStore::replaceRoute(uint8_t slot, const char* routeName, const int16_t* xyMm, uint8_t n) {
+    if (slot > count) return false;
+    beginWrite();
+    for (uint8_t r = 0; r < count; ++r) {
+        bool ok = (r == slot) ? writeRoute(routeName, xyMm, n) : copyRoute(r);
+        if (!ok) {
+            begin();   // reindexar el banco activo (intacto)
+            return false;
+        }
+    }
+    if (slot == count && !writeRoute(routeName, xyMm, n)) {
+        begin();
+        return false;
+    }
+    return commit();
+}
+
+bool RouteStore::removeRoute(uint8_t slot) {
+    if (slot >= count) return false;
+    beginWrite();
+    for (uint8_t r = 0; r < count; ++r) {
+        if (r != slot && !copyRoute(r)) {
+            begin();
+            return false;
+        }
+    }
+    return commit();
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#ifndef ROUTE_STORE_H
+#define ROUTE_STORE_H
+
+#include <Arduino.h>
+
+// ========================================
+//     ALMACÉN DE RUTAS EN EEPROM
+// ========================================
+// Las rutas viven en EEPROM (emulada en data flash en UNO R4) en formato
+// binario compacto, y se leen de ahí cuando se necesitan: en RAM solo queda
+// un índice de offsets. Se pueden reemplazar en caliente (POST /routes) sin
+// reflashear.
+//
+// Dos bancos [cabecera][rutas]; el válido con secuencia más alta es el
+// activo. Una escritura va siempre al banco inactivo y la cabecera se graba
+// la última, así que un corte a medias deja intacto el banco anterior: el
+// cambio es atómico.
+//
+// Cabecera (ROUTE_STORE_HEADER_BYTES, little-endian):
+//   'R' 'T' | versión | nº rutas | secuencia u16 | longitud u16 | CRC16 u16
+// El CRC-16/CCITT (telemCrc16) cubre todas las rutas y después los bytes
+// 2..7 de la cabecera.
+//
+// Cada ruta:
+//   nombre\0 | nº puntos u8 | puntos x,y int16 en mm (décimas de cm)
+//
+// Uso:
+//     routeStore.begin();                       // en setup()
+//     routeStore.point(r, i, x, y);             // cm
+//     routeStore.replaceRoute(slot, name, xyMm, n);
+
+#define ROUTE_STORE_MAGIC0 'R'
+#define ROUTE_STORE_MAGIC1 'T'
+#define ROUTE_STORE_VERSION 1
+#define ROUTE_STORE_HEADER_BYTES 10
+#define ROUTE_STORE_MAX_ROUTES 8
+#define ROUTE_STORE_MAX_POINTS 32
+#define ROUTE_STORE_NAME_MAX 15       // caracteres sin el '\0'
+#define ROUTE_STORE_BASE 0            // dirección EEPROM del banco 0
+
+#if defined(__AVR__)
+#define ROUTE_STORE_BANK_BYTES 384    // 2 bancos de los 1024 bytes de EEPROM
+#else
+#define ROUTE_STORE_BANK_BYTES 1024   // 2 bancos de los 8 KB de data flash
+#endif
+// Primera dirección EEPROM libre para otros módulos
+#define ROUTE_STORE_END (ROUTE_STORE_BASE + 2 * ROUTE_STORE_BANK_BYTES)
+
+class RouteStore {
+private:
+    uint8_t activeBank = 0;
+    bool valid = false;
+    uint16_t sequence = 0;
+    uint8_t count = 0;
+    uint16_t offsets[ROUTE_STORE_MAX_ROUTES];   // inicio de cada ruta en el banco
+    uint8_t counts[ROUTE_STORE_MAX_ROUTES];
+
+    // Escritura en curso (banco inactivo)
+    bool writing = false;
+    uint16_t writePos = 0;
+    uint8_t writeCount = 0;
+    uint16_t writeCrc = 0;
+
+    static uint16_t bankAddress(uint8_t bank) { return ROUTE_STORE_BASE + bank * ROUTE_STORE_BANK_BYTES; }
+    static uint16_t readU16(uint16_t addr);
+    bool checkBank(uint8_t bank, uint16_t& seq) const;
+    bool indexBank(uint8_t bank);
+    bool putByte(uint8_t b);
+    uint16_t nameAddress(uint8_t r) const { return bankAddress(activeBank) + offsets[r]; }
+    uint16_t pointsAddress(uint8_t r) const;
+
+public:
+    // Cargar el banco válido más reciente; false si no hay ninguno
+    bool begin();
+
+    bool isValid() const { return valid; }
+    uint8_t routeCount() const { return count; }
+    uint8_t pointCount(uint8_t r) const { return (r < count) ? counts[r] : 0; }
+    uint16_t getSequence() const { return sequence; }
+
+    // Punto i de la ruta r: en mm (formato almacenado) o en cm
+    bool pointMm(uint8_t r, uint8_t i, int16_t& xMm, int16_t& yMm) const;
+    bool point(uint8_t r, uint8_t i, float& x, float& y) const;
+    // Copia el nombre (truncado a size-1); devuelve out
+    char* name(uint8_t r, char* out, uint8_t size) const;
+
+    // Banco activo tal cual está en EEPROM (cabecera + rutas)
+    uint16_t storedBytes() const;
+    uint8_t storedByte(uint16_t i) const;
+
+    // Reescritura completa en el banco inactivo:
+    //   beginWrite(); writeRoute()/copyRoute()...; commit();
+    // commit() activa el banco nuevo; si algo falla el activo no cambia.
+    void beginWrite();
+    bool writeRoute(const char* routeName, const int16_t* xyMm, uint8_t n);
+    bool copyRoute(uint8_t r);
+    bool commit();
+
+    // Sustituir la ruta slot (slot == routeCount() la añade) o borrarla
+    bool replaceRoute(uint8_t slot, const char* routeName, const int16_t* xyMm, uint8_t n);
+    bool removeRoute(uint8_t slot);
+};
+
+#endif // ROUTE_STORE_H
@@ -0,0 +1,183 @@
+#include "Scheduler.h"
+#include "CriticalSection.h"
+
+#if defined(ARDUINO_ARCH_RENESAS)
+#include <FspTimer.h>
+static FspTimer tickTimer;
+#endif
+
+// Instancia que recibe el tick de la ISR (hay un único scheduler en el sketch)
+static Scheduler* activeScheduler = nullptr;
+
+#if defined(ARDUINO_ARCH_RENESAS)
+static void schedulerTickCallback(timer_callback_args_t* args) {
+    (void)args;
+    if (activeScheduler) activeScheduler->tick();
+}
+#elif defined(__AVR__)
+// millis() usa el overflow del Timer0; la comparación A dispara una vez por
+// ciclo (~976 Hz) sea cual sea OCR0A, así que el PWM del pin 6 (MotorPwm) solo
+// desplaza la fase del tick.
+ISR(TIMER0_COMPA_vect) {
+    if (activeScheduler) activeScheduler->tick();
+}
+#endif
+
+bool Scheduler::addTask(const __FlashStringHelper* name, SchedTaskFn fn, unsigned long periodUs,
+                        uint8_t priority, bool hardRealTime) {
+    if (count >= SCHED_MAX_TASKS || fn == nullptr || started) return false;
+    // Las tareas de tiempo real necesitan un periodo (no hay best-effort en la ISR)
+    if (hardRealTime && periodUs == 0) return false;
+
+    SchedTask t;
+    t.name = name;
+    t.fn = fn;
+    t.periodTicks = 0;
+    if (periodUs > 0) {
+        t.periodTicks = (periodUs + SCHED_TICK_US / 2) / SCHED_TICK_US;
+        if (t.periodTicks == 0) t.periodTicks = 1;
+    }
+    t.priority = priority;
+    t.hardRealTime = hardRealTime;
+    t.nextTick = 0;
+    t.runs = 0;
+    t.overruns = 0;
+    t.lastExecUs = 0;
+    t.maxExecUs = 0;
+
+    // Inserción ordenada por prioridad (estable para prioridades iguales)
+    uint8_t pos = count;
+    while (pos > 0 && tasks[pos - 1].priority > priority) {
+        tasks[pos] = tasks[pos - 1];
+        pos--;
+    }
+    tasks[pos] = t;
+    count++;
+    return true;
+}
+
+void Scheduler::begin() {
+    activeScheduler = this;
+    lastPollMicros = micros();
+    for (uint8_t i = 0; i < count; ++i) tasks[i].nextTick = tickCount;
+    started = true;
+
+#if defined(ARDUINO_ARCH_RENESAS)
+    uint8_t timerType = GPT_TIMER;
+    int8_t channel = FspTimer::get_available_timer(timerType);
+    if (channel >= 0 &&
+        tickTimer.begin(TIMER_MODE_PERIODIC, timerType, channel, 1000000.0f / (float)SCHED_TICK_US, 0.0f,
+                        schedulerTickCallback) &&
+        tickTimer.setup_overflow_irq() && tickTimer.open() && tickTimer.start()) {
+        timerRunning = true;
+    }
+#elif defined(__AVR__)
+    {
+        CriticalSection cs;
+        TIMSK0 |= _BV(OCIE0A);
+    }
+    timerRunning = true;
+#endif
+
+    Serial.print(F("Sched OK tick:"));
+    Serial.print(SCHED_TICK_US);
+    Serial.print(F("us "));
+    Serial.println(timerRunning ? F("(timer)") : F("(poll)"));
+}
+
+void Scheduler::runTask(SchedTask& t, uint32_t now) {
+    // Activación perdida: la tarea arranca más de un periodo tarde
+    bool late = false;
+    if (t.periodTicks > 0 && (int32_t)(now - t.nextTick) >= (int32_t)t.periodTicks) {
+        late = true;
+        t.nextTick = now; // resincronizar en lugar de ejecutar en ráfaga
+    }
+
+    unsigned long t0 = micros();
+    t.fn();
+    uint32_t exec = (uint32_t)(micros() - t0);
+
+    t.runs++;
+    t.lastExecUs = exec;
+    if (exec > t.maxExecUs) t.maxExecUs = exec;
+    if (t.periodTicks > 0) {
+        if (late || exec > t.periodTicks * SCHED_TICK_US) t.overruns++;
+        t.nextTick += t.periodTicks;
+    }
+}
+
+void Scheduler::runHardRealTime(uint32_t now) {
+    for (uint8_t i = 0; i < count; ++i) {
+        SchedTask& t = tasks[i];
+        if (t.hardRealTime && (int32_t)(now - t.nextTick) >= 0) runTask(t, now);
+    }
+}
+
+void Scheduler::tick() {
+    uint32_t now = ++tickCount;
+    runHardRealTime(now);
+}
+
+uint32_t Scheduler::ticks() {
+    CriticalSection cs;
+    return tickCount;
+}
+
+void Scheduler::pollTicks() {
+    // Sin timer: derivar el tick de micros() y ejecutar aquí las tareas de tiempo real
+    unsigned long now = micros();
+    bool advanced = false;
+    while (now - lastPollMicros >= SCHED_TICK_US) {
+        lastPollMicros += SCHED_TICK_US;
+        tickCount++;
+        advanced = true;
+    }
+    if (advanced) runHardRealTime(tickCount);
+}
+
+void Scheduler::run() {
+    if (!started) return;
+    if (!timerRunning) pollTicks();
+
+    uint32_t now = ticks();
+    for (uint8_t i = 0; i < count; ++i) {
+        SchedTask& t = tasks[i];
+        if (t.hardRealTime) continue;
+        if (t.periodTicks == 0 || (int32_t)(now - t.nextTick) >= 0) runTask(t, now);
+    }
+}
+
+void Scheduler::resetStats() {
+    CriticalSection cs;
+    for (uint8_t i = 0; i < count; ++i) {
+        tasks[i].runs = 0;
+        tasks[i].overruns = 0;
+        tasks[i].lastExecUs = 0;
+        tasks[i].maxExecUs = 0;
+    }
+}
+
+void Scheduler::printStats(Print& out) {
+    out.println(F("=== SCHEDULER ==="));
+    out.print(F("Tick:")); out.print(SCHED_TICK_US);
+    out.print(F("us ")); out.println(timerRunning ? F("timer") : F("poll"));
+    out.println(F("Tarea       Hz Pri RT  Runs      Overruns  LastUs  MaxUs"));
+    for (uint8_t i = 0; i < count; ++i) {
+        SchedTask t;
+        {
+            CriticalSection cs;
+            t = tasks[i];
+        }
+        char line[80];
+        unsigned long hz = t.periodTicks ? 1000000UL / (t.periodTicks * SCHED_TICK_US) : 0;
+        snprintf(line, sizeof(line), " %3lu %3u  %c  %-9lu %-9lu %-7lu %lu",
+                 hz, (unsigned)t.priority, t.hardRealTime ? 'Y' : 'N',
+                 (unsigned long)t.runs, (unsigned long)t.overruns,
+                 (unsigned long)t.lastExecUs, (unsigned long)t.maxExecUs);
+        out.print(t.name);
+        // Alinear el nombre a 10 columnas (los nombres son cortos y viven en flash)
+        size_t len = strlen_P(reinterpret_cast<const char*>(t.name));
+        for (size_t k = len; k < 10; ++k) out.print(' ');
+        out.println(line);
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <Arduino.h>
+
+// ========================================
+//      PLANIFICADOR DE TAREAS A TASA FIJA
+// ========================================
+// Cada tarea declara periodo y prioridad (0 = más alta):
+// - Tareas de tiempo real (hardRealTime = true): las ejecuta la ISR del tick
+//   del timer, así que nunca las retrasa un cliente HTTP lento ni una ráfaga
+//   de Serial. Deben ser cortas y NO usar Serial, WiFi ni delay().
+// - Tareas de loop: las despacha run() desde loop() por orden de prioridad
+//   cuando vence su periodo. Periodo 0 = best-effort (cada pasada de run()).
+//
+// Se cuentan overruns por tarea: ejecución más larga que su periodo o una
+// activación perdida (la tarea arrancó más de un periodo tarde).
+//
+// Fuente del tick:
+// - UNO R4 (Renesas): FspTimer periódico a 1 kHz
+// - AVR (Uno): interrupción TIMER0_COMPA (~976 Hz, no altera millis() ni el PWM)
+// - Sin timer disponible: el tick se deriva de micros() dentro de run()
+
+#define SCHED_MAX_TASKS 12
+
+#if defined(__AVR__)
+#define SCHED_TICK_US 1024UL   // periodo de overflow del Timer0 @16 MHz
+#else
+#define SCHED_TICK_US 1000UL   // 1 kHz
+#endif
+
+typedef void (*SchedTaskFn)();
+
+struct SchedTask {
+    const __FlashStringHelper* name;
+    SchedTaskFn fn;
+    uint32_t periodTicks;          // 0 = best-effort (solo tareas de loop)
+    uint8_t priority;
+    bool hardRealTime;
+    uint32_t nextTick;             // siguiente activación (en ticks)
+    volatile uint32_t runs;
+    volatile uint32_t overruns;
+    volatile uint32_t lastExecUs;
+    volatile uint32_t maxExecUs;
+};
+
+class Scheduler {
+private:
+    SchedTask tasks[SCHED_MAX_TASKS];
+    uint8_t count = 0;
+    volatile uint32_t tickCount = 0;
+    bool timerRunning = false;
+    bool started = false;
+    unsigned long lastPollMicros = 0;
+
+    void runTask(SchedTask& t, uint32_t now);
+    void runHardRealTime(uint32_t now);
+    void pollTicks();
+
+public:
+    // Registrar una tarea antes de begin(). periodUs se redondea a ticks.
+    bool addTask(const __FlashStringHelper* name, SchedTaskFn fn, unsigned long periodUs,
+                 uint8_t priority, bool hardRealTime = false);
+
+    // Arranca el timer del tick. Llamar después de motors.init(): en el R4
+    // los timers PWM deben estar reservados antes de pedir uno libre.
+    void begin();
+
+    // Despacha tareas de loop vencidas (llamar en cada loop())
+    void run();
+
+    // Tick del timer (llamado desde la ISR)
+    void tick();
+
+    uint32_t ticks();
+    bool isTimerDriven() { return timerRunning; }
+
+    uint8_t taskCount() { return count; }
+    const SchedTask& task(uint8_t i) { return tasks[i]; }
+    void resetStats();
+    void printStats(Print& out);
+};
+
+#endif // SCHEDULER_H
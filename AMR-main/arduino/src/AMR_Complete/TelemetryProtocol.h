@@ -0,0 +1,254 @@
+#pragma once
+
+#ifndef TELEMETRY_PROTOCOL_H
+#define TELEMETRY_PROTOCOL_H
+
+// ========================================
+//     PROTOCOLO BINARIO DE TELEMETRÍA
+// ========================================
+// Esquema compartido entre el firmware y el decodificador del host
+// (tools/telemetry_decode.cpp). Solo depende de <stdint.h>/<string.h> para
+// que compile igual con arduino-cli y con g++ en el PC.
+//
+// Trama (little-endian):
+//     [SYNC 0xA5][VERSION][ID][SEQ][LEN][PAYLOAD: LEN bytes][CRC16 lo][CRC16 hi]
+// - CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) sobre VERSION..PAYLOAD.
+// - SEQ se incrementa en cada trama: un salto en el host = tramas perdidas.
+// - El texto de Serial (respuestas a comandos) puede intercalarse entre
+//   tramas: el decodificador resincroniza con SYNC + CRC.
+//
+// Versionado: cambiar el layout de un payload exige subir TELEM_VERSION.
+// Añadir un mensaje nuevo con otro ID no lo exige.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define TELEM_SYNC 0xA5
+#define TELEM_VERSION 1
+#define TELEM_HEADER_SIZE 5
+#define TELEM_CRC_SIZE 2
+#define TELEM_MAX_PAYLOAD 64
+#define TELEM_MAX_FRAME (TELEM_HEADER_SIZE + TELEM_MAX_PAYLOAD + TELEM_CRC_SIZE)
+
+// Escalas de punto fijo
+#define TELEM_POS_PER_CM 100.0f      // x, y en 1/100 cm (0.1 mm)
+#define TELEM_THETA_PER_RAD 10000.0f // theta en 1e-4 rad (cabe ±pi en int16)
+
+enum TelemMessageId {
+    TELEM_MSG_STATE = 0x01,
+    TELEM_MSG_TRACE_INFO = 0x02,   // cabecera de un volcado del grabador (TraceRing.h)
+    TELEM_MSG_TRACE = 0x03,        // un registro del grabador, del más antiguo al más nuevo
+    TELEM_MSG_FLEET_STATE = 0x04   // difusión UDP del modo flota (FleetControl.h)
+};
+
+// Bits de TelemState::flags
+#define TELEM_FLAG_ROUTE_ACTIVE     0x01
+#define TELEM_FLAG_AWAITING_CONFIRM 0x02
+#define TELEM_FLAG_OBSTACLE         0x04
+#define TELEM_FLAG_WALL_FOLLOW      0x08
+#define TELEM_FLAG_CLOSED_LOOP      0x10
+
+// TELEM_MSG_STATE: estado completo del robot en una trama
+struct __attribute__((packed)) TelemState {
+    uint32_t timeMs;       // millis()
+    int32_t x;             // 1/100 cm
+    int32_t y;             // 1/100 cm
+    int16_t theta;         // 1e-4 rad
+    int16_t v;             // mm/s
+    int16_t w;             // mrad/s
+    int32_t encLeft;       // pulsos acumulados
+    int32_t encRight;
+    uint16_t ir[5];        // raws promediados (orden L, FL, B, FR, R)
+    uint8_t routeState;    // mismo código que "state" de /route_status
+    uint8_t routePoint;
+    uint8_t obstacleState;
+    uint8_t flags;         // TELEM_FLAG_*
+};
+
+static_assert(sizeof(TelemState) == 40, "TelemState layout changed: bump TELEM_VERSION");
+static_assert(sizeof(TelemState) <= TELEM_MAX_PAYLOAD, "TelemState too large");
+
+// Motivo de congelación del grabador (TelemTraceInfo::reason)
+enum TelemTraceReason {
+    TELEM_TRACE_RUNNING = 0,       // volcado sin congelar (no debería verse)
+    TELEM_TRACE_MANUAL,            // pedido por /trace o 'G'
+    TELEM_TRACE_STOP,              // 'X'
+    TELEM_TRACE_ROUTE_ABORT,       // ruta abortada (stop_route, sin desvío, error)
+    TELEM_TRACE_TURN_TIMEOUT,      // MAX_TURN_TIME superado
+    TELEM_TRACE_DIAG_TIMEOUT       // 'V' sin completar la vuelta
+};
+
+// TELEM_MSG_TRACE_INFO: precede a los registros de un volcado
+struct __attribute__((packed)) TelemTraceInfo {
+    uint16_t count;        // registros que siguen
+    uint16_t periodMs;     // periodo nominal de grabación
+    uint32_t triggerMs;    // millis() del disparo (0 si no hubo)
+    uint8_t reason;        // TelemTraceReason
+    uint8_t recordSize;    // sizeof(TelemTraceRecord)
+};
+
+// Bits extra de TelemTraceRecord::flags (además de TELEM_FLAG_*)
+#define TELEM_FLAG_TURNING          0x20
+#define TELEM_FLAG_TELEOP           0x40
+#define TELEM_FLAG_TRIGGER          0x80   // primer registro tras el disparo
+
+// TELEM_MSG_TRACE: estado de control de una pasada de la tarea motion
+struct __attribute__((packed)) TelemTraceRecord {
+    uint32_t timeMs;       // millis()
+    int32_t encLeft;       // pulsos acumulados
+    int32_t encRight;
+    int16_t x;             // mm (±32 m)
+    int16_t y;
+    int16_t theta;         // 1e-4 rad
+    int16_t pwmLeft;       // última orden con signo, 1/16 de paso PWM (±4080)
+    int16_t pwmRight;
+    uint16_t ir[5];        // raws promediados (orden L, FL, B, FR, R)
+    uint8_t routeState;    // como TelemState
+    uint8_t routePoint;
+    uint8_t obstacleState;
+    uint8_t flags;         // TELEM_FLAG_*
+};
+
+static_assert(sizeof(TelemTraceInfo) == 10, "TelemTraceInfo layout changed: bump TELEM_VERSION");
+static_assert(sizeof(TelemTraceRecord) == 36, "TelemTraceRecord layout changed: bump TELEM_VERSION");
+
+// Bits de TelemFleetState::fleetFlags
+#define TELEM_FLEET_HOLD            0x01   // retenido por el coordinador
+#define TELEM_FLEET_LEASING         0x02   // avanza solo con reserva vigente
+#define TELEM_FLEET_LEASE_EXPIRED   0x04   // reserva vencida: retenido
+#define TELEM_FLEET_STATION         0x08   // unido a la red del sitio (no AP propio)
+
+// TELEM_MSG_FLEET_STATE: un datagrama UDP de difusión por trama. SEQ
+// cuenta solo estas tramas, así el coordinador ve las pérdidas por robot.
+struct __attribute__((packed)) TelemFleetState {
+    uint8_t robotId;       // identifica al emisor (varios robots en el mismo puerto)
+    uint8_t fleetFlags;    // TELEM_FLEET_*
+    uint8_t routeIndex;    // ruta en curso, 0xFF sin ruta
+    uint8_t reserved;
+    uint16_t leaseLeftMs;  // ms de reserva restantes (saturado)
+    TelemState state;
+};
+
+static_assert(sizeof(TelemFleetState) == 46, "TelemFleetState layout changed: bump TELEM_VERSION");
+static_assert(sizeof(TelemFleetState) <= TELEM_MAX_PAYLOAD, "TelemFleetState too large");
+
+inline uint16_t telemCrc16(const uint8_t* data, size_t len, uint16_t crc = 0xFFFF) {
+    for (size_t i = 0; i < len; ++i) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t b = 0; b < 8; ++b) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+// Empaqueta una trama en out. Devuelve su longitud, o 0 si no cabe.
+inline size_t telemEncodeFrame(uint8_t* out, size_t cap, uint8_t id, uint8_t seq,
+                               const void* payload, uint8_t len) {
+    size_t total = TELEM_HEADER_SIZE + (size_t)len + TELEM_CRC_SIZE;
+    if (len > TELEM_MAX_PAYLOAD || total > cap) return 0;
+    out[0] = TELEM_SYNC;
+    out[1] = TELEM_VERSION;
+    out[2] = id;
+    out[3] = seq;
+    out[4] = len;
+    memcpy(out + TELEM_HEADER_SIZE, payload, len);
+    uint16_t crc = telemCrc16(out + 1, TELEM_HEADER_SIZE - 1 + len);
+    out[TELEM_HEADER_SIZE + len] = (uint8_t)(crc & 0xFF);
+    out[TELEM_HEADER_SIZE + len + 1] = (uint8_t)(crc >> 8);
+    return total;
+}
+
+// Decodificador incremental: feed() byte a byte; true cuando hay una trama
+// válida disponible en id()/seq()/payload()/length() (hasta la siguiente
+// llamada). Tras un error de cabecera o CRC se sigue decodificando lo ya
+// recibido desde el siguiente SYNC: si ahí hay tramas completas salen una
+// por llamada, y al acabar el flujo next() entrega las que queden.
+class TelemDecoder {
+private:
+    uint8_t buf[TELEM_MAX_FRAME];
+    size_t pos = 0;
+    size_t need = TELEM_HEADER_SIZE;
+    bool ready = false;         // buf[0, need) es la trama entregada
+
+public:
+    uint32_t frames = 0;
+    uint32_t crcErrors = 0;
+    uint32_t versionErrors = 0;
+
+    bool feed(uint8_t b) {
+        consume();
+        buf[pos++] = b;   // cabe: scan() deja pos < need, o consume() acaba de quitar una trama
+        ready = scan();
+        return ready;
+    }
+
+    // Siguiente trama completa que ya esté en el buffer, sin bytes nuevos
+    bool next() {
+        consume();
+        ready = scan();
+        return ready;
+    }
+
+    uint8_t id() const { return buf[2]; }
+    uint8_t seq() const { return buf[3]; }
+    uint8_t length() const { return buf[4]; }
+    const uint8_t* payload() const { return buf + TELEM_HEADER_SIZE; }
+
+private:
+    // Quitar la trama ya entregada; lo que venía detrás se decodifica después
+    void consume() {
+        if (!ready) return;
+        ready = false;
+        drop(need);
+        need = TELEM_HEADER_SIZE;
+    }
+
+    void drop(size_t n) {
+        memmove(buf, buf + n, pos - n);
+        pos -= n;
+    }
+
+    // Descartar el SYNC de buf[0] (falso o de una trama rota) hasta el siguiente
+    void resync() {
+        size_t i = 1;
+        while (i < pos && buf[i] != TELEM_SYNC) ++i;
+        drop(i);
+        need = TELEM_HEADER_SIZE;
+    }
+
+    // true si buf empieza por una trama válida completa
+    bool scan() {
+        while (pos > 0) {
+            if (buf[0] != TELEM_SYNC) {
+                resync();
+                continue;
+            }
+            if (pos < TELEM_HEADER_SIZE) return false;
+            if (buf[1] != TELEM_VERSION || buf[4] > TELEM_MAX_PAYLOAD) {
+                if (buf[1] != TELEM_VERSION) versionErrors++;
+                resync();
+                continue;
+            }
+            uint8_t len = buf[4];
+            need = TELEM_HEADER_SIZE + len + TELEM_CRC_SIZE;
+            if (pos < need) return false;
+
+            uint16_t crc = telemCrc16(buf + 1, TELEM_HEADER_SIZE - 1 + len);
+            uint16_t got = (uint16_t)buf[TELEM_HEADER_SIZE + len] |
+                           ((uint16_t)buf[TELEM_HEADER_SIZE + len + 1] << 8);
+            if (crc != got) {
+                // Posible SYNC falso (p.ej. dentro de texto): reintentar desde el siguiente
+                crcErrors++;
+                resync();
+                continue;
+            }
+            frames++;
+            return true;
+        }
+        return false;
+    }
+};
+
+#endif // TELEMETRY_PROTOCOL_H
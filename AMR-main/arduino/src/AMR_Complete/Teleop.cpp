@@ -0,0 +1,69 @@
+#include "Teleop.h"
+#include <stdlib.h>
+
+// Lee "t,v,w" desde p; devuelve el puntero tras el último número o nullptr
+static const char* parseSetpoint(const char* p, long& t, long& v, long& w) {
+    char* end;
+    t = strtol(p, &end, 10);
+    if (end == p || *end != ',') return nullptr;
+    p = end + 1;
+    v = strtol(p, &end, 10);
+    if (end == p || *end != ',') return nullptr;
+    p = end + 1;
+    w = strtol(p, &end, 10);
+    if (end == p) return nullptr;
+    return end;
+}
+
+TeleopResult Teleop::submit(uint16_t seq, const char* body, unsigned long nowMs) {
+    // Solo lotes posteriores (seq de 16 bits con vuelta), salvo tras un
+    // silencio largo: un lote retrasado no debe reanudar una sesión parada
+    bool recent = batches > 0 && (active || nowMs - batchStartMs < TELEOP_RESYNC_MS);
+    if (recent && (int16_t)(seq - lastSeq) <= 0) {
+        staleBatches++;
+        return TELEOP_STALE;
+    }
+
+    TeleopSetpoint parsed[TELEOP_MAX_SETPOINTS];
+    uint8_t n = 0;
+    long prevT = -1;
+    const char* p = body;
+    while (p && *p) {
+        if (*p == ';' || *p == ' ' || *p == '\r' || *p == '\n') { p++; continue; }
+        if (n >= TELEOP_MAX_SETPOINTS) return TELEOP_BAD_BATCH;
+        long t, v, w;
+        p = parseSetpoint(p, t, v, w);
+        if (!p || t <= prevT || t > 0xFFFF) return TELEOP_BAD_BATCH;
+        prevT = t;
+        parsed[n].tMs = (uint16_t)t;
+        parsed[n].vMmS = (int16_t)constrain(v, -TELEOP_MAX_MM_S, TELEOP_MAX_MM_S);
+        parsed[n].wDegS = (int16_t)constrain(w, -TELEOP_MAX_DEG_S, TELEOP_MAX_DEG_S);
+        n++;
+    }
+    if (n == 0) return TELEOP_BAD_BATCH;
+
+    for (uint8_t i = 0; i < n; ++i) points[i] = parsed[i];
+    count = n;
+    lastSeq = seq;
+    batchStartMs = nowMs;
+    active = true;
+    batches++;
+    return TELEOP_ACCEPTED;
+}
+
+bool Teleop::current(unsigned long nowMs, float& vMmS, float& wDegS) {
+    if (!active) return false;
+    unsigned long elapsed = nowMs - batchStartMs;
+    if (elapsed > (unsigned long)points[count - 1].tMs + TELEOP_DEADMAN_MS) {
+        active = false;
+        count = 0;
+        deadmanStops++;
+        return false;
+    }
+    // Última consigna ya vencida (antes de la primera: la primera)
+    uint8_t i = 0;
+    while (i + 1 < count && points[i + 1].tMs <= elapsed) i++;
+    vMmS = points[i].vMmS;
+    wDegS = points[i].wDegS;
+    return true;
+}
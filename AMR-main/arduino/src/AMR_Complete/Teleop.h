@@ -0,0 +1,80 @@
+#pragma once
+
+#ifndef TELEOP_H
+#define TELEOP_H
+
+#include <Arduino.h>
+
+// ========================================
+//     TELEOPERACIÓN POR LOTES DE CONSIGNAS
+// ========================================
+// POST /teleop?seq=N con cuerpo "t,v,w;t,v,w;..." lleva un lote de
+// consignas con sello de tiempo:
+//   t  ms desde la llegada del lote (creciente, el primero normalmente 0)
+//   v  velocidad lineal en mm/s       w  velocidad angular en °/s (antihorario +)
+// Cada lote sustituye al anterior y se reproduce a su ritmo: el dashboard
+// envía un lote cada 80 ms con 8 consignas cada 40 ms (los 320 ms
+// siguientes), así que la consigna cambia a 25 Hz aunque la conexión
+// tenga jitter. La conexión se mantiene abierta (keep-alive).
+// Lotes con seq no posterior al último aceptado se descartan (llegan
+// desordenados o duplicados). Tras TELEOP_RESYNC_MS sin lotes se acepta
+// cualquier seq (p.ej. página recargada, que vuelve a empezar en 1).
+//
+// Hombre muerto: pasados TELEOP_DEADMAN_MS desde la última consigna del
+// lote vigente sin lote nuevo, current() devuelve false y el sketch para
+// los motores. Un lote "0,0,0" para en el acto. El sketch pasa además
+// deadmanAtMs() como caducidad de la consigna (DriveController): si loop()
+// se bloquea, la tarea de control para igualmente a esa hora.
+//
+// Teleop no toca hardware: el sketch aplica current() con
+// DriveController::setVelocity() (igual que PathFollower).
+
+#define TELEOP_MAX_SETPOINTS 24       // cabe en HTTP_MAX_BODY con valores típicos
+#define TELEOP_DEADMAN_MS 250
+#define TELEOP_RESYNC_MS 2000
+#define TELEOP_MAX_MM_S 400
+#define TELEOP_MAX_DEG_S 120
+
+struct TeleopSetpoint {
+    uint16_t tMs;
+    int16_t vMmS;
+    int16_t wDegS;
+};
+
+enum TeleopResult : uint8_t {
+    TELEOP_ACCEPTED = 0,
+    TELEOP_STALE,                 // seq antiguo: se ignora
+    TELEOP_BAD_BATCH              // vacío, mal formado u orden de t incorrecto
+};
+
+class Teleop {
+private:
+    TeleopSetpoint points[TELEOP_MAX_SETPOINTS];
+    uint8_t count = 0;
+    bool active = false;
+    uint16_t lastSeq = 0;
+    unsigned long batchStartMs = 0;
+
+    // Estadística (GET /teleop)
+    unsigned long batches = 0;
+    unsigned long staleBatches = 0;
+    unsigned long deadmanStops = 0;
+
+public:
+    TeleopResult submit(uint16_t seq, const char* body, unsigned long nowMs);
+
+    // Consigna vigente; false si no hay sesión o saltó el hombre muerto
+    bool current(unsigned long nowMs, float& vMmS, float& wDegS);
+
+    // Instante (millis) en que salta el hombre muerto sin lote nuevo
+    unsigned long deadmanAtMs() const { return batchStartMs + points[count - 1].tMs + TELEOP_DEADMAN_MS; }
+
+    void stop() { active = false; count = 0; }
+    bool isActive() const { return active; }
+
+    unsigned long getBatches() const { return batches; }
+    unsigned long getStaleBatches() const { return staleBatches; }
+    unsigned long getDeadmanStops() const { return deadmanStops; }
+};
+
+#endif // TELEOP_H
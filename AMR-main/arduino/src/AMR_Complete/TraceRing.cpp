@@ -0,0 +1,57 @@
+#include "TraceRing.h"
+
+void TraceRing::commit() {
+    if (frozen) return;
+    if (markNext) {
+        records[head].flags |= TELEM_FLAG_TRIGGER;
+        markNext = false;
+    }
+    head = (head + 1 < TRACE_RECORDS) ? head + 1 : 0;
+    if (count < TRACE_RECORDS) count++;
+    if (triggered && --postLeft == 0) frozen = true;
+}
+
+void TraceRing::trigger(TelemTraceReason why, uint32_t nowMs) {
+    if (triggered || frozen) return;
+    triggered = true;
+    reason = why;
+    triggerMs = nowMs;
+    postLeft = TRACE_POST_TRIGGER;
+    markNext = true;
+}
+
+void TraceRing::freeze(TelemTraceReason why, uint32_t nowMs) {
+    if (frozen) return;
+    if (!triggered) {
+        triggered = true;
+        reason = why;
+        triggerMs = nowMs;
+    }
+    frozen = true;
+}
+
+void TraceRing::rearm() {
+    head = 0;
+    count = 0;
+    postLeft = 0;
+    triggerMs = 0;
+    reason = TELEM_TRACE_RUNNING;
+    triggered = false;
+    frozen = false;
+    markNext = false;
+}
+
+const TelemTraceRecord& TraceRing::at(uint16_t i) const {
+    uint16_t start = (count < TRACE_RECORDS) ? 0 : head;
+    uint16_t idx = start + i;
+    if (idx >= TRACE_RECORDS) idx -= TRACE_RECORDS;
+    return records[idx];
+}
+
+void TraceRing::info(TelemTraceInfo& out, uint16_t periodMs) const {
+    out.count = count;
+    out.periodMs = periodMs;
+    out.triggerMs = triggerMs;
+    out.reason = reason;
+    out.recordSize = (uint8_t)sizeof(TelemTraceRecord);
+}
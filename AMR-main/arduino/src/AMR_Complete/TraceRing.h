@@ -0,0 +1,67 @@
+#pragma once
+
+#ifndef TRACE_RING_H
+#define TRACE_RING_H
+
+#include <Arduino.h>
+#include "TelemetryProtocol.h"
+
+// ========================================
+//     GRABADOR DE VUELO (TRAZA CIRCULAR)
+// ========================================
+// Anillo fijo de registros binarios TelemTraceRecord (36 B): la tarea
+// motion escribe uno por pasada (100 Hz) con estado de ruta, encoders,
+// PWM, raws IR y pose. Grabar es copiar campos ya calculados al hueco
+// siguiente: sin texto, sin heap y sin locks (productor y lector viven en
+// el contexto de loop(), como LogRing).
+//
+// Un evento de fallo (timeout de giro, ruta abortada, 'X') llama a
+// trigger(): se graban TRACE_POST_TRIGGER registros más para ver el
+// después y el anillo se congela hasta rearm(). Solo cuenta el primer
+// disparo; arrancar una ruta o el seguimiento de pared rearma.
+//
+// Volcado: tramas TELEM_MSG_TRACE_INFO + TELEM_MSG_TRACE por /trace o por
+// Serial ('G'); tools/telemetry_decode --trace las pasa a CSV y el
+// simulador (amr_sim --replay) reproduce el PWM sobre la planta.
+
+#if defined(__AVR__)
+#define TRACE_RECORDS 16              // 576 B: el Uno no tiene RAM para más
+#else
+#define TRACE_RECORDS 200             // 7.2 KB: 2 s a 100 Hz
+#endif
+#define TRACE_POST_TRIGGER 25         // registros tras el disparo (250 ms)
+
+class TraceRing {
+private:
+    TelemTraceRecord records[TRACE_RECORDS];
+    uint16_t head = 0;                // siguiente hueco
+    uint16_t count = 0;
+    uint16_t postLeft = 0;            // registros hasta congelar tras el disparo
+    uint32_t triggerMs = 0;
+    uint8_t reason = TELEM_TRACE_RUNNING;
+    bool triggered = false;
+    bool frozen = false;
+    bool markNext = false;            // TELEM_FLAG_TRIGGER en el siguiente registro
+
+public:
+    // Hueco para el registro de esta pasada; nullptr si está congelado.
+    // Rellenarlo entero y llamar a commit().
+    TelemTraceRecord* slot() { return frozen ? nullptr : &records[head]; }
+    void commit();
+
+    // Evento de fallo: congelar tras TRACE_POST_TRIGGER registros
+    void trigger(TelemTraceReason why, uint32_t nowMs);
+    // Congelar ya (volcado pedido); conserva el motivo si ya había disparo
+    void freeze(TelemTraceReason why, uint32_t nowMs);
+    void rearm();
+
+    bool isFrozen() const { return frozen; }
+    bool isTriggered() const { return triggered; }
+    uint16_t size() const { return count; }
+
+    // i = 0 es el registro más antiguo
+    const TelemTraceRecord& at(uint16_t i) const;
+    void info(TelemTraceInfo& out, uint16_t periodMs) const;
+};
+
+#endif // TRACE_RING_H
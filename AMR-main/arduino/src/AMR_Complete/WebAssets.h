@@ -0,0 +1,648 @@
+#pragma once
+
+#ifndef WEB_ASSETS_H
+#define WEB_ASSETS_H
+
+#include <Arduino.h>
+
+// ========================================
+//     PÁGINAS WEB COMPRIMIDAS (GENERADO)
+// ========================================
+// NO EDITAR: generado por tools/build_web_assets.py desde web/*.html.
+// Cada página: bytes gzip en flash, longitud, ETag (hash del contenido,
+// con comillas) y tipo MIME.
+
+// web/dashboard.html: 14752 bytes -> 5160 gzip
+#define WEB_DASHBOARD_ETAG "\"c55ea0d83f8509b0\""
+#define WEB_DASHBOARD_TYPE "text/html; charset=utf-8"
+#define WEB_DASHBOARD_GZ_LEN 5160U
+static const uint8_t WEB_DASHBOARD_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xb5, 0x5b, 0xdd, 0x72, 0xdb, 0x46,
+    0x96, 0xbe, 0xcf, 0x53, 0x74, 0x94, 0xcc, 0x10, 0xb4, 0x00, 0x12, 0xa4, 0x6d, 0x45, 0x21, 0x05,
+    0x65, 0x65, 0x49, 0x29, 0x6b, 0xcb, 0xb1, 0x15, 0x91, 0x13, 0x27, 0xe5, 0xf2, 0x26, 0x4d, 0xa0,
+    0x29, 0x42, 0x06, 0x01, 0x06, 0x3f, 0xa2, 0x68, 0x8d, 0x6e, 0xe7, 0x76, 0xff, 0x9e, 0x20, 0x0f,
+    0xb0, 0x55, 0xa9, 0x9a, 0xab, 0xcd, 0x65, 0xfc, 0x26, 0xf3, 0x24, 0xfb, 0x9d, 0xee, 0xc6, 0x2f,
+    0x49, 0xd9, 0xc9, 0x64, 0x9d, 0x8a, 0x48, 0x74, 0x9f, 0x73, 0xfa, 0xf4, 0xf9, 0x3f, 0xdd, 0xe0,
+    0xc1, 0xc7, 0x27, 0x2f, 0x8e, 0xc7, 0xdf, 0x9d, 0x9f, 0xb2, 0x59, 0x3a, 0x0f, 0x0e, 0x3f, 0x3a,
+    0xc8, 0x3f, 0x04, 0xf7, 0xf0, 0x31, 0x17, 0x29, 0x67, 0xee, 0x8c, 0xc7, 0x89, 0x48, 0x9d, 0x9d,
+    0x2c, 0x9d, 0x5a, 0xfb, 0x3b, 0xf9, 0x70, 0xc8, 0xe7, 0xc2, 0xd9, 0xb9, 0xf6, 0xc5, 0x72, 0x11,
+    0xc5, 0xe9, 0x0e, 0x73, 0xa3, 0x30, 0x15, 0x21, 0xc0, 0x96, 0xbe, 0x97, 0xce, 0x1c, 0x4f, 0x5c,
+    0xfb, 0xae, 0xb0, 0xe4, 0x83, 0xe9, 0x87, 0x7e, 0xea, 0xf3, 0xc0, 0x4a, 0x5c, 0x1e, 0x08, 0xa7,
+    0x47, 0x34, 0x52, 0x3f, 0x0d, 0xc4, 0xe1, 0xd1, 0x57, 0x17, 0xec, 0x84, 0x27, 0xb3, 0x49, 0xc4,
+    0x63, 0xef, 0xa0, 0xab, 0x06, 0x3f, 0x3a, 0x48, 0xd2, 0x15, 0x7d, 0x32, 0xfc, 0xeb, 0x3e, 0x60,
+    0xa7, 0xd7, 0x7e, 0xca, 0x63, 0x96, 0x88, 0x40, 0xb8, 0xae, 0xff, 0xee, 0xef, 0x21, 0x5b, 0xb1,
+    0x58, 0x24, 0x3c, 0x48, 0xb9, 0x17, 0xb1, 0xf4, 0xdd, 0x4f, 0x6e, 0xea, 0x07, 0x4c, 0x84, 0x6c,
+    0x12, 0xa5, 0x51, 0x28, 0x92, 0xee, 0xbb, 0x9f, 0x62, 0xc1, 0x13, 0x16, 0x46, 0x4c, 0x78, 0x40,
+    0x9d, 0x04, 0x22, 0x61, 0x0f, 0xba, 0x92, 0x1c, 0xed, 0xcf, 0x04, 0xa0, 0xb7, 0x62, 0xb7, 0x72,
+    0x80, 0xfe, 0x4d, 0xb8, 0xfb, 0xe6, 0x32, 0x8e, 0xb2, 0xd0, 0x1b, 0x7c, 0xd2, 0xeb, 0xf5, 0x86,
+    0xd8, 0x4b, 0x10, 0xc5, 0x83, 0x4f, 0x84, 0x10, 0x43, 0x36, 0xc5, 0xbe, 0xac, 0x29, 0x9f, 0xfb,
+    0xc1, 0x6a, 0x70, 0x14, 0x63, 0x17, 0x43, 0x36, 0xe7, 0xf1, 0xa5, 0x1f, 0x0e, 0xec, 0x21, 0x5b,
+    0x70, 0xcf, 0xf3, 0xc3, 0xcb, 0xc1, 0xfe, 0xe2, 0x66, 0x58, 0x90, 0xb3, 0x96, 0x62, 0xf2, 0xc6,
+    0x4f, 0xad, 0x2c, 0x11, 0xb1, 0x25, 0xb9, 0x4e, 0x07, 0x60, 0x26, 0x04, 0x31, 0xec, 0x66, 0xc4,
+    0xa7, 0x3c, 0xf6, 0x73, 0x7e, 0x24, 0xfc, 0x3c, 0x7a, 0xbb, 0x01, 0xb8, 0x32, 0x9f, 0xdc, 0x37,
+    0xbd, 0x79, 0x19, 0x29, 0xb4, 0xaa, 0xcc, 0x3c, 0xc1, 0x52, 0x71, 0x93, 0x46, 0x0c, 0xea, 0x62,
+    0x41, 0x14, 0x5e, 0x5a, 0x0b, 0x08, 0x31, 0xa9, 0x31, 0xa2, 0x19, 0x4f, 0xa3, 0xcc, 0x9d, 0x59,
+    0xd0, 0x55, 0x10, 0x65, 0x55, 0x9a, 0xfe, 0x8b, 0xd1, 0xfb, 0x30, 0xf9, 0xc2, 0x9a, 0xf9, 0x97,
+    0xb3, 0x00, 0xff, 0xa7, 0x96, 0x12, 0x23, 0x8b, 0x2f, 0x27, 0xdc, 0xb0, 0x4d, 0xf9, 0x5f, 0x5b,
+    0x12, 0xfa, 0x31, 0x93, 0x1a, 0x2d, 0x20, 0xab, 0xa4, 0xd4, 0xe2, 0x1c, 0x3a, 0x8d, 0xc2, 0x01,
+    0x44, 0x1d, 0xfa, 0x8b, 0x2c, 0xe0, 0xf4, 0x24, 0x51, 0xe7, 0xe2, 0x2a, 0x8a, 0x39, 0x0b, 0x38,
+    0xf3, 0x61, 0x6f, 0x31, 0xd7, 0xbb, 0xcb, 0xad, 0x40, 0x13, 0xba, 0xcb, 0x6d, 0xe7, 0x5c, 0xc4,
+    0x73, 0xd8, 0x5e, 0xcd, 0x7a, 0x60, 0x29, 0x2e, 0x9f, 0x2f, 0xa2, 0x64, 0xdd, 0x3c, 0x94, 0x18,
+    0x4d, 0xd0, 0x5e, 0x64, 0xf8, 0x20, 0x81, 0x71, 0xd8, 0x12, 0xbb, 0xdd, 0xac, 0x54, 0x9a, 0x1f,
+    0xb2, 0x0d, 0x43, 0x6a, 0xfd, 0x59, 0x0f, 0x88, 0xda, 0x96, 0xec, 0x29, 0xcc, 0x85, 0x26, 0x2d,
+    0x8e, 0x2d, 0x87, 0x03, 0x57, 0x10, 0xfb, 0x85, 0x2d, 0xc1, 0x80, 0x98, 0x9d, 0xe3, 0x7d, 0x42,
+    0x2e, 0x97, 0x26, 0x40, 0xf6, 0xfc, 0x64, 0x11, 0xf0, 0xd5, 0x60, 0x1a, 0x88, 0x9b, 0x21, 0xbb,
+    0xca, 0x92, 0xd4, 0x9f, 0xae, 0x2c, 0xed, 0x6a, 0x83, 0x64, 0xc1, 0xe1, 0x62, 0x5c, 0x5a, 0x2e,
+    0x0c, 0x15, 0x30, 0xd6, 0x32, 0xe6, 0x8b, 0x01, 0xfd, 0x19, 0xb2, 0x4b, 0x7c, 0xeb, 0xd9, 0x30,
+    0x4c, 0x26, 0x57, 0xb4, 0xfc, 0x54, 0xcc, 0x93, 0x62, 0xdd, 0xdc, 0x72, 0xf7, 0x08, 0xa0, 0x10,
+    0xd7, 0x69, 0x98, 0x64, 0xb1, 0x90, 0x2e, 0x9f, 0x02, 0x24, 0x14, 0x41, 0xc2, 0x14, 0x06, 0x4b,
+    0x67, 0x02, 0x62, 0xd4, 0x4b, 0x33, 0x1e, 0x7a, 0x6c, 0xc6, 0xaf, 0x05, 0xf8, 0x4f, 0xdd, 0x19,
+    0x08, 0xe5, 0x60, 0x81, 0x1f, 0x96, 0xe2, 0xec, 0x28, 0x42, 0xcd, 0x7d, 0x48, 0x4e, 0x3d, 0x3f,
+    0x16, 0x4a, 0xc9, 0x90, 0x50, 0x36, 0x0f, 0x37, 0xb3, 0xd9, 0xdc, 0x72, 0x21, 0x36, 0x3f, 0xb4,
+    0xc0, 0x10, 0x6c, 0x67, 0xd0, 0xdb, 0xb3, 0xcb, 0x3d, 0xb8, 0x3c, 0xbc, 0xe6, 0x24, 0xb9, 0xaa,
+    0x4f, 0xf7, 0xfb, 0xfd, 0x21, 0x7c, 0x3e, 0xf6, 0x44, 0x3c, 0xe8, 0x41, 0xd0, 0x49, 0x14, 0xf8,
+    0x1e, 0xfb, 0xe4, 0xd1, 0xa3, 0x47, 0xf9, 0xb0, 0x15, 0x73, 0xcf, 0xcf, 0x12, 0x25, 0x8d, 0x9c,
+    0xd9, 0x49, 0x10, 0xb9, 0x6f, 0x86, 0x4c, 0x86, 0x30, 0x48, 0xd2, 0xfe, 0xd3, 0x90, 0xe9, 0x25,
+    0x79, 0x96, 0x46, 0xf9, 0x8a, 0x9d, 0x39, 0x5f, 0x60, 0xbd, 0x39, 0xbf, 0x51, 0xc1, 0x6e, 0xd0,
+    0xaf, 0xf2, 0xd3, 0x71, 0xa3, 0xf9, 0x82, 0x27, 0x49, 0x0d, 0xa2, 0xf7, 0xa8, 0x0a, 0x01, 0xa9,
+    0x56, 0x27, 0x1f, 0xda, 0x75, 0xf4, 0x30, 0x8d, 0xa3, 0x40, 0xe1, 0x93, 0xa5, 0xc0, 0x39, 0xa1,
+    0xd6, 0x47, 0x55, 0x3e, 0x37, 0x1b, 0x47, 0x2e, 0x29, 0x32, 0x03, 0x0a, 0x4f, 0x6b, 0xf6, 0xd1,
+    0x5c, 0x61, 0x92, 0xa5, 0x08, 0x9f, 0x0d, 0xd1, 0x3d, 0x7c, 0xf8, 0x70, 0x58, 0x33, 0x61, 0x2d,
+    0x46, 0x15, 0x13, 0x72, 0x23, 0x22, 0x33, 0x63, 0x3d, 0x29, 0x3c, 0x6d, 0xcf, 0x92, 0x41, 0x19,
+    0x3a, 0x13, 0xff, 0xad, 0x18, 0xf4, 0x24, 0x07, 0x1b, 0x64, 0xbd, 0x99, 0x89, 0xc1, 0x2c, 0xba,
+    0x16, 0x71, 0x83, 0x15, 0xb9, 0x7c, 0xce, 0x8a, 0x6d, 0x57, 0xac, 0x76, 0x2c, 0x12, 0x78, 0x8b,
+    0x34, 0x57, 0x66, 0x48, 0x81, 0xbb, 0xa9, 0xa6, 0x94, 0x20, 0x9e, 0xb0, 0x34, 0xf6, 0x2f, 0x2f,
+    0x41, 0x6f, 0x92, 0xf9, 0x41, 0x6a, 0xf9, 0x88, 0x16, 0x84, 0xd0, 0x2e, 0xac, 0x54, 0x3e, 0x5a,
+    0x97, 0x31, 0x8c, 0xa2, 0x69, 0xaa, 0x85, 0xf4, 0xb6, 0x89, 0xb7, 0x29, 0xd5, 0xaa, 0x96, 0xec,
+    0x9a, 0x6f, 0x25, 0x62, 0xc1, 0x63, 0x19, 0xc8, 0x94, 0xf7, 0x20, 0xc5, 0x82, 0xa7, 0x69, 0xa4,
+    0x9c, 0x4a, 0xee, 0x3e, 0x51, 0x1e, 0x51, 0x30, 0xa6, 0x9f, 0x2d, 0x99, 0x17, 0xcb, 0x58, 0xf2,
+    0xd9, 0xf1, 0x97, 0xc7, 0xf6, 0xbd, 0xe1, 0xa4, 0xd7, 0xa7, 0x78, 0xc2, 0xf6, 0x1a, 0x5a, 0xe8,
+    0xd8, 0xfd, 0x58, 0xcc, 0x9b, 0x52, 0xb7, 0xf2, 0x65, 0x6f, 0x7f, 0x83, 0x49, 0x29, 0x8d, 0x56,
+    0x5d, 0x56, 0x4a, 0x22, 0x41, 0xbc, 0x4c, 0x37, 0x48, 0xa1, 0x92, 0x28, 0x15, 0x57, 0xda, 0x16,
+    0x24, 0x44, 0xe9, 0x92, 0xd2, 0x53, 0x37, 0x1b, 0x2a, 0x24, 0x78, 0x62, 0x81, 0x0c, 0x34, 0x1c,
+    0x67, 0x2e, 0x2a, 0x90, 0x36, 0x92, 0xc0, 0x4a, 0x26, 0x28, 0x04, 0x60, 0x86, 0x94, 0x74, 0xed,
+    0x47, 0x59, 0x61, 0xc6, 0x1c, 0x3a, 0x9d, 0x89, 0xd4, 0x77, 0x69, 0x80, 0xf1, 0x38, 0xe6, 0xe1,
+    0xa5, 0xf0, 0x10, 0xd8, 0x99, 0x46, 0x2f, 0x84, 0xec, 0x11, 0xd1, 0x72, 0xeb, 0x64, 0x06, 0xd8,
+    0x22, 0xfe, 0x5a, 0xd8, 0x16, 0x86, 0x52, 0x61, 0xa9, 0x08, 0x95, 0x0c, 0x58, 0x6f, 0x1a, 0xe7,
+    0xff, 0x6b, 0x18, 0x0a, 0x05, 0x56, 0x1c, 0x2d, 0x31, 0xa9, 0xa2, 0x42, 0x19, 0x76, 0xb7, 0x89,
+    0x6f, 0x53, 0x9c, 0xab, 0x06, 0x99, 0x4a, 0x2c, 0x50, 0xa1, 0x24, 0xaf, 0x37, 0x58, 0x2d, 0xee,
+    0x10, 0xdf, 0xd6, 0x24, 0xfd, 0x6d, 0x1e, 0x5b, 0x77, 0xc1, 0xfd, 0xaa, 0x6a, 0x2a, 0x4e, 0x5c,
+    0x31, 0x19, 0xe5, 0xd4, 0xd0, 0xa5, 0xe6, 0x50, 0x6d, 0xad, 0x12, 0x7e, 0x1f, 0x49, 0x57, 0x77,
+    0xb3, 0x38, 0xc1, 0x8a, 0x8b, 0xc8, 0x57, 0xfb, 0x69, 0xf0, 0xb8, 0xd1, 0xa1, 0x73, 0x33, 0x5e,
+    0xf7, 0xe9, 0x12, 0x8f, 0xea, 0x80, 0x6b, 0x32, 0xfd, 0x14, 0x0a, 0x4c, 0xe0, 0x2c, 0xf3, 0x81,
+    0xfa, 0x4a, 0x7a, 0xf9, 0xce, 0x80, 0xe9, 0xb4, 0x6b, 0x48, 0xf0, 0x19, 0x4a, 0x8a, 0x8d, 0xa5,
+    0x24, 0x06, 0xbc, 0x0f, 0xc2, 0x26, 0x11, 0xc0, 0x4c, 0x67, 0x28, 0x1d, 0x97, 0x35, 0x99, 0xe8,
+    0x87, 0x3a, 0x2d, 0x98, 0x67, 0x83, 0x69, 0x99, 0x34, 0x34, 0xc7, 0xd3, 0xe9, 0x54, 0xcb, 0x6a,
+    0xa9, 0x64, 0x31, 0x89, 0x02, 0xaf, 0x20, 0x01, 0x04, 0x98, 0xce, 0xba, 0x82, 0xa4, 0x8d, 0x37,
+    0x3c, 0x79, 0x3d, 0x39, 0x49, 0x35, 0xd6, 0x55, 0xf3, 0x68, 0x3d, 0x86, 0xee, 0x6f, 0xd2, 0xd6,
+    0x16, 0x5d, 0x50, 0x94, 0xfb, 0x63, 0xd8, 0x21, 0x27, 0x56, 0x76, 0xb0, 0x21, 0xa2, 0x57, 0xb8,
+    0xd9, 0x68, 0x19, 0x6b, 0xb6, 0xd4, 0x60, 0xef, 0x83, 0x4d, 0x45, 0xaf, 0xdd, 0x60, 0x5d, 0x53,
+    0x43, 0x1c, 0x4a, 0x33, 0xca, 0x9a, 0x5b, 0x63, 0x64, 0x25, 0x38, 0x69, 0x12, 0xae, 0xeb, 0x02,
+    0x5d, 0xe2, 0xff, 0xcb, 0x1c, 0xa5, 0x21, 0x67, 0x46, 0xe9, 0x8a, 0x8f, 0xfb, 0x00, 0x6d, 0x57,
+    0x9a, 0x86, 0xb5, 0xbc, 0xff, 0xf9, 0xde, 0x9f, 0xf2, 0xe5, 0xb7, 0x66, 0xfe, 0x7d, 0xbb, 0x0e,
+    0xd3, 0xc8, 0xfd, 0xeb, 0x24, 0x9a, 0xb9, 0xb9, 0xb0, 0x08, 0x0a, 0xf0, 0xbd, 0x86, 0xfa, 0xfb,
+    0x15, 0x79, 0xea, 0x90, 0x99, 0x07, 0xbb, 0x3c, 0x1b, 0x52, 0xa8, 0xf4, 0xc4, 0x94, 0x67, 0x41,
+    0xca, 0x80, 0x43, 0x85, 0x9b, 0x81, 0x3e, 0xe9, 0x6d, 0x14, 0xcd, 0xdb, 0xd5, 0x2a, 0xbc, 0x5c,
+    0xfa, 0x10, 0x91, 0xf1, 0x7a, 0x30, 0xf5, 0x63, 0xa8, 0x07, 0x95, 0x5e, 0xe0, 0x95, 0xcc, 0x34,
+    0xf3, 0xfb, 0x86, 0x48, 0x72, 0xa7, 0xcb, 0xf1, 0x83, 0xae, 0xee, 0xe9, 0x0e, 0xba, 0xba, 0xb7,
+    0xa4, 0x1e, 0x4c, 0xb5, 0x78, 0x07, 0xb3, 0xde, 0x21, 0xa3, 0x4e, 0xf0, 0xf8, 0xc5, 0xf3, 0xf1,
+    0xc5, 0x8b, 0x67, 0xec, 0xe4, 0x68, 0xf4, 0xf4, 0xc9, 0x8b, 0xa3, 0x8b, 0x13, 0x00, 0xf7, 0x34,
+    0x0c, 0x98, 0x60, 0xbe, 0xe7, 0xec, 0xa8, 0xd2, 0x78, 0xe7, 0xb0, 0xe0, 0x54, 0xce, 0xb8, 0x01,
+    0x24, 0xad, 0x27, 0x21, 0xcf, 0xc5, 0xce, 0xe1, 0x81, 0xae, 0x04, 0x09, 0x47, 0x0d, 0x74, 0xd5,
+    0xc8, 0xe1, 0x41, 0x32, 0x47, 0x67, 0x73, 0x38, 0x8e, 0xf9, 0x0a, 0x79, 0x2f, 0x42, 0x4b, 0xc7,
+    0x2e, 0x84, 0x1b, 0xc5, 0x88, 0xe6, 0x1c, 0x6c, 0xca, 0xc9, 0x83, 0x2e, 0xa8, 0xde, 0xb7, 0x86,
+    0x56, 0x6e, 0x7d, 0x9d, 0x72, 0xb0, 0xb1, 0xd6, 0x93, 0xf8, 0xdd, 0x2f, 0x57, 0xe8, 0x62, 0x3e,
+    0x98, 0xbc, 0x1f, 0xd7, 0x29, 0xfb, 0xf1, 0x31, 0x8d, 0xaf, 0x53, 0x1e, 0x89, 0x10, 0xde, 0x85,
+    0x8a, 0xfb, 0xec, 0x62, 0x03, 0x71, 0xfd, 0x55, 0x7d, 0xff, 0xd8, 0xb2, 0xd8, 0x48, 0x67, 0x7a,
+    0x55, 0x50, 0xe4, 0x15, 0x09, 0x55, 0xef, 0xaa, 0xe3, 0xa0, 0xc2, 0xa4, 0xd0, 0xbc, 0x65, 0xe5,
+    0xfa, 0xe9, 0xe7, 0xdc, 0xd5, 0x0a, 0x92, 0x9d, 0xc3, 0x73, 0x59, 0x72, 0xa1, 0xb3, 0x3c, 0x56,
+    0x38, 0xd0, 0x57, 0xbf, 0xba, 0xdc, 0x71, 0xa3, 0xb0, 0x41, 0xec, 0x5e, 0x46, 0x3a, 0x9b, 0xea,
+    0xec, 0x2d, 0x0b, 0xa0, 0x39, 0xa7, 0xbc, 0x9c, 0x03, 0xef, 0x32, 0x19, 0x3a, 0x73, 0x3b, 0x2b,
+    0xd8, 0xa8, 0x4a, 0xa9, 0x5e, 0xb9, 0x34, 0xcc, 0xa1, 0x7c, 0x6a, 0xe2, 0x51, 0x58, 0xdf, 0xa9,
+    0x4f, 0x4b, 0x10, 0xbd, 0x54, 0x05, 0x4a, 0x46, 0x4a, 0x95, 0x4b, 0x76, 0x50, 0x3e, 0xf8, 0x1c,
+    0x7d, 0xad, 0xe7, 0x89, 0xd0, 0xd9, 0x49, 0xe3, 0x4c, 0x90, 0x22, 0x14, 0xce, 0x76, 0x62, 0xa4,
+    0x37, 0x10, 0x79, 0xb9, 0xb3, 0x46, 0x36, 0x5b, 0xec, 0xb0, 0x28, 0x9c, 0xa3, 0x5a, 0x11, 0xc8,
+    0x42, 0x20, 0x29, 0xab, 0xa6, 0xa7, 0x48, 0x1e, 0x46, 0xeb, 0x65, 0xab, 0x5d, 0x4c, 0x66, 0x0b,
+    0x9a, 0x8a, 0x16, 0x72, 0xa6, 0x1c, 0x0e, 0x04, 0x1a, 0xaf, 0xe6, 0x8c, 0x6c, 0x9b, 0x25, 0x9d,
+    0x4d, 0xe4, 0xe4, 0xac, 0x08, 0xbd, 0x1a, 0xd6, 0xe1, 0x3f, 0xfe, 0xf6, 0x9f, 0xec, 0xc8, 0x13,
+    0x01, 0x47, 0x5c, 0x7c, 0xff, 0x7e, 0x7e, 0x97, 0x70, 0x3e, 0x98, 0x5a, 0x20, 0xa6, 0xe9, 0x76,
+    0xa9, 0x7c, 0xfd, 0xc7, 0x4a, 0xe5, 0xeb, 0xfb, 0xa5, 0xf2, 0x1f, 0xec, 0xec, 0xed, 0x8f, 0xbf,
+    0x43, 0x20, 0x20, 0x42, 0x64, 0xdd, 0xc0, 0x77, 0xdf, 0x90, 0xaf, 0x84, 0xde, 0xf1, 0x1c, 0xab,
+    0x7d, 0xdb, 0x22, 0xaa, 0xff, 0xfe, 0xbf, 0x6c, 0x04, 0x80, 0xdf, 0x4e, 0x36, 0xa6, 0xd2, 0x62,
+    0xbb, 0x68, 0x4e, 0xff, 0x58, 0xd1, 0x9c, 0xde, 0x27, 0x9a, 0x13, 0x24, 0xe6, 0x7f, 0xfc, 0xed,
+    0xbf, 0x7e, 0x87, 0x7a, 0xff, 0x08, 0x4f, 0x1a, 0xad, 0x7b, 0x12, 0x49, 0x63, 0xbb, 0x68, 0x46,
+    0x7f, 0xac, 0x68, 0x46, 0xf7, 0x5b, 0xcd, 0x7f, 0xb3, 0xa3, 0x34, 0x7e, 0xf7, 0x53, 0xf2, 0xff,
+    0xe4, 0x49, 0x35, 0x42, 0x8d, 0xfc, 0x51, 0x09, 0xf3, 0x45, 0xc4, 0x93, 0xf9, 0x16, 0x8b, 0x54,
+    0x3b, 0xba, 0x0d, 0x9d, 0xc7, 0x96, 0x26, 0xa5, 0x52, 0xa5, 0xc9, 0xc3, 0x8a, 0x46, 0xd0, 0x6c,
+    0xec, 0xa4, 0x28, 0x75, 0x2b, 0xe6, 0x1f, 0x44, 0xae, 0x6c, 0x76, 0x3b, 0xb3, 0x58, 0x4c, 0x9d,
+    0x56, 0x57, 0xc2, 0x24, 0xdf, 0x67, 0x7e, 0x6b, 0xe7, 0x50, 0xe7, 0x05, 0x76, 0x91, 0xa5, 0x7c,
+    0x83, 0xbc, 0xee, 0xcb, 0x60, 0xaa, 0xd7, 0x97, 0x47, 0x33, 0x6c, 0x8e, 0x4a, 0x11, 0xe5, 0x88,
+    0x08, 0xa2, 0x65, 0x91, 0x3d, 0x4c, 0x76, 0xed, 0x27, 0x19, 0xf2, 0xe0, 0x8a, 0x51, 0xf1, 0xb8,
+    0x00, 0x00, 0x25, 0xb5, 0xa5, 0x9f, 0xce, 0x18, 0x67, 0x32, 0x43, 0xe6, 0xad, 0x77, 0x2d, 0xb1,
+    0x68, 0x71, 0xad, 0x97, 0x8b, 0x95, 0x6a, 0x91, 0x8a, 0x9c, 0xb2, 0x56, 0x1c, 0x96, 0xe5, 0x8f,
+    0xdd, 0xf9, 0xfc, 0x31, 0x35, 0xd6, 0xc8, 0x88, 0xd0, 0xda, 0x04, 0x49, 0xfb, 0xe2, 0xdd, 0x4f,
+    0x0b, 0xd4, 0x13, 0x49, 0x75, 0x2b, 0x79, 0x09, 0x23, 0x8f, 0x1b, 0x0a, 0x5b, 0x2e, 0x0f, 0x1f,
+    0x76, 0x72, 0x26, 0x1a, 0x4b, 0x56, 0xb3, 0x5b, 0x5d, 0xee, 0x79, 0xcd, 0xbc, 0x29, 0xea, 0x8c,
+    0x29, 0xea, 0x90, 0xb4, 0xd8, 0x57, 0x51, 0x2a, 0x4b, 0x04, 0x63, 0xdc, 0xde, 0x20, 0xeb, 0x0f,
+    0xa7, 0xf8, 0x0d, 0x51, 0x3c, 0xba, 0xe6, 0xe1, 0x5b, 0x8e, 0x0e, 0x98, 0x5d, 0x67, 0x22, 0x40,
+    0x65, 0x69, 0x7c, 0xf3, 0xcf, 0x51, 0x3d, 0x23, 0xaa, 0x67, 0x68, 0xcf, 0xf2, 0xe3, 0x59, 0xe3,
+    0xec, 0x9f, 0x23, 0x78, 0x41, 0x04, 0x2f, 0x44, 0x22, 0x52, 0x76, 0x1e, 0x61, 0xd7, 0x17, 0x0d,
+    0x72, 0x35, 0x93, 0xaa, 0xd4, 0x06, 0xaa, 0x65, 0x80, 0xcb, 0x25, 0x30, 0xa4, 0xf0, 0xf2, 0xf0,
+    0x34, 0xa1, 0xfb, 0x85, 0x01, 0x55, 0xae, 0xf2, 0x99, 0x1d, 0xc0, 0x4f, 0x55, 0x30, 0x52, 0xa0,
+    0x63, 0xd8, 0xca, 0xce, 0xa1, 0x05, 0x00, 0x8c, 0x1f, 0xd6, 0xc8, 0x26, 0x6e, 0xec, 0x2f, 0x52,
+    0x7d, 0x83, 0xd1, 0x45, 0x7d, 0x99, 0x2c, 0x50, 0x7d, 0x53, 0x27, 0xab, 0x8b, 0x3a, 0x70, 0x97,
+    0x2d, 0x50, 0xe9, 0xc8, 0xe3, 0x6f, 0xd5, 0x3d, 0x32, 0xb4, 0xa7, 0x30, 0x4b, 0x11, 0xab, 0x83,
+    0x4c, 0xc0, 0xcb, 0x52, 0xf6, 0x58, 0x21, 0x38, 0x88, 0x75, 0x6e, 0x36, 0x87, 0x4d, 0x76, 0x2e,
+    0x45, 0x7a, 0x1a, 0x08, 0xfa, 0xfa, 0x64, 0x75, 0x86, 0x0d, 0x03, 0xa8, 0xd5, 0x1e, 0x56, 0xb0,
+    0x74, 0x1d, 0xfa, 0x7e, 0x4c, 0x0d, 0x58, 0xc7, 0x46, 0xad, 0xf9, 0x5e, 0x44, 0x5d, 0x8f, 0xd6,
+    0x11, 0x4b, 0xa9, 0xdc, 0x87, 0x5a, 0x42, 0xe5, 0xd8, 0x01, 0x34, 0x05, 0x15, 0xa4, 0xd0, 0x96,
+    0x4f, 0x11, 0x83, 0x56, 0x7e, 0xf5, 0x7a, 0xa8, 0x44, 0x39, 0xcd, 0x42, 0x55, 0xb2, 0x42, 0x62,
+    0x27, 0xe7, 0x17, 0x86, 0x5b, 0xed, 0xc1, 0xd4, 0xba, 0xde, 0x22, 0x06, 0xc6, 0xd2, 0x0f, 0x91,
+    0x00, 0x3a, 0xea, 0xde, 0xe9, 0xdc, 0xbf, 0x11, 0xc1, 0x05, 0xc5, 0x1f, 0xf6, 0xd7, 0xbf, 0xb2,
+    0xde, 0xb0, 0x81, 0x41, 0x27, 0xcf, 0x40, 0x71, 0x89, 0xb9, 0x27, 0xd4, 0x61, 0xa2, 0x04, 0x3e,
+    0x0e, 0x7c, 0xf0, 0x88, 0x4e, 0x20, 0x35, 0xda, 0x15, 0xf8, 0x8e, 0x8c, 0x82, 0x00, 0xfe, 0x8a,
+    0xa7, 0x33, 0xf4, 0x7c, 0x37, 0x46, 0xcf, 0x54, 0xdf, 0xa7, 0x41, 0x14, 0xc5, 0x06, 0x91, 0xd2,
+    0x30, 0x0f, 0x88, 0x93, 0x76, 0x05, 0x19, 0x9a, 0x7f, 0x23, 0xc4, 0x82, 0xe2, 0xce, 0x8f, 0x19,
+    0x8f, 0x85, 0xe5, 0x27, 0xb3, 0x5c, 0x39, 0x26, 0xe9, 0x16, 0x2d, 0xd8, 0xdc, 0x0f, 0x78, 0x5c,
+    0x60, 0x90, 0x28, 0xdc, 0x24, 0x79, 0x8a, 0xf5, 0x4a, 0xc2, 0x43, 0xe6, 0x4f, 0x99, 0xe1, 0x3a,
+    0x8e, 0x93, 0xab, 0xa6, 0xbd, 0x0e, 0x84, 0xd5, 0xed, 0xce, 0xde, 0xe3, 0x12, 0xb6, 0x66, 0x04,
+    0x1b, 0x10, 0xaa, 0x7b, 0x54, 0x47, 0x39, 0xdb, 0x37, 0x29, 0x91, 0xd7, 0xb6, 0xa7, 0x8d, 0x2d,
+    0xbd, 0xc9, 0x45, 0x49, 0x61, 0x1d, 0x7a, 0x35, 0x5a, 0x7d, 0x0f, 0xba, 0xa5, 0x99, 0x0e, 0xb4,
+    0x36, 0xce, 0x4f, 0x6e, 0x0c, 0xe0, 0xcb, 0x5b, 0x20, 0xfd, 0xa9, 0x49, 0xdd, 0x35, 0x14, 0x8d,
+    0x50, 0x85, 0x98, 0x7a, 0x14, 0x04, 0x46, 0xfb, 0x96, 0xbd, 0x2a, 0x3c, 0xc0, 0xac, 0x9b, 0xb5,
+    0x59, 0xd8, 0xe9, 0xeb, 0x0e, 0x88, 0x9f, 0x72, 0x77, 0x66, 0x28, 0x13, 0x91, 0x07, 0x42, 0x75,
+    0x92, 0x5e, 0xcc, 0x97, 0x5f, 0xf1, 0x85, 0x71, 0x63, 0xae, 0xda, 0xb7, 0x35, 0xbe, 0x0b, 0xf2,
+    0x9b, 0xf8, 0x97, 0x70, 0xcb, 0x1a, 0x94, 0x2b, 0xad, 0xe4, 0xa5, 0xbc, 0xd5, 0x64, 0xb3, 0x0d,
+    0x53, 0x4f, 0xa5, 0x28, 0xd5, 0xe6, 0x5d, 0x54, 0x17, 0xb1, 0xb4, 0x28, 0xda, 0x75, 0x09, 0xa9,
+    0x2e, 0x45, 0xcb, 0x67, 0x25, 0x7e, 0x2d, 0xb1, 0xa9, 0x1f, 0x04, 0x23, 0x99, 0x07, 0x5a, 0x74,
+    0x19, 0xd9, 0x2a, 0x47, 0x0b, 0x4a, 0x4b, 0x73, 0x96, 0x8b, 0x17, 0xa1, 0xe9, 0x8d, 0xc8, 0xc1,
+    0x1f, 0x3e, 0x7c, 0xd8, 0x1a, 0x16, 0xce, 0x08, 0xc3, 0xab, 0x2a, 0x74, 0x4f, 0x6b, 0x54, 0x9e,
+    0xa8, 0x18, 0x6a, 0xdc, 0x0f, 0x0d, 0xa2, 0xd5, 0xed, 0xd9, 0xd0, 0x2b, 0x75, 0x62, 0x06, 0x19,
+    0xa0, 0xef, 0xd8, 0x43, 0xff, 0xc0, 0x59, 0x0e, 0xfd, 0x5d, 0x87, 0xc8, 0x90, 0xc8, 0xb0, 0xd6,
+    0x44, 0x20, 0x29, 0x9d, 0x03, 0xcf, 0xd0, 0x8b, 0x53, 0xfa, 0x1d, 0x47, 0x86, 0x2f, 0x6f, 0xf5,
+    0x68, 0x80, 0xee, 0x7e, 0xe4, 0x40, 0x9d, 0x3d, 0x82, 0xbf, 0x6b, 0x52, 0x9f, 0x7d, 0x20, 0x75,
+    0xdb, 0xf4, 0xeb, 0xd4, 0x97, 0xc5, 0x40, 0x95, 0x7a, 0x2d, 0x7e, 0x74, 0x16, 0x59, 0x32, 0x33,
+    0x6e, 0xa1, 0xed, 0xbb, 0x36, 0x39, 0x84, 0x51, 0x9f, 0x0d, 0x44, 0x78, 0x99, 0xce, 0x0e, 0xf7,
+    0xed, 0x76, 0x03, 0x2d, 0x99, 0xf9, 0xd3, 0xd4, 0xd8, 0x24, 0xda, 0xc0, 0x9f, 0x0b, 0xad, 0x89,
+    0x1a, 0xa3, 0x75, 0xfc, 0xdc, 0x0e, 0x8d, 0x05, 0x78, 0x74, 0x0e, 0x73, 0x4b, 0x4b, 0x6e, 0x9c,
+    0x65, 0xb7, 0x8f, 0x60, 0xbf, 0xe8, 0xdc, 0x98, 0x2c, 0x59, 0x39, 0x33, 0x3c, 0x59, 0x78, 0x5a,
+    0x49, 0xe6, 0x7c, 0xc7, 0x01, 0x27, 0x95, 0x2d, 0x27, 0x37, 0x66, 0xb2, 0x02, 0x71, 0x11, 0x24,
+    0xa2, 0xba, 0xf3, 0x7c, 0xfc, 0x6e, 0x6d, 0xff, 0x0d, 0xbb, 0x89, 0x85, 0xb7, 0x89, 0x59, 0x1a,
+    0xe0, 0xb1, 0x6b, 0x28, 0x66, 0xc0, 0x8a, 0xe2, 0x63, 0x65, 0x96, 0x56, 0xf2, 0x30, 0xff, 0x0e,
+    0xcb, 0xd8, 0x37, 0xd9, 0xf2, 0x81, 0xdd, 0xb1, 0xfb, 0xed, 0xb6, 0xc9, 0x6c, 0x93, 0xf5, 0x1f,
+    0xc8, 0xa9, 0xf3, 0xb3, 0xca, 0x82, 0xc6, 0x16, 0x67, 0x3b, 0x56, 0xae, 0x6a, 0xa4, 0xb3, 0x86,
+    0xbf, 0xd5, 0x7c, 0xf8, 0x5e, 0x9f, 0xab, 0x43, 0xae, 0xf9, 0xdd, 0xa6, 0xe9, 0xed, 0xbe, 0x57,
+    0x87, 0x56, 0xfe, 0x57, 0x1f, 0x2b, 0x7d, 0x50, 0x71, 0x2b, 0x75, 0x86, 0x98, 0x23, 0xb5, 0x65,
+    0xb2, 0xd8, 0xa9, 0x7b, 0x4c, 0xdf, 0xda, 0xbb, 0x47, 0xc2, 0xee, 0x8d, 0xe9, 0xae, 0x4c, 0x0a,
+    0x72, 0x4d, 0xa1, 0xd5, 0x1d, 0xf6, 0xf1, 0xe3, 0xc7, 0xad, 0x4d, 0xba, 0x4c, 0xd0, 0x94, 0xe4,
+    0xdf, 0x8b, 0xd3, 0x6e, 0x45, 0x55, 0x8f, 0xc6, 0x51, 0x4a, 0x43, 0xe9, 0x2c, 0xa7, 0xdf, 0xed,
+    0xed, 0xe7, 0x6e, 0xb8, 0xdd, 0x95, 0x1a, 0x8e, 0x6a, 0x9b, 0x56, 0x0c, 0x0d, 0xef, 0x6f, 0xe2,
+    0xad, 0xb4, 0xa1, 0x3a, 0x6b, 0x88, 0xce, 0x54, 0x4d, 0x6e, 0xb0, 0x3a, 0x7a, 0x5d, 0xa2, 0x12,
+    0xad, 0x28, 0xc3, 0x1b, 0x95, 0x88, 0x03, 0x53, 0xd8, 0x6d, 0xfd, 0xfa, 0x73, 0xcb, 0x74, 0x6f,
+    0xac, 0x1e, 0x34, 0xb2, 0xda, 0xad, 0x4c, 0x12, 0x1b, 0x8f, 0xdb, 0x5b, 0x8c, 0xe9, 0xec, 0xc2,
+    0xb8, 0xe6, 0x41, 0x26, 0x92, 0xf6, 0xed, 0xc6, 0xdc, 0x93, 0x27, 0x82, 0x75, 0x73, 0x6a, 0x80,
+    0x2f, 0xab, 0xc0, 0x6b, 0x16, 0xd5, 0x98, 0xd1, 0xc6, 0x54, 0x92, 0x58, 0x33, 0xaa, 0x02, 0x41,
+    0xbf, 0xe4, 0x12, 0x37, 0x4c, 0xa9, 0xb1, 0xba, 0x3e, 0x1d, 0xc5, 0x4a, 0xf0, 0xac, 0x4b, 0x4e,
+    0xd1, 0x79, 0xbf, 0x09, 0x33, 0x89, 0x50, 0xa7, 0xce, 0x9f, 0x71, 0xf4, 0x34, 0x47, 0xf4, 0xde,
+    0x81, 0xc3, 0x7a, 0xfb, 0x43, 0xaa, 0x23, 0x20, 0x76, 0x11, 0xa3, 0x7c, 0x94, 0xad, 0xa2, 0x3c,
+    0x33, 0x4b, 0xe4, 0xc9, 0x1f, 0x22, 0xd0, 0x84, 0x2e, 0xe9, 0x33, 0x2a, 0x1d, 0xd9, 0x84, 0xc7,
+    0x49, 0x93, 0x22, 0x8f, 0x89, 0xd2, 0x4b, 0xaa, 0x90, 0x28, 0xe8, 0x28, 0x26, 0x1e, 0xf4, 0x87,
+    0xeb, 0x70, 0x2f, 0x75, 0xa5, 0x63, 0x14, 0x38, 0x16, 0xf1, 0xf9, 0x40, 0x4b, 0x5f, 0xc7, 0x4d,
+    0xab, 0xd7, 0x6e, 0xb3, 0x2e, 0xab, 0x8d, 0xd5, 0x4a, 0x9e, 0x13, 0xd5, 0x71, 0x32, 0xf9, 0xb2,
+    0x8f, 0xbc, 0x70, 0x83, 0x34, 0x11, 0x3f, 0xd1, 0x4c, 0xa1, 0x1a, 0xa7, 0x97, 0x25, 0xb0, 0x9b,
+    0x1f, 0x81, 0x9c, 0xa2, 0x37, 0x43, 0xd0, 0x61, 0x3d, 0xdb, 0x66, 0xee, 0x5c, 0x1f, 0x04, 0x52,
+    0xe7, 0xd3, 0x6e, 0xf0, 0x06, 0xa0, 0x6f, 0x78, 0x70, 0x3c, 0x27, 0x71, 0xd8, 0x88, 0x48, 0xb5,
+    0xe5, 0xb8, 0xc7, 0x17, 0xf2, 0x8e, 0x88, 0xda, 0x31, 0x3a, 0xd3, 0x16, 0x4d, 0x11, 0x80, 0xd5,
+    0x2f, 0x31, 0x37, 0xc2, 0x54, 0x2d, 0x23, 0xda, 0xb5, 0x8c, 0xa8, 0x2a, 0x28, 0x7b, 0x7f, 0xbd,
+    0xc2, 0xa1, 0x37, 0x9d, 0x3e, 0x9c, 0xc0, 0x5e, 0x8d, 0x00, 0x39, 0x30, 0xec, 0xf1, 0x88, 0x3a,
+    0x4a, 0xe0, 0xb6, 0x54, 0x53, 0xd9, 0x2a, 0x21, 0x68, 0xd7, 0x2a, 0x2f, 0x62, 0xda, 0x46, 0x42,
+    0x60, 0x07, 0x0d, 0xd9, 0x32, 0x7f, 0x77, 0xb7, 0x5a, 0xf4, 0x56, 0xca, 0x58, 0x4e, 0x16, 0xfd,
+    0x3c, 0x9b, 0x4f, 0x44, 0xac, 0x95, 0xf4, 0xca, 0x7f, 0x5d, 0x59, 0xbe, 0x26, 0xc2, 0x27, 0x3c,
+    0x7e, 0x9a, 0xd7, 0x79, 0xb3, 0xd2, 0x14, 0xf0, 0xad, 0x61, 0x75, 0xc3, 0xfa, 0xb1, 0x0e, 0x64,
+    0x0c, 0xaf, 0xba, 0x16, 0x71, 0xca, 0x8e, 0x4e, 0x8e, 0xbb, 0xb4, 0xa8, 0x5c, 0x8b, 0x6e, 0xd6,
+    0xab, 0xaa, 0xcd, 0x12, 0xa2, 0x96, 0xce, 0xa8, 0xc7, 0x09, 0xfc, 0x49, 0xcc, 0x49, 0xbf, 0x54,
+    0xf7, 0x65, 0x01, 0x6f, 0x12, 0xf4, 0x7c, 0xb4, 0x01, 0xa1, 0xeb, 0xf3, 0xef, 0x5d, 0xa9, 0xd5,
+    0xcf, 0x1e, 0xef, 0x7d, 0xde, 0xf9, 0x0c, 0x02, 0xe4, 0x9e, 0xfb, 0x6f, 0x56, 0xaf, 0xd3, 0xb7,
+    0xf7, 0xfa, 0x35, 0x1c, 0x92, 0x10, 0x21, 0x91, 0x90, 0xaa, 0x06, 0x40, 0xff, 0xa8, 0xe2, 0x25,
+    0xae, 0x0e, 0x30, 0xd7, 0x14, 0x14, 0xfd, 0xd3, 0x78, 0xb9, 0x15, 0x49, 0x7f, 0x02, 0x8e, 0x0f,
+    0x67, 0xa5, 0xbb, 0x2d, 0xec, 0x98, 0xe4, 0x80, 0xcc, 0x3c, 0x8b, 0x96, 0x0c, 0x7d, 0xcf, 0xb4,
+    0x52, 0x90, 0xcb, 0x02, 0x55, 0x65, 0xe2, 0xad, 0x84, 0x4b, 0xee, 0xa5, 0x35, 0x2c, 0xa2, 0x25,
+    0xb1, 0x63, 0x32, 0xbd, 0x8f, 0x86, 0x3e, 0xee, 0xd6, 0x78, 0xff, 0xd8, 0x4f, 0xbe, 0xa4, 0x37,
+    0xe4, 0x84, 0x41, 0x04, 0xe1, 0x5d, 0x4d, 0x86, 0xd7, 0x30, 0x24, 0xc0, 0x01, 0xeb, 0x77, 0xec,
+    0x02, 0xb8, 0xbf, 0x49, 0x2a, 0x72, 0xee, 0xb0, 0x20, 0xb4, 0x81, 0x72, 0x53, 0x31, 0xda, 0x42,
+    0x16, 0x71, 0x44, 0x6f, 0xf5, 0x21, 0x02, 0xf3, 0x80, 0xf4, 0xac, 0xf5, 0x25, 0x98, 0x61, 0x77,
+    0x3a, 0x85, 0x3b, 0xa2, 0x82, 0xa5, 0xf3, 0x15, 0xcc, 0xab, 0xd1, 0xc2, 0xc2, 0xda, 0x1b, 0x2c,
+    0x10, 0x41, 0xe5, 0x69, 0xd5, 0x7b, 0x90, 0x54, 0x15, 0x7f, 0xdd, 0x0a, 0x7f, 0x0f, 0x6a, 0x86,
+    0xba, 0xd1, 0x92, 0x29, 0xe2, 0xe7, 0xa6, 0xbb, 0x0b, 0x77, 0x79, 0x20, 0xe3, 0x95, 0x8a, 0x5d,
+    0xbb, 0x14, 0xaf, 0x36, 0x62, 0xad, 0xb4, 0xd1, 0x37, 0x03, 0xac, 0x25, 0xf9, 0x5a, 0x97, 0x43,
+    0xfe, 0xea, 0x1a, 0xbd, 0x32, 0x30, 0x65, 0x30, 0xfe, 0x15, 0x73, 0x83, 0x08, 0x56, 0x60, 0x88,
+    0xce, 0x65, 0xc7, 0x24, 0xe1, 0x53, 0xd0, 0x42, 0x65, 0x14, 0xc1, 0xe2, 0xe3, 0xa5, 0x8f, 0x29,
+    0x2a, 0x12, 0xeb, 0x4b, 0x57, 0x13, 0x24, 0xf5, 0xc4, 0x5a, 0x6d, 0xb0, 0x60, 0xf6, 0x05, 0x93,
+    0x29, 0x96, 0x0d, 0x98, 0x2e, 0x2e, 0x37, 0x62, 0xca, 0x5c, 0x83, 0x4a, 0x0d, 0x35, 0x5a, 0xbe,
+    0x49, 0xf9, 0xed, 0x69, 0x7b, 0x9d, 0x65, 0x4a, 0x95, 0x2c, 0x44, 0xd3, 0x1d, 0xfb, 0xae, 0xf6,
+    0x50, 0x3e, 0x41, 0xe6, 0x97, 0x2e, 0x09, 0x1c, 0x25, 0x6e, 0xa9, 0x45, 0x0a, 0xca, 0x73, 0x75,
+    0x26, 0xd6, 0x63, 0x9e, 0x70, 0xfd, 0x39, 0x0f, 0xda, 0xf7, 0xb2, 0xde, 0xa2, 0xcb, 0xee, 0x4d,
+    0x4c, 0x52, 0xd0, 0x75, 0x6a, 0x21, 0x76, 0x97, 0xb5, 0x16, 0x37, 0x4c, 0xbe, 0x2a, 0xd9, 0xda,
+    0xa4, 0x0a, 0xc9, 0xda, 0xb7, 0x40, 0xba, 0x01, 0x68, 0xa1, 0xba, 0x2e, 0xeb, 0x6f, 0x05, 0xfe,
+    0xae, 0x16, 0x75, 0x61, 0x38, 0x2b, 0xe8, 0x6d, 0xaf, 0xbd, 0x59, 0x64, 0xb2, 0xee, 0x18, 0xa5,
+    0x31, 0xec, 0x43, 0x6e, 0xb8, 0x93, 0x46, 0x5f, 0xfa, 0x37, 0xc2, 0x33, 0x28, 0x6f, 0x81, 0x37,
+    0xec, 0xbc, 0x65, 0x6a, 0x26, 0xf4, 0xe7, 0x77, 0xdb, 0xa4, 0xa9, 0x73, 0x2c, 0x02, 0x43, 0xac,
+    0xd2, 0x80, 0x7e, 0xcb, 0xad, 0x38, 0x75, 0xd4, 0xa2, 0x7d, 0x8f, 0xe8, 0x64, 0x61, 0xb4, 0x4d,
+    0x74, 0xb5, 0xec, 0xf2, 0x3e, 0xd9, 0x11, 0xb0, 0x3c, 0x1e, 0x69, 0x3d, 0x6b, 0x99, 0xad, 0x2f,
+    0xe9, 0xcf, 0x13, 0xfa, 0x72, 0x81, 0x3f, 0x17, 0xad, 0xd7, 0xdb, 0x50, 0x28, 0xa9, 0x4b, 0x54,
+    0xa4, 0x07, 0x3a, 0x10, 0xa1, 0xa3, 0x6c, 0x5a, 0x6b, 0xeb, 0x1a, 0xdf, 0x69, 0x77, 0x79, 0x74,
+    0x8f, 0x8c, 0x09, 0xce, 0x5c, 0x53, 0xa2, 0xa9, 0xf0, 0x2b, 0xca, 0xb9, 0xab, 0x66, 0xeb, 0x58,
+    0x9e, 0xcb, 0x95, 0x29, 0x91, 0x62, 0x8b, 0xbe, 0x8e, 0xa6, 0x1b, 0x20, 0x99, 0x0e, 0xa5, 0x47,
+    0x49, 0x05, 0x40, 0x87, 0xc9, 0xf6, 0x5c, 0x4a, 0x08, 0xad, 0xda, 0x19, 0x02, 0x16, 0x18, 0x8b,
+    0x40, 0x44, 0x0b, 0x7a, 0x31, 0x94, 0x0e, 0x13, 0x07, 0xc8, 0x45, 0x1e, 0x67, 0xfb, 0x36, 0x9b,
+    0x53, 0x8d, 0xc4, 0x82, 0x28, 0xa5, 0xfb, 0x6f, 0xb6, 0x2f, 0xf7, 0x0a, 0x3a, 0x08, 0xf7, 0x06,
+    0xb2, 0x23, 0x1d, 0x1b, 0xb3, 0xf9, 0xbc, 0x8b, 0xcf, 0x25, 0xfb, 0xf5, 0xe7, 0x2e, 0x1d, 0x98,
+    0x10, 0xe2, 0x23, 0x89, 0x48, 0x6f, 0xcc, 0x9e, 0xbf, 0x18, 0x8d, 0x59, 0x37, 0x95, 0xd4, 0xcd,
+    0x8f, 0x8a, 0x28, 0x11, 0x22, 0x09, 0xa3, 0x8d, 0x60, 0x33, 0xac, 0xc7, 0x91, 0x27, 0x58, 0x34,
+    0xb9, 0x12, 0x28, 0x47, 0x22, 0xea, 0x0d, 0x69, 0x5e, 0xdc, 0xc8, 0x43, 0x4d, 0xd4, 0x3b, 0x20,
+    0xc7, 0x27, 0x3e, 0xd2, 0x28, 0x87, 0xfd, 0x02, 0x32, 0x8e, 0x10, 0x8c, 0x18, 0xdd, 0xc0, 0xd2,
+    0x4b, 0x16, 0x11, 0x4a, 0x17, 0x70, 0x76, 0xc5, 0xe5, 0x9b, 0xba, 0x41, 0x20, 0x2e, 0x79, 0x2c,
+    0xd9, 0x4d, 0x2a, 0x27, 0x6c, 0xe3, 0xd3, 0x67, 0xa7, 0x2f, 0xce, 0x9d, 0xdb, 0x97, 0x83, 0x57,
+    0xfd, 0xc7, 0x28, 0x41, 0x5f, 0x9b, 0xa3, 0xc1, 0x2b, 0xab, 0x6f, 0xcb, 0xaf, 0x5f, 0x0f, 0x5e,
+    0xd9, 0xe6, 0x1e, 0xbe, 0x9c, 0xd2, 0x17, 0x0b, 0xdf, 0xee, 0x4c, 0x89, 0xf1, 0xfd, 0xf9, 0xe9,
+    0xc5, 0xd9, 0x8b, 0x13, 0x67, 0xdf, 0xd6, 0xcf, 0xa3, 0xf1, 0xe9, 0xb9, 0xf3, 0x28, 0x7f, 0x3a,
+    0x7f, 0x71, 0xf6, 0x7c, 0x3c, 0x72, 0xf6, 0xf5, 0xe3, 0xd1, 0xf1, 0xb1, 0xb3, 0x67, 0xe7, 0x93,
+    0x47, 0xcf, 0xce, 0x9f, 0x1e, 0x39, 0xe8, 0x2d, 0xaa, 0x07, 0x7d, 0x24, 0x05, 0xe7, 0x36, 0x45,
+    0xad, 0x26, 0x52, 0x5a, 0x0b, 0x6b, 0xba, 0x59, 0xac, 0xbf, 0x25, 0xe2, 0xc7, 0x81, 0x6d, 0x52,
+    0x55, 0x10, 0x0f, 0xc2, 0x2c, 0x08, 0xcc, 0x49, 0x96, 0xac, 0x06, 0x53, 0x8e, 0x14, 0x7a, 0x37,
+    0xac, 0x17, 0xf7, 0x44, 0x67, 0x24, 0x50, 0x3a, 0x2d, 0x52, 0xd4, 0xf6, 0xf2, 0xb1, 0x43, 0xd0,
+    0x0e, 0xdd, 0x7d, 0x0c, 0xd9, 0x54, 0xa4, 0x68, 0xa6, 0x5b, 0x5a, 0xe8, 0x5f, 0x80, 0xb0, 0xd3,
+    0xda, 0x35, 0x76, 0x77, 0x25, 0x1c, 0x9e, 0xda, 0xe6, 0x2d, 0x4a, 0x8f, 0x59, 0xe4, 0x0d, 0x5a,
+    0xa4, 0x9d, 0x96, 0x49, 0xaf, 0x14, 0x0c, 0x40, 0xab, 0x73, 0x15, 0xa1, 0x4f, 0x6b, 0x0d, 0x5b,
+    0xed, 0xbb, 0x76, 0xc7, 0xa5, 0x17, 0x54, 0x0d, 0x83, 0xfa, 0x71, 0x3c, 0x4d, 0xfd, 0x90, 0xee,
+    0x06, 0xd4, 0x73, 0x65, 0x45, 0xc9, 0x9f, 0x6a, 0xad, 0xef, 0xd6, 0x99, 0x1c, 0xfb, 0xee, 0x1b,
+    0x3a, 0x8d, 0x42, 0xb7, 0x5e, 0xa0, 0xb4, 0x61, 0xcb, 0x69, 0x16, 0x87, 0x79, 0xc7, 0xe8, 0x5d,
+    0x3b, 0xb9, 0xfc, 0x1e, 0x14, 0x52, 0xee, 0xa2, 0x5e, 0x85, 0x28, 0xbd, 0xa5, 0x53, 0x4a, 0x73,
+    0x6d, 0x16, 0xf1, 0xdf, 0x41, 0x90, 0xf7, 0xc0, 0x52, 0x11, 0xe5, 0x2c, 0xcf, 0x2c, 0x1a, 0x4e,
+    0xcf, 0xbc, 0xa1, 0xd6, 0x88, 0x4a, 0xa0, 0x6b, 0x47, 0xae, 0x0f, 0x69, 0xbf, 0x82, 0xa8, 0xd9,
+    0xb2, 0x7c, 0xec, 0xbd, 0xce, 0x19, 0x81, 0x00, 0x9c, 0x57, 0xaf, 0x9b, 0xc7, 0x39, 0x15, 0x55,
+    0x0f, 0xa9, 0xa0, 0x94, 0x9b, 0xf1, 0x4b, 0x5e, 0x1c, 0xa7, 0x62, 0x2a, 0x6d, 0x96, 0xd3, 0x75,
+    0x5e, 0x5d, 0x9b, 0x4b, 0x10, 0x23, 0xa9, 0xca, 0x53, 0x95, 0x1f, 0x3e, 0xbd, 0xad, 0x60, 0xdd,
+    0x99, 0x9f, 0xde, 0x56, 0x4a, 0xe0, 0xeb, 0x76, 0x63, 0x60, 0xd9, 0xbe, 0xfb, 0x01, 0xac, 0x5f,
+    0xef, 0x3a, 0xd8, 0xa4, 0x92, 0x9d, 0x32, 0x1b, 0xb0, 0x6f, 0x5d, 0x9b, 0xde, 0x35, 0x26, 0x97,
+    0xeb, 0x93, 0xbd, 0xd7, 0xd6, 0xd2, 0xf4, 0x96, 0xf2, 0x64, 0xa7, 0x66, 0x24, 0x6b, 0xda, 0x29,
+    0xaf, 0xe7, 0xdc, 0xb9, 0x97, 0xdb, 0x90, 0xa2, 0xe2, 0x28, 0x6f, 0x79, 0x85, 0x89, 0xd7, 0xf2,
+    0xa0, 0xe5, 0x63, 0x35, 0x49, 0x96, 0xa9, 0x21, 0x95, 0x5e, 0x87, 0xac, 0x9c, 0x70, 0x10, 0x9e,
+    0xce, 0x28, 0xc4, 0x23, 0x31, 0x18, 0x39, 0x88, 0x59, 0x15, 0x0d, 0xf1, 0xb4, 0xc6, 0x44, 0x7e,
+    0x0f, 0x78, 0xdb, 0x5c, 0xa7, 0x34, 0x12, 0x6a, 0x1d, 0x6b, 0x94, 0x35, 0x44, 0x6d, 0x75, 0x72,
+    0x98, 0x61, 0x6d, 0x13, 0xd2, 0xa9, 0x86, 0x15, 0x7d, 0x94, 0xcf, 0x52, 0x2a, 0xaf, 0x5a, 0xf2,
+    0xbd, 0xfa, 0xd6, 0xeb, 0x0d, 0xb2, 0xd1, 0x37, 0x22, 0x4a, 0x32, 0xb9, 0x37, 0xe1, 0xe9, 0x0b,
+    0x17, 0x8e, 0x44, 0xa3, 0x75, 0xe7, 0x58, 0xef, 0xbe, 0x51, 0xdf, 0x05, 0xab, 0x13, 0x9e, 0x72,
+    0xe3, 0x0a, 0x14, 0xf2, 0x53, 0xd4, 0xab, 0xce, 0x8d, 0x79, 0xd5, 0xa1, 0x93, 0x88, 0xea, 0x51,
+    0xcf, 0x55, 0x27, 0x9d, 0xe9, 0x21, 0x34, 0xec, 0x57, 0x1d, 0x9f, 0xb6, 0x56, 0x1e, 0xf6, 0xcb,
+    0xd0, 0x7d, 0xac, 0xdf, 0x1e, 0x77, 0xd8, 0x0f, 0x37, 0x83, 0x4f, 0x6f, 0x41, 0xa8, 0xc8, 0xce,
+    0xfd, 0xf6, 0x1d, 0x5b, 0xc9, 0xb1, 0x55, 0x6d, 0x2c, 0x9d, 0xc9, 0x41, 0x58, 0x54, 0x3e, 0x6a,
+    0xb7, 0xef, 0x7e, 0xfd, 0xf9, 0x87, 0xe2, 0xb5, 0x50, 0x15, 0xf2, 0x11, 0x08, 0xe2, 0x77, 0xff,
+    0xc3, 0x65, 0xa8, 0x1e, 0x51, 0xa7, 0x1c, 0x5b, 0x23, 0x5a, 0xe9, 0xf4, 0x1a, 0x7f, 0x93, 0x21,
+    0x05, 0x57, 0xb8, 0x78, 0xc0, 0x51, 0xe5, 0x47, 0x68, 0x95, 0x29, 0xeb, 0xb0, 0xae, 0xc7, 0x65,
+    0x2c, 0x8e, 0x85, 0x2f, 0xd9, 0xa2, 0xc1, 0x80, 0x4d, 0x83, 0xec, 0x2a, 0x52, 0xd1, 0xbf, 0x67,
+    0xb3, 0xa4, 0xb8, 0xa1, 0x58, 0x44, 0x41, 0x80, 0x7c, 0xa4, 0x22, 0x85, 0x29, 0x4f, 0xfe, 0x46,
+    0x89, 0x18, 0xc7, 0x2b, 0xc7, 0x6e, 0x84, 0xb5, 0x6c, 0x01, 0xc2, 0xe2, 0x59, 0x14, 0x2d, 0x72,
+    0x83, 0xd0, 0xb8, 0xa5, 0x35, 0xe4, 0xca, 0x20, 0x0e, 0x5a, 0x6d, 0xec, 0x4e, 0x84, 0x46, 0xec,
+    0x1c, 0xc6, 0x9d, 0x2b, 0xb0, 0x67, 0xb4, 0xf5, 0x48, 0x21, 0xfe, 0x9a, 0xa2, 0xb6, 0x08, 0xd5,
+    0x69, 0x3d, 0x8f, 0xa4, 0x59, 0x68, 0x51, 0xb4, 0x54, 0x34, 0xc3, 0xf2, 0xfa, 0x66, 0x44, 0x8a,
+    0x62, 0x14, 0x65, 0x31, 0x0a, 0xc0, 0x3f, 0xff, 0x99, 0x81, 0xae, 0xe8, 0x84, 0xe8, 0x55, 0xda,
+    0x56, 0xb9, 0x97, 0x43, 0x8a, 0x48, 0x76, 0xfb, 0x56, 0xf9, 0x55, 0x2e, 0xd8, 0x15, 0xf9, 0x48,
+    0xce, 0xfa, 0x1d, 0xdd, 0xc4, 0x8c, 0x61, 0xad, 0x51, 0x96, 0x1a, 0xe5, 0x56, 0xcd, 0xc7, 0xb6,
+    0xbd, 0xc5, 0x3d, 0x2b, 0x64, 0x94, 0x38, 0xd6, 0x19, 0xc2, 0x44, 0x2e, 0x5f, 0x15, 0xfb, 0xab,
+    0x32, 0xac, 0xae, 0x5d, 0x11, 0x7b, 0xb9, 0x81, 0x61, 0x5d, 0x39, 0x79, 0x20, 0x14, 0x89, 0x13,
+    0x8a, 0x25, 0xab, 0x2c, 0x03, 0x89, 0x0b, 0x69, 0x10, 0x5f, 0xcc, 0xde, 0x3a, 0x3d, 0x9b, 0x0e,
+    0x1c, 0xd1, 0x67, 0xa3, 0x99, 0x90, 0x30, 0xcf, 0x50, 0x2d, 0x8a, 0x10, 0xad, 0x74, 0x6b, 0x81,
+    0x4a, 0x1f, 0x45, 0xa2, 0x90, 0x39, 0x22, 0x5e, 0xdd, 0x56, 0x1c, 0xe1, 0x5f, 0x47, 0x2f, 0x9e,
+    0x77, 0x16, 0xf4, 0x8b, 0x28, 0x74, 0x02, 0xa4, 0x3e, 0x79, 0x6a, 0xa5, 0xd4, 0xf3, 0x7d, 0xfb,
+    0xf6, 0x4e, 0x0a, 0x1d, 0x44, 0x91, 0xf9, 0xe3, 0x38, 0x8a, 0x1d, 0xa5, 0x32, 0x41, 0xa7, 0x4a,
+    0x20, 0x6a, 0x28, 0x8d, 0x14, 0x06, 0x71, 0xff, 0xb6, 0x41, 0xac, 0xf0, 0x49, 0x2d, 0xb3, 0x75,
+    0x5e, 0x83, 0x88, 0x7b, 0xe0, 0x55, 0xad, 0x53, 0xb9, 0x3b, 0x19, 0x6e, 0x47, 0x51, 0x50, 0x40,
+    0x2a, 0xc0, 0x95, 0xab, 0x36, 0x34, 0x7e, 0xa7, 0x8b, 0xb8, 0xad, 0x74, 0xa2, 0x98, 0x0e, 0xca,
+    0xe4, 0x2d, 0xbf, 0x3b, 0xa3, 0xf7, 0xab, 0x35, 0x1f, 0x55, 0x0b, 0x29, 0x96, 0x30, 0x51, 0xb1,
+    0xe4, 0x47, 0x23, 0x07, 0xdd, 0xea, 0x05, 0x69, 0xed, 0xb6, 0x54, 0xfb, 0xf4, 0xfa, 0x6f, 0xbe,
+    0x1a, 0x3f, 0x5b, 0x12, 0x21, 0xdb, 0xf0, 0x33, 0x2f, 0x93, 0xa1, 0xf4, 0x8b, 0xe8, 0x8f, 0xfa,
+    0xd5, 0x0f, 0xa0, 0xe4, 0x4f, 0x79, 0x92, 0xae, 0xfa, 0x7d, 0x4e, 0x59, 0x4d, 0x16, 0xf7, 0x93,
+    0xeb, 0xdb, 0xd2, 0xa0, 0x24, 0x0f, 0x6c, 0x28, 0xb7, 0x65, 0x43, 0x6c, 0x3e, 0x84, 0xa1, 0x68,
+    0x96, 0x47, 0x6b, 0xf2, 0xab, 0xfc, 0x3b, 0x3e, 0x2e, 0x9f, 0xa3, 0x14, 0x5e, 0xef, 0xca, 0x53,
+    0xf6, 0xb1, 0x83, 0xf2, 0xf5, 0xec, 0xf9, 0xf9, 0x5f, 0xc6, 0x2d, 0x42, 0xd1, 0x03, 0xe3, 0xd3,
+    0x6f, 0xc7, 0x47, 0x17, 0xa7, 0x47, 0xd5, 0xb1, 0x11, 0x32, 0xcf, 0xf1, 0x18, 0xd5, 0xba, 0xe8,
+    0xd0, 0x1b, 0xee, 0xe0, 0xf3, 0x44, 0x95, 0xcb, 0xd5, 0x4b, 0x4a, 0xd4, 0x79, 0xd2, 0xf0, 0xeb,
+    0x57, 0x8f, 0x5a, 0x84, 0x08, 0x69, 0xd8, 0xe7, 0xbb, 0x5f, 0xd4, 0x4f, 0x77, 0x6e, 0xd2, 0x0c,
+    0x1d, 0xfd, 0xba, 0x2c, 0xf5, 0x4f, 0xe7, 0x98, 0xf1, 0xee, 0x17, 0xfd, 0x63, 0xba, 0xf9, 0xbb,
+    0xbf, 0x5f, 0xfb, 0x10, 0x69, 0xfb, 0x43, 0x44, 0xa6, 0x69, 0x63, 0x36, 0xab, 0x8b, 0xec, 0x56,
+    0xee, 0xf8, 0x3e, 0xf9, 0x30, 0x87, 0xf6, 0xf9, 0xe4, 0x2f, 0xe3, 0xf1, 0x8b, 0xe7, 0x9b, 0xf7,
+    0xb9, 0x65, 0x7f, 0x5f, 0x37, 0x7f, 0x44, 0x96, 0xff, 0x06, 0x8c, 0x7b, 0xbe, 0xab, 0x4e, 0x2e,
+    0x04, 0x35, 0x18, 0x5e, 0x94, 0x60, 0xb3, 0x49, 0xb9, 0x45, 0x91, 0x00, 0x2a, 0xa2, 0xde, 0x1e,
+    0x25, 0x0a, 0xbd, 0xfb, 0x56, 0x6e, 0xf1, 0x28, 0x8e, 0xf9, 0xaa, 0x33, 0x8d, 0xa3, 0xb9, 0x51,
+    0xec, 0x16, 0xa5, 0x7b, 0xbc, 0x1a, 0x49, 0x9b, 0x88, 0x62, 0x72, 0xad, 0x96, 0x7a, 0x9b, 0xa0,
+    0x85, 0x30, 0x9d, 0xdf, 0xf8, 0x4c, 0xc8, 0xf9, 0x26, 0x1d, 0xf9, 0xfe, 0x46, 0x47, 0xfd, 0x52,
+    0x6c, 0xcc, 0x17, 0x4f, 0x73, 0xd6, 0x8e, 0xe9, 0x34, 0x81, 0x5a, 0x96, 0xca, 0x8b, 0xe8, 0xad,
+    0xd2, 0xc1, 0x4a, 0x77, 0x38, 0xe8, 0xaa, 0xd7, 0x62, 0x0f, 0xba, 0xea, 0x87, 0x98, 0xff, 0x07,
+    0xb3, 0x48, 0xe8, 0xa1, 0xa0, 0x39, 0x00, 0x00,
+};
+
+// web/routes.html: 17893 bytes -> 4724 gzip
+#define WEB_ROUTES_UI_ETAG "\"3cc1f67a25dc4fd3\""
+#define WEB_ROUTES_UI_TYPE "text/html; charset=utf-8"
+#define WEB_ROUTES_UI_GZ_LEN 4724U
+static const uint8_t WEB_ROUTES_UI_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xc5, 0x5c, 0xdd, 0x72, 0xdb, 0x38,
+    0x96, 0xbe, 0xcf, 0x53, 0x20, 0x4a, 0x6f, 0x48, 0x75, 0x2c, 0x59, 0x4e, 0x67, 0x32, 0x1e, 0xc9,
+    0x52, 0xd6, 0x9d, 0x38, 0x35, 0xde, 0x72, 0xec, 0x94, 0xed, 0x74, 0xef, 0x56, 0x3a, 0x95, 0xc0,
+    0x24, 0x24, 0x31, 0xa1, 0x08, 0x0e, 0x48, 0xfa, 0xa7, 0x63, 0x55, 0xed, 0xd5, 0x5e, 0xef, 0xc5,
+    0x5e, 0xed, 0x5d, 0x3f, 0xc3, 0x3e, 0x42, 0xde, 0x64, 0x9e, 0x64, 0xcf, 0x01, 0x40, 0x12, 0x24,
+    0x41, 0xfa, 0xa7, 0x67, 0x7b, 0xe3, 0x4a, 0x4c, 0x81, 0xc0, 0xc1, 0xf9, 0xfd, 0xce, 0xc1, 0x8f,
+    0xb2, 0xf3, 0xd0, 0xe7, 0x5e, 0x7a, 0x15, 0x33, 0xb2, 0x4c, 0x57, 0xe1, 0xec, 0xc1, 0x0e, 0xfe,
+    0x22, 0x21, 0x8d, 0x16, 0xd3, 0x1e, 0x4b, 0x7a, 0xd8, 0xc0, 0xa8, 0x3f, 0x7b, 0x40, 0xe0, 0xcf,
+    0xce, 0x8a, 0xa5, 0x94, 0x78, 0x4b, 0x2a, 0x12, 0x96, 0x4e, 0x7b, 0x59, 0x3a, 0x1f, 0x6c, 0xf7,
+    0xc8, 0xa6, 0xf9, 0x32, 0xa2, 0x2b, 0x36, 0xed, 0x9d, 0x07, 0xec, 0x22, 0xe6, 0x22, 0xed, 0x11,
+    0x8f, 0x47, 0x29, 0x8b, 0xa0, 0xf3, 0x45, 0xe0, 0xa7, 0xcb, 0xa9, 0xcf, 0xce, 0x03, 0x8f, 0x0d,
+    0xe4, 0x87, 0x8d, 0x20, 0x0a, 0xd2, 0x80, 0x86, 0x83, 0xc4, 0xa3, 0x21, 0x9b, 0x6e, 0x95, 0x94,
+    0xd2, 0x20, 0x0d, 0xd9, 0xec, 0x25, 0x0c, 0x15, 0x3c, 0x24, 0x3e, 0x23, 0xc7, 0x59, 0x4a, 0x13,
+    0x32, 0x20, 0xc7, 0xfc, 0x8c, 0xa7, 0x3b, 0x9b, 0xea, 0xbd, 0xea, 0x9b, 0xa4, 0x57, 0xf9, 0x33,
+    0xfe, 0xd9, 0xfc, 0x9e, 0xbc, 0xa2, 0xc9, 0xf2, 0x8c, 0x53, 0xe1, 0x0f, 0xc2, 0xe0, 0x0b, 0x23,
+    0x3e, 0x15, 0x5f, 0x48, 0xba, 0x64, 0x2b, 0x46, 0xe6, 0x5c, 0x00, 0x89, 0x2c, 0x65, 0x09, 0x79,
+    0xb7, 0x4f, 0xbe, 0xdf, 0x2c, 0x46, 0xa1, 0xcc, 0x1b, 0xe4, 0x8c, 0xfb, 0x57, 0xe4, 0x6b, 0xd1,
+    0x88, 0x7f, 0xce, 0xa8, 0xf7, 0x65, 0x21, 0x78, 0x16, 0xf9, 0x63, 0xf2, 0x68, 0x74, 0x86, 0x3f,
+    0x93, 0x4a, 0x07, 0x8f, 0x87, 0x5c, 0xc0, 0x3b, 0x46, 0xf1, 0xa7, 0xfa, 0x6e, 0x0e, 0x02, 0x0c,
+    0xe6, 0x74, 0x15, 0x84, 0x57, 0x63, 0xb2, 0x2b, 0x40, 0xd4, 0x0d, 0x92, 0xd0, 0x28, 0x19, 0x24,
+    0x4c, 0x04, 0xf3, 0x6a, 0xdf, 0x15, 0x15, 0x8b, 0x20, 0x1a, 0x93, 0x51, 0xb5, 0x39, 0xa6, 0xbe,
+    0x1f, 0x44, 0x8b, 0x31, 0xd9, 0x7a, 0x1a, 0x5f, 0x56, 0x5f, 0x0d, 0x2e, 0xd8, 0xd9, 0x97, 0x20,
+    0x1d, 0x64, 0x40, 0x0d, 0x28, 0x86, 0xcc, 0x4b, 0xc7, 0x24, 0xe2, 0x11, 0xab, 0x75, 0x5b, 0xf1,
+    0x5f, 0x6f, 0xee, 0x93, 0xdc, 0xd4, 0xe5, 0x26, 0x0a, 0x9a, 0x99, 0x94, 0x67, 0xde, 0x72, 0x00,
+    0xf6, 0x0c, 0x41, 0xcd, 0x9d, 0x1d, 0x69, 0x3c, 0x58, 0x06, 0x8b, 0x65, 0x08, 0x7f, 0xd3, 0x81,
+    0xd6, 0xa2, 0x58, 0x9c, 0x51, 0x77, 0xb4, 0x21, 0x7f, 0xfa, 0xd5, 0x71, 0x8a, 0x30, 0xf5, 0xd2,
+    0x80, 0x83, 0x96, 0x56, 0x34, 0x0a, 0xe2, 0x2c, 0xa4, 0xf8, 0xa9, 0xec, 0xb7, 0x2e, 0x9e, 0x86,
+    0xe8, 0x76, 0x34, 0x88, 0x98, 0x20, 0x5f, 0xa1, 0xf3, 0xa5, 0x72, 0xb8, 0x31, 0xf9, 0xf3, 0xf6,
+    0x08, 0xd4, 0x58, 0x2a, 0x9b, 0xd0, 0x2c, 0xe5, 0x13, 0x3d, 0x70, 0xe8, 0x81, 0xcf, 0x40, 0xff,
+    0x8a, 0xcd, 0xb7, 0xb6, 0xb6, 0x26, 0xe0, 0x18, 0xc2, 0x67, 0xc0, 0xdf, 0x56, 0x7c, 0x49, 0x12,
+    0x1e, 0x06, 0x3e, 0x79, 0xf4, 0xf4, 0xe9, 0xd3, 0xbc, 0x7d, 0x20, 0xa8, 0x1f, 0x64, 0xc9, 0x98,
+    0x6c, 0x23, 0xed, 0xaa, 0xc5, 0xa0, 0xcb, 0xe5, 0x20, 0x59, 0x52, 0x9f, 0x5f, 0xe0, 0x74, 0xd0,
+    0x44, 0x9e, 0xc3, 0x5f, 0x53, 0xd0, 0xe1, 0xf3, 0xfe, 0x84, 0xf8, 0x41, 0x12, 0x87, 0xf4, 0x6a,
+    0x7c, 0x16, 0x72, 0xef, 0xcb, 0xc4, 0x94, 0x04, 0xa3, 0x8f, 0x89, 0x63, 0x7e, 0x01, 0x9c, 0xe5,
+    0xbd, 0xe6, 0x21, 0x03, 0xd2, 0x14, 0x74, 0x17, 0x0d, 0x82, 0x94, 0xad, 0x92, 0xb1, 0x07, 0x31,
+    0xc6, 0xc4, 0x84, 0x2c, 0x68, 0x3c, 0xde, 0x32, 0x64, 0x1c, 0x40, 0xbc, 0xa4, 0x7c, 0xa5, 0xdb,
+    0xac, 0x64, 0x97, 0x4f, 0xa5, 0x8e, 0xa4, 0x46, 0x46, 0x13, 0xe5, 0xb4, 0x49, 0xf0, 0x2b, 0x1b,
+    0x6f, 0x0d, 0x9f, 0xb2, 0xd5, 0x44, 0x7b, 0xf8, 0xa3, 0x3f, 0xbf, 0x7c, 0xfd, 0x72, 0x34, 0x6a,
+    0xa1, 0x71, 0x96, 0xc1, 0x2c, 0x51, 0x55, 0x77, 0xa9, 0x00, 0x57, 0x8f, 0xa9, 0x00, 0xce, 0x0a,
+    0x0d, 0x8e, 0x1a, 0xe4, 0xca, 0xe9, 0x9e, 0x4a, 0x16, 0x95, 0xa1, 0x9e, 0xc9, 0xe7, 0x25, 0x43,
+    0xe7, 0xd0, 0x1f, 0xaa, 0xba, 0x7e, 0x8e, 0x4d, 0x5e, 0x26, 0x12, 0xa0, 0x15, 0xf3, 0x40, 0x09,
+    0xdf, 0xc1, 0xda, 0x18, 0x3d, 0xe7, 0x9c, 0x01, 0x87, 0x92, 0x2d, 0x00, 0x82, 0xd5, 0x58, 0x3d,
+    0x82, 0x13, 0xb1, 0x7f, 0x73, 0xc1, 0xb2, 0x7d, 0x24, 0x20, 0x29, 0x84, 0xf4, 0x8c, 0x85, 0x86,
+    0xba, 0xb5, 0x51, 0x72, 0xaf, 0x01, 0x33, 0x83, 0x29, 0xd1, 0x8c, 0xa5, 0x38, 0x9e, 0xe7, 0x4d,
+    0x48, 0xca, 0x2e, 0xd3, 0x81, 0xb4, 0x4a, 0x61, 0x0f, 0xc5, 0x92, 0x8a, 0x9b, 0x0d, 0x12, 0x44,
+    0x71, 0x96, 0xbe, 0x47, 0xb0, 0x9d, 0x46, 0xd9, 0xea, 0x8c, 0x89, 0x0f, 0x30, 0x8b, 0x92, 0xf8,
+    0x2f, 0xa3, 0x7f, 0x9a, 0x18, 0x9e, 0xfa, 0x27, 0x25, 0x74, 0xee, 0x4c, 0xdb, 0x2d, 0x1a, 0xd0,
+    0x6a, 0x35, 0xfc, 0xf2, 0x87, 0x1f, 0x7e, 0x98, 0x98, 0x56, 0x78, 0x34, 0xf2, 0xf1, 0xa7, 0x60,
+    0x94, 0x31, 0x56, 0x48, 0x52, 0x75, 0xff, 0x92, 0x51, 0xc2, 0x63, 0x0c, 0xac, 0xaa, 0x39, 0x55,
+    0x24, 0x98, 0x54, 0xca, 0x61, 0xb1, 0x60, 0xb5, 0xce, 0x23, 0x86, 0x3f, 0xa5, 0x7a, 0xe6, 0xf8,
+    0x73, 0xb3, 0x3c, 0xda, 0x00, 0x43, 0x61, 0x71, 0x77, 0xe9, 0xda, 0x72, 0xa0, 0xe9, 0xf8, 0xf8,
+    0x6e, 0x90, 0xa4, 0x54, 0xa4, 0xb9, 0xef, 0x6c, 0x8d, 0x50, 0x95, 0x86, 0x2f, 0x20, 0xb1, 0x19,
+    0xf9, 0x1e, 0x08, 0x62, 0x67, 0x08, 0x4c, 0xf8, 0xa9, 0xc6, 0xbd, 0x4a, 0x34, 0x89, 0x75, 0xca,
+    0x6d, 0x23, 0x98, 0x52, 0xae, 0x3f, 0xcb, 0x59, 0x2f, 0x04, 0xbc, 0xc6, 0x7f, 0x26, 0xe4, 0x73,
+    0x96, 0xa4, 0xc1, 0xfc, 0x6a, 0xa0, 0xb3, 0x5d, 0xcd, 0xfc, 0xe5, 0x04, 0xb6, 0x38, 0x51, 0x50,
+    0x52, 0x0b, 0x0b, 0x6d, 0x58, 0x89, 0x9f, 0x85, 0xd6, 0x30, 0x88, 0x35, 0xac, 0x68, 0x0b, 0x3e,
+    0x53, 0x4e, 0x68, 0xc4, 0xec, 0xf3, 0xbb, 0xc7, 0x4a, 0x8d, 0xbb, 0xf1, 0x92, 0x9f, 0x4b, 0xdc,
+    0x34, 0x79, 0xcc, 0xf9, 0xd2, 0x6c, 0x8e, 0xaa, 0x48, 0x60, 0x66, 0xdf, 0x3d, 0xd0, 0x44, 0xc8,
+    0x13, 0x60, 0x5a, 0x50, 0x02, 0xee, 0xb4, 0x02, 0x55, 0xc0, 0x47, 0x9f, 0x01, 0x0a, 0x9e, 0x05,
+    0x61, 0x90, 0x02, 0x16, 0x26, 0xc4, 0x05, 0x97, 0xc1, 0x22, 0xa1, 0x6f, 0x66, 0x61, 0x9d, 0x5e,
+    0xc0, 0x06, 0xf4, 0x2c, 0x64, 0x7e, 0x2d, 0x15, 0xf3, 0x98, 0x7a, 0x41, 0x0a, 0x99, 0x14, 0x10,
+    0xb3, 0x96, 0x83, 0x95, 0x6c, 0x90, 0x6d, 0x30, 0xfc, 0x42, 0x7e, 0xc1, 0xfc, 0x49, 0x7b, 0x16,
+    0xdf, 0xa2, 0xf8, 0x43, 0x1e, 0x06, 0x2b, 0xac, 0x50, 0x28, 0xa0, 0x93, 0x25, 0x81, 0xd4, 0x59,
+    0xc9, 0x23, 0xc2, 0x9a, 0xfb, 0x9f, 0x3f, 0x7f, 0x6e, 0xd2, 0x28, 0x1e, 0xff, 0x79, 0xc5, 0xfc,
+    0x80, 0x12, 0xd7, 0x08, 0x6b, 0x04, 0xb9, 0x7e, 0x8d, 0x4c, 0x25, 0x59, 0xe5, 0xb6, 0x7e, 0x5e,
+    0xc5, 0x6b, 0x1b, 0x66, 0x9b, 0x48, 0x3d, 0x42, 0xa4, 0x5e, 0x37, 0xc9, 0x56, 0xbd, 0xae, 0x70,
+    0x24, 0xcc, 0x43, 0x5b, 0xcf, 0xa4, 0x27, 0x97, 0x44, 0xb6, 0xab, 0x53, 0xaa, 0xa7, 0x9d, 0x4d,
+    0x5d, 0x60, 0xed, 0x6c, 0xaa, 0x3a, 0x70, 0x07, 0xab, 0x24, 0x5d, 0x7b, 0xf9, 0xc1, 0x39, 0xf1,
+    0x42, 0x9a, 0x24, 0xd3, 0x5e, 0x21, 0x43, 0xcf, 0xf2, 0x0e, 0xf2, 0xaa, 0xa5, 0xb9, 0x10, 0xa7,
+    0x57, 0x96, 0x6f, 0x3b, 0x9a, 0xd7, 0xc0, 0x9f, 0xf6, 0xd0, 0x6a, 0xa7, 0x1c, 0xab, 0xb9, 0x1e,
+    0x91, 0x15, 0xdf, 0xb4, 0xf7, 0x13, 0x0f, 0xd1, 0x37, 0x29, 0x14, 0x85, 0x79, 0x91, 0xd7, 0x23,
+    0x3c, 0xf2, 0xc2, 0xc0, 0xfb, 0x32, 0xed, 0x01, 0x4c, 0xcb, 0x8a, 0x60, 0xb8, 0x14, 0x6c, 0x3e,
+    0x75, 0x36, 0x9d, 0xde, 0xec, 0xef, 0xff, 0xf1, 0x9f, 0x3b, 0x9b, 0x8a, 0xa6, 0x31, 0xc9, 0xf2,
+    0x69, 0xb3, 0xb8, 0xdc, 0x05, 0x44, 0x58, 0x7d, 0xfb, 0x2d, 0x0d, 0x3c, 0x9a, 0x80, 0xac, 0x4f,
+    0x35, 0xbf, 0x9b, 0xc0, 0xb0, 0x7a, 0x2c, 0xf8, 0x37, 0x08, 0xa9, 0x4c, 0x01, 0xd9, 0x64, 0xda,
+    0x13, 0x58, 0x57, 0x9e, 0x48, 0xb7, 0xe9, 0xcd, 0xe4, 0x6f, 0x0f, 0x58, 0xa1, 0x90, 0x4c, 0x88,
+    0x80, 0x09, 0xc6, 0x3b, 0x9b, 0xb2, 0xb3, 0x31, 0x58, 0x83, 0x2d, 0x8a, 0x5a, 0x19, 0x0c, 0x2a,
+    0x97, 0x4f, 0x15, 0x0e, 0x6e, 0x98, 0xfd, 0x82, 0x5e, 0xc9, 0xd0, 0xce, 0x69, 0xfc, 0xac, 0x3f,
+    0x63, 0xe0, 0xe5, 0x2c, 0xc0, 0x8c, 0x31, 0x8d, 0x88, 0xb4, 0x27, 0x1a, 0x4c, 0x46, 0xf2, 0xf6,
+    0xf6, 0xb6, 0xe9, 0x04, 0xa3, 0xe1, 0xf6, 0x9f, 0xc0, 0x95, 0x7a, 0x33, 0xf7, 0xad, 0x0a, 0x50,
+    0x28, 0xba, 0xf7, 0x57, 0xb1, 0x0a, 0x63, 0x88, 0xbf, 0x6f, 0xff, 0x13, 0x91, 0x79, 0x96, 0x66,
+    0x82, 0xf6, 0x81, 0x4d, 0x20, 0x37, 0xeb, 0x16, 0xac, 0xc6, 0x17, 0x29, 0x02, 0x4a, 0x73, 0x91,
+    0x07, 0x35, 0xc6, 0x74, 0x1e, 0xc7, 0x66, 0x18, 0x57, 0x33, 0x90, 0x8c, 0xdc, 0xc9, 0xfd, 0x34,
+    0x04, 0x14, 0xdf, 0x4a, 0x8d, 0xe4, 0x2a, 0x3a, 0xe5, 0x08, 0x44, 0x12, 0xaa, 0x32, 0x09, 0x51,
+    0xff, 0x0f, 0xea, 0xa9, 0x33, 0x45, 0x70, 0x96, 0x69, 0xef, 0xf9, 0x1f, 0xa3, 0xa8, 0x3c, 0x10,
+    0x45, 0x35, 0x04, 0x2b, 0x2a, 0xac, 0xab, 0xd1, 0x67, 0x90, 0x1e, 0x4f, 0x98, 0xd7, 0x9b, 0xbd,
+    0xc2, 0x27, 0x02, 0xf8, 0xc9, 0xa4, 0x93, 0xc1, 0x62, 0xce, 0x0b, 0xa8, 0x20, 0x6e, 0xc2, 0x16,
+    0xc0, 0x04, 0x4f, 0xfa, 0x4d, 0xd1, 0x25, 0x31, 0x59, 0x04, 0x49, 0xe9, 0x0b, 0x5a, 0x44, 0x96,
+    0x44, 0x3d, 0x55, 0x13, 0xf5, 0xc8, 0x39, 0x0d, 0x33, 0xf8, 0xb8, 0x35, 0xea, 0x91, 0x55, 0x10,
+    0x4d, 0x7b, 0xf0, 0x5b, 0x6b, 0xa1, 0xcc, 0xf0, 0xc5, 0x62, 0xb1, 0x16, 0xa5, 0x85, 0x6c, 0x7a,
+    0x44, 0x25, 0xa1, 0xcb, 0xb4, 0xed, 0x07, 0x82, 0xa9, 0x65, 0x04, 0xd8, 0x38, 0x5b, 0x45, 0x13,
+    0xcc, 0xf2, 0x08, 0xb7, 0xbd, 0x1a, 0xa3, 0x35, 0x74, 0x43, 0x28, 0xad, 0x75, 0xa9, 0x23, 0x96,
+    0xac, 0x43, 0xf6, 0x7d, 0xda, 0x9b, 0xed, 0xe7, 0xda, 0xd8, 0x7f, 0xb5, 0xdb, 0x6f, 0x22, 0x50,
+    0xeb, 0xe0, 0x63, 0x96, 0x1a, 0x83, 0x8f, 0xf7, 0x4e, 0x8f, 0x8e, 0x0f, 0x8f, 0x6e, 0x4d, 0x80,
+    0xc7, 0x72, 0x75, 0x8b, 0xb6, 0x81, 0x32, 0x84, 0x09, 0xfb, 0xb8, 0x9a, 0xb6, 0xee, 0x29, 0x2b,
+    0x74, 0x9b, 0x07, 0x62, 0x75, 0x82, 0x5c, 0x97, 0xee, 0x8a, 0xb8, 0x8a, 0xcd, 0xc0, 0xbd, 0x74,
+    0x08, 0xde, 0xc1, 0xba, 0x61, 0xa5, 0x4a, 0xd6, 0x6b, 0xab, 0x8d, 0x46, 0xf3, 0x51, 0xbd, 0xb4,
+    0x91, 0x29, 0xac, 0x59, 0x76, 0xf7, 0x66, 0x2f, 0x33, 0x0c, 0x48, 0x22, 0xd8, 0x42, 0xb0, 0x24,
+    0x38, 0xa7, 0x63, 0x1d, 0xdd, 0x8a, 0x73, 0x88, 0x77, 0x58, 0x90, 0x45, 0xbd, 0xd9, 0x60, 0xa0,
+    0xc3, 0xd4, 0xa6, 0x93, 0x16, 0x35, 0x69, 0x96, 0x8d, 0x92, 0x50, 0x95, 0x64, 0x5a, 0x06, 0xa3,
+    0x45, 0xf3, 0x2a, 0x1b, 0xaa, 0x15, 0x7a, 0xaf, 0x5b, 0x1d, 0x96, 0x85, 0x44, 0xad, 0x3e, 0xac,
+    0xae, 0xee, 0xb6, 0xab, 0x99, 0x7c, 0x34, 0xfc, 0x8b, 0x04, 0xa9, 0x13, 0x88, 0xc4, 0x60, 0x15,
+    0x60, 0x01, 0x86, 0x11, 0xfa, 0x16, 0xd6, 0x62, 0xbe, 0x45, 0xaa, 0x3b, 0x38, 0x40, 0xdd, 0x09,
+    0x2e, 0x00, 0x7e, 0x5e, 0x73, 0x84, 0xa0, 0x03, 0x36, 0x4f, 0x8b, 0x30, 0x35, 0x2d, 0xf8, 0xec,
+    0xd9, 0xb3, 0x3a, 0xf7, 0x9a, 0x33, 0xa1, 0x38, 0x22, 0xfb, 0xbf, 0xfe, 0x2d, 0x0b, 0x98, 0xf0,
+    0x69, 0xbb, 0xaf, 0xb4, 0xcf, 0x7b, 0x8c, 0x4b, 0xc4, 0x7b, 0x4e, 0xfc, 0x8a, 0x01, 0x12, 0x2c,
+    0xef, 0x30, 0x2d, 0x46, 0xd8, 0xcf, 0xc5, 0xd4, 0xd6, 0x59, 0xb1, 0x16, 0xcc, 0x67, 0x9d, 0xcf,
+    0xe7, 0x93, 0x22, 0x16, 0x89, 0x61, 0x8d, 0x8e, 0xa0, 0xb8, 0x95, 0x1f, 0xda, 0x80, 0xaf, 0x02,
+    0xee, 0xf2, 0x99, 0xec, 0x3c, 0x1c, 0x0c, 0xf4, 0xae, 0xc6, 0x60, 0x30, 0xb3, 0xbc, 0x29, 0xea,
+    0x4e, 0x7c, 0x6d, 0xcb, 0x9f, 0x09, 0x38, 0x42, 0xb4, 0x98, 0x41, 0x4d, 0x0f, 0x55, 0xfb, 0x18,
+    0x6b, 0x41, 0xf9, 0xb9, 0xec, 0x80, 0x2b, 0x3f, 0x0d, 0x5e, 0x69, 0x96, 0x20, 0x74, 0xc9, 0x85,
+    0x36, 0x48, 0x08, 0x6f, 0x6e, 0x4c, 0xcf, 0x9a, 0xdc, 0x7e, 0x84, 0xeb, 0x71, 0x9d, 0x3e, 0xcb,
+    0x7a, 0xa5, 0x73, 0x3e, 0x99, 0xd6, 0x98, 0x5f, 0x29, 0xb5, 0xb2, 0x48, 0x17, 0x3a, 0x72, 0xed,
+    0x81, 0x85, 0x62, 0x92, 0x25, 0x24, 0x2f, 0x41, 0x92, 0x36, 0x9e, 0x12, 0x4f, 0x04, 0x71, 0x5a,
+    0x4e, 0x02, 0x6a, 0x49, 0x52, 0x72, 0x7c, 0xf4, 0xee, 0x74, 0xef, 0xe4, 0xe3, 0xbb, 0xe3, 0x03,
+    0x32, 0x25, 0xce, 0xa6, 0xac, 0xd0, 0x12, 0x67, 0x52, 0xeb, 0x75, 0x72, 0xba, 0x7b, 0x7c, 0x5a,
+    0x74, 0x92, 0x10, 0xfe, 0x51, 0x76, 0xb5, 0xf4, 0x3c, 0x7a, 0x6b, 0x74, 0xe4, 0x71, 0x6b, 0xbf,
+    0xdd, 0xd3, 0x77, 0xb5, 0x79, 0x3f, 0x2a, 0xf5, 0x36, 0xfa, 0xee, 0xfd, 0xb4, 0x77, 0x78, 0x5a,
+    0xf6, 0x65, 0xe7, 0xe0, 0x5c, 0xcd, 0x5e, 0x2f, 0x8f, 0x0e, 0x5f, 0xef, 0x1f, 0xbf, 0x29, 0xba,
+    0x69, 0xe4, 0x6e, 0x99, 0xff, 0xe7, 0xdd, 0x83, 0x83, 0x8f, 0xaf, 0x8f, 0x0e, 0x0e, 0x8e, 0x7e,
+    0x2e, 0x46, 0x60, 0xb8, 0x7d, 0x9c, 0x4b, 0xa7, 0xb7, 0xcb, 0x65, 0x1b, 0x24, 0x65, 0xac, 0x8e,
+    0x2c, 0x86, 0x86, 0x2c, 0x25, 0x4a, 0xa3, 0xd0, 0xf5, 0xfd, 0x87, 0x3a, 0x4d, 0xa3, 0x1c, 0x86,
+    0xf7, 0x3e, 0xf7, 0x32, 0xac, 0xaf, 0x86, 0x0b, 0x96, 0xee, 0xa9, 0x52, 0xeb, 0xc7, 0xab, 0x7d,
+    0xdf, 0x75, 0x8c, 0x6e, 0x4e, 0xbf, 0x4e, 0xa3, 0x5a, 0x79, 0x76, 0x91, 0xa9, 0xf6, 0x6c, 0x52,
+    0xaa, 0x15, 0x69, 0x5d, 0xa4, 0x6a, 0x5d, 0x9b, 0xb4, 0x72, 0xbf, 0x85, 0xf2, 0xb1, 0x8b, 0x4e,
+    0xde, 0xcd, 0x42, 0x40, 0x7a, 0xc2, 0x4d, 0xc3, 0x95, 0xbb, 0x34, 0x06, 0x17, 0x99, 0xef, 0x04,
+    0x73, 0x61, 0x07, 0x81, 0xa2, 0xa3, 0x8d, 0x86, 0xf4, 0x9e, 0x1f, 0xd3, 0x1b, 0x08, 0x94, 0xd5,
+    0x01, 0xd2, 0x28, 0x88, 0xd0, 0xe4, 0x2a, 0xf2, 0xa0, 0x46, 0x8e, 0x64, 0x09, 0x06, 0xe5, 0x37,
+    0xf5, 0xd5, 0x8e, 0xbc, 0x5b, 0x5f, 0x16, 0xa7, 0xa2, 0xbe, 0x19, 0x6f, 0x38, 0x08, 0x4b, 0x62,
+    0x98, 0x9e, 0x5e, 0xd0, 0x20, 0x25, 0x73, 0x96, 0x7a, 0x4b, 0xb7, 0x8c, 0xd7, 0x0d, 0x58, 0xe9,
+    0x7a, 0xd4, 0x5b, 0xb2, 0x31, 0x71, 0x22, 0x3e, 0x00, 0x3f, 0x14, 0xcc, 0x21, 0xeb, 0xda, 0x86,
+    0x32, 0xfe, 0x09, 0xe6, 0xc4, 0x7d, 0x88, 0xb4, 0x86, 0xfc, 0x4b, 0x9f, 0xa4, 0x4b, 0xdc, 0x29,
+    0x8a, 0xa0, 0xa8, 0xdf, 0x13, 0x82, 0x0b, 0xd7, 0x91, 0xbf, 0x88, 0x43, 0x9e, 0xc8, 0xf9, 0x86,
+    0x4a, 0xab, 0x16, 0x32, 0x85, 0x27, 0x2b, 0x7e, 0x64, 0xe7, 0xcf, 0x09, 0x8f, 0x5c, 0x4b, 0xdf,
+    0x98, 0xcb, 0x7d, 0x6b, 0x76, 0x5c, 0xfa, 0x6e, 0x57, 0xb7, 0xdd, 0xdc, 0xa1, 0xdc, 0x16, 0xf6,
+    0xd5, 0xdc, 0xc3, 0x90, 0x45, 0x8b, 0x74, 0x49, 0x66, 0x64, 0x04, 0x6a, 0x24, 0xd6, 0x44, 0x66,
+    0x44, 0xcb, 0x30, 0xf7, 0xaf, 0xfd, 0xc8, 0x67, 0x97, 0xc0, 0x38, 0x54, 0x14, 0xd6, 0x31, 0x39,
+    0x1b, 0xc5, 0x72, 0xf2, 0x35, 0x17, 0x92, 0x73, 0x77, 0xd4, 0x6f, 0x19, 0xb2, 0xb9, 0x49, 0xde,
+    0x70, 0xc0, 0x6d, 0x59, 0x01, 0x1a, 0xb8, 0xae, 0xd6, 0x07, 0xa1, 0xc6, 0xf7, 0x58, 0x04, 0x2b,
+    0x26, 0x14, 0x5c, 0x5b, 0xc9, 0x28, 0x3b, 0x83, 0x0f, 0x25, 0xa9, 0x9c, 0x10, 0x98, 0x54, 0xa2,
+    0xbe, 0x1f, 0x7d, 0x98, 0x58, 0x47, 0xa0, 0x36, 0x8c, 0xfe, 0x8f, 0x1f, 0x1b, 0xa3, 0x87, 0x7a,
+    0x31, 0x6c, 0x6b, 0xac, 0xea, 0xce, 0x4a, 0xba, 0xdc, 0x11, 0x92, 0x91, 0x3b, 0xc4, 0xfa, 0xec,
+    0xa5, 0xda, 0xea, 0x03, 0xbe, 0x3e, 0xe1, 0x06, 0xc2, 0x98, 0x7c, 0xf7, 0xd5, 0x20, 0x8d, 0xc7,
+    0x60, 0xe4, 0xfa, 0x9a, 0x38, 0xf8, 0x8e, 0x8c, 0x9c, 0xf5, 0x2f, 0x51, 0xa1, 0xc3, 0x5a, 0xd7,
+    0x0a, 0x17, 0xd0, 0xef, 0xad, 0x54, 0x8d, 0x5a, 0x94, 0x8e, 0x89, 0x6b, 0xe9, 0x0b, 0x2a, 0x18,
+    0x5e, 0xae, 0x37, 0x48, 0xcb, 0xab, 0xab, 0x75, 0xff, 0x97, 0xe8, 0xdb, 0x7f, 0x87, 0x69, 0xb0,
+    0xe2, 0x9d, 0x64, 0xda, 0x98, 0x18, 0x6c, 0xb5, 0xd3, 0xef, 0x1a, 0x03, 0x13, 0x7f, 0xb2, 0xdb,
+    0x66, 0xfd, 0xa0, 0xbb, 0x65, 0x0d, 0x01, 0x0b, 0x41, 0x4c, 0x5c, 0x26, 0x84, 0xcd, 0x08, 0x05,
+    0xea, 0xd5, 0x54, 0xef, 0x1c, 0x72, 0x30, 0x0c, 0x08, 0xe9, 0x43, 0x01, 0x09, 0x70, 0x02, 0xb5,
+    0xce, 0x02, 0x1c, 0x0f, 0xbd, 0x0a, 0xd4, 0x8c, 0x91, 0x0b, 0x04, 0xab, 0x2c, 0xad, 0x6d, 0x3b,
+    0x75, 0x05, 0x1e, 0x59, 0xc3, 0xb3, 0xc6, 0x90, 0x19, 0x48, 0x41, 0x04, 0xe5, 0xd3, 0x5f, 0x4f,
+    0xdf, 0xc8, 0x94, 0xe7, 0x4c, 0x9a, 0xfd, 0x92, 0x21, 0xc4, 0xc0, 0x1e, 0xa0, 0x91, 0xeb, 0x8a,
+    0x0d, 0x28, 0x5d, 0x2e, 0xfb, 0x64, 0x3a, 0x43, 0x80, 0x92, 0xfe, 0xcd, 0xe3, 0x74, 0x5a, 0x60,
+    0xa8, 0x27, 0x18, 0xcc, 0xac, 0x61, 0xd4, 0x75, 0xd4, 0x96, 0x23, 0x80, 0x27, 0xf6, 0x1a, 0xaa,
+    0x35, 0x31, 0x8c, 0x57, 0x1f, 0x5b, 0x3c, 0x50, 0x48, 0xc7, 0xbb, 0xbe, 0x76, 0x9d, 0x47, 0xce,
+    0x13, 0x9c, 0x6c, 0xfd, 0x69, 0x52, 0xe1, 0x97, 0xc6, 0x31, 0x8b, 0xfc, 0x97, 0xcb, 0x20, 0xf4,
+    0x5d, 0xa0, 0x83, 0x67, 0x1e, 0x7d, 0xdb, 0xfe, 0x67, 0x43, 0x21, 0x4d, 0x04, 0x90, 0x64, 0x25,
+    0x80, 0xd4, 0x15, 0x54, 0x4d, 0xa8, 0x9d, 0x3a, 0xaa, 0xe6, 0x6a, 0xc4, 0x50, 0x8d, 0x68, 0xef,
+    0x4b, 0xf2, 0x1f, 0x30, 0x6c, 0x9b, 0xad, 0xda, 0xff, 0xfa, 0x18, 0x66, 0xef, 0x6b, 0x98, 0x50,
+    0x10, 0x2c, 0xb5, 0x1f, 0xa7, 0x1b, 0xb1, 0xe2, 0x76, 0x3a, 0xb3, 0x20, 0xe4, 0x5d, 0xec, 0xd1,
+    0x18, 0x5c, 0x1a, 0xe8, 0x13, 0xd8, 0xa0, 0x60, 0x71, 0x7d, 0xfd, 0xdd, 0x57, 0x35, 0x27, 0x9a,
+    0xc1, 0x3a, 0xca, 0xb0, 0xe3, 0xf4, 0x53, 0xae, 0x63, 0x92, 0x0f, 0x03, 0xff, 0xdd, 0x5a, 0xcb,
+    0xe0, 0x85, 0xae, 0x2a, 0x22, 0xe1, 0x41, 0x86, 0x59, 0x93, 0x5c, 0x4d, 0xeb, 0x4d, 0x4b, 0x57,
+    0xc3, 0xa0, 0x96, 0x4f, 0x10, 0x3d, 0x4b, 0xad, 0xa9, 0x98, 0x9e, 0x4e, 0xa7, 0xa3, 0xfe, 0xff,
+    0x85, 0xae, 0x4c, 0xa9, 0x1d, 0x37, 0x09, 0xa2, 0xd2, 0x60, 0x7d, 0xa7, 0x53, 0xbf, 0x8e, 0x73,
+    0x0f, 0xc9, 0x1f, 0xb4, 0x03, 0x0f, 0x64, 0xab, 0x5d, 0x2f, 0xcd, 0x60, 0xad, 0xfd, 0x6b, 0x3d,
+    0x61, 0xad, 0x64, 0x16, 0xf3, 0xe9, 0x8d, 0x6a, 0x6a, 0xcb, 0x1c, 0x46, 0x2d, 0x7b, 0x88, 0xe9,
+    0x60, 0x6a, 0x71, 0xe2, 0x17, 0x45, 0xa6, 0x90, 0x31, 0x4c, 0x2a, 0xee, 0x63, 0x01, 0xd3, 0x5b,
+    0x64, 0xa1, 0x62, 0xc2, 0x7a, 0xce, 0xa9, 0xf3, 0x6d, 0xcb, 0x35, 0x45, 0x9f, 0x32, 0xc7, 0x54,
+    0x9a, 0x5a, 0x72, 0x4b, 0xd9, 0xa7, 0x3e, 0x49, 0x99, 0x4b, 0xba, 0xfb, 0x34, 0x73, 0xc7, 0xfa,
+    0x36, 0xb0, 0x64, 0xd4, 0x47, 0x5f, 0xeb, 0x85, 0x7a, 0x09, 0x3c, 0xd2, 0x6d, 0x9a, 0x70, 0x2c,
+    0x02, 0x89, 0x05, 0xae, 0xd0, 0x50, 0x72, 0x7d, 0xfd, 0xfe, 0x43, 0xbf, 0x8a, 0x18, 0xaa, 0xc7,
+    0xfd, 0xc0, 0x1a, 0xb1, 0x20, 0x90, 0x18, 0x10, 0x60, 0xfc, 0x37, 0xc2, 0xbd, 0x11, 0xd6, 0xf8,
+    0x00, 0x23, 0xe4, 0xe7, 0x60, 0xdd, 0x27, 0x7f, 0xff, 0xf7, 0xff, 0x32, 0x30, 0xdd, 0x71, 0x90,
+    0x4a, 0x5d, 0x46, 0x2b, 0xa0, 0xab, 0xbf, 0x4d, 0xad, 0x25, 0x4b, 0x7e, 0x71, 0xa2, 0x3d, 0xe8,
+    0xb5, 0xe0, 0xab, 0x23, 0xc9, 0xf5, 0x4f, 0xc8, 0xad, 0x2b, 0x79, 0xae, 0x47, 0x7b, 0x30, 0x77,
+    0x1f, 0x5a, 0x5f, 0x74, 0xf8, 0xe2, 0xd4, 0xb9, 0xfd, 0x92, 0xdc, 0x16, 0xcd, 0x82, 0xa5, 0x99,
+    0x88, 0xea, 0x70, 0x45, 0x2c, 0x69, 0xe3, 0xbd, 0xd8, 0x88, 0x3f, 0x4c, 0x25, 0x7f, 0xc3, 0x24,
+    0x0e, 0x03, 0xb0, 0xc3, 0xb5, 0xd3, 0x1f, 0xae, 0x68, 0xec, 0x46, 0xd3, 0x59, 0x8c, 0xb7, 0x94,
+    0xf6, 0xc1, 0x38, 0xd1, 0xc6, 0xd6, 0xa8, 0x5f, 0x87, 0x22, 0x90, 0x2c, 0x48, 0x0e, 0xe9, 0xa1,
+    0x2b, 0xfa, 0xd7, 0xd7, 0xea, 0x29, 0x86, 0xa7, 0x87, 0x79, 0x88, 0x7e, 0x30, 0x9f, 0xf3, 0xe2,
+    0x27, 0xfe, 0x70, 0x27, 0x3d, 0x80, 0x62, 0x39, 0x82, 0xca, 0xf9, 0xb7, 0xdf, 0xc2, 0xc0, 0xe7,
+    0xbf, 0x4f, 0x58, 0x70, 0x3e, 0x0b, 0x3f, 0x13, 0x5b, 0x57, 0x1b, 0xe4, 0x7c, 0x68, 0x02, 0x4d,
+    0x1d, 0x5f, 0xda, 0xe4, 0xe8, 0x44, 0x16, 0xf4, 0x55, 0x99, 0xa6, 0xb0, 0xb0, 0xd7, 0x5d, 0x0c,
+    0x16, 0x4b, 0xa8, 0x79, 0xc9, 0x71, 0x37, 0x34, 0x02, 0x40, 0x05, 0x30, 0xba, 0x9c, 0x16, 0xbe,
+    0x7f, 0x35, 0xd5, 0xde, 0xff, 0x4b, 0xf4, 0x4b, 0x64, 0x1c, 0xab, 0x68, 0x27, 0xd2, 0x5b, 0x42,
+    0x65, 0x85, 0x80, 0x1b, 0xfa, 0x3c, 0x0a, 0xce, 0x42, 0x46, 0x58, 0x7e, 0xd8, 0x92, 0xa0, 0x67,
+    0x25, 0xe0, 0x70, 0x2c, 0x31, 0x51, 0xc4, 0x28, 0xf0, 0xaa, 0x38, 0x5f, 0x52, 0xf3, 0x32, 0x1a,
+    0xf9, 0x1c, 0xea, 0xc6, 0xd5, 0x59, 0x50, 0x9c, 0xd5, 0x11, 0x37, 0xe1, 0x21, 0xd7, 0x2e, 0x1b,
+    0x24, 0x6a, 0x94, 0x64, 0xa5, 0xff, 0xc0, 0x56, 0x04, 0x52, 0xdf, 0xdf, 0xc3, 0xad, 0x97, 0x83,
+    0x20, 0x91, 0x5b, 0x7d, 0xb0, 0xfc, 0x5d, 0xd2, 0x68, 0xc1, 0x9c, 0x0d, 0xe2, 0x36, 0xab, 0x0d,
+    0x65, 0x23, 0x28, 0xce, 0xa6, 0x85, 0x87, 0x9a, 0xc4, 0xa4, 0x3b, 0xa3, 0xc7, 0xd6, 0x4c, 0xdb,
+    0x5e, 0x88, 0x61, 0x9d, 0xd7, 0xf4, 0xee, 0x5a, 0x52, 0x54, 0x00, 0x95, 0xdb, 0x63, 0x66, 0xcd,
+    0xeb, 0xb5, 0x21, 0x95, 0x45, 0xe2, 0xd4, 0xb6, 0x44, 0x6c, 0x5b, 0xeb, 0xf9, 0x2c, 0xd4, 0x2b,
+    0xbc, 0x82, 0x26, 0x88, 0x8d, 0x19, 0x43, 0x99, 0xf7, 0x41, 0xc7, 0x6a, 0xaf, 0x70, 0xac, 0x29,
+    0xb1, 0x8b, 0x60, 0x5d, 0x00, 0x16, 0x8b, 0xbf, 0x62, 0x78, 0xbe, 0xd4, 0xcb, 0x1b, 0x94, 0x62,
+    0xdb, 0x56, 0x78, 0x5d, 0xc8, 0x68, 0x23, 0xd3, 0xe4, 0x60, 0x4d, 0x58, 0x08, 0x4b, 0x91, 0x16,
+    0xf2, 0xb7, 0x4c, 0xdb, 0xc9, 0x7b, 0x30, 0xa6, 0x51, 0x14, 0x38, 0x87, 0x9b, 0xbb, 0x8d, 0xb5,
+    0x63, 0xa5, 0xa7, 0x6a, 0x7e, 0x91, 0x97, 0x22, 0x30, 0x66, 0x64, 0xab, 0x1b, 0xd6, 0x6d, 0xa9,
+    0xd5, 0x90, 0xc4, 0x0c, 0x96, 0x03, 0x6e, 0xa0, 0x34, 0x61, 0x49, 0xfa, 0xed, 0xb7, 0xa8, 0x76,
+    0x87, 0x63, 0x83, 0xc4, 0xb0, 0xe6, 0xc2, 0xab, 0x78, 0xe8, 0xf4, 0x2b, 0x7d, 0x96, 0x1a, 0xea,
+    0x18, 0xd0, 0x17, 0x40, 0x64, 0x7c, 0xf2, 0x07, 0x6d, 0x95, 0x5a, 0x77, 0xe0, 0xd4, 0x94, 0x29,
+    0x77, 0x6b, 0x6a, 0x14, 0xf2, 0x73, 0x27, 0xeb, 0xa2, 0xb1, 0xc3, 0xa6, 0x35, 0x32, 0x36, 0xa3,
+    0xde, 0xa0, 0xa4, 0x46, 0x22, 0xbe, 0x13, 0x08, 0x48, 0x59, 0xea, 0x24, 0xee, 0x2b, 0x4c, 0x9d,
+    0x8e, 0x96, 0xa6, 0xad, 0x70, 0x57, 0x69, 0xd3, 0x3a, 0xe8, 0xce, 0x69, 0x34, 0x2f, 0x12, 0xf2,
+    0x5c, 0xda, 0xbf, 0xc5, 0xe6, 0x93, 0x9c, 0x09, 0x53, 0xd3, 0x9d, 0x37, 0x9d, 0x44, 0xdb, 0xa6,
+    0x53, 0xc9, 0x42, 0xdc, 0xc7, 0xc8, 0x6f, 0x41, 0x0e, 0xc8, 0xdf, 0x9d, 0x20, 0x07, 0x4c, 0xc5,
+    0x96, 0x19, 0xba, 0x82, 0xa7, 0x6d, 0x63, 0x53, 0x9d, 0xe6, 0x4a, 0xae, 0xfd, 0xa0, 0xb1, 0xa7,
+    0x01, 0x11, 0x76, 0x82, 0x29, 0x26, 0x4b, 0x00, 0x3a, 0xf3, 0xac, 0x93, 0x14, 0x65, 0x93, 0x4f,
+    0x37, 0x48, 0xb0, 0x88, 0xb8, 0xa8, 0xe4, 0x2a, 0xd7, 0x1a, 0x86, 0x7d, 0x5b, 0x01, 0x00, 0xd8,
+    0x80, 0xb2, 0xb4, 0xe6, 0x17, 0x89, 0x2d, 0x23, 0x70, 0xcd, 0xad, 0x91, 0x65, 0x1d, 0xa8, 0x8d,
+    0x29, 0x37, 0x2b, 0xa0, 0xa3, 0xa4, 0xb6, 0x63, 0x5f, 0xe3, 0xb4, 0x6e, 0xcc, 0xc8, 0xbd, 0xd3,
+    0x31, 0xb1, 0x95, 0x82, 0xaa, 0x1c, 0xa2, 0xce, 0xa4, 0xad, 0x1a, 0xea, 0x58, 0xaf, 0x29, 0xf9,
+    0xf2, 0x8b, 0x03, 0xb9, 0x8c, 0xaf, 0x43, 0x4e, 0x53, 0xb7, 0x75, 0x33, 0x3a, 0xef, 0x0e, 0x4e,
+    0x6d, 0x4a, 0xdf, 0x9f, 0xb4, 0x91, 0x7e, 0x83, 0x1b, 0x11, 0x6f, 0x68, 0xba, 0x84, 0x20, 0xb8,
+    0x74, 0x47, 0x1b, 0xea, 0x59, 0x9e, 0xf0, 0xb9, 0x39, 0xb1, 0xef, 0xb7, 0x46, 0x23, 0x8c, 0x07,
+    0x0b, 0x8d, 0x4c, 0x84, 0x88, 0xec, 0xdf, 0x7d, 0x2d, 0x4e, 0x87, 0xd6, 0x2f, 0xa4, 0x09, 0xa6,
+    0x58, 0xdf, 0xfb, 0x97, 0xeb, 0xc7, 0xe0, 0x12, 0xf0, 0x0c, 0xff, 0xc2, 0x23, 0xd2, 0xc3, 0x0f,
+    0x6a, 0xe2, 0x3a, 0x78, 0xdb, 0x77, 0xc1, 0xdb, 0xd4, 0xfe, 0xe9, 0xad, 0xe0, 0x0b, 0x41, 0x57,
+    0xb2, 0xa8, 0x11, 0xc6, 0x82, 0x12, 0x4a, 0xb2, 0x6a, 0x66, 0x91, 0x7c, 0xe0, 0xd2, 0x0d, 0x99,
+    0xe8, 0x0f, 0x87, 0x43, 0x4b, 0xd2, 0xd0, 0xce, 0x54, 0xdb, 0x68, 0x07, 0xe9, 0x5a, 0xb7, 0xd2,
+    0xed, 0xfb, 0xe8, 0x7f, 0x3d, 0x3d, 0x7d, 0x4b, 0x9c, 0x27, 0xa2, 0x7d, 0x07, 0xbd, 0x55, 0x1e,
+    0x59, 0xab, 0xc6, 0x5a, 0x28, 0xdf, 0x4c, 0x94, 0x9d, 0xf2, 0x58, 0x84, 0x81, 0x90, 0x93, 0x31,
+    0x09, 0xf0, 0x12, 0x86, 0x41, 0xb4, 0xd0, 0x73, 0xb6, 0x6c, 0x43, 0xe2, 0x2e, 0xfa, 0x4d, 0xbe,
+    0xed, 0x3c, 0x61, 0x13, 0xfb, 0x76, 0x62, 0x03, 0x0b, 0xf4, 0xc5, 0x0c, 0x5c, 0xa4, 0x4a, 0x83,
+    0xb6, 0xa8, 0x36, 0x3f, 0x23, 0x04, 0x98, 0x43, 0x44, 0xbb, 0xad, 0x3a, 0xdb, 0x39, 0x95, 0x67,
+    0xcf, 0x6a, 0xe9, 0xa1, 0x65, 0x73, 0x71, 0x29, 0xd7, 0x2d, 0x99, 0xe4, 0x37, 0x17, 0xaf, 0x43,
+    0x2c, 0xf3, 0x8c, 0xe7, 0x26, 0xc9, 0x8c, 0x33, 0xc8, 0x7f, 0x98, 0x70, 0xf2, 0x9a, 0x0c, 0xcf,
+    0xd9, 0xa0, 0x77, 0x95, 0x52, 0x8f, 0xb3, 0x09, 0xda, 0x75, 0xb0, 0x26, 0x2f, 0xf8, 0x00, 0x92,
+    0x58, 0xf2, 0x3d, 0xde, 0x42, 0xcc, 0x4b, 0x17, 0x03, 0xff, 0x1d, 0x04, 0x3b, 0x13, 0x29, 0xba,
+    0xc9, 0x1f, 0xb3, 0xf4, 0x6e, 0xe4, 0x01, 0x35, 0xb9, 0x88, 0xf8, 0x6d, 0xa7, 0xd0, 0xbe, 0x78,
+    0x9b, 0x39, 0x0a, 0xb7, 0xad, 0x9e, 0x02, 0xea, 0xf3, 0xbf, 0x9b, 0xc6, 0x57, 0xfd, 0xa3, 0xa5,
+    0xd0, 0xac, 0xdd, 0x51, 0xc1, 0xef, 0x0b, 0xf8, 0x9d, 0x39, 0xb5, 0xbc, 0x7f, 0xe1, 0x26, 0x81,
+    0xcf, 0xee, 0x74, 0x6a, 0x58, 0x73, 0x4a, 0x40, 0xe8, 0xda, 0xc1, 0xf5, 0xfa, 0x05, 0xd2, 0x04,
+    0x34, 0xc6, 0x5f, 0xeb, 0x4f, 0x7f, 0x1c, 0xce, 0xd9, 0xd4, 0x40, 0x14, 0x1b, 0x64, 0x3a, 0x05,
+    0x9f, 0x0d, 0xd9, 0x3c, 0x75, 0xc8, 0x0b, 0xe2, 0x04, 0xf9, 0x6d, 0x19, 0x87, 0x80, 0xeb, 0xfa,
+    0xea, 0x0a, 0x8b, 0xb3, 0xd6, 0xe7, 0x6b, 0x3e, 0xaf, 0xef, 0xa2, 0x15, 0x01, 0x71, 0x1f, 0x44,
+    0x6b, 0x56, 0xbd, 0x4d, 0x64, 0x33, 0x0c, 0xf2, 0x7b, 0x8c, 0x61, 0xbb, 0x47, 0xf0, 0x87, 0xe9,
+    0xdf, 0xb1, 0xea, 0xdf, 0x2f, 0xd0, 0xf3, 0xbe, 0x2a, 0xad, 0x40, 0x69, 0x97, 0x5e, 0x3b, 0x2e,
+    0x27, 0x98, 0x37, 0xac, 0x6e, 0x09, 0x0c, 0x86, 0x49, 0x94, 0xe3, 0xdc, 0x0a, 0x1a, 0x6a, 0x97,
+    0xaa, 0xee, 0x31, 0x97, 0x50, 0xe3, 0x6e, 0x8b, 0x43, 0xe5, 0xd0, 0xdb, 0x81, 0x91, 0xe9, 0x69,
+    0x66, 0xe9, 0x0d, 0x30, 0xf2, 0x2e, 0xf6, 0x61, 0xc5, 0x80, 0xdf, 0xea, 0x9b, 0xc3, 0xe2, 0x88,
+    0x50, 0xb5, 0xe0, 0xd0, 0xd6, 0x21, 0xfc, 0xec, 0x33, 0x5e, 0xdc, 0x70, 0x2b, 0xb7, 0x69, 0x08,
+    0x9e, 0xed, 0xab, 0x3b, 0x30, 0x44, 0xde, 0x9c, 0xe9, 0x37, 0x37, 0x4c, 0x69, 0x1c, 0x87, 0x57,
+    0x27, 0xb2, 0xbb, 0xfb, 0xb9, 0xff, 0xd5, 0x56, 0x54, 0x64, 0x6a, 0x66, 0xa4, 0xc9, 0xac, 0xde,
+    0xfa, 0x79, 0xa8, 0xbe, 0x7b, 0xd4, 0x75, 0xb8, 0xdc, 0x89, 0x0d, 0xbb, 0x72, 0xf8, 0x50, 0x4d,
+    0x31, 0xfe, 0xee, 0xeb, 0x67, 0xe9, 0xdf, 0x6c, 0xad, 0x64, 0x94, 0x0d, 0xc6, 0xa1, 0x01, 0x89,
+    0x53, 0xd9, 0xe4, 0x65, 0x02, 0xbf, 0x7a, 0x25, 0xd7, 0x78, 0x6b, 0x15, 0x69, 0x50, 0xf5, 0xe8,
+    0xeb, 0x99, 0xb2, 0x47, 0xad, 0x6d, 0x0d, 0x6a, 0x02, 0xc2, 0x5e, 0xa8, 0x48, 0xe6, 0x1f, 0xd4,
+    0xec, 0x2f, 0xb6, 0xc6, 0x23, 0xec, 0x70, 0x52, 0xf0, 0x90, 0xbf, 0x97, 0x2d, 0xeb, 0x96, 0x73,
+    0x5f, 0xd0, 0x8f, 0x5e, 0xd4, 0xea, 0xe2, 0x4b, 0xdd, 0x7b, 0x4b, 0xc8, 0xc5, 0x32, 0x80, 0x36,
+    0xa5, 0x18, 0xeb, 0xc8, 0xdb, 0xa4, 0xe0, 0xe2, 0x8e, 0xf4, 0x14, 0x90, 0x26, 0x63, 0x93, 0x7b,
+    0x10, 0x52, 0xc9, 0xf6, 0xf7, 0x12, 0x2a, 0x53, 0xaa, 0x41, 0x69, 0x4e, 0xc3, 0x84, 0xdd, 0x75,
+    0x9f, 0xa8, 0xbd, 0xd6, 0x51, 0xf7, 0xea, 0x9c, 0xc9, 0x3f, 0x42, 0x5b, 0x2d, 0xac, 0xdd, 0x43,
+    0x5d, 0xf7, 0xa3, 0x64, 0xd5, 0x97, 0x5d, 0xf3, 0x6b, 0x5b, 0xcc, 0xe5, 0x9e, 0x9b, 0x97, 0x18,
+    0x6d, 0x71, 0x57, 0x75, 0xf0, 0xb6, 0x00, 0x34, 0x2a, 0x9a, 0xdf, 0x69, 0x3e, 0x3b, 0xa5, 0x3b,
+    0x08, 0x56, 0xdc, 0xbb, 0x6a, 0x91, 0x48, 0xb0, 0x15, 0x85, 0x44, 0x1f, 0x2d, 0x5e, 0xe9, 0x65,
+    0xea, 0xe3, 0xc7, 0xc4, 0xd2, 0xda, 0x71, 0x95, 0x45, 0xdf, 0x22, 0xcb, 0xd7, 0xb7, 0x1e, 0x0b,
+    0x42, 0x0b, 0xdd, 0x4d, 0xb9, 0xb8, 0x9d, 0xb4, 0x50, 0x30, 0x2e, 0x91, 0xd5, 0xfc, 0x34, 0x21,
+    0x4f, 0x88, 0x43, 0x12, 0xe7, 0xce, 0x7a, 0x6b, 0x27, 0xe9, 0x0c, 0x06, 0x4e, 0x97, 0xf6, 0xaa,
+    0x9b, 0xfc, 0x6f, 0x21, 0x3d, 0x54, 0xb1, 0xdf, 0x05, 0x43, 0x86, 0x78, 0x43, 0x17, 0x30, 0x87,
+    0x45, 0x44, 0x5f, 0x92, 0x24, 0x41, 0x82, 0x5f, 0x17, 0x23, 0xf4, 0x9c, 0x06, 0x21, 0x1a, 0xaa,
+    0xdf, 0x56, 0xe2, 0xe0, 0x72, 0x51, 0x67, 0x80, 0xfe, 0xef, 0xa9, 0x6e, 0xf2, 0x5b, 0x9d, 0x77,
+    0xbd, 0x9d, 0x66, 0x2f, 0x75, 0x14, 0x47, 0xe4, 0xe6, 0x8a, 0xc7, 0xcc, 0x60, 0xfa, 0x7a, 0x9a,
+    0xbe, 0x9b, 0xd6, 0x9f, 0xb4, 0xaf, 0x7d, 0x6d, 0xbe, 0x29, 0x37, 0xa4, 0xd8, 0x83, 0xdb, 0x58,
+    0xe1, 0x00, 0xbf, 0x6a, 0x9b, 0x67, 0xd9, 0x73, 0x79, 0xf7, 0x59, 0xc0, 0xaf, 0xc1, 0x09, 0x9a,
+    0x54, 0x66, 0xf9, 0x64, 0x42, 0x40, 0xb7, 0x4c, 0xd6, 0x48, 0x68, 0x20, 0x79, 0xe9, 0x9f, 0x40,
+    0xf1, 0xa5, 0x57, 0xe7, 0x26, 0x35, 0x1a, 0xf9, 0xb8, 0x33, 0x04, 0xda, 0x4e, 0x97, 0x48, 0x56,
+    0x30, 0xba, 0xc2, 0x8c, 0x0d, 0x0d, 0x5b, 0x23, 0x92, 0x54, 0x2e, 0x95, 0xe2, 0xf0, 0x53, 0x79,
+    0xf0, 0x30, 0x25, 0x51, 0x16, 0x86, 0x13, 0xcb, 0x21, 0x28, 0x02, 0x99, 0x62, 0xa2, 0x6e, 0x51,
+    0xb5, 0xc3, 0x1c, 0x44, 0xe0, 0x8a, 0x43, 0xd9, 0xe3, 0x84, 0x67, 0xc2, 0x93, 0x75, 0x9e, 0x7c,
+    0x55, 0x50, 0xef, 0x57, 0x26, 0x4a, 0x58, 0xba, 0x8f, 0xb7, 0xf4, 0xcf, 0x69, 0xe8, 0x96, 0xee,
+    0xb2, 0x41, 0xb6, 0x31, 0x86, 0x8a, 0x23, 0x3e, 0xdb, 0x46, 0x96, 0xbc, 0x35, 0x28, 0xcd, 0x5a,
+    0xce, 0xe6, 0x96, 0xb7, 0x7a, 0x6b, 0x26, 0x62, 0x89, 0xa5, 0x4a, 0x52, 0x15, 0xcc, 0x06, 0x61,
+    0xea, 0x5e, 0x91, 0x5a, 0x84, 0x9b, 0x56, 0xff, 0x97, 0x93, 0xa3, 0xc3, 0xa1, 0xdc, 0x26, 0x73,
+    0xd9, 0x10, 0x6a, 0x15, 0x8a, 0x9b, 0xb8, 0x79, 0x0d, 0xfb, 0x11, 0x64, 0x5b, 0x37, 0xbc, 0x0f,
+    0x26, 0xe2, 0x11, 0x8f, 0x19, 0x5e, 0xf1, 0x74, 0xf5, 0x85, 0x25, 0x54, 0x80, 0x21, 0x3f, 0x38,
+    0x71, 0xc8, 0xa8, 0xa8, 0xc8, 0xad, 0x5e, 0x4d, 0x9a, 0x46, 0xc0, 0xd5, 0xb5, 0x65, 0x06, 0x65,
+    0xfe, 0x62, 0x8a, 0x86, 0xd3, 0x41, 0x27, 0x2f, 0xe4, 0xc0, 0x77, 0x5b, 0x70, 0xdc, 0xc7, 0x1e,
+    0x96, 0xe3, 0xdb, 0x14, 0x07, 0x82, 0x1a, 0x5d, 0xc3, 0x35, 0x70, 0x6b, 0xb4, 0x89, 0x81, 0xeb,
+    0xb6, 0xc3, 0x45, 0xfd, 0x5f, 0x59, 0xc8, 0xfb, 0xac, 0xd2, 0x61, 0x55, 0xb9, 0x13, 0x96, 0x81,
+    0x50, 0xba, 0xa9, 0x71, 0xe5, 0xb5, 0x24, 0x67, 0xc2, 0x4c, 0xd9, 0x5a, 0xf1, 0xd5, 0x49, 0xfe,
+    0x85, 0x4c, 0xe3, 0xbe, 0x7a, 0xe3, 0xf2, 0x3a, 0xf0, 0xb2, 0x77, 0x1e, 0xc0, 0x30, 0xf2, 0xb7,
+    0x8c, 0xe1, 0xdd, 0xb8, 0x62, 0x57, 0x99, 0xc9, 0x2f, 0xca, 0x70, 0x3c, 0x35, 0x65, 0x21, 0x56,
+    0xca, 0x31, 0x28, 0x3f, 0xe4, 0xd1, 0x62, 0x10, 0x0b, 0x96, 0x24, 0xcd, 0x92, 0xbd, 0xe9, 0x6b,
+    0x6a, 0xb3, 0x5c, 0x32, 0x05, 0x1e, 0x97, 0x47, 0x54, 0x13, 0x31, 0x94, 0x73, 0x23, 0x7a, 0x43,
+    0x21, 0x43, 0x05, 0x14, 0x00, 0x98, 0xa8, 0xf2, 0x67, 0xf8, 0xb5, 0xc0, 0x53, 0xe4, 0xe6, 0xc6,
+    0x73, 0x4a, 0x1e, 0xe2, 0x5a, 0x77, 0xff, 0xf0, 0xed, 0xbb, 0x53, 0x07, 0x87, 0xe8, 0x86, 0xd3,
+    0xbd, 0x7f, 0x3d, 0xdd, 0x3d, 0xde, 0xdb, 0x35, 0xdb, 0x4e, 0xf6, 0x0e, 0xf6, 0x5e, 0x9e, 0x3a,
+    0x7d, 0x20, 0x8b, 0xa7, 0x8a, 0xc0, 0xe7, 0x2b, 0x36, 0xa7, 0x59, 0x58, 0xb9, 0x4e, 0xbb, 0xde,
+    0x50, 0x79, 0xdc, 0x68, 0xc2, 0x24, 0x21, 0xfb, 0x07, 0x02, 0xf5, 0x00, 0x92, 0x66, 0xea, 0x3f,
+    0x29, 0xb9, 0xc4, 0xe3, 0xe1, 0x9a, 0x52, 0x50, 0x59, 0x67, 0x3c, 0xc5, 0x83, 0x65, 0x7d, 0x28,
+    0x5c, 0x36, 0xf4, 0x6f, 0xa3, 0x31, 0x4d, 0x19, 0x67, 0xa9, 0x6a, 0x4c, 0x05, 0x54, 0x97, 0x7a,
+    0xd4, 0xba, 0xff, 0xc7, 0x77, 0xa7, 0xa7, 0x47, 0x87, 0x76, 0x31, 0xeb, 0xe2, 0x95, 0xae, 0xb1,
+    0xb3, 0xa9, 0xbe, 0xa5, 0xbb, 0xb3, 0xa9, 0xfe, 0x53, 0x97, 0xff, 0x05, 0xfd, 0x52, 0x74, 0x06,
+    0xe5, 0x45, 0x00, 0x00,
+};
+
+#endif // WEB_ASSETS_H
@@ -0,0 +1,177 @@
+#include "Plant.h"
+#include "SimHal.h"
+#include "MotorDriver.h"   // pines MOTOR_*PWM
+#include "Encoder.h"       // pines ENCODER_*
+#include "IRScanner.h"     // pines IR_* y canales
+#include <math.h>
+
+// Mismas posiciones que IR_MOUNTS del sketch (x adelante, y izquierda, cm),
+// en el orden de IRChannel
+struct PlantIrMount {
+    uint8_t pin;
+    float x;
+    float y;
+    float angleRad;
+};
+
+static const PlantIrMount IR_MOUNTS_SIM[IR_CHANNEL_COUNT] = {
+    { IR_LEFT_SIDE_PIN,     0.0f,  30.0f,  (float)(PI / 2) },
+    { IR_FRONT_LEFT_PIN,   25.0f,  15.0f,  0.0f },
+    { IR_BACK_CENTER_PIN, -25.0f,   0.0f,  (float)PI },
+    { IR_FRONT_RIGHT_PIN,  25.0f, -15.0f,  0.0f },
+    { IR_RIGHT_SIDE_PIN,    0.0f, -30.0f, -(float)(PI / 2) },
+};
+
+#define PLANT_IR_PERIOD_US 1000
+
+// Estado de cuadratura (A << 1) | B para la cuenta c: en el orden de
+// QUAD_TABLE de Encoder.cpp (00 -> 01 -> 11 -> 10 suma). La cuenta 0 es 11,
+// el reposo con pull-up que Encoder::init() lee antes del primer flanco.
+static const uint8_t QUAD_SEQUENCE[4] = { 0x0, 0x1, 0x3, 0x2 };
+
+static inline uint8_t quadState(long count) {
+    return QUAD_SEQUENCE[(count + 2) & 3];
+}
+
+void Plant::reset(float xCm, float yCm, float thetaRad) {
+    x = xCm;
+    y = yCm;
+    theta = thetaRad;
+    distanceCm = 0.0f;
+    left = PlantWheel();
+    right = PlantWheel();
+    lastIrUs = 0;
+    uint64_t now = simNowUs();
+    writeQuadrature(0, false, ENCODER_LEFT_A_PIN, ENCODER_LEFT_B_PIN, now);
+    writeQuadrature(0, true, ENCODER_RIGHT_A_PIN, ENCODER_RIGHT_B_PIN, now);
+    minClearanceCm = clearance();
+    updateIr();
+}
+
+void Plant::addSegment(float x0, float y0, float x1, float y1) {
+    world.push_back({ x0, y0, x1, y1 });
+}
+
+void Plant::addBox(float xMin, float yMin, float xMax, float yMax) {
+    addSegment(xMin, yMin, xMax, yMin);
+    addSegment(xMax, yMin, xMax, yMax);
+    addSegment(xMax, yMax, xMin, yMax);
+    addSegment(xMin, yMax, xMin, yMin);
+}
+
+void Plant::step(uint64_t fromUs, uint64_t toUs) {
+    float dtS = (float)(toUs - fromUs) * 1e-6f;
+    double leftFrom = left.position;
+    double rightFrom = right.position;
+
+    stepWheel(left, params.leftKff, simPwm(MOTOR_LEFT_LPWM), simPwm(MOTOR_LEFT_RPWM), dtS);
+    stepWheel(right, params.rightKff, simPwm(MOTOR_RIGHT_LPWM), simPwm(MOTOR_RIGHT_RPWM), dtS);
+    emitEdges(left, false, ENCODER_LEFT_A_PIN, ENCODER_LEFT_B_PIN, leftFrom, fromUs, toUs);
+    emitEdges(right, true, ENCODER_RIGHT_A_PIN, ENCODER_RIGHT_B_PIN, rightFrom, fromUs, toUs);
+
+    // Cinemática diferencial con el rumbo a mitad de paso
+    float dl = (float)(left.position - leftFrom) * (float)PI * params.leftWheelDiameterCm / params.countsPerRev;
+    float dr = (float)(right.position - rightFrom) * (float)PI * params.rightWheelDiameterCm / params.countsPerRev;
+    float ds = 0.5f * (dl + dr);
+    float dth = (dr - dl) / params.wheelBaseCm;
+    float mid = theta + 0.5f * dth;
+    x += ds * cosf(mid);
+    y += ds * sinf(mid);
+    theta += dth;
+    distanceCm += fabsf(ds);
+
+    if (toUs - lastIrUs >= PLANT_IR_PERIOD_US) {
+        lastIrUs = toUs;
+        updateIr();
+        float c = clearance();
+        if (c < minClearanceCm) minClearanceCm = c;
+    }
+}
+
+void Plant::stepWheel(PlantWheel& w, float kff, int fwdPwm, int revPwm, float dtS) {
+    float pwm = (float)(fwdPwm - revPwm);
+    float mag = fabsf(pwm) - params.staticPwm;
+    float target = (mag > 0.0f) ? copysignf(mag / kff, pwm) : 0.0f;
+    float alpha = 1.0f - expf(-dtS / params.motorTauS);
+    float start = w.pps;
+    w.pps += (target - w.pps) * alpha;
+    w.position += 0.5 * (double)(start + w.pps) * (double)dtS;
+}
+
+void Plant::emitEdges(PlantWheel& w, bool mirrored, uint8_t pinA, uint8_t pinB,
+                      double fromPos, uint64_t fromUs, uint64_t toUs) {
+    long target = (long)floor(w.position);
+    double span = w.position - fromPos;
+    while (w.edgeCount != target) {
+        // Cruce de la posición entera k: avanzando lleva a k, retrocediendo a k - 1
+        long k = (target > w.edgeCount) ? w.edgeCount + 1 : w.edgeCount;
+        double frac = (span != 0.0) ? ((double)k - fromPos) / span : 1.0;
+        if (frac < 0.0) frac = 0.0;
+        if (frac > 1.0) frac = 1.0;
+        uint64_t at = fromUs + (uint64_t)(frac * (double)(toUs - fromUs));
+        w.edgeCount = (target > w.edgeCount) ? k : k - 1;
+        writeQuadrature(w.edgeCount, mirrored, pinA, pinB, at);
+    }
+}
+
+void Plant::writeQuadrature(long count, bool mirrored, uint8_t pinA, uint8_t pinB, uint64_t atUs) {
+    uint8_t st = quadState(mirrored ? -count : count);
+    // Solo cambia un canal por cuenta: el otro simSetPin() no hace nada
+    simSetPin(pinA, (st & 0x2) != 0, atUs);
+    simSetPin(pinB, (st & 0x1) != 0, atUs);
+}
+
+void Plant::updateIr() {
+    float c = cosf(theta);
+    float s = sinf(theta);
+    for (uint8_t ch = 0; ch < IR_CHANNEL_COUNT; ++ch) {
+        const PlantIrMount& m = IR_MOUNTS_SIM[ch];
+        float ox = x + m.x * c - m.y * s;
+        float oy = y + m.x * s + m.y * c;
+        float d = rayCast(ox, oy, theta + m.angleRad, params.irMaxRangeCm);
+        if (d < params.irMinRangeCm) d = params.irMinRangeCm;
+        // Inversa de irRawToCentimeters(): d = 17569.7 * adc^-1.2062
+        float adc = powf(d / 17569.7f, -1.0f / 1.2062f);
+        simSetAnalog(m.pin, (int)lroundf(adc) + noise());
+    }
+}
+
+float Plant::rayCast(float ox, float oy, float angle, float maxRange) const {
+    float dx = cosf(angle);
+    float dy = sinf(angle);
+    float best = maxRange;
+    for (const PlantSegment& seg : world) {
+        float ex = seg.x1 - seg.x0;
+        float ey = seg.y1 - seg.y0;
+        float den = dx * ey - dy * ex;
+        if (fabsf(den) < 1e-9f) continue;          // paralelo
+        float wx = seg.x0 - ox;
+        float wy = seg.y0 - oy;
+        float t = (wx * ey - wy * ex) / den;       // a lo largo del rayo
+        float u = (wx * dy - wy * dx) / den;       // a lo largo del segmento
+        if (t >= 0.0f && u >= 0.0f && u <= 1.0f && t < best) best = t;
+    }
+    return best;
+}
+
+float Plant::clearance() const {
+    float best = 1e9f;
+    for (const PlantSegment& seg : world) {
+        float ex = seg.x1 - seg.x0;
+        float ey = seg.y1 - seg.y0;
+        float len2 = ex * ex + ey * ey;
+        float u = (len2 > 0.0f) ? ((x - seg.x0) * ex + (y - seg.y0) * ey) / len2 : 0.0f;
+        u = constrain(u, 0.0f, 1.0f);
+        float px = seg.x0 + u * ex - x;
+        float py = seg.y0 + u * ey - y;
+        float d = sqrtf(px * px + py * py);
+        if (d < best) best = d;
+    }
+    return best;
+}
+
+int Plant::noise() {
+    if (params.irNoiseAdc <= 0) return 0;
+    noiseState = noiseState * 1103515245u + 12345u;
+    return (int)((noiseState >> 16) % (uint32_t)(2 * params.irNoiseAdc + 1)) - params.irNoiseAdc;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#ifndef SIM_PLANT_H
+#define SIM_PLANT_H
+
+#include <stdint.h>
+#include <vector>
+
+// ========================================
+//   PLANTA: ROBOT DIFERENCIAL + SENSORES
+// ========================================
+// Modelo del robot para el simulador, en el mismo marco que Odometry
+// (x adelante, y izquierda, cm; theta antihorario en rad):
+// - Motores: el PWM que escribe el firmware (analogWrite en los pines del
+//   BTS7960, adelante = LPWM) da una velocidad de rueda en régimen
+//   (|PWM| - staticPwm) / kff [cuentas/s], alcanzada con constante de
+//   tiempo motorTauS. Por debajo de staticPwm la rueda no vence la fricción.
+// - Encoders: cada cuenta entera de la rueda cambia A o B en el orden de la
+//   cuadratura, con el instante interpolado dentro del paso; la ISR del
+//   firmware lee el puerto como en la placa. La rueda derecha está montada
+//   en espejo (el firmware la invierte).
+// - IR: rayo desde el montaje de cada sensor contra los segmentos del
+//   mundo; la distancia pasa a ADC con la inversa de irRawToCentimeters()
+//   más ruido uniforme determinista.
+//
+// Los valores por defecto de PlantParams difieren a propósito de los del
+// firmware (base, diámetros, motor derecho más flojo): sin error de modelo
+// la odometría sería perfecta y el error de pose no mediría nada.
+
+struct PlantParams {
+    float wheelBaseCm = 64.2f;           // firmware: WHEEL_BASE_CM 63.5
+    float leftWheelDiameterCm = 15.52f;  // firmware: 15.50 en ambas
+    float rightWheelDiameterCm = 15.44f;
+    float countsPerRev = 6836.0f;        // cuentas 4x por vuelta (DEFAULT_PULSES_PER_REVOLUTION)
+    float leftKff = 0.020f;              // PWM por cuenta/s
+    float rightKff = 0.0212f;
+    float staticPwm = 38.0f;
+    float motorTauS = 0.08f;
+    float irMinRangeCm = 8.0f;           // por debajo la curva del Sharp se dobla: se satura
+    float irMaxRangeCm = 100.0f;         // más allá la salida es la del alcance máximo
+    int irNoiseAdc = 3;                  // ruido ± cuentas ADC
+};
+
+struct PlantSegment {
+    float x0, y0, x1, y1;
+};
+
+struct PlantWheel {
+    float pps = 0.0f;                    // velocidad en cuentas/s (sentido de avance +)
+    double position = 0.0;               // cuentas acumuladas (sentido de avance +)
+    long edgeCount = 0;                  // cuenta entera ya señalada en los pines
+};
+
+class Plant {
+public:
+    PlantParams params;
+
+    void reset(float xCm, float yCm, float thetaRad);
+    void addSegment(float x0, float y0, float x1, float y1);
+    void addBox(float xMin, float yMin, float xMax, float yMax);
+
+    // Hook de SimHal: integra [fromUs, toUs)
+    void step(uint64_t fromUs, uint64_t toUs);
+
+    float getX() const { return x; }
+    float getY() const { return y; }
+    float getTheta() const { return theta; }
+    float getDistanceCm() const { return distanceCm; }
+    // Distancia mínima del centro del robot a un obstáculo desde reset()
+    float getMinClearanceCm() const { return minClearanceCm; }
+    // Cuentas acumuladas por rueda (sentido de avance +), como Encoder::getCount()
+    double getLeftCounts() const { return left.position; }
+    double getRightCounts() const { return right.position; }
+    // Velocidad actual de cada rueda en cuentas/s (sentido de avance +)
+    float getLeftPps() const { return left.pps; }
+    float getRightPps() const { return right.pps; }
+    // Velocidad inicial de las ruedas para el replay de una traza
+    void setWheelRates(float leftPps, float rightPps) { left.pps = leftPps; right.pps = rightPps; }
+
+private:
+    std::vector<PlantSegment> world;
+    float x = 0.0f;
+    float y = 0.0f;
+    float theta = 0.0f;
+    float distanceCm = 0.0f;
+    float minClearanceCm = 1e9f;
+    PlantWheel left;
+    PlantWheel right;
+    uint64_t lastIrUs = 0;
+    uint32_t noiseState = 12345;
+
+    void stepWheel(PlantWheel& w, float kff, int fwdPwm, int revPwm, float dtS);
+    void emitEdges(PlantWheel& w, bool mirrored, uint8_t pinA, uint8_t pinB,
+                   double fromPos, uint64_t fromUs, uint64_t toUs);
+    void writeQuadrature(long count, bool mirrored, uint8_t pinA, uint8_t pinB, uint64_t atUs);
+    void updateIr();
+    float rayCast(float ox, float oy, float angle, float maxRange) const;
+    float clearance() const;
+    int noise();
+};
+
+#endif // SIM_PLANT_H
@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+# ========================================
+#   SKETCH .ino -> .cpp PARA EL SIMULADOR
+# ========================================
+# Hace lo mismo que el preprocesador del IDE de Arduino: añade
+# #include <Arduino.h> y los prototipos de las funciones del sketch antes de
+# la primera definición, para poder compilarlo como C++ normal. Con #line
+# los errores apuntan a las líneas del .ino.
+#
+# Uso (lo llama CMake):
+#     python3 gen_sketch.py AMR_Complete.ino sketch.cpp
+
+import re
+import sys
+
+# Definición de función en columna 0: tipo, nombre, (parámetros) y '{' en la misma línea
+FUNC_DEF = re.compile(r'^([A-Za-z_][\w:<>\*&\s]*?[\s\*&])([A-Za-z_]\w*)\s*\(([^;{}]*)\)\s*\{')
+KEYWORDS = ("if", "while", "for", "switch", "else", "return", "struct", "class", "enum")
+
+
+def main():
+    src_path, out_path = sys.argv[1], sys.argv[2]
+    with open(src_path, encoding="utf-8") as f:
+        lines = f.read().split("\n")
+
+    protos = []
+    first = None
+    in_raw = False
+    for i, line in enumerate(lines):
+        # Los literales R"rawliteral(...)" pueden contener cualquier cosa
+        if 'R"rawliteral(' in line:
+            in_raw = True
+        if in_raw:
+            if ')rawliteral"' in line:
+                in_raw = False
+            continue
+        m = FUNC_DEF.match(line)
+        if not m or m.group(1).split()[0] in KEYWORDS or m.group(2) in KEYWORDS:
+            continue
+        # Los valores por defecto solo pueden ir en una declaración
+        params = re.sub(r'=\s*[^,)]+', '', m.group(3))
+        protos.append("%s%s(%s);" % (m.group(1), m.group(2), params))
+        if first is None:
+            first = i
+
+    if first is None:
+        first = len(lines)
+    path = src_path.replace("\\", "/")
+    out = ["#include <Arduino.h>", '#line 1 "%s"' % path]
+    out += lines[:first]
+    out += protos
+    out.append('#line %d "%s"' % (first + 1, path))
+    out += lines[first:]
+    with open(out_path, "w", encoding="utf-8", newline="\n") as f:
+        f.write("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
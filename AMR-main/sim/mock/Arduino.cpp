@@ -0,0 +1,165 @@
+#include "Arduino.h"
+#include "SimHal.h"
+#include "EEPROM.h"
+#include "Wire.h"
+#include <deque>
+
+EEPROMClass EEPROM;
+TwoWire Wire;
+TwoWire Wire1;
+
+// ========================================
+//            RELOJ VIRTUAL
+// ========================================
+static uint64_t clockUs = 0;
+static uint32_t stepUs = 100;
+static SimStepHook stepHook = nullptr;
+static bool inStep = false;
+
+uint64_t simNowUs() { return clockUs; }
+void simSetStepUs(uint32_t us) { stepUs = us > 0 ? us : 1; }
+void simSetStepHook(SimStepHook hook) { stepHook = hook; }
+
+void simAdvanceUs(uint64_t us) {
+    uint64_t end = clockUs + us;
+    while (clockUs < end) {
+        uint64_t from = clockUs;
+        uint64_t to = std::min<uint64_t>(end, from + stepUs);
+        // Un delay() dentro de una ISR simulada solo mueve el reloj
+        if (stepHook && !inStep) {
+            inStep = true;
+            stepHook(from, to);
+            inStep = false;
+        }
+        clockUs = to;
+    }
+}
+
+unsigned long millis() { return (unsigned long)(clockUs / 1000); }
+unsigned long micros() { return (unsigned long)clockUs; }
+void delay(unsigned long ms) { simAdvanceUs((uint64_t)ms * 1000); }
+void delayMicroseconds(unsigned int us) { simAdvanceUs(us); }
+
+// ========================================
+//         PINES E INTERRUPCIONES
+// ========================================
+volatile uint16_t simPortInput[(SIM_PIN_COUNT + 7) / 8];
+static int analogValue[SIM_PIN_COUNT];
+static int pwmValue[SIM_PIN_COUNT];
+
+struct SimIsr {
+    void (*fn)();
+    int mode;
+};
+static SimIsr isrs[SIM_PIN_COUNT];
+
+int digitalPinToInterrupt(int pin) {
+    return (pin == 2 || pin == 3 || pin == 8) ? pin : NOT_AN_INTERRUPT;
+}
+
+static bool pinLevel(uint8_t pin) {
+    return (simPortInput[digitalPinToPort(pin)] & digitalPinToBitMask(pin)) != 0;
+}
+
+void simSetPin(uint8_t pin, bool level, uint64_t atUs) {
+    if (pin >= SIM_PIN_COUNT) return;
+    bool prev = pinLevel(pin);
+    if (level == prev) return;
+    if (level) simPortInput[digitalPinToPort(pin)] |= digitalPinToBitMask(pin);
+    else simPortInput[digitalPinToPort(pin)] &= ~digitalPinToBitMask(pin);
+    if (atUs > clockUs) clockUs = atUs;
+
+    const SimIsr& isr = isrs[pin];
+    if (!isr.fn) return;
+    if (isr.mode == CHANGE || (isr.mode == RISING && level) || (isr.mode == FALLING && !level)) isr.fn();
+}
+
+void attachInterrupt(int interrupt, void (*isr)(), int mode) {
+    if (interrupt < 0 || interrupt >= SIM_PIN_COUNT) return;
+    isrs[interrupt].fn = isr;
+    isrs[interrupt].mode = mode;
+}
+
+void detachInterrupt(int interrupt) {
+    if (interrupt < 0 || interrupt >= SIM_PIN_COUNT) return;
+    isrs[interrupt].fn = nullptr;
+}
+
+void pinMode(int pin, int mode) {
+    // INPUT_PULLUP: reposo a nivel alto, como en la placa
+    if (pin >= 0 && pin < SIM_PIN_COUNT && mode == INPUT_PULLUP)
+        simPortInput[digitalPinToPort(pin)] |= digitalPinToBitMask(pin);
+}
+
+int digitalRead(int pin) {
+    if (pin < 0 || pin >= SIM_PIN_COUNT) return LOW;
+    return pinLevel((uint8_t)pin) ? HIGH : LOW;
+}
+
+void digitalWrite(int pin, int value) {
+    if (pin < 0 || pin >= SIM_PIN_COUNT) return;
+    pwmValue[pin] = (value != LOW) ? 255 : 0;
+}
+
+void simSetAnalog(uint8_t pin, int value) {
+    if (pin < SIM_PIN_COUNT) analogValue[pin] = constrain(value, 0, 1023);
+}
+
+int analogRead(int pin) {
+    if (pin < 0 || pin >= SIM_PIN_COUNT) return 0;
+    return analogValue[pin];
+}
+
+void analogWrite(int pin, int value) {
+    if (pin < 0 || pin >= SIM_PIN_COUNT) return;
+    pwmValue[pin] = constrain(value, 0, 255);
+}
+
+int simPwm(uint8_t pin) {
+    return pin < SIM_PIN_COUNT ? pwmValue[pin] : 0;
+}
+
+// Generador determinista: misma semilla, misma ejecución
+static uint32_t randomState = 1;
+
+void randomSeed(unsigned long seed) { randomState = seed ? (uint32_t)seed : 1; }
+
+long random(long howBig) {
+    if (howBig <= 0) return 0;
+    randomState = randomState * 1664525u + 1013904223u;
+    return (long)((randomState >> 8) % (uint32_t)howBig);
+}
+
+long random(long howSmall, long howBig) {
+    if (howSmall >= howBig) return howSmall;
+    return howSmall + random(howBig - howSmall);
+}
+
+// ========================================
+//                SERIAL
+// ========================================
+HardwareSerial Serial;
+static std::deque<char> serialIn;
+static bool serialEcho = true;
+
+void simSetSerialEcho(bool on) { serialEcho = on; }
+
+void simSerialInput(const char* text) {
+    while (*text) serialIn.push_back(*text++);
+}
+
+int HardwareSerial::available() { return (int)serialIn.size(); }
+
+int HardwareSerial::read() {
+    if (serialIn.empty()) return -1;
+    char c = serialIn.front();
+    serialIn.pop_front();
+    return (uint8_t)c;
+}
+
+int HardwareSerial::peek() { return serialIn.empty() ? -1 : (uint8_t)serialIn.front(); }
+
+size_t HardwareSerial::write(uint8_t c) {
+    if (serialEcho) fputc(c, stdout);
+    return 1;
+}
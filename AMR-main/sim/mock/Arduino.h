@@ -0,0 +1,257 @@
+#pragma once
+
+#ifndef SIM_ARDUINO_H
+#define SIM_ARDUINO_H
+
+// ========================================
+//   NÚCLEO ARDUINO SIMULADO (HOST)
+// ========================================
+// Lo justo del core de Arduino para compilar el sketch en el PC. No define
+// __AVR__ ni ARDUINO_ARCH_RENESAS, así que el firmware toma sus ramas
+// genéricas: PWM con analogWrite(), Scheduler por sondeo de micros() e
+// IRScanner::service() con analogRead().
+//
+// El tiempo es virtual (ver SimHal.h): millis()/micros() solo avanzan
+// cuando el arnés avanza el reloj o el firmware llama a delay(). Las
+// "interrupciones" de attachInterrupt() las dispara el modelo de planta al
+// cambiar un pin, siempre fuera de las funciones del firmware, así que
+// noInterrupts()/interrupts() no necesitan hacer nada.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <strings.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <ctype.h>
+#include <algorithm>
+#include <string>
+
+using std::min;
+using std::max;
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#ifndef PI
+#define PI 3.14159265358979323846
+#endif
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+
+// Pines analógicos con la numeración del UNO (A0 = 14)
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+#define A4 18
+#define A5 19
+#define SIM_PIN_COUNT 20
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// ---- Flash: en el host todo es RAM ----
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(p) (*(const uint8_t*)(p))
+#define pgm_read_word(p) (*(const uint16_t*)(p))
+#define pgm_read_dword(p) (*(const uint32_t*)(p))
+#define pgm_read_float(p) (*(const float*)(p))
+#define pgm_read_ptr(p) (*(void* const*)(p))
+#define memcpy_P memcpy
+#define strcmp_P strcmp
+#define strncmp_P strncmp
+#define strlen_P strlen
+#define strcpy_P strcpy
+
+// ---- Puertos: 8 pines por puerto, registros de entrada que escribe la planta ----
+extern volatile uint16_t simPortInput[(SIM_PIN_COUNT + 7) / 8];
+#define digitalPinToPort(P) ((P) / 8)
+#define digitalPinToBitMask(P) (1u << ((P) % 8))
+#define portInputRegister(port) (&simPortInput[port])
+#define NOT_AN_INTERRUPT -1
+
+// Mismos pines con interrupción externa que el UNO R4 para los encoders
+// (2, 3 y 8; el 9 no), así la rueda derecha decodifica en 2x como en la placa
+int digitalPinToInterrupt(int pin);
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+void pinMode(int pin, int mode);
+int digitalRead(int pin);
+void digitalWrite(int pin, int value);
+int analogRead(int pin);
+void analogWrite(int pin, int value);
+
+void attachInterrupt(int interrupt, void (*isr)(), int mode);
+void detachInterrupt(int interrupt);
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+long random(long howBig);
+long random(long howSmall, long howBig);
+void randomSeed(unsigned long seed);
+
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+// ========================================
+//         PRINT / STREAM / STRING
+// ========================================
+class String;
+class Printable;
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buf, size_t n) {
+        size_t k = 0;
+        while (n--) k += write(*buf++);
+        return k;
+    }
+    size_t write(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+    size_t write(const char* s, size_t n) { return write((const uint8_t*)s, n); }
+    virtual int availableForWrite() { return 64; }
+    virtual void flush() {}
+
+    size_t print(const __FlashStringHelper* s) { return write(reinterpret_cast<const char*>(s)); }
+    size_t print(const char* s) { return write(s); }
+    size_t print(const String& s);
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char v, int base = 10) { return print((unsigned long)v, base); }
+    size_t print(int v, int base = 10) { return print((long)v, base); }
+    size_t print(unsigned int v, int base = 10) { return print((unsigned long)v, base); }
+    size_t print(long v, int base = 10) {
+        char b[34];
+        snprintf(b, sizeof(b), base == 16 ? "%lx" : "%ld", v);
+        return write(b);
+    }
+    size_t print(unsigned long v, int base = 10) {
+        char b[34];
+        snprintf(b, sizeof(b), base == 16 ? "%lx" : "%lu", v);
+        return write(b);
+    }
+    size_t print(double v, int digits = 2) {
+        char b[48];
+        snprintf(b, sizeof(b), "%.*f", digits, v);
+        return write(b);
+    }
+    size_t print(const Printable& p);
+
+    size_t println() { return write("\r\n"); }
+    template <typename T> size_t println(T v) { size_t n = print(v); return n + println(); }
+    template <typename T> size_t println(T v, int fmt) { size_t n = print(v, fmt); return n + println(); }
+};
+
+class Printable {
+public:
+    virtual ~Printable() {}
+    virtual size_t printTo(Print& p) const = 0;
+};
+
+inline size_t Print::print(const Printable& p) { return p.printTo(*this); }
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() { return -1; }
+    void setTimeout(unsigned long ms) { timeoutMs = ms; }
+    size_t readBytes(char* buf, size_t n) {
+        size_t k = 0;
+        while (k < n && available() > 0) buf[k++] = (char)read();
+        return k;
+    }
+    String readStringUntil(char terminator);
+
+protected:
+    unsigned long timeoutMs = 1000;
+};
+
+class String {
+private:
+    std::string s;
+
+public:
+    String() {}
+    String(const char* c) : s(c ? c : "") {}
+    String(const __FlashStringHelper* f) : s(reinterpret_cast<const char*>(f)) {}
+    String(const std::string& x) : s(x) {}
+    explicit String(char c) : s(1, c) {}
+    String(int v) : s(std::to_string(v)) {}
+    String(unsigned int v) : s(std::to_string(v)) {}
+    String(long v) : s(std::to_string(v)) {}
+    String(unsigned long v) : s(std::to_string(v)) {}
+    String(double v, int digits = 2) {
+        char b[48];
+        snprintf(b, sizeof(b), "%.*f", digits, v);
+        s = b;
+    }
+
+    String& operator+=(const String& o) { s += o.s; return *this; }
+    String& operator+=(const char* o) { s += o; return *this; }
+    String& operator+=(char c) { s += c; return *this; }
+    friend String operator+(const String& a, const String& b) { return String(a.s + b.s); }
+    friend String operator+(const char* a, const String& b) { return String(std::string(a) + b.s); }
+    friend String operator+(const String& a, const char* b) { return String(a.s + b); }
+    bool operator==(const char* o) const { return s == o; }
+    char operator[](unsigned int i) const { return i < s.size() ? s[i] : 0; }
+
+    unsigned int length() const { return (unsigned int)s.size(); }
+    const char* c_str() const { return s.c_str(); }
+    long toInt() const { return atol(s.c_str()); }
+    void toLowerCase() { for (auto& c : s) c = (char)tolower((unsigned char)c); }
+    int indexOf(char c) const { size_t p = s.find(c); return p == std::string::npos ? -1 : (int)p; }
+    int indexOf(const char* x) const { size_t p = s.find(x); return p == std::string::npos ? -1 : (int)p; }
+    int indexOf(const String& x) const { return indexOf(x.c_str()); }
+    String substring(unsigned int from, unsigned int to) const {
+        if (from > s.size()) return String();
+        if (to > s.size()) to = (unsigned int)s.size();
+        return String(s.substr(from, to - from));
+    }
+};
+
+inline size_t Print::print(const String& s) { return write(s.c_str()); }
+
+inline String Stream::readStringUntil(char terminator) {
+    std::string r;
+    while (available() > 0) {
+        int c = read();
+        if (c == terminator) break;
+        r += (char)c;
+    }
+    return String(r);
+}
+
+// Serial: la salida va a stdout (o se descarta, ver simSetSerialEcho) y la
+// entrada sale de la cola que llena el arnés con simSerialInput()
+class HardwareSerial : public Stream {
+public:
+    void begin(unsigned long) {}
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t write(uint8_t c) override;
+    using Print::write;
+    int availableForWrite() override { return 256; }
+    explicit operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
+
+#endif // SIM_ARDUINO_H
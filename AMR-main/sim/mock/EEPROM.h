@@ -0,0 +1,25 @@
+#pragma once
+
+#ifndef SIM_EEPROM_H
+#define SIM_EEPROM_H
+
+#include <stdint.h>
+#include <string.h>
+
+// EEPROM de 8 KB como la del UNO R4, borrada (0xFF) en cada arranque del
+// simulador: el firmware graba sus rutas y calibración de fábrica
+class EEPROMClass {
+private:
+    uint8_t mem[8192];
+
+public:
+    EEPROMClass() { memset(mem, 0xFF, sizeof(mem)); }
+    uint8_t read(int addr) const { return (addr >= 0 && addr < (int)sizeof(mem)) ? mem[addr] : 0xFF; }
+    void write(int addr, uint8_t v) { if (addr >= 0 && addr < (int)sizeof(mem)) mem[addr] = v; }
+    void update(int addr, uint8_t v) { write(addr, v); }
+    uint16_t length() const { return sizeof(mem); }
+};
+
+extern EEPROMClass EEPROM;
+
+#endif // SIM_EEPROM_H
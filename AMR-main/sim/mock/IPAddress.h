@@ -0,0 +1,25 @@
+#pragma once
+
+#ifndef SIM_IPADDRESS_H
+#define SIM_IPADDRESS_H
+
+#include "Arduino.h"
+
+class IPAddress : public Printable {
+private:
+    uint8_t octets[4] = { 0, 0, 0, 0 };
+
+public:
+    IPAddress() {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+        octets[0] = a; octets[1] = b; octets[2] = c; octets[3] = d;
+    }
+    uint8_t operator[](int i) const { return octets[i & 3]; }
+    size_t printTo(Print& p) const override {
+        char s[16];
+        snprintf(s, sizeof(s), "%u.%u.%u.%u", octets[0], octets[1], octets[2], octets[3]);
+        return p.print(s);
+    }
+};
+
+#endif // SIM_IPADDRESS_H
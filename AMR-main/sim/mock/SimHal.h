@@ -0,0 +1,60 @@
+#pragma once
+
+#ifndef SIM_HAL_H
+#define SIM_HAL_H
+
+#include <stdint.h>
+#include <string>
+
+// ========================================
+//   HARDWARE SIMULADO: API DEL ARNÉS
+// ========================================
+// Lo que el arnés (sim_main.cpp) y el modelo de planta ven del núcleo
+// simulado. El firmware no incluye este fichero.
+//
+// Reloj virtual en µs. simAdvanceUs() lo avanza en pasos de como mucho
+// simStepUs y, en cada paso, llama al hook de la planta con el intervalo
+// [desde, hasta): la planta integra la física y genera los flancos de
+// encoder con simSetPin() dentro de ese intervalo. delay() del firmware
+// usa el mismo camino, así que el robot sigue moviéndose durante un delay.
+
+typedef void (*SimStepHook)(uint64_t fromUs, uint64_t toUs);
+
+uint64_t simNowUs();
+void simAdvanceUs(uint64_t us);
+void simSetStepUs(uint32_t us);
+void simSetStepHook(SimStepHook hook);
+
+// Pin digital de entrada a nivel 'level' en el instante atUs (dentro del
+// paso en curso, no decreciente). Actualiza el registro del puerto y, si el
+// pin tiene ISR con ese flanco, la ejecuta con micros() == atUs.
+void simSetPin(uint8_t pin, bool level, uint64_t atUs);
+
+// Valor que devolverá analogRead(pin) (0..1023)
+void simSetAnalog(uint8_t pin, int value);
+
+// Último valor de analogWrite(pin) (0..255)
+int simPwm(uint8_t pin);
+
+// Serial del firmware: eco a stdout on/off; entrada de comandos
+void simSetSerialEcho(bool on);
+void simSerialInput(const char* text);
+
+// ========================================
+//          CLIENTE HTTP SIMULADO
+// ========================================
+// simHttpBegin() deja una conexión pendiente que el WiFiServer del firmware
+// devolverá en su siguiente available(). La respuesta se acumula hasta que
+// el firmware cierra la conexión (stop()). Uso típico:
+//     int id = simHttpBegin("GET /route_status HTTP/1.1\r\n\r\n");
+//     while (!simHttpDone(id)) { simAdvanceUs(step); loop(); }
+//     std::string resp = simHttpTake(id);
+int simHttpBegin(const std::string& request);
+bool simHttpDone(int id);
+std::string simHttpTake(int id);
+
+// Datagramas UDP enviados por el firmware (WiFiUDP), en orden; false si no
+// queda ninguno
+bool simUdpTake(std::string& out);
+
+#endif // SIM_HAL_H
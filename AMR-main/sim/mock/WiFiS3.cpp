@@ -0,0 +1,112 @@
+#include "WiFiS3.h"
+#include "SimHal.h"
+#include <deque>
+#include <map>
+
+WiFiClass WiFi;
+
+struct SimConnection {
+    std::string rx;          // petición del arnés (la lee el firmware)
+    size_t rxPos = 0;
+    std::string tx;          // respuesta del firmware
+    bool closed = false;     // el firmware llamó a stop()
+};
+
+static std::deque<std::shared_ptr<SimConnection>> pendingAccept;
+static std::map<int, std::shared_ptr<SimConnection>> connections;
+static int nextConnectionId = 1;
+
+int simHttpBegin(const std::string& request) {
+    auto c = std::make_shared<SimConnection>();
+    c->rx = request;
+    int id = nextConnectionId++;
+    connections[id] = c;
+    pendingAccept.push_back(c);
+    return id;
+}
+
+bool simHttpDone(int id) {
+    auto it = connections.find(id);
+    return it == connections.end() || it->second->closed;
+}
+
+std::string simHttpTake(int id) {
+    auto it = connections.find(id);
+    if (it == connections.end()) return std::string();
+    std::string out;
+    out.swap(it->second->tx);
+    if (it->second->closed) connections.erase(it);
+    return out;
+}
+
+WiFiClient WiFiServer::available() {
+    if (pendingAccept.empty()) return WiFiClient();
+    WiFiClient client(pendingAccept.front());
+    pendingAccept.pop_front();
+    return client;
+}
+
+int WiFiClient::available() {
+    if (!conn || conn->closed) return 0;
+    return (int)(conn->rx.size() - conn->rxPos);
+}
+
+int WiFiClient::read() {
+    if (available() <= 0) return -1;
+    return (uint8_t)conn->rx[conn->rxPos++];
+}
+
+int WiFiClient::peek() {
+    if (available() <= 0) return -1;
+    return (uint8_t)conn->rx[conn->rxPos];
+}
+
+size_t WiFiClient::write(uint8_t c) {
+    if (!conn || conn->closed) return 0;
+    conn->tx.push_back((char)c);
+    return 1;
+}
+
+size_t WiFiClient::write(const uint8_t* buf, size_t n) {
+    if (!conn || conn->closed) return 0;
+    conn->tx.append((const char*)buf, n);
+    return n;
+}
+
+// El arnés no cierra su lado: la conexión vive hasta que el firmware la suelta
+uint8_t WiFiClient::connected() {
+    return (conn && !conn->closed) ? 1 : 0;
+}
+
+void WiFiClient::stop() {
+    if (conn) conn->closed = true;
+    conn.reset();
+}
+
+static std::deque<std::string> udpSent;
+
+size_t WiFiUDP::write(uint8_t c) {
+    if (!open) return 0;
+    packet.push_back((char)c);
+    return 1;
+}
+
+size_t WiFiUDP::write(const uint8_t* buf, size_t n) {
+    if (!open) return 0;
+    packet.append((const char*)buf, n);
+    return n;
+}
+
+int WiFiUDP::endPacket() {
+    if (!open) return 0;
+    open = false;
+    udpSent.push_back(packet);
+    return 1;
+}
+
+bool simUdpTake(std::string& out) {
+    if (udpSent.empty()) return false;
+    out.swap(udpSent.front());
+    udpSent.pop_front();
+    return true;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#ifndef SIM_WIFIS3_H
+#define SIM_WIFIS3_H
+
+#include "Arduino.h"
+#include "IPAddress.h"
+#include <memory>
+#include <string>
+
+// ========================================
+//      WIFI S3 SIMULADO (AP + TCP + UDP)
+// ========================================
+// WiFiClient es un asa (copiable, como en WiFiS3) sobre una conexión en
+// memoria: lo que escribe el firmware se acumula para el arnés y lo que
+// lee sale de la petición que el arnés encoló con simHttpBegin().
+// WiFiUDP solo envía: cada endPacket() deja el datagrama en una cola que
+// el arnés vacía con simUdpTake().
+
+#define WL_IDLE_STATUS 0
+#define WL_CONNECTED 3
+#define WL_CONNECT_FAILED 4
+#define WL_AP_LISTENING 7
+
+struct SimConnection;
+
+class WiFiClient : public Stream {
+private:
+    std::shared_ptr<SimConnection> conn;
+
+public:
+    WiFiClient() {}
+    explicit WiFiClient(const std::shared_ptr<SimConnection>& c) : conn(c) {}
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buf, size_t n) override;
+    using Print::write;
+    int availableForWrite() override { return conn ? 4096 : 0; }
+
+    uint8_t connected();
+    void stop();
+    explicit operator bool() const { return conn != nullptr; }
+    bool operator==(const WiFiClient& o) const { return conn == o.conn; }
+    bool operator!=(const WiFiClient& o) const { return conn != o.conn; }
+};
+
+class WiFiServer {
+public:
+    explicit WiFiServer(int port) : port(port) {}
+    void begin() {}
+    WiFiClient available();
+    WiFiClient accept() { return available(); }
+
+private:
+    int port;
+};
+
+class WiFiUDP : public Print {
+private:
+    std::string packet;
+    bool open = false;
+
+public:
+    uint8_t begin(uint16_t) { return 1; }
+    int beginPacket(IPAddress, uint16_t) { packet.clear(); open = true; return 1; }
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buf, size_t n) override;
+    using Print::write;
+    int endPacket();
+    int parsePacket() { return 0; }
+};
+
+class WiFiClass {
+public:
+    int disconnect() { return 0; }
+    int beginAP(const char*, const char*) { return WL_AP_LISTENING; }
+    int begin(const char*, const char*) { return WL_CONNECTED; }
+    int status() { return WL_AP_LISTENING; }
+    IPAddress localIP() { return IPAddress(192, 168, 4, 1); }
+    IPAddress subnetMask() { return IPAddress(255, 255, 255, 0); }
+};
+
+extern WiFiClass WiFi;
+
+#endif // SIM_WIFIS3_H
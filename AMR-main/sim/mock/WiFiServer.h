@@ -0,0 +1,4 @@
+#pragma once
+
+// En WiFiS3 WiFiServer vive en su propia cabecera; aquí todo está en WiFiS3.h
+#include "WiFiS3.h"
@@ -0,0 +1,26 @@
+#pragma once
+
+#ifndef SIM_WIRE_H
+#define SIM_WIRE_H
+
+#include "Arduino.h"
+
+// Bus I2C sin dispositivos: toda transmisión acaba en NACK, así que la IMU
+// no se detecta y el firmware gira y estima rumbo solo con los encoders
+class TwoWire : public Stream {
+public:
+    void begin() {}
+    void setClock(unsigned long) {}
+    void beginTransmission(uint8_t) {}
+    uint8_t endTransmission(bool = true) { return 2; }
+    uint8_t requestFrom(uint8_t, uint8_t) { return 0; }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    size_t write(uint8_t) override { return 1; }
+    using Print::write;
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
+
+#endif // SIM_WIRE_H
@@ -0,0 +1,4 @@
+#pragma once
+
+// PROGMEM y pgm_read_* ya los define Arduino.h (en el host no hay flash)
+#include "../Arduino.h"
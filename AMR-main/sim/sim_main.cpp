@@ -0,0 +1,647 @@
+// ========================================
+//   SIMULADOR DEL FIRMWARE EN EL PC (HOST)
+// ========================================
+// Ejecuta AMR_Complete.ino sin cambios (setup() + loop()) contra el núcleo
+// simulado de mock/ y el modelo de planta de Plant.h, en tiempo virtual y
+// mucho más rápido que en tiempo real. Cada escenario arranca una ruta por
+// la API HTTP igual que el dashboard (/start_route, /confirm_route,
+// /route_status) o, si es de teleoperación, abre POST /teleop con un lote
+// de consignas, y mide:
+//   time_s         duración de la ruta (hasta DONE, o hasta esperar el retorno)
+//   odom_err_cm    |pose de Odometry - pose real| al terminar
+//   odom_err_deg   error de rumbo de Odometry
+//   goal_err_cm    |pose real - último waypoint|
+//   clearance_cm   distancia mínima a un obstáculo
+//   fleet_hz       tramas de flota (UDP) por segundo durante la ruta
+//   hold_drift_cm  avance mientras el coordinador lo retiene (/fleet?hold=1)
+//   stall_drift_cm avance con loop() bloqueado (solo corre el tick del timer)
+//   deadman_late_ms ruedas paradas respecto a la hora del hombre muerto del
+//                  lote (Teleop::deadmanAtMs()) con loop() bloqueado
+//   speedup        tiempo simulado / tiempo de CPU del host
+// Si alguna métrica sale de los límites del escenario, el código de salida
+// es 1: sirve como prueba de regresión tras tocar control, odometría o rutas.
+//
+// Compilar y ejecutar (ver CMakeLists.txt):
+//     cmake -S sim -B build-sim && cmake --build build-sim
+//     ./build-sim/amr_sim                (todos los escenarios)
+//     ./build-sim/amr_sim -v route_a     (uno, con la salida Serial del firmware)
+//     ./build-sim/amr_sim --trace a.csv route_a
+//     ./build-sim/amr_sim --dump-trace a.bin route_a   (GET /trace al acabar)
+//     ./build-sim/amr_sim --replay robot.bin [--trace r.csv]
+//
+// Replay: una traza del flight-recorder (GET /trace o comando 'G' del robot
+// real, TelemetryProtocol.h) se reproduce en lazo abierto sobre la planta:
+// el PWM grabado mueve las ruedas del modelo y se compara con las cuentas de
+// encoder grabadas. No ejecuta el firmware; sirve para ajustar PlantParams
+// (kff, staticPwm, motorTauS) contra el robot real y para ver si un fallo
+// grabado se reproduce con el modelo.
+//
+// Perfilado: el ejecutable es código nativo, así que vale cualquier
+// perfilador del host (perf record ./amr_sim route_e, o -DAMR_SIM_GPROF=ON).
+// Perf.h sigue compilado pero mide 0 µs: el reloj virtual no avanza
+// mientras corre el firmware.
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "SimHal.h"
+#include "Plant.h"
+#include "Odometry.h"
+#include "MotorDriver.h"
+#include "TelemetryProtocol.h"
+#include "Scheduler.h"
+#include "Teleop.h"
+#include <vector>
+
+// Sketch (sketch.cpp generado desde AMR_Complete.ino)
+void setup();
+void loop();
+extern Odometry odometry;
+extern Scheduler scheduler;
+extern Teleop teleop;
+
+#define SIM_STEP_US 100                 // paso de la planta y de loop()
+#define SIM_STATUS_PERIOD_US 100000ULL  // sondeo de /route_status (como la página de rutas)
+#define SIM_TRACE_PERIOD_US 50000ULL
+#define SIM_HTTP_TIMEOUT_US 2000000ULL
+#define SIM_REPLAY_STEP_US 1000ULL
+#define SIM_MIN_FLEET_HZ 18.0f          // difusión de flota nominal: 20 Hz
+#define SIM_HOLD_SETTLE_S 0.5f          // frenada tras /fleet?hold=1 antes de medir la deriva
+#define SIM_MAX_HOLD_DRIFT_CM 1.0f      // subpaso de la planta entre registros de la traza
+#define SIM_MAX_STALL_DRIFT_CM 10.0f    // 50 ms sin consigna + frenada a 800 mm/s² desde crucero (~8 cm; sin vigilancia, 30)
+// Lote de teleoperación a 300 mm/s en línea recta, 280 ms de consignas
+#define SIM_TELEOP_BATCH "0,300,0;40,300,0;80,300,0;120,300,0;160,300,0;200,300,0;240,300,0;280,300,0"
+#define SIM_TELEOP_REST_PPS 70.0f       // rueda parada: < 0.5 cm/s
+#define SIM_MAX_DEADMAN_LATE_MS 200.0f  // frenada del PID con consigna 0 (~180 ms; solo con la vigilancia de consigna, 255)
+
+struct ScenarioBox {
+    float xMin, yMin, xMax, yMax;
+};
+
+struct Scenario {
+    const char* name;
+    const char* description;
+    int routeIndex;          // -1: teleoperación (POST /teleop) en lugar de ruta
+    bool withReturn;         // confirmar el retorno tras la IDA
+    float goalX, goalY;      // donde debe acabar el robot (cm)
+    const ScenarioBox* boxes;
+    int boxCount;
+    // Límites de regresión
+    float maxTimeS;
+    float maxOdomErrCm;
+    float maxOdomErrDeg;
+    float maxGoalErrCm;
+    float minClearanceCm;
+    // Coordinador de flota: retener el robot holdForS segundos a partir de
+    // holdAtS (0 = sin retención)
+    float holdAtS = 0.0f;
+    float holdForS = 0.0f;
+    // loop() bloqueado stallForS segundos a partir de stallAtS (p.ej. una
+    // escritura WiFi que no vuelve): solo corren las tareas de la ISR. En
+    // teleoperación stallAtS cuenta desde el envío del lote
+    float stallAtS = 0.0f;
+    float stallForS = 0.0f;
+};
+
+// /fleet con algún parámetro inválido (fuera de rango o no numérico)
+static const char* const SIM_BAD_FLEET_ORDERS[] = {
+    "/fleet?hold=1&lease=99999",
+    "/fleet?hold=yes",
+    "/fleet?hold=1x",
+    "/fleet?hold=1&lease=abc",
+    "/fleet?hold=1&route=abc",
+    "/fleet?lease=500&route=99",
+};
+
+// Caja en el primer tramo de Ruta E (de (0,0) a (0,200) cm)
+static const ScenarioBox ROUTE_E_OBSTACLE[] = {
+    { -15.0f, 95.0f, 15.0f, 125.0f },
+};
+
+static const Scenario SCENARIOS[] = {
+    { "route_a", "Ruta A ida y vuelta (30 cm por tramo)",
+      0, true, 0.0f, 0.0f, nullptr, 0,
+      25.0f, 5.0f, 8.0f, 8.0f, 0.0f },
+    { "route_e", "Ruta E ida (2 x 200 cm)",
+      4, false, 200.0f, 200.0f, nullptr, 0,
+      30.0f, 12.0f, 5.0f, 15.0f, 0.0f },
+    { "route_e_obstacle", "Ruta E ida con una caja en el primer tramo",
+      4, false, 200.0f, 200.0f, ROUTE_E_OBSTACLE, 1,
+      60.0f, 15.0f, 6.0f, 20.0f, 32.0f },   // clearance: medio ancho del robot
+    { "route_e_hold", "Ruta E ida, retenida 3 s por el coordinador en el primer tramo",
+      4, false, 200.0f, 200.0f, nullptr, 0,
+      35.0f, 12.0f, 5.0f, 15.0f, 0.0f, 3.0f, 3.0f },
+    { "route_e_stall", "Ruta E ida con loop() bloqueado 1 s en crucero",
+      4, false, 200.0f, 200.0f, nullptr, 0,
+      35.0f, 12.0f, 5.0f, 15.0f, 0.0f, 0.0f, 0.0f, 5.0f, 1.0f },
+    { "teleop_stall", "Teleoperación a 300 mm/s con loop() bloqueado 2 s antes del hombre muerto",
+      -1, false, 0.0f, 0.0f, nullptr, 0,
+      0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.2f, 2.0f },
+};
+static const int SCENARIO_COUNT = sizeof(SCENARIOS) / sizeof(SCENARIOS[0]);
+
+static Plant plant;
+
+static void plantStep(uint64_t fromUs, uint64_t toUs) {
+    plant.step(fromUs, toUs);
+}
+
+static void runFor(uint64_t us) {
+    uint64_t end = simNowUs() + us;
+    while (simNowUs() < end) {
+        simAdvanceUs(SIM_STEP_US);
+        loop();
+    }
+}
+
+// loop() bloqueado: el tick del timer sigue ejecutando las tareas de tiempo
+// real (en el mock el scheduler va por sondeo, así que se le da el tick a mano)
+static void stallFor(uint64_t us) {
+    uint64_t end = simNowUs() + us;
+    while (simNowUs() < end) {
+        simAdvanceUs(SCHED_TICK_US);
+        scheduler.tick();
+    }
+}
+
+// Petición completa: avanza la simulación hasta que el firmware cierra
+static std::string httpGet(const char* target) {
+    std::string req = std::string("GET ") + target + " HTTP/1.1\r\nHost: 192.168.4.1\r\n\r\n";
+    int id = simHttpBegin(req);
+    uint64_t deadline = simNowUs() + SIM_HTTP_TIMEOUT_US;
+    while (!simHttpDone(id) && simNowUs() < deadline) {
+        simAdvanceUs(SIM_STEP_US);
+        loop();
+    }
+    return simHttpTake(id);
+}
+
+static long jsonInt(const std::string& body, const char* key) {
+    std::string k = std::string("\"") + key + "\":";
+    size_t p = body.find(k);
+    if (p == std::string::npos) return -1;
+    return strtol(body.c_str() + p + k.size(), nullptr, 10);
+}
+
+static float wrapDeg(float deg) {
+    while (deg > 180.0f) deg -= 360.0f;
+    while (deg < -180.0f) deg += 360.0f;
+    return deg;
+}
+
+static bool check(const char* metric, float value, float limit, bool isMax) {
+    bool ok = isMax ? value <= limit : value >= limit;
+    printf("  %-14s %9.2f  (%s %.2f)%s\n", metric, value, isMax ? "max" : "min", limit, ok ? "" : "  FALLO");
+    return ok;
+}
+
+// Cuerpo de una respuesta HTTP (sin cabeceras)
+static std::string httpBody(const std::string& resp) {
+    size_t p = resp.find("\r\n\r\n");
+    return (p == std::string::npos) ? std::string() : resp.substr(p + 4);
+}
+
+static bool dumpTrace(const char* path) {
+    std::string resp = httpGet("/trace");
+    if (resp.compare(0, 12, "HTTP/1.1 200") != 0) {
+        printf("  /trace rechazado: %.40s\n", resp.c_str());
+        return false;
+    }
+    std::string body = httpBody(resp);
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        printf("  no se puede escribir %s\n", path);
+        return false;
+    }
+    fwrite(body.data(), 1, body.size(), f);
+    fclose(f);
+    printf("  traza           %zu bytes en %s\n", body.size(), path);
+    return true;
+}
+
+// Datagramas de flota enviados por el firmware desde la última llamada
+struct FleetRx {
+    TelemDecoder dec;
+    unsigned long frames = 0;    // con timeMs >= fromMs
+    unsigned long lost = 0;      // saltos de SEQ
+    bool haveSeq = false;
+    uint8_t lastSeq = 0;
+    uint32_t fromMs = 0;
+};
+
+static void drainFleet(FleetRx& rx) {
+    std::string pkt;
+    while (simUdpTake(pkt)) {
+        for (char c : pkt) {
+            if (!rx.dec.feed((uint8_t)c)) continue;
+            if (rx.dec.id() != TELEM_MSG_FLEET_STATE || rx.dec.length() != sizeof(TelemFleetState)) continue;
+            TelemFleetState fs;
+            memcpy(&fs, rx.dec.payload(), sizeof(fs));
+            if (rx.haveSeq) rx.lost += (uint8_t)(rx.dec.seq() - rx.lastSeq - 1);
+            rx.haveSeq = true;
+            rx.lastSeq = rx.dec.seq();
+            if (fs.state.timeMs >= rx.fromMs) rx.frames++;
+        }
+    }
+}
+
+// Teleoperación con loop() bloqueado a mitad de lote: handleTeleop() no
+// corre, así que solo la caducidad de la consigna en la tarea de control
+// (DriveController::enforceExpiry) puede parar el robot a la hora del
+// hombre muerto
+static int runTeleopScenario(const Scenario& sc, bool verbose) {
+    simSetSerialEcho(verbose);
+    simSetStepUs(SIM_STEP_US);
+    simSetStepHook(plantStep);
+    plant.reset(0.0f, 0.0f, 0.0f);
+
+    clock_t cpu0 = clock();
+    setup();
+    runFor(500000);
+
+    // Como el dashboard: la conexión queda abierta (keep-alive), sin esperar
+    // a que se cierre
+    std::string body = SIM_TELEOP_BATCH;
+    std::string req = "POST /teleop?seq=1 HTTP/1.1\r\nHost: 192.168.4.1\r\nContent-Length: " +
+                      std::to_string(body.size()) + "\r\n\r\n" + body;
+    uint64_t startUs = simNowUs();
+    simHttpBegin(req);
+    runFor((uint64_t)(sc.stallAtS * 1e6f));
+
+    bool opened = teleop.isActive();
+    long driveDeadman0 = jsonInt(httpBody(httpGet("/teleop")), "driveDeadman");
+    unsigned long deadlineMs = teleop.deadmanAtMs();
+    float fromCm = plant.getDistanceCm();
+    bool movingAtStall = fabsf(plant.getLeftPps()) >= SIM_TELEOP_REST_PPS;
+    uint64_t lastMovingUs = simNowUs();
+    uint64_t end = simNowUs() + (uint64_t)(sc.stallForS * 1e6f);
+    while (simNowUs() < end) {
+        simAdvanceUs(SCHED_TICK_US);
+        scheduler.tick();
+        if (fabsf(plant.getLeftPps()) >= SIM_TELEOP_REST_PPS || fabsf(plant.getRightPps()) >= SIM_TELEOP_REST_PPS) {
+            lastMovingUs = simNowUs();
+        }
+    }
+    float stallDriftCm = plant.getDistanceCm() - fromCm;
+    bool stillMoving = lastMovingUs + SCHED_TICK_US >= end;
+    float lateMs = (float)(lastMovingUs / 1000.0) - (float)deadlineMs;
+    runFor(200000);
+    long driveDeadman = jsonInt(httpBody(httpGet("/teleop")), "driveDeadman");
+
+    double cpuS = (double)(clock() - cpu0) / CLOCKS_PER_SEC;
+    double simS = simNowUs() * 1e-6;
+    printf("%s: %s\n", sc.name, sc.description);
+    printf("  hombre muerto a %.0f ms del lote, bloqueo desde %.0f ms, recorrido %.1f cm\n",
+           deadlineMs - startUs / 1000.0, sc.stallAtS * 1000.0f, plant.getDistanceCm());
+    bool ok = opened && movingAtStall;
+    if (!ok) printf("  teleoperación sin abrir antes del bloqueo  FALLO\n");
+    if (stillMoving) printf("  ruedas girando al acabar el bloqueo  FALLO\n");
+    ok &= !stillMoving;
+    ok &= check("deadman_late_ms", lateMs, SIM_MAX_DEADMAN_LATE_MS, true);
+    printf("  stall_drift_cm %9.2f\n", stallDriftCm);
+    if (driveDeadman <= driveDeadman0) printf("  la tarea de control no aplicó la caducidad  FALLO\n");
+    ok &= driveDeadman > driveDeadman0;
+    printf("  speedup        %9.1fx (%.1f s simulados en %.2f s de CPU)\n",
+           cpuS > 0.0 ? simS / cpuS : 0.0, simS, cpuS);
+    printf("  %s\n", ok ? "OK" : "FALLO");
+    return ok ? 0 : 1;
+}
+
+static int runScenario(const Scenario& sc, bool verbose, const char* tracePath, const char* dumpPath) {
+    if (sc.routeIndex < 0) return runTeleopScenario(sc, verbose);
+    simSetSerialEcho(verbose);
+    simSetStepUs(SIM_STEP_US);
+    simSetStepHook(plantStep);
+    for (int i = 0; i < sc.boxCount; ++i) {
+        plant.addBox(sc.boxes[i].xMin, sc.boxes[i].yMin, sc.boxes[i].xMax, sc.boxes[i].yMax);
+    }
+    plant.reset(0.0f, 0.0f, 0.0f);
+
+    FILE* trace = nullptr;
+    if (tracePath) {
+        trace = fopen(tracePath, "w");
+        if (trace) fprintf(trace, "t_s,x_cm,y_cm,theta_deg,odom_x_cm,odom_y_cm,odom_theta_deg,pwm_l,pwm_r\n");
+    }
+
+    clock_t cpu0 = clock();
+    setup();
+    runFor(500000);   // escáner IR, mapa y filtros en régimen con el robot quieto
+
+    char target[64];
+    snprintf(target, sizeof(target), "/start_route?route=%d&dir=ida&delay=0", sc.routeIndex);
+    std::string resp = httpGet(target);
+    if (resp.compare(0, 12, "HTTP/1.1 200") != 0) {
+        printf("%s: /start_route rechazado: %.40s\n", sc.name, resp.c_str());
+        return 1;
+    }
+
+    uint64_t startUs = simNowUs();
+    FleetRx fleetRx;
+    drainFleet(fleetRx);
+    fleetRx.fromMs = (uint32_t)(startUs / 1000);
+    uint64_t limitUs = startUs + (uint64_t)(sc.maxTimeS * 2.0f * 1e6f);
+    uint64_t nextStatusUs = startUs;
+    uint64_t nextTraceUs = startUs;
+    int statusId = -1;
+    bool returnConfirmed = false;
+    bool finished = false;
+    int holdPhase = 0;       // 0 pendiente, 1 frenando, 2 midiendo, 3 soltado
+    float holdFromCm = 0.0f;
+    float holdDriftCm = 0.0f;
+    bool holdPartial = false;  // /fleet aplicó parte de una orden rechazada
+    bool stalled = false;
+    float stallDriftCm = 0.0f;
+    while (!finished && simNowUs() < limitUs) {
+        simAdvanceUs(SIM_STEP_US);
+        loop();
+        drainFleet(fleetRx);
+        uint64_t now = simNowUs();
+
+        if (statusId < 0 && now >= nextStatusUs) {
+            statusId = simHttpBegin("GET /route_status HTTP/1.1\r\n\r\n");
+            nextStatusUs = now + SIM_STATUS_PERIOD_US;
+        }
+        if (statusId >= 0 && simHttpDone(statusId)) {
+            std::string st = simHttpTake(statusId);
+            statusId = -1;
+            long active = jsonInt(st, "active");
+            long state = jsonInt(st, "state");
+            bool awaiting = jsonInt(st, "awaitingConfirm") == 1;
+            if (active == 0) {
+                finished = true;
+            } else if (state == 1 && awaiting) {
+                // IDA terminada y girada: confirmar el retorno o dar la ruta por acabada
+                if (sc.withReturn && !returnConfirmed) {
+                    returnConfirmed = true;
+                    httpGet("/confirm_route");
+                } else if (!sc.withReturn) {
+                    finished = true;
+                }
+            }
+        }
+
+        if (sc.holdForS > 0.0f && holdPhase < 3) {
+            float t = (float)((now - startUs) * 1e-6);
+            if (holdPhase == 0 && t >= sc.holdAtS) {
+                // Órdenes con un parámetro inválido: se rechazan enteras
+                for (const char* bad : SIM_BAD_FLEET_ORDERS) {
+                    if (httpGet(bad).compare(0, 12, "HTTP/1.1 400") != 0) {
+                        printf("  %s no devolvió 400\n", bad);
+                        holdPartial = true;
+                    }
+                }
+                std::string st = httpGet("/fleet");
+                holdPartial |= st.find("\"hold\":false") == std::string::npos ||
+                               st.find("\"leasing\":false") == std::string::npos;
+                httpGet("/fleet?hold=1");
+                holdPhase = 1;
+            } else if (holdPhase == 1 && t >= sc.holdAtS + SIM_HOLD_SETTLE_S) {
+                holdFromCm = plant.getDistanceCm();
+                holdPhase = 2;
+            } else if (holdPhase == 2 && t >= sc.holdAtS + sc.holdForS) {
+                holdDriftCm = plant.getDistanceCm() - holdFromCm;
+                httpGet("/fleet?hold=0");
+                holdPhase = 3;
+            }
+        }
+
+        if (sc.stallForS > 0.0f && !stalled && (now - startUs) * 1e-6 >= sc.stallAtS) {
+            stalled = true;
+            float fromCm = plant.getDistanceCm();
+            stallFor((uint64_t)(sc.stallForS * 1e6f));
+            stallDriftCm = plant.getDistanceCm() - fromCm;
+        }
+
+        if (trace && now >= nextTraceUs) {
+            nextTraceUs = now + SIM_TRACE_PERIOD_US;
+            fprintf(trace, "%.3f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%d,%d\n",
+                    (now - startUs) * 1e-6, plant.getX(), plant.getY(), plant.getTheta() * 180.0 / PI,
+                    odometry.getX(), odometry.getY(), odometry.getTheta() * 180.0 / PI,
+                    simPwm(MOTOR_LEFT_LPWM) - simPwm(MOTOR_LEFT_RPWM),
+                    simPwm(MOTOR_RIGHT_LPWM) - simPwm(MOTOR_RIGHT_RPWM));
+        }
+    }
+    uint64_t routeEndUs = simNowUs();
+    drainFleet(fleetRx);
+    float fleetHz = (routeEndUs > startUs) ? fleetRx.frames / ((routeEndUs - startUs) * 1e-6f) : 0.0f;
+    if (!finished) httpGet("/stop_route");
+    runFor(200000);   // que el robot se detenga antes de medir
+    if (trace) fclose(trace);
+
+    double cpuS = (double)(clock() - cpu0) / CLOCKS_PER_SEC;
+    double simS = simNowUs() * 1e-6;
+    float timeS = (float)((simNowUs() - startUs) * 1e-6) - 0.2f;
+    float ex = odometry.getX() - plant.getX();
+    float ey = odometry.getY() - plant.getY();
+    float odomErr = sqrtf(ex * ex + ey * ey);
+    float odomErrDeg = fabsf(wrapDeg((odometry.getTheta() - plant.getTheta()) * 180.0f / (float)PI));
+    float gx = plant.getX() - sc.goalX;
+    float gy = plant.getY() - sc.goalY;
+    float goalErr = sqrtf(gx * gx + gy * gy);
+
+    printf("%s: %s\n", sc.name, sc.description);
+    printf("  final real (%.1f, %.1f, %.1f°) odometría (%.1f, %.1f, %.1f°) recorrido %.0f cm\n",
+           plant.getX(), plant.getY(), wrapDeg(plant.getTheta() * 180.0f / (float)PI),
+           odometry.getX(), odometry.getY(), wrapDeg(odometry.getTheta() * 180.0f / (float)PI),
+           plant.getDistanceCm());
+    bool ok = finished;
+    if (!finished) printf("  ruta sin terminar en %.0f s  FALLO\n", sc.maxTimeS * 2.0f);
+    ok &= check("time_s", timeS, sc.maxTimeS, true);
+    ok &= check("odom_err_cm", odomErr, sc.maxOdomErrCm, true);
+    ok &= check("odom_err_deg", odomErrDeg, sc.maxOdomErrDeg, true);
+    ok &= check("goal_err_cm", goalErr, sc.maxGoalErrCm, true);
+    if (sc.boxCount > 0) ok &= check("clearance_cm", plant.getMinClearanceCm(), sc.minClearanceCm, false);
+    ok &= check("fleet_hz", fleetHz, SIM_MIN_FLEET_HZ, false);
+    if (sc.holdForS > 0.0f) {
+        if (holdPhase != 3) printf("  retención sin completar  FALLO\n");
+        ok &= holdPhase == 3;
+        if (holdPartial) printf("  /fleet aplicó parte de una orden rechazada  FALLO\n");
+        ok &= !holdPartial;
+        ok &= check("hold_drift_cm", holdDriftCm, SIM_MAX_HOLD_DRIFT_CM, true);
+    }
+    if (sc.stallForS > 0.0f) {
+        if (!stalled) printf("  bloqueo sin completar  FALLO\n");
+        ok &= stalled;
+        ok &= check("stall_drift_cm", stallDriftCm, SIM_MAX_STALL_DRIFT_CM, true);
+    }
+    printf("  speedup        %9.1fx (%.1f s simulados en %.2f s de CPU)\n",
+           cpuS > 0.0 ? simS / cpuS : 0.0, simS, cpuS);
+    if (dumpPath) ok &= dumpTrace(dumpPath);
+    printf("  %s\n", ok ? "OK" : "FALLO");
+    return ok ? 0 : 1;
+}
+
+// PWM con signo (adelante +) en los pines del BTS7960, como MotorDriver
+static void replayWritePwm(uint8_t fwdPin, uint8_t revPin, float pwm) {
+    int v = (int)lroundf(fabsf(pwm));
+    if (v > 255) v = 255;
+    analogWrite(fwdPin, pwm > 0.0f ? v : 0);
+    analogWrite(revPin, pwm < 0.0f ? v : 0);
+}
+
+// Replay en lazo abierto de una traza del flight-recorder. Entre dos
+// registros la planta recibe el PWM interpolado linealmente: la traza va a
+// 100 Hz y el PID a 200 Hz, así que la escritura intermedia no está grabada.
+static int runReplay(const char* path, const char* tracePath) {
+    FILE* in = fopen(path, "rb");
+    if (!in) {
+        printf("No se puede abrir %s\n", path);
+        return 2;
+    }
+    TelemDecoder dec;
+    TelemTraceInfo info = {};
+    bool haveInfo = false;
+    std::vector<TelemTraceRecord> records;
+    int c;
+    // Al acabar el fichero, next() entrega las tramas que queden en el buffer
+    while ((c = fgetc(in)) != EOF || dec.next()) {
+        if (c != EOF && !dec.feed((uint8_t)c)) continue;
+        if (dec.id() == TELEM_MSG_TRACE_INFO && dec.length() == sizeof(TelemTraceInfo)) {
+            memcpy(&info, dec.payload(), sizeof(info));
+            haveInfo = true;
+        } else if (dec.id() == TELEM_MSG_TRACE && dec.length() == sizeof(TelemTraceRecord)) {
+            TelemTraceRecord r;
+            memcpy(&r, dec.payload(), sizeof(r));
+            records.push_back(r);
+        }
+    }
+    fclose(in);
+    if (!haveInfo || records.size() < 2) {
+        printf("%s: sin traza válida (%zu registros, crc:%lu)\n", path, records.size(), (unsigned long)dec.crcErrors);
+        return 2;
+    }
+
+    const TelemTraceRecord& r0 = records[0];
+    const float pwmScale = 1.0f / MOTOR_PWM_SUBSTEPS;
+    plant.reset(r0.x * 0.1f, r0.y * 0.1f, r0.theta / TELEM_THETA_PER_RAD);
+    // Ruedas ya en marcha si la traza empieza en movimiento
+    float dt0 = (records[1].timeMs - r0.timeMs) * 1e-3f;
+    if (dt0 > 0.0f) {
+        plant.setWheelRates((records[1].encLeft - r0.encLeft) / dt0, (records[1].encRight - r0.encRight) / dt0);
+    }
+
+    FILE* trace = nullptr;
+    if (tracePath) {
+        trace = fopen(tracePath, "w");
+        if (trace) fprintf(trace, "t_s,enc_l,enc_r,plant_l,plant_r,x_cm,y_cm,plant_x_cm,plant_y_cm,pwm_l,pwm_r\n");
+    }
+
+    double sumSq = 0.0;
+    double maxErr = 0.0;
+    uint64_t now = 0;
+    for (size_t i = 0; i < records.size(); ++i) {
+        const TelemTraceRecord& r = records[i];
+        if (i > 0) {
+            const TelemTraceRecord& p = records[i - 1];
+            uint64_t spanUs = (uint64_t)(uint32_t)(r.timeMs - p.timeMs) * 1000ULL;
+            for (uint64_t t = 0; t < spanUs; t += SIM_REPLAY_STEP_US) {
+                uint64_t stepUs = (spanUs - t < SIM_REPLAY_STEP_US) ? spanUs - t : SIM_REPLAY_STEP_US;
+                float k = (float)(t + stepUs / 2) / (float)spanUs;
+                replayWritePwm(MOTOR_LEFT_LPWM, MOTOR_LEFT_RPWM, (p.pwmLeft + (r.pwmLeft - p.pwmLeft) * k) * pwmScale);
+                replayWritePwm(MOTOR_RIGHT_LPWM, MOTOR_RIGHT_RPWM, (p.pwmRight + (r.pwmRight - p.pwmRight) * k) * pwmScale);
+                plant.step(now, now + stepUs);
+                now += stepUs;
+            }
+        }
+        double el = plant.getLeftCounts() - (double)(r.encLeft - r0.encLeft);
+        double er = plant.getRightCounts() - (double)(r.encRight - r0.encRight);
+        sumSq += 0.5 * (el * el + er * er);
+        if (fabs(el) > maxErr) maxErr = fabs(el);
+        if (fabs(er) > maxErr) maxErr = fabs(er);
+        if (trace) {
+            fprintf(trace, "%.3f,%ld,%ld,%.0f,%.0f,%.1f,%.1f,%.2f,%.2f,%.2f,%.2f\n",
+                    (r.timeMs - r0.timeMs) * 1e-3, (long)(r.encLeft - r0.encLeft), (long)(r.encRight - r0.encRight),
+                    plant.getLeftCounts(), plant.getRightCounts(), r.x * 0.1f, r.y * 0.1f,
+                    plant.getX(), plant.getY(), r.pwmLeft * pwmScale, r.pwmRight * pwmScale);
+        }
+    }
+    if (trace) fclose(trace);
+
+    const TelemTraceRecord& rn = records.back();
+    long recL = (long)(rn.encLeft - r0.encLeft);
+    long recR = (long)(rn.encRight - r0.encRight);
+    float ex = plant.getX() - rn.x * 0.1f;
+    float ey = plant.getY() - rn.y * 0.1f;
+    float travel = 0.5f * (fabsf((float)recL) + fabsf((float)recR));
+    printf("%s: %zu registros, %.2f s, motivo %u\n", path, records.size(), now * 1e-6, (unsigned)info.reason);
+    printf("  cuentas grabadas  izq %ld der %ld / planta izq %.0f der %.0f\n",
+           recL, recR, plant.getLeftCounts(), plant.getRightCounts());
+    printf("  enc_rms_err       %9.1f cuentas\n", sqrt(sumSq / records.size()));
+    printf("  enc_max_err       %9.1f cuentas\n", maxErr);
+    printf("  enc_final_err     %9.1f %%\n",
+           travel > 0.0f ? 100.0 * 0.5 * (fabs(plant.getLeftCounts() - recL) + fabs(plant.getRightCounts() - recR)) / travel : 0.0);
+    printf("  pose_err_cm       %9.2f  (planta frente a la odometría grabada)\n", sqrtf(ex * ex + ey * ey));
+    printf("  pose_err_deg      %9.2f\n",
+           fabsf(wrapDeg((plant.getTheta() - rn.theta / TELEM_THETA_PER_RAD) * 180.0f / (float)PI)));
+    return 0;
+}
+
+static void usage() {
+    printf("Uso: amr_sim [-v] [--trace fichero.csv] [--dump-trace fichero.bin] [--list] [escenario...]\n");
+    printf("       amr_sim --replay traza.bin [--trace fichero.csv]\n");
+    printf("Sin escenarios ejecuta todos, cada uno en su propio proceso.\n");
+}
+
+int main(int argc, char** argv) {
+    bool verbose = false;
+    const char* tracePath = nullptr;
+    const char* dumpPath = nullptr;
+    const char* replayPath = nullptr;
+    const Scenario* selected[SCENARIO_COUNT];
+    int selectedCount = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-v") == 0) {
+            verbose = true;
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else if (strcmp(argv[i], "--dump-trace") == 0 && i + 1 < argc) {
+            dumpPath = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (strcmp(argv[i], "--list") == 0) {
+            for (int k = 0; k < SCENARIO_COUNT; ++k) {
+                printf("%-18s %s\n", SCENARIOS[k].name, SCENARIOS[k].description);
+            }
+            return 0;
+        } else if (argv[i][0] == '-') {
+            usage();
+            return 2;
+        } else {
+            int k = 0;
+            while (k < SCENARIO_COUNT && strcmp(SCENARIOS[k].name, argv[i]) != 0) k++;
+            if (k == SCENARIO_COUNT) {
+                printf("Escenario desconocido: %s\n", argv[i]);
+                return 2;
+            }
+            if (selectedCount < SCENARIO_COUNT) selected[selectedCount++] = &SCENARIOS[k];
+        }
+    }
+    if (replayPath) return runReplay(replayPath, tracePath);
+    if (selectedCount == 0) {
+        for (int k = 0; k < SCENARIO_COUNT; ++k) selected[selectedCount++] = &SCENARIOS[k];
+    }
+
+    // El firmware vive en globales y setup() solo se llama una vez: un
+    // proceso por escenario
+    if (selectedCount == 1) return runScenario(*selected[0], verbose, tracePath, dumpPath);
+    int failures = 0;
+    for (int i = 0; i < selectedCount; ++i) {
+        fflush(stdout);
+        pid_t pid = fork();
+        if (pid == 0) {
+            int rc = runScenario(*selected[i], verbose, nullptr, nullptr);
+            fflush(stdout);
+            _exit(rc);
+        }
+        int status = 1;
+        if (pid < 0 || waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) failures++;
+    }
+    printf("%d/%d escenarios OK\n", selectedCount - failures, selectedCount);
+    return failures ? 1 : 0;
+}
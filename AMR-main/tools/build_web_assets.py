@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+# ========================================
+#   GENERADOR DE PÁGINAS WEB EN FLASH (HOST)
+# ========================================
+# Comprime web/*.html con gzip y genera arduino/src/AMR_Complete/WebAssets.h
+# con un array PROGMEM por página, su longitud y un ETag derivado del
+# contenido. El firmware las sirve tal cual con Content-Encoding: gzip y
+# responde 304 si el navegador ya tiene la misma versión.
+#
+# Uso (desde cualquier directorio), tras editar una página:
+#     python3 tools/build_web_assets.py
+# y compilar el sketch. WebAssets.h se versiona junto al .html: el IDE de
+# Arduino no ejecuta este paso.
+#
+# La salida es determinista (gzip sin fecha ni nombre): sin cambios en el
+# .html, el .h no cambia.
+
+import gzip
+import hashlib
+import os
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+WEB_DIR = os.path.join(ROOT, "web")
+OUT = os.path.join(ROOT, "arduino", "src", "AMR_Complete", "WebAssets.h")
+
+# (fichero, identificador C, tipo MIME)
+ASSETS = [
+    ("dashboard.html", "DASHBOARD", "text/html; charset=utf-8"),
+    ("routes.html", "ROUTES_UI", "text/html; charset=utf-8"),
+]
+
+
+def c_array(data):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    return "\n".join(lines)
+
+
+def main():
+    out = []
+    out.append("#pragma once")
+    out.append("")
+    out.append("#ifndef WEB_ASSETS_H")
+    out.append("#define WEB_ASSETS_H")
+    out.append("")
+    out.append("#include <Arduino.h>")
+    out.append("")
+    out.append("// ========================================")
+    out.append("//     PÁGINAS WEB COMPRIMIDAS (GENERADO)")
+    out.append("// ========================================")
+    out.append("// NO EDITAR: generado por tools/build_web_assets.py desde web/*.html.")
+    out.append("// Cada página: bytes gzip en flash, longitud, ETag (hash del contenido,")
+    out.append("// con comillas) y tipo MIME.")
+    out.append("")
+
+    total_raw = 0
+    total_gz = 0
+    for fname, ident, mime in ASSETS:
+        path = os.path.join(WEB_DIR, fname)
+        with open(path, "rb") as f:
+            raw = f.read()
+        gz = gzip.compress(raw, compresslevel=9, mtime=0)
+        etag = hashlib.sha256(raw).hexdigest()[:16]
+        total_raw += len(raw)
+        total_gz += len(gz)
+
+        out.append("// web/%s: %d bytes -> %d gzip" % (fname, len(raw), len(gz)))
+        out.append("#define WEB_%s_ETAG \"\\\"%s\\\"\"" % (ident, etag))
+        out.append("#define WEB_%s_TYPE \"%s\"" % (ident, mime))
+        out.append("#define WEB_%s_GZ_LEN %dU" % (ident, len(gz)))
+        out.append("static const uint8_t WEB_%s_GZ[] PROGMEM = {" % ident)
+        out.append(c_array(gz))
+        out.append("};")
+        out.append("")
+
+    out.append("#endif // WEB_ASSETS_H")
+    out.append("")
+
+    with open(OUT, "w", newline="\n") as f:
+        f.write("\n".join(out))
+    sys.stderr.write("WebAssets.h: %d bytes -> %d gzip\n" % (total_raw, total_gz))
+
+
+if __name__ == "__main__":
+    main()
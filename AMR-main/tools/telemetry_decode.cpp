@@ -0,0 +1,224 @@
+// ========================================
+//   DECODIFICADOR DE TELEMETRÍA BINARIA (HOST)
+// ========================================
+// Lee el flujo de Serial (o un volcado, o la respuesta de GET /telemetry) y
+// escribe una línea CSV por trama TELEM_MSG_STATE. Con --trace escribe en
+// su lugar los registros del grabador de vuelo (TELEM_MSG_TRACE, de GET
+// /trace o del comando 'G'). Con --fleet decodifica la difusión UDP del
+// modo flota (TELEM_MSG_FLEET_STATE), una línea por trama con el robot que
+// la emite. Comparte el esquema con el firmware a través de
+// TelemetryProtocol.h.
+//
+// Compilar:
+//     g++ -std=c++11 -O2 -o telemetry_decode telemetry_decode.cpp
+// Uso (Linux):
+//     stty -F /dev/ttyACM0 115200 raw -echo
+//     ./telemetry_decode /dev/ttyACM0 > log.csv      (enviar 'B' al robot)
+//     curl -s http://192.168.4.1/telemetry | ./telemetry_decode
+//     curl -s http://192.168.4.1/trace | ./telemetry_decode --trace > trace.csv
+//     socat -u UDP-RECV:4210 - | ./telemetry_decode --fleet > fleet.csv
+//
+// Tramas perdidas (saltos de SEQ) y errores de CRC se informan por stderr.
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "../arduino/src/AMR_Complete/TelemetryProtocol.h"
+
+static void printHeader() {
+    printf("seq,time_ms,x_cm,y_cm,theta_deg,v_cm_s,w_rad_s,enc_l,enc_r,"
+           "ir_l,ir_fl,ir_b,ir_fr,ir_r,route_state,route_point,obstacle_state,flags\n");
+}
+
+static void printState(uint8_t seq, const TelemState& st) {
+    printf("%u,%lu,%.2f,%.2f,%.2f,%.1f,%.3f,%ld,%ld,%u,%u,%u,%u,%u,%u,%u,%u,0x%02X\n",
+           (unsigned)seq, (unsigned long)st.timeMs,
+           st.x / TELEM_POS_PER_CM, st.y / TELEM_POS_PER_CM,
+           st.theta / TELEM_THETA_PER_RAD * 180.0 / M_PI,
+           st.v / 10.0, st.w / 1000.0,
+           (long)st.encLeft, (long)st.encRight,
+           (unsigned)st.ir[0], (unsigned)st.ir[1], (unsigned)st.ir[2],
+           (unsigned)st.ir[3], (unsigned)st.ir[4],
+           (unsigned)st.routeState, (unsigned)st.routePoint,
+           (unsigned)st.obstacleState, (unsigned)st.flags);
+}
+
+static const char* traceReasonName(uint8_t reason) {
+    switch (reason) {
+        case TELEM_TRACE_MANUAL: return "manual";
+        case TELEM_TRACE_STOP: return "stop";
+        case TELEM_TRACE_ROUTE_ABORT: return "route_abort";
+        case TELEM_TRACE_TURN_TIMEOUT: return "turn_timeout";
+        case TELEM_TRACE_DIAG_TIMEOUT: return "diag_timeout";
+        default: return "running";
+    }
+}
+
+static void printTraceHeader() {
+    printf("time_ms,x_cm,y_cm,theta_deg,enc_l,enc_r,pwm_l,pwm_r,"
+           "ir_l,ir_fl,ir_b,ir_fr,ir_r,route_state,route_point,obstacle_state,flags,trigger\n");
+}
+
+static void printTraceRecord(const TelemTraceRecord& r) {
+    printf("%lu,%.1f,%.1f,%.2f,%ld,%ld,%.2f,%.2f,%u,%u,%u,%u,%u,%u,%u,%u,0x%02X,%d\n",
+           (unsigned long)r.timeMs, r.x / 10.0, r.y / 10.0,
+           r.theta / TELEM_THETA_PER_RAD * 180.0 / M_PI,
+           (long)r.encLeft, (long)r.encRight,
+           r.pwmLeft / 16.0, r.pwmRight / 16.0,
+           (unsigned)r.ir[0], (unsigned)r.ir[1], (unsigned)r.ir[2],
+           (unsigned)r.ir[3], (unsigned)r.ir[4],
+           (unsigned)r.routeState, (unsigned)r.routePoint,
+           (unsigned)r.obstacleState, (unsigned)r.flags,
+           (r.flags & TELEM_FLAG_TRIGGER) ? 1 : 0);
+}
+
+static void printFleetHeader() {
+    printf("robot,seq,hold,leasing,lease_expired,station,route,lease_left_ms,"
+           "time_ms,x_cm,y_cm,theta_deg,v_cm_s,w_rad_s,route_state,route_point,obstacle_state,flags\n");
+}
+
+static void printFleetState(uint8_t seq, const TelemFleetState& f) {
+    const TelemState& st = f.state;
+    printf("%u,%u,%d,%d,%d,%d,%d,%u,%lu,%.2f,%.2f,%.2f,%.1f,%.3f,%u,%u,%u,0x%02X\n",
+           (unsigned)f.robotId, (unsigned)seq,
+           (f.fleetFlags & TELEM_FLEET_HOLD) ? 1 : 0,
+           (f.fleetFlags & TELEM_FLEET_LEASING) ? 1 : 0,
+           (f.fleetFlags & TELEM_FLEET_LEASE_EXPIRED) ? 1 : 0,
+           (f.fleetFlags & TELEM_FLEET_STATION) ? 1 : 0,
+           (f.routeIndex == 0xFF) ? -1 : (int)f.routeIndex,
+           (unsigned)f.leaseLeftMs, (unsigned long)st.timeMs,
+           st.x / TELEM_POS_PER_CM, st.y / TELEM_POS_PER_CM,
+           st.theta / TELEM_THETA_PER_RAD * 180.0 / M_PI,
+           st.v / 10.0, st.w / 1000.0,
+           (unsigned)st.routeState, (unsigned)st.routePoint,
+           (unsigned)st.obstacleState, (unsigned)st.flags);
+}
+
+// Difusión de la flota: varios robots en el mismo flujo, pérdidas por robot
+static int decodeFleet(FILE* in) {
+    TelemDecoder dec;
+    bool haveSeq[256] = {};
+    uint8_t lastSeq[256] = {};
+    unsigned long lost = 0;
+    printFleetHeader();
+    int c;
+    // Al acabar el fichero, next() entrega las tramas que queden en el buffer
+    while ((c = fgetc(in)) != EOF || dec.next()) {
+        if (c != EOF && !dec.feed((uint8_t)c)) continue;
+        if (dec.id() != TELEM_MSG_FLEET_STATE || dec.length() != sizeof(TelemFleetState)) continue;
+
+        TelemFleetState f;
+        memcpy(&f, dec.payload(), sizeof(f));
+        uint8_t id = f.robotId;
+        if (haveSeq[id]) {
+            uint8_t gap = (uint8_t)(dec.seq() - lastSeq[id] - 1);
+            if (gap) {
+                lost += gap;
+                fprintf(stderr, "robot %u seq %u: %u tramas perdidas\n",
+                        (unsigned)id, (unsigned)dec.seq(), (unsigned)gap);
+            }
+        }
+        haveSeq[id] = true;
+        lastSeq[id] = dec.seq();
+
+        printFleetState(dec.seq(), f);
+        fflush(stdout);
+    }
+    fprintf(stderr, "tramas:%lu perdidas:%lu crc:%lu version:%lu\n",
+            (unsigned long)dec.frames, lost, (unsigned long)dec.crcErrors,
+            (unsigned long)dec.versionErrors);
+    return 0;
+}
+
+// Registros del grabador: cabecera por stderr, un CSV por registro
+static int decodeTrace(FILE* in) {
+    TelemDecoder dec;
+    unsigned long records = 0;
+    unsigned long expected = 0;
+    printTraceHeader();
+    int c;
+    while ((c = fgetc(in)) != EOF || dec.next()) {
+        if (c != EOF && !dec.feed((uint8_t)c)) continue;
+        if (dec.id() == TELEM_MSG_TRACE_INFO && dec.length() == sizeof(TelemTraceInfo)) {
+            TelemTraceInfo info;
+            memcpy(&info, dec.payload(), sizeof(info));
+            expected += info.count;
+            fprintf(stderr, "traza: %u registros cada %u ms, motivo %s en t=%lu ms\n",
+                    (unsigned)info.count, (unsigned)info.periodMs,
+                    traceReasonName(info.reason), (unsigned long)info.triggerMs);
+        } else if (dec.id() == TELEM_MSG_TRACE && dec.length() == sizeof(TelemTraceRecord)) {
+            TelemTraceRecord r;
+            memcpy(&r, dec.payload(), sizeof(r));
+            printTraceRecord(r);
+            records++;
+        }
+    }
+    fprintf(stderr, "registros:%lu de %lu crc:%lu version:%lu\n",
+            records, expected, (unsigned long)dec.crcErrors, (unsigned long)dec.versionErrors);
+    return (records == expected) ? 0 : 2;
+}
+
+int main(int argc, char** argv) {
+    FILE* in = stdin;
+    bool trace = false;
+    bool fleetMode = false;
+    if (argc > 1 && strcmp(argv[1], "--trace") == 0) {
+        trace = true;
+        argc--;
+        argv++;
+    } else if (argc > 1 && strcmp(argv[1], "--fleet") == 0) {
+        fleetMode = true;
+        argc--;
+        argv++;
+    }
+    if (argc > 1 && strcmp(argv[1], "-") != 0) {
+        in = fopen(argv[1], "rb");
+        if (!in) {
+            perror(argv[1]);
+            return 1;
+        }
+    }
+    if (trace) {
+        int rc = decodeTrace(in);
+        if (in != stdin) fclose(in);
+        return rc;
+    }
+    if (fleetMode) {
+        int rc = decodeFleet(in);
+        if (in != stdin) fclose(in);
+        return rc;
+    }
+
+    TelemDecoder dec;
+    bool haveSeq = false;
+    uint8_t lastSeq = 0;
+    unsigned long lost = 0;
+    printHeader();
+
+    int c;
+    while ((c = fgetc(in)) != EOF || dec.next()) {
+        if (c != EOF && !dec.feed((uint8_t)c)) continue;
+        if (dec.id() != TELEM_MSG_STATE || dec.length() != sizeof(TelemState)) continue;
+
+        if (haveSeq) {
+            uint8_t gap = (uint8_t)(dec.seq() - lastSeq - 1);
+            if (gap) {
+                lost += gap;
+                fprintf(stderr, "seq %u: %u tramas perdidas\n", (unsigned)dec.seq(), (unsigned)gap);
+            }
+        }
+        haveSeq = true;
+        lastSeq = dec.seq();
+
+        TelemState st;
+        memcpy(&st, dec.payload(), sizeof(st));
+        printState(dec.seq(), st);
+        fflush(stdout);
+    }
+
+    fprintf(stderr, "tramas:%lu perdidas:%lu crc:%lu version:%lu\n",
+            (unsigned long)dec.frames, lost, (unsigned long)dec.crcErrors,
+            (unsigned long)dec.versionErrors);
+    if (in != stdin) fclose(in);
+    return 0;
+}